@@ -0,0 +1,109 @@
+LOCAL_PATH := $(call my-dir)
+
+###############################################################################
+# internal benchmarks are built with libobus sources, its symbols are hidden
+###############################################################################
+
+include $(LOCAL_PATH)/../../src/libobus/libobus.mk
+BENCH_LIBOBUS_DIR := ../../src/libobus
+BENCH_LIBOBUS_SRC_FILES := \
+	$(addprefix $(BENCH_LIBOBUS_DIR)/,$(LIBOBUS_SOURCE_FILES))
+BENCH_LIBOBUS_CFLAGS := $(LIBOBUS_CFLAGS) -DHAVE_SYS_TIMERFD_H -DHAVE_EPOLL
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := obus-loopbench
+LOCAL_DESCRIPTION := obus fd loop wakeup benchmark
+LOCAL_CATEGORY_PATH := libs/obus/test
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH)/$(BENCH_LIBOBUS_DIR)/include \
+	$(LOCAL_PATH)/$(BENCH_LIBOBUS_DIR)/src
+
+LOCAL_CFLAGS := $(BENCH_LIBOBUS_CFLAGS)
+LOCAL_LDLIBS := $(LIBOBUS_LDLIBS)
+
+LOCAL_SRC_FILES := \
+	loopbench.c \
+	$(BENCH_LIBOBUS_SRC_FILES)
+
+include $(BUILD_EXECUTABLE)
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := obus-structbench
+LOCAL_DESCRIPTION := obus struct fields lookup and decoding benchmark
+LOCAL_CATEGORY_PATH := libs/obus/test
+
+LOCAL_C_INCLUDES := \
+	$(LOCAL_PATH)/$(BENCH_LIBOBUS_DIR)/include \
+	$(LOCAL_PATH)/$(BENCH_LIBOBUS_DIR)/src \
+	$(LOCAL_PATH)/generated/server
+
+LOCAL_CFLAGS := $(BENCH_LIBOBUS_CFLAGS)
+LOCAL_LDLIBS := $(LIBOBUS_LDLIBS)
+
+LOCAL_SRC_FILES := \
+	structbench.c \
+	$(BENCH_LIBOBUS_SRC_FILES)
+
+LOCAL_DEPENDS_HOST_MODULES := host.obusgen
+
+LOCAL_CUSTOM_MACROS := \
+	obusgen-macro:server,c,unused,$(LOCAL_PATH)/generated/server,$(LOCAL_PATH)/bench.xml,codecs
+
+include $(BUILD_EXECUTABLE)
+
+###############################################################################
+# bench bus server and client
+###############################################################################
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := obus-benchd
+LOCAL_DESCRIPTION := obus benchmarks server
+LOCAL_CATEGORY_PATH := libs/obus/test
+LOCAL_LIBRARIES := libobus
+
+LOCAL_C_INCLUDES := $(LOCAL_PATH)/generated/server
+
+LOCAL_CFLAGS := \
+	-Wdeclaration-after-statement \
+	-Wunsafe-loop-optimizations \
+	-Wshadow -Wmissing-prototypes \
+	-D_FORTIFY_SOURCE=2
+
+LOCAL_SRC_FILES := \
+	benchd.c
+
+LOCAL_DEPENDS_HOST_MODULES := host.obusgen
+
+LOCAL_CUSTOM_MACROS := \
+	obusgen-macro:server,c,unused,$(LOCAL_PATH)/generated/server,$(LOCAL_PATH)/bench.xml,codecs
+
+include $(BUILD_EXECUTABLE)
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := obus-benchclient
+LOCAL_DESCRIPTION := obus benchmarks client
+LOCAL_CATEGORY_PATH := libs/obus/test
+LOCAL_LIBRARIES := libobus
+
+LOCAL_C_INCLUDES := $(LOCAL_PATH)/generated/client
+
+LOCAL_CFLAGS := \
+	-Wdeclaration-after-statement \
+	-Wunsafe-loop-optimizations \
+	-Wshadow -Wmissing-prototypes \
+	-D_FORTIFY_SOURCE=2
+
+LOCAL_SRC_FILES := \
+	benchclient.c
+
+LOCAL_DEPENDS_HOST_MODULES := host.obusgen
+
+LOCAL_CUSTOM_MACROS := \
+	obusgen-macro:client,c,unused,$(LOCAL_PATH)/generated/client,$(LOCAL_PATH)/bench.xml
+
+include $(BUILD_EXECUTABLE)
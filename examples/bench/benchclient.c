@@ -0,0 +1,419 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file benchclient.c
+ *
+ * @brief obus benchmarks client
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <poll.h>
+
+#include "libobus.h"
+#include "bench_bus.h"
+#include "bench_point.h"
+#include "bench.h"
+
+static int s_fdpipes[2];
+static struct obus_client *s_client;
+static int s_done;
+
+/* number of point events to receive */
+static uint32_t s_n_events;
+static uint32_t s_events;
+static uint64_t s_events_start;
+static uint64_t s_events_end;
+
+/* number of ping calls to do, at most s_window waiting for their ack */
+static uint32_t s_n_calls;
+static uint32_t s_window = 1;
+static int s_batch;
+static int s_calls_started;
+static int s_max_pending;
+static uint32_t s_calls_sent;
+static uint32_t s_calls_acked;
+static uint32_t s_calls_failed;
+static uint64_t s_calls_start;
+static uint64_t s_calls_end;
+static unsigned long s_calls_rss_start;
+static struct obus_alloc_stats s_calls_alloc_start;
+static struct bench_point *s_point;
+
+/* calls send time indexed by handle and acks latency */
+static uint64_t s_calls_sent_ns[UINT16_MAX + 1];
+static uint64_t *s_latencies;
+
+static void stop_client(void)
+{
+	uint8_t dummy = 0xff;
+
+	if (write(s_fdpipes[1], &dummy, sizeof(dummy)) < 0)
+		fprintf(stderr, "can't write in pipe: %s\n", strerror(errno));
+}
+
+static void sig_handler(int signum)
+{
+	stop_client();
+}
+
+static void ping_status(struct bench_point *object, obus_handle_t handle,
+			enum obus_call_status status)
+{
+	s_latencies[s_calls_acked + s_calls_failed] =
+		bench_now_ns() - s_calls_sent_ns[handle];
+
+	if (status == OBUS_CALL_ACKED)
+		s_calls_acked++;
+	else
+		s_calls_failed++;
+
+	if (s_calls_acked + s_calls_failed == s_n_calls) {
+		s_calls_end = bench_now_ns();
+		stop_client();
+	}
+}
+
+/* send ping calls until client pending calls limit is reached */
+static void send_pings(void)
+{
+	struct bench_point_ping_args args;
+	uint64_t now;
+	uint16_t handle;
+	int ret, pending;
+
+	while (s_calls_started && s_calls_sent < s_n_calls) {
+		bench_point_ping_args_init(&args);
+		OBUS_SET(&args, value, s_calls_sent);
+		now = bench_now_ns();
+		ret = bench_point_call_ping(s_client, s_point, &args,
+					    &ping_status, &handle);
+		if (ret == -EBUSY)
+			break;
+
+		if (ret < 0) {
+			fprintf(stderr, "can't call ping: %s\n",
+				strerror(-ret));
+			stop_client();
+			return;
+		}
+
+		s_calls_sent_ns[handle] = now;
+		s_calls_sent++;
+	}
+
+	pending = obus_client_get_pending_calls(s_client);
+	if (pending > s_max_pending)
+		s_max_pending = pending;
+}
+
+static void start_calls(void)
+{
+	/* touch latencies memory so that it is in start rss */
+	memset(s_calls_sent_ns, 0, sizeof(s_calls_sent_ns));
+	memset(s_latencies, 0, s_n_calls * sizeof(*s_latencies));
+	s_calls_rss_start = bench_mem_kb("VmRSS");
+	obus_client_get_alloc_stats(s_client, &s_calls_alloc_start);
+	s_calls_start = bench_now_ns();
+	s_calls_started = 1;
+}
+
+static void start_events(void)
+{
+	struct bench_point_flood_args args;
+	uint16_t handle;
+	int ret;
+
+	bench_point_flood_args_init(&args);
+	OBUS_SET(&args, count, s_n_events);
+	ret = bench_point_call_flood(s_client, s_point, &args, NULL, &handle);
+	if (ret < 0) {
+		fprintf(stderr, "can't call flood: %s\n", strerror(-ret));
+		stop_client();
+	}
+}
+
+/* start benchmark once point is known */
+static void point_add(struct bench_point *object,
+		      struct bench_bus_event *bus_event, void *user_data)
+{
+	s_point = object;
+	if (s_n_events > 0)
+		start_events();
+	else
+		start_calls();
+}
+
+static void point_remove(struct bench_point *object,
+			 struct bench_bus_event *bus_event, void *user_data)
+{
+}
+
+static void point_event(struct bench_point *object,
+			struct bench_point_event *event,
+			struct bench_bus_event *bus_event, void *user_data)
+{
+	if (s_events++ == 0)
+		s_events_start = bench_now_ns();
+
+	if (s_events == s_n_events) {
+		s_events_end = bench_now_ns();
+		stop_client();
+	}
+}
+
+static void bus_event(struct obus_bus_event *obus_event, void *user_data)
+{
+	struct bench_bus_event *event;
+
+	event = bench_bus_event_from_obus_event(obus_event);
+	if (!event)
+		return;
+
+	/* client destruction also disconnects it */
+	if (s_done)
+		return;
+
+	switch (bench_bus_event_get_type(event)) {
+	case BENCH_BUS_EVENT_DISCONNECTED:
+	case BENCH_BUS_EVENT_CONNECTION_REFUSED:
+		fprintf(stderr, "connection lost\n");
+		stop_client();
+		break;
+	default:
+		break;
+	}
+}
+
+static void print_events_result(void)
+{
+	struct obus_client_stats stats;
+	uint64_t elapsed = s_events_end - s_events_start;
+
+	obus_client_get_stats(s_client, &stats);
+	printf("events      : %" PRIu32 "/%" PRIu32 "\n", s_events, s_n_events);
+	if (s_events != s_n_events || elapsed == 0)
+		return;
+
+	printf("elapsed     : %.1f ms\n", (double)elapsed / 1e6);
+	printf("rate        : %.0f events/s\n",
+	       (double)s_events * 1e9 / (double)elapsed);
+	printf("rx          : %" PRIu64 " packets, %" PRIu64 " bytes\n",
+	       stats.traffic.rx_packets, stats.traffic.rx_bytes);
+	if (stats.decode.n_samples == 0)
+		return;
+
+	printf("decode      : %.1f ns/packet avg, %" PRIu64 " ns max\n",
+	       (double)stats.decode.total_ns / (double)stats.decode.n_samples,
+	       stats.decode.max_ns);
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+	uint64_t va = *(const uint64_t *)a, vb = *(const uint64_t *)b;
+
+	return va < vb ? -1 : va > vb ? 1 : 0;
+}
+
+/* latency percentile in us, per mille given */
+static double latency_us(uint32_t permille)
+{
+	return (double)s_latencies[(uint64_t)(s_n_calls - 1) * permille /
+				   1000] / 1e3;
+}
+
+static void print_calls_result(void)
+{
+	struct obus_alloc_stats alloc;
+	uint64_t elapsed = s_calls_end - s_calls_start;
+
+	obus_client_get_alloc_stats(s_client, &alloc);
+	printf("calls       : %" PRIu32 "/%" PRIu32 " acked, %" PRIu32
+	       " failed, window %" PRIu32 "%s\n", s_calls_acked, s_n_calls,
+	       s_calls_failed, s_window, s_batch ? ", batched" : "");
+	if (s_calls_acked + s_calls_failed != s_n_calls || elapsed == 0)
+		return;
+
+	printf("elapsed     : %.1f ms\n", (double)elapsed / 1e6);
+	printf("rate        : %.0f calls/s\n",
+	       (double)s_n_calls * 1e9 / (double)elapsed);
+	printf("depth       : %d calls waiting for their ack at most\n",
+	       s_max_pending);
+
+	qsort(s_latencies, s_n_calls, sizeof(*s_latencies), &compare_u64);
+	printf("ack latency : p50 %.1f us, p90 %.1f us, p99 %.1f us, "
+	       "p99.9 %.1f us, max %.1f us\n", latency_us(500),
+	       latency_us(900), latency_us(990), latency_us(999),
+	       latency_us(1000));
+	printf("rss         : %lu kB start, %lu kB end, %lu kB peak\n",
+	       s_calls_rss_start, bench_mem_kb("VmRSS"), bench_mem_kb("VmHWM"));
+	printf("allocs      : %" PRIu64 " allocs, %" PRIu64 " from heap\n",
+	       alloc.n_allocs - s_calls_alloc_start.n_allocs,
+	       alloc.n_heap_allocs - s_calls_alloc_start.n_heap_allocs);
+}
+
+static void print_usage(void)
+{
+	fprintf(stderr, "usage: benchclient -e <events> <address>\n");
+	fprintf(stderr, "       benchclient -c <calls> [-w <window>] [-b] "
+			"<address>\n\n");
+	fprintf(stderr, "\t-e: receive <events> point events sent at once\n");
+	fprintf(stderr, "\t-c: do <calls> point ping calls\n");
+	fprintf(stderr, "\t-w: keep at most <window> calls waiting for "
+			"their ack (default 1)\n");
+	fprintf(stderr, "\t-b: batch calls issued in a loop iteration in one "
+			"write\n");
+	fprintf(stderr, "\t<address>: bench bus server address\n");
+}
+
+int main(int argc, char *argv[])
+{
+	int ret, c, stop;
+	struct pollfd fds[2];
+	struct bench_point_provider point_provider = {
+		.add = point_add,
+		.remove = point_remove,
+		.event = point_event,
+	};
+
+	while ((c = getopt(argc, argv, "e:c:w:b")) != -1) {
+		switch (c) {
+		case 'e':
+			s_n_events = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			s_n_calls = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'w':
+			s_window = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			s_batch = 1;
+			break;
+		default:
+			print_usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (optind >= argc || (s_n_events == 0) == (s_n_calls == 0) ||
+	    s_window == 0) {
+		print_usage();
+		return EXIT_FAILURE;
+	}
+
+	if (s_n_calls > 0) {
+		s_latencies = calloc(s_n_calls, sizeof(*s_latencies));
+		if (!s_latencies)
+			return EXIT_FAILURE;
+	}
+
+	ret = pipe(s_fdpipes);
+	if (ret < 0) {
+		free(s_latencies);
+		return EXIT_FAILURE;
+	}
+
+	s_client = obus_client_new("benchclient", bench_bus_desc,
+				   &bus_event, NULL);
+	if (!s_client) {
+		ret = EXIT_FAILURE;
+		goto close_pipes;
+	}
+
+	bench_point_subscribe(s_client, &point_provider, NULL);
+	obus_client_set_stats_timing(s_client, 1);
+	obus_client_set_max_pending_calls(s_client, s_window);
+
+	ret = obus_client_start(s_client, argv[optind]);
+	if (ret < 0) {
+		fprintf(stderr, "can't start client on %s\n", argv[optind]);
+		ret = EXIT_FAILURE;
+		goto destroy_client;
+	}
+
+	signal(SIGINT, &sig_handler);
+	signal(SIGTERM, &sig_handler);
+
+	fds[0].fd = s_fdpipes[0];
+	fds[0].events = POLLIN;
+	fds[1].fd = obus_client_fd(s_client);
+	fds[1].events = POLLIN;
+
+	stop = 0;
+	do {
+		do {
+			ret = poll(fds, SIZEOF_ARRAY(fds), -1);
+		} while (ret == -1 && errno == EINTR);
+
+		if (ret < 0 || fds[0].revents)
+			stop = 1;
+
+		if (!stop && fds[1].revents) {
+			/* acks processing refills the calls window */
+			if (s_batch)
+				obus_client_cork_calls(s_client);
+
+			obus_client_process_fd(s_client);
+			send_pings();
+
+			if (s_batch)
+				obus_client_flush_calls(s_client);
+		}
+	} while (!stop);
+
+	s_done = 1;
+	if (s_n_events > 0) {
+		print_events_result();
+		ret = s_events == s_n_events ? EXIT_SUCCESS : EXIT_FAILURE;
+	} else {
+		print_calls_result();
+		ret = s_calls_acked == s_n_calls ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+destroy_client:
+	obus_client_destroy(s_client);
+close_pipes:
+	close(s_fdpipes[0]);
+	close(s_fdpipes[1]);
+	free(s_latencies);
+	return ret;
+}
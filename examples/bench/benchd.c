@@ -0,0 +1,307 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file benchd.c
+ *
+ * @brief obus benchmarks server
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <poll.h>
+#include <sys/timerfd.h>
+
+#include "libobus.h"
+#include "bench_bus.h"
+#include "bench_point.h"
+#include "bench.h"
+
+static int s_fdpipes[2];
+static struct obus_server *s_server;
+static struct bench_point *s_point;
+
+/* last point sequence number */
+static uint32_t s_seq;
+
+/* ping handler duration in us, acks are deferred unless handler blocks */
+static uint32_t s_delay_us;
+static int s_blocking;
+
+/* deferred ping ack, same delay for all so fifo is in deadline order */
+struct deferred_ack {
+	obus_handle_t handle;
+	uint64_t deadline;
+};
+
+static struct deferred_ack *s_acks;
+static size_t s_acks_size;
+static size_t s_acks_head;
+static size_t s_acks_count;
+static int s_tfd = -1;
+
+static void sig_handler(int signum)
+{
+	uint8_t dummy = 0xff;
+
+	if (write(s_fdpipes[1], &dummy, sizeof(dummy)) < 0)
+		fprintf(stderr, "can't write in pipe: %s\n", strerror(errno));
+}
+
+/* send point events at once, sequence always changes so that no event
+ * is sanitized away */
+static void point_flood(struct bench_point *object, obus_handle_t handle,
+			const struct bench_point_flood_args *args)
+{
+	struct bench_point_info info;
+	uint32_t i;
+
+	if (!args || !args->fields.count) {
+		obus_server_send_ack(s_server, handle,
+				     OBUS_CALL_INVALID_ARGUMENTS);
+		return;
+	}
+
+	obus_server_send_ack(s_server, handle, OBUS_CALL_ACKED);
+	for (i = 0; i < args->count; i++) {
+		bench_point_info_init(&info);
+		OBUS_SET(&info, x, (int32_t)i);
+		OBUS_SET(&info, y, -(int32_t)i);
+		OBUS_SET(&info, seq, ++s_seq);
+		bench_point_send_event(s_server, s_point,
+				       BENCH_POINT_EVENT_MOVED, &info);
+	}
+}
+
+/* arm timer on oldest deferred ack deadline, disarm it if none */
+static void arm_acks_timer(void)
+{
+	struct itimerspec its;
+	uint64_t deadline;
+
+	memset(&its, 0, sizeof(its));
+	if (s_acks_count > 0) {
+		deadline = s_acks[s_acks_head].deadline;
+		its.it_value.tv_sec = (time_t)(deadline / 1000000000ULL);
+		its.it_value.tv_nsec = (long)(deadline % 1000000000ULL);
+	}
+
+	if (timerfd_settime(s_tfd, TFD_TIMER_ABSTIME, &its, NULL) < 0)
+		fprintf(stderr, "timerfd_settime: %s\n", strerror(errno));
+}
+
+static int push_deferred_ack(obus_handle_t handle)
+{
+	struct deferred_ack *acks;
+	size_t i, size;
+
+	/* grow fifo keeping its order */
+	if (s_acks_count == s_acks_size) {
+		size = s_acks_size ? 2 * s_acks_size : 64;
+		acks = malloc(size * sizeof(*acks));
+		if (!acks)
+			return -ENOMEM;
+
+		for (i = 0; i < s_acks_count; i++)
+			acks[i] = s_acks[(s_acks_head + i) % s_acks_size];
+
+		free(s_acks);
+		s_acks = acks;
+		s_acks_size = size;
+		s_acks_head = 0;
+	}
+
+	i = (s_acks_head + s_acks_count) % s_acks_size;
+	s_acks[i].handle = handle;
+	s_acks[i].deadline = bench_now_ns() + (uint64_t)s_delay_us * 1000;
+	if (s_acks_count++ == 0)
+		arm_acks_timer();
+
+	return 0;
+}
+
+/* ack deferred pings whose delay elapsed */
+static void process_deferred_acks(void)
+{
+	uint64_t now, expirations;
+
+	if (read(s_tfd, &expirations, sizeof(expirations)) < 0 &&
+	    errno != EAGAIN)
+		fprintf(stderr, "timerfd read: %s\n", strerror(errno));
+
+	now = bench_now_ns();
+	while (s_acks_count > 0 && s_acks[s_acks_head].deadline <= now) {
+		/* call is gone if its peer disconnected meanwhile */
+		obus_server_send_ack(s_server, s_acks[s_acks_head].handle,
+				     OBUS_CALL_ACKED);
+		s_acks_head = (s_acks_head + 1) % s_acks_size;
+		s_acks_count--;
+	}
+
+	arm_acks_timer();
+}
+
+static void point_ping(struct bench_point *object, obus_handle_t handle,
+		       const struct bench_point_ping_args *args)
+{
+	/* simulate a slow handler, blocking loop or not */
+	if (s_delay_us > 0 && s_blocking) {
+		usleep(s_delay_us);
+	} else if (s_delay_us > 0 &&
+		   obus_server_defer_ack(s_server, handle) == 0) {
+		if (push_deferred_ack(handle) == 0)
+			return;
+	}
+
+	obus_server_send_ack(s_server, handle, OBUS_CALL_ACKED);
+}
+
+static const struct bench_point_method_handlers s_point_handlers = {
+	.method_flood = point_flood,
+	.method_ping = point_ping,
+};
+
+static void print_usage(void)
+{
+	fprintf(stderr, "usage: benchd [-d <delay> [-b]] <address>\n\n");
+	fprintf(stderr, "\t-d: ack ping calls <delay> us after they are "
+			"received\n");
+	fprintf(stderr, "\t-b: block ping handler during <delay> instead of "
+			"deferring ack\n");
+	fprintf(stderr, "\t<address>: bench bus server address\n");
+}
+
+int main(int argc, char *argv[])
+{
+	int ret, c, stop;
+	const char *addrs[1];
+	struct pollfd fds[3];
+	struct bench_point_info info;
+
+	while ((c = getopt(argc, argv, "d:b")) != -1) {
+		switch (c) {
+		case 'd':
+			s_delay_us = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			s_blocking = 1;
+			break;
+		default:
+			print_usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (optind >= argc) {
+		print_usage();
+		return EXIT_FAILURE;
+	}
+
+	addrs[0] = argv[optind];
+	ret = pipe(s_fdpipes);
+	if (ret < 0)
+		return EXIT_FAILURE;
+
+	s_tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (s_tfd < 0) {
+		ret = EXIT_FAILURE;
+		goto close_pipes;
+	}
+
+	s_server = obus_server_new(bench_bus_desc);
+	if (!s_server) {
+		ret = EXIT_FAILURE;
+		goto close_timer;
+	}
+
+	bench_point_info_init(&info);
+	OBUS_SET(&info, x, 0);
+	OBUS_SET(&info, y, 0);
+	OBUS_SET(&info, seq, 0);
+	OBUS_SET(&info, method_flood, OBUS_METHOD_ENABLED);
+	OBUS_SET(&info, method_ping, OBUS_METHOD_ENABLED);
+	s_point = bench_point_new(s_server, &info, &s_point_handlers);
+	bench_point_register(s_server, s_point);
+
+	ret = obus_server_start(s_server, addrs, SIZEOF_ARRAY(addrs));
+	if (ret < 0) {
+		fprintf(stderr, "can't start server on %s\n", addrs[0]);
+		ret = EXIT_FAILURE;
+		goto destroy_server;
+	}
+
+	signal(SIGINT, &sig_handler);
+	signal(SIGTERM, &sig_handler);
+
+	fds[0].fd = s_fdpipes[0];
+	fds[0].events = POLLIN;
+	fds[1].fd = obus_server_fd(s_server);
+	fds[1].events = POLLIN;
+	fds[2].fd = s_tfd;
+	fds[2].events = POLLIN;
+
+	stop = 0;
+	do {
+		do {
+			ret = poll(fds, SIZEOF_ARRAY(fds), -1);
+		} while (ret == -1 && errno == EINTR);
+
+		if (ret < 0 || fds[0].revents)
+			stop = 1;
+
+		if (!stop && fds[1].revents)
+			obus_server_process_fd(s_server);
+
+		if (!stop && fds[2].revents)
+			process_deferred_acks();
+	} while (!stop);
+
+	ret = EXIT_SUCCESS;
+
+destroy_server:
+	obus_server_destroy(s_server);
+	free(s_acks);
+close_timer:
+	close(s_tfd);
+close_pipes:
+	close(s_fdpipes[0]);
+	close(s_fdpipes[1]);
+	return ret;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_bus.c
+ *
+ * @brief obus bench bus client api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OBUS_USE_PRIVATE
+#include "libobus.h"
+#include "libobus_private.h"
+#include "bench_bus.h"
+
+
+static const struct obus_bus_event_desc bench_bus_events[] = {
+	{
+		.uid = 1,
+		.name = "connected",
+	}
+	,
+	{
+		.uid = 2,
+		.name = "disconnected",
+	}
+	,
+	{
+		.uid = 3,
+		.name = "connection_refused",
+	}
+};
+
+/* referenced objects supported by bench bus */
+extern const struct obus_object_desc bench_point_desc;
+extern const struct obus_object_desc bench_wide_desc;
+
+/* array of bench objects descriptors */
+static const struct obus_object_desc *const objects[] = {
+	&bench_point_desc,
+	&bench_wide_desc,
+};
+/* bench bus description */
+static const struct obus_bus_desc bench_desc = {
+	.name = "bench",
+	.n_objects = OBUS_SIZEOF_ARRAY(objects),
+	.objects = objects,
+	.n_events = OBUS_SIZEOF_ARRAY(bench_bus_events),
+	.events = bench_bus_events,
+	.crc = 0,
+};
+
+/*public reference to bench  */
+const struct obus_bus_desc *bench_bus_desc = &bench_desc;
+
+const char *bench_bus_event_type_str(enum bench_bus_event_type type)
+{
+	if (type >= OBUS_SIZEOF_ARRAY(bench_bus_events))
+		return "???";
+
+	return bench_bus_events[type].name;
+}
+
+enum bench_bus_event_type
+bench_bus_event_get_type(const struct bench_bus_event *event)
+{
+	long idx;
+	const struct obus_bus_event *evt;
+	const struct obus_bus_event_desc *desc;
+
+	evt = (const struct obus_bus_event *)event;
+	desc = obus_bus_event_get_desc(evt);
+	idx = desc - bench_bus_events;
+
+	if (idx < 0 || idx > BENCH_BUS_EVENT_COUNT)
+		return BENCH_BUS_EVENT_COUNT;
+
+	return (enum bench_bus_event_type)idx;
+}
+
+
+struct bench_bus_event *
+bench_bus_event_from_obus_event(struct obus_bus_event *event)
+{
+	long idx;
+	const struct obus_bus_event_desc *desc;
+
+	desc = obus_bus_event_get_desc(event);
+	idx = desc - bench_bus_events;
+
+	if (idx < 0 || idx > BENCH_BUS_EVENT_COUNT)
+		return NULL;
+
+	return (struct  bench_bus_event *)event;
+}
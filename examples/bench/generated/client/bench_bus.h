@@ -0,0 +1,82 @@
+/**
+ * @file bench_bus.h
+ *
+ * @brief obus bench bus client api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _BENCH_BUS_H_
+#define _BENCH_BUS_H_
+
+#include "libobus.h"
+
+OBUS_BEGIN_DECLS
+
+
+/**
+ * @brief bench bus descriptor.
+ *
+ * Reference to bench bus descripor.
+ **/
+extern const struct obus_bus_desc *bench_bus_desc;
+/**
+ * @brief bench bus event structure
+ *
+ * This opaque structure represent an bench bus event.
+ **/
+struct bench_bus_event;
+
+
+/**
+ * @brief bench bus event type enumeration.
+ *
+ * This enumeration describes all kind of bench bus events.
+ **/
+enum bench_bus_event_type {
+	/** bench bus connected */
+	BENCH_BUS_EVENT_CONNECTED = 0,
+	/** bench bus disconnected */
+	BENCH_BUS_EVENT_DISCONNECTED,
+	/** bench bus connection refused */
+	BENCH_BUS_EVENT_CONNECTION_REFUSED,
+	/** for internal use only*/
+	BENCH_BUS_EVENT_COUNT,
+};
+
+/**
+ * @brief get bench_bus_event_type string value.
+ *
+ * @param[in] type bus event type to be converted into string.
+ *
+ * @retval non NULL constant string value.
+ **/
+const char *bench_bus_event_type_str(enum bench_bus_event_type type);
+
+/**
+ * @brief get bench bus event type.
+ *
+ * This function is used to get the type of a bench bus event.
+ *
+ * @param[in]  event  bench bus event.
+ *
+ * @retval  one of @ref bench_bus_event_type value.
+ **/
+enum bench_bus_event_type
+bench_bus_event_get_type(const struct bench_bus_event *event);
+
+/**
+ * @brief get bench bus event from generic obus bus event.
+ *
+ * This function is used to get a bench bus event from an obus bus event.
+ *
+ * @param[in]  event       generic obus bus event.
+ *
+ * @retval  bench bus event or NULL if not a bench bus event.
+ **/
+
+struct bench_bus_event *
+bench_bus_event_from_obus_event(struct obus_bus_event *event);
+
+OBUS_END_DECLS
+
+#endif /*_BENCH_BUS_H_*/
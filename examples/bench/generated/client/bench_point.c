@@ -0,0 +1,424 @@
+/**
+ * @file bench_point.c
+ *
+ * @brief obus bench_point object client api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OBUS_USE_PRIVATE
+#include "libobus.h"
+#include "libobus_private.h"
+#include "bench_point.h"
+
+
+enum bench_point_field_type {
+	BENCH_POINT_FIELD_X = 0,
+	BENCH_POINT_FIELD_Y,
+	BENCH_POINT_FIELD_SEQ,
+	BENCH_POINT_FIELD_METHOD_FLOOD,
+	BENCH_POINT_FIELD_METHOD_PING,
+};
+
+static const struct obus_field_desc bench_point_info_fields[] = {
+	[BENCH_POINT_FIELD_X] = {
+		.uid = 1,
+		.name = "x",
+		.offset = obus_offsetof(struct bench_point_info, x),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_I32,
+	},
+	[BENCH_POINT_FIELD_Y] = {
+		.uid = 2,
+		.name = "y",
+		.offset = obus_offsetof(struct bench_point_info, y),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_I32,
+	},
+	[BENCH_POINT_FIELD_SEQ] = {
+		.uid = 3,
+		.name = "seq",
+		.offset = obus_offsetof(struct bench_point_info, seq),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_POINT_FIELD_METHOD_FLOOD] = {
+		.uid = 101,
+		.name = "flood",
+		.offset = obus_offsetof(struct bench_point_info, method_flood),
+		.role = OBUS_METHOD,
+		.type = OBUS_FIELD_ENUM,
+		.enum_drv = &obus_method_state_driver,
+	},
+	[BENCH_POINT_FIELD_METHOD_PING] = {
+		.uid = 102,
+		.name = "ping",
+		.offset = obus_offsetof(struct bench_point_info, method_ping),
+		.role = OBUS_METHOD,
+		.type = OBUS_FIELD_ENUM,
+		.enum_drv = &obus_method_state_driver,
+	},
+
+};
+
+static const uint16_t bench_point_info_uids[] = {
+	[1] = BENCH_POINT_FIELD_X + 1,
+	[2] = BENCH_POINT_FIELD_Y + 1,
+	[3] = BENCH_POINT_FIELD_SEQ + 1,
+	[101] = BENCH_POINT_FIELD_METHOD_FLOOD + 1,
+	[102] = BENCH_POINT_FIELD_METHOD_PING + 1,
+};
+
+static const struct obus_struct_desc bench_point_info_desc = {
+	.size = sizeof(struct bench_point_info),
+	.fields_offset = obus_offsetof(struct bench_point_info, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_point_info_fields),
+	.fields = bench_point_info_fields,
+	.uids = bench_point_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_point_info_uids),
+};
+
+static const struct obus_event_update_desc event_moved_updates[] = {
+	{
+		.field = &bench_point_info_fields[BENCH_POINT_FIELD_X],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_point_info_fields[BENCH_POINT_FIELD_Y],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_point_info_fields[BENCH_POINT_FIELD_SEQ],
+		.flags = 0,
+	}
+
+};
+
+static const struct obus_event_desc bench_point_events_desc[] = {
+	{
+		.uid = 1,
+		.name = "moved",
+		.updates = event_moved_updates,
+		.n_updates = OBUS_SIZEOF_ARRAY(event_moved_updates),
+	}
+
+};
+
+const char *bench_point_event_type_str(enum bench_point_event_type type)
+{
+	if(type >= OBUS_SIZEOF_ARRAY(bench_point_events_desc))
+		return "???";
+
+	return bench_point_events_desc[type].name;
+}
+
+enum bench_point_method_type {
+	BENCH_POINT_METHOD_FLOOD = 0,
+	BENCH_POINT_METHOD_PING,
+	BENCH_POINT_METHOD_COUNT,
+};
+
+static const struct obus_field_desc bench_point_flood_args_fields[] = {
+	{		.uid = 1,
+		.name = "count",
+		.offset = obus_offsetof(struct bench_point_flood_args, count),
+		.role = OBUS_ARGUMENT,
+		.type = OBUS_FIELD_U32,
+	}
+};
+
+static const uint16_t bench_point_flood_args_uids[] = {
+	[1] = 1,
+};
+
+static const struct obus_struct_desc bench_point_flood_args_desc = {
+	.size = sizeof(struct bench_point_flood_args),
+	.fields_offset = obus_offsetof(struct bench_point_flood_args, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_point_flood_args_fields),
+	.fields = bench_point_flood_args_fields,
+	.uids = bench_point_flood_args_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_point_flood_args_uids),
+};
+
+static const struct obus_field_desc bench_point_ping_args_fields[] = {
+	{		.uid = 1,
+		.name = "value",
+		.offset = obus_offsetof(struct bench_point_ping_args, value),
+		.role = OBUS_ARGUMENT,
+		.type = OBUS_FIELD_U32,
+	}
+};
+
+static const uint16_t bench_point_ping_args_uids[] = {
+	[1] = 1,
+};
+
+static const struct obus_struct_desc bench_point_ping_args_desc = {
+	.size = sizeof(struct bench_point_ping_args),
+	.fields_offset = obus_offsetof(struct bench_point_ping_args, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_point_ping_args_fields),
+	.fields = bench_point_ping_args_fields,
+	.uids = bench_point_ping_args_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_point_ping_args_uids),
+};
+
+static const struct obus_method_desc bench_point_methods_desc[] = {
+	{		.uid = 101,
+		.name = "flood",
+		.args_desc = &bench_point_flood_args_desc,
+	}
+	,
+	{		.uid = 102,
+		.name = "ping",
+		.args_desc = &bench_point_ping_args_desc,
+	}
+};
+
+const struct obus_object_desc bench_point_desc = {
+	.uid = BENCH_POINT_UID,
+	.name = "point",
+	.info_desc = &bench_point_info_desc,
+	.n_events = OBUS_SIZEOF_ARRAY(bench_point_events_desc),
+	.events = bench_point_events_desc,
+	.n_methods = OBUS_SIZEOF_ARRAY(bench_point_methods_desc),
+	.methods = bench_point_methods_desc,
+};
+
+static inline struct bench_point *
+bench_point_from_object(struct obus_object *object)
+{
+	const struct obus_object_desc *desc;
+
+	if (!object)
+		return NULL;
+
+	desc = obus_object_get_desc(object);
+	if (desc != &bench_point_desc)
+		return NULL;
+
+	return (struct bench_point *)object;
+}
+
+static inline struct obus_object *
+bench_point_object(struct bench_point *object)
+{
+	struct obus_object *obj;
+
+	obj = (struct obus_object *)object;
+	if (bench_point_from_object(obj) != object)
+		return NULL;
+
+	return (struct obus_object *)object;
+}
+
+static inline const struct obus_object *
+bench_point_const_object(const struct bench_point *object)
+{
+	const struct obus_object *obj;
+
+	obj = (const struct obus_object *)object;
+	if (obus_object_get_desc(obj) != &bench_point_desc)
+		return NULL;
+
+	return obj;
+}
+
+const struct bench_point_info *
+bench_point_get_info(const struct bench_point *object)
+{
+	return (const struct bench_point_info *)obus_object_get_info(bench_point_const_object(object));
+}
+
+void bench_point_log(const struct bench_point *object, enum obus_log_level level)
+{
+	obus_object_log(bench_point_const_object(object), level);
+}
+
+int bench_point_set_user_data(struct bench_point *object, void *user_data)
+{
+	return obus_object_set_user_data(bench_point_object(object), user_data);
+}
+
+void *bench_point_get_user_data(const struct bench_point *object)
+{
+	return obus_object_get_user_data(bench_point_const_object(object));
+}
+
+obus_handle_t bench_point_get_handle(const struct bench_point *object)
+{
+	return obus_object_get_handle(bench_point_const_object(object));
+}
+
+struct bench_point *
+bench_point_from_handle(struct obus_client *client, obus_handle_t handle)
+{
+	struct obus_object *obj;
+
+	obj = obus_client_get_object(client, handle);	return bench_point_from_object(obj);
+}
+
+struct bench_point *
+bench_point_next(struct obus_client *client, struct bench_point *previous)
+{
+	struct obus_object *next, *prev;
+
+	prev = (struct obus_object *)previous;
+	next = obus_client_object_next(client, prev, bench_point_desc.uid);
+	return bench_point_from_object(next);
+}
+
+static inline struct obus_event *
+bench_point_obus_event(struct bench_point_event *event)
+{
+	return event && (obus_event_get_object_desc((struct obus_event *)event) == &bench_point_desc) ? (struct obus_event *)event : NULL;
+}
+
+static inline const struct obus_event *
+bench_point_const_obus_event(const struct bench_point_event *event)
+{
+	return event && (obus_event_get_object_desc((const struct obus_event *)event) == &bench_point_desc) ? (const struct obus_event *)event : NULL;
+}
+
+enum bench_point_event_type
+bench_point_event_get_type(const struct bench_point_event *event)
+{
+	const struct obus_event_desc *desc;
+	desc = obus_event_get_desc(bench_point_const_obus_event(event));
+	return desc ? (enum bench_point_event_type)(desc - bench_point_events_desc) : BENCH_POINT_EVENT_COUNT;
+}
+
+void bench_point_event_log(const struct bench_point_event *event, enum obus_log_level level)
+{
+	obus_event_log(bench_point_const_obus_event(event), level);
+}
+
+int bench_point_event_is_empty(const struct bench_point_event *event)
+{
+	return obus_event_is_empty(bench_point_const_obus_event(event));
+}
+
+int bench_point_event_commit(struct bench_point_event *event)
+{
+	return obus_event_commit(bench_point_obus_event(event));
+}
+
+const struct bench_point_info *
+bench_point_event_get_info(const struct bench_point_event *event)
+{
+	return (const struct bench_point_info *)obus_event_get_info(bench_point_const_obus_event(event));
+}
+
+void bench_point_flood_args_init(struct bench_point_flood_args *args)
+{
+	if (args)
+		memset(args, 0, sizeof(*args));
+}
+
+int bench_point_flood_args_is_empty(const struct bench_point_flood_args *args)
+{
+	return (args &&
+		!args->fields.count);
+}
+int bench_point_call_flood(struct obus_client *client,
+			struct bench_point *object,
+			const struct bench_point_flood_args *args,
+			bench_point_method_status_cb_t cb,
+			uint16_t *handle)
+{
+	const struct obus_method_desc *desc = &bench_point_methods_desc[BENCH_POINT_METHOD_FLOOD];
+	struct obus_struct st = {.u.const_addr = args, .desc = desc->args_desc};
+	return obus_client_call(client , bench_point_object(object), desc, &st, (obus_method_call_status_handler_cb_t)cb, handle);
+}
+void bench_point_ping_args_init(struct bench_point_ping_args *args)
+{
+	if (args)
+		memset(args, 0, sizeof(*args));
+}
+
+int bench_point_ping_args_is_empty(const struct bench_point_ping_args *args)
+{
+	return (args &&
+		!args->fields.value);
+}
+int bench_point_call_ping(struct obus_client *client,
+			struct bench_point *object,
+			const struct bench_point_ping_args *args,
+			bench_point_method_status_cb_t cb,
+			uint16_t *handle)
+{
+	const struct obus_method_desc *desc = &bench_point_methods_desc[BENCH_POINT_METHOD_PING];
+	struct obus_struct st = {.u.const_addr = args, .desc = desc->args_desc};
+	return obus_client_call(client , bench_point_object(object), desc, &st, (obus_method_call_status_handler_cb_t)cb, handle);
+}
+
+/**
+ * @brief subscribe to events concerning bench_point objects.
+ *
+ * @param[in] client bus client.
+ * @param[in] provider callback set for reacting on bench_point events.
+ * @param[in] user_data data passed to callbacks on events.
+ *
+ * @retval 0 success.
+ **/
+int bench_point_subscribe(struct obus_client *client, struct bench_point_provider *provider, void *user_data)
+{
+	struct obus_provider *p;
+	int ret;
+	if (!client || !provider || !provider->add || !provider->remove || !provider->event)
+		return -EINVAL;
+
+	p = calloc(1, sizeof(*p));
+	if (!p)
+		return -ENOMEM;
+
+	p->add = (obus_provider_add_cb_t)provider->add;
+	p->remove = (obus_provider_remove_cb_t)provider->remove;
+	p->event = (obus_provider_event_cb_t)provider->event;
+	p->desc = &bench_point_desc;
+	p->user_data = user_data;
+
+	ret = obus_client_register_provider(client, p);
+	if (ret < 0) {
+		free(p);
+		return ret;
+	}
+
+	provider->priv = p;
+	return 0;
+}
+
+
+/**
+ * @brief unsubscribe to events concerning bench_point objects.
+ *
+ * @param[in] client bus client.
+ * @param[in] provider passed to bench_point_subscribe.
+ *
+ * @retval 0 success.
+ **/int bench_point_unsubscribe(struct obus_client *client, struct bench_point_provider *provider)
+{
+	int ret;
+	if (!client || !provider)
+		return -EINVAL;
+
+	ret = obus_client_unregister_provider(client, provider->priv);
+	if (ret < 0)
+		return ret;
+
+	free(provider->priv);
+	provider->priv = NULL;
+	return 0;
+}
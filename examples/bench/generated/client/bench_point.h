@@ -0,0 +1,459 @@
+/**
+ * @file bench_point.h
+ *
+ * @brief obus bench_point object client api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _BENCH_POINT_H_
+#define _BENCH_POINT_H_
+
+#include "libobus.h"
+
+OBUS_BEGIN_DECLS
+
+/**
+ * @brief bench_point object uid
+ **/
+#define BENCH_POINT_UID 1
+
+/**
+ * @brief bench_point event type enumeration.
+ *
+ * This enumeration describes all kind of bench_point events.
+ **/
+enum bench_point_event_type {
+	/** Point moved */
+	BENCH_POINT_EVENT_MOVED = 0,
+	/** for internal use only*/
+	BENCH_POINT_EVENT_COUNT,
+};
+
+/**
+ * @brief get bench_point_event_type string value.
+ *
+ * @param[in]  type  event type to be converted into string.
+ *
+ * @retval non NULL constant string value.
+ **/
+const char *bench_point_event_type_str(enum bench_point_event_type type);
+
+/**
+ * @brief bench_point object structure
+ *
+ * This opaque structure represent an bench_point object.
+ **/
+struct bench_point;
+
+/**
+ * @brief bench_point object event structure
+ *
+ * This opaque structure represent an bench_point object event.
+ **/
+struct bench_point_event;
+
+/**
+ * @brief bench bus event structure
+ *
+ * This opaque structure represent an bench bus event.
+ **/
+struct bench_bus_event;
+
+/**
+ * @brief bench_point object info fields structure.
+ *
+ * This structure contains a presence bit for each fields
+ * (property or method state) in bench_point object.
+ * When a bit is set, the corresponding field in
+ * @ref bench_point_info structure must be taken into account.
+ **/
+struct bench_point_info_fields {
+	/** x field presence bit */
+	unsigned int x:1;
+	/** y field presence bit */
+	unsigned int y:1;
+	/** seq field presence bit */
+	unsigned int seq:1;
+	/** flood method presence bit */
+	unsigned int method_flood:1;
+	/** ping method presence bit */
+	unsigned int method_ping:1;
+};
+
+/**
+ * @brief bench_point object info structure.
+ *
+ * This structure represent bench_point object contents.
+ **/
+struct bench_point_info {
+	/** fields presence bit structure */
+	struct bench_point_info_fields fields;
+	/** X coordinate */
+	int32_t x;
+	/** Y coordinate */
+	int32_t y;
+	/** Update sequence number */
+	uint32_t seq;
+	/** method flood state */
+	enum obus_method_state method_flood;
+	/** method ping state */
+	enum obus_method_state method_ping;
+};
+
+/**
+ * @brief read current bench_point object fields values.
+ *
+ * This function is used to read current object fields values.
+ *
+ * @param[in]  object  bench_point object.
+ *
+ * @retval  info  pointer to a constant object fields values.
+ * @retval  NULL  object is NULL or not an bench_point object.
+ *
+ * @note: object info pointer returned never changed during object life cycle
+ * so that user may keep a reference on this pointer until object destruction.
+ * this is not the case for info pointers members.
+ **/
+
+const struct bench_point_info *
+bench_point_get_info(const struct bench_point *object);
+
+/**
+ * @brief log bench_point object.
+ *
+ * This function log object and its current fields values.
+ *
+ * @param[in]  object  bench_point object.
+ * @param[in]  level   obus log level.
+ **/
+void bench_point_log(const struct bench_point *object, enum obus_log_level level);
+
+/**
+ * @brief set bench_point object user data pointer.
+ *
+ * This function store a user data pointer in a bench_point object.
+ * This pointer is never used by libobus and can be retrieved using
+ * @ref bench_point_get_user_data function.
+ *
+ * @param[in]  object      bench_point object.
+ * @param[in]  user_data   user data pointer.
+ *
+ * @retval  0        success.
+ * @retval  -EINVAL  object is NULL.
+ **/
+int bench_point_set_user_data(struct bench_point *object, void *user_data);
+
+/**
+ * @brief get bench_point object user data pointer.
+ *
+ * This function retrieve user data pointer stored in a bench_point object
+ * by a previous call to @ref bench_point_set_user_data function
+ *
+ * @param[in]  object  bench_point object.
+ *
+ * @retval  user_data  user data pointer.
+ **/
+void *bench_point_get_user_data(const struct bench_point *object);
+
+/**
+ * @brief get registered bench_point object obus handle.
+ *
+ * This function retrieve bench_point object obus handle.
+ * obus handle is an unsigned 16 bits integer.
+ * object handle is generated during object creation.
+ * object handle can be used to reference an object into another one.
+ *
+ * @param[in]  object  bench_point object.
+ *
+ * @retval  handle               registered object obus handle.
+ * @retval  OBUS_INVALID_HANDLE  if object is not registered.
+ **/
+obus_handle_t bench_point_get_handle(const struct bench_point *object);
+
+/**
+ * @brief get bench_point object from obus handle.
+ *
+ * This function retrieve bench_point object given its obus handle.
+ *
+ * @param[in]  client  bench bus client
+ * @param[in]  handle  bench_point object handle.
+ *
+ * @retval  object  bench_point object.
+ * @retval  NULL    invalid parameters.
+ * @retval  NULL    corresponding handle object is not a bench_point.
+ **/
+struct bench_point *
+bench_point_from_handle(struct obus_client *client, obus_handle_t handle);
+
+/**
+ * @brief get next registered bench_point object in bus.
+ *
+ * This function retrieve the next registered bench_point object in bus.
+ *
+ * @param[in]  client    bench bus client
+ * @param[in]  previous  previous bench_point object in list (may be NULL).
+ *
+ * @retval  object  next bench_point object.
+ * @retval  NULL    invalid parameters.
+ * @retval  NULL    no more bench_point objects in bus.
+ *
+ * @note: if @p previous is NULL, then the first
+ * registered bench_point object is returned.
+ **/
+struct bench_point *
+bench_point_next(struct obus_client *client, struct bench_point *previous);
+
+/**
+ * @brief get bench_point event type.
+ *
+ * This function is used to retrieved bench_point event type.
+ *
+ * @param[in]  event  bench_point event.
+ *
+ * @retval     type   bench_point event type.
+ **/
+enum bench_point_event_type
+bench_point_event_get_type(const struct bench_point_event *event);
+
+/**
+ * @brief log bench_point event.
+ *
+ * This function log bench_point event and its associated fields values.
+ *
+ * @param[in]  event   bench_point event.
+ * @param[in]  level   obus log level.
+ **/
+void bench_point_event_log(const struct bench_point_event *event, enum obus_log_level level);
+
+/**
+ * @brief check bench_point event contents is empty.
+ *
+ * This function check if each event field has its presence bit cleared.
+ *
+ * @param[in]  event   bench_point event.
+ *
+ * @retval     1     Each field has its presence bit cleared.
+ * @retval     0     One field (or more) has its presence bit set.
+ **/
+int bench_point_event_is_empty(const struct bench_point_event *event);
+
+/**
+ * @brief commit bench_point event contents in object.
+ *
+ * This function copy bench_point event contents in object.
+ *
+ * @param[in]  event   bench_point event.
+ *
+ * @retval     0     Commit succeed.
+ * @retval     <0    Commit failed.
+ *
+ * @note: if not call by client, event commit is done internally
+ * on client provider event callback return.
+ **/
+int bench_point_event_commit(struct bench_point_event *event);
+
+/**
+ * @brief read bench_point event associated fields values.
+ *
+ * This function is used to read event fields values.
+ *
+ * @param[in]  event   bench_point event.
+ *
+ * @retval  info  pointer to a constant object fields values.
+ * @retval  NULL  event is NULL or not an bench_point object event.
+ **/
+const struct bench_point_info *
+bench_point_event_get_info(const struct bench_point_event *event);
+
+/**
+ * generic bench_point client method status callback
+ **/
+typedef void (*bench_point_method_status_cb_t) (struct bench_point *object, obus_handle_t handle, enum obus_call_status status);
+/**
+ * @brief bench_point method flood arguments presence structure.
+ *
+ * This structure contains a presence bit for each
+ * of bench_point method flood argument.
+ * When a bit is set, the corresponding argument in
+ * @ref bench_point_flood_args_fields structure must be taken into account.
+ **/
+struct bench_point_flood_args_fields {
+	/** presence bit for argument count */
+	unsigned int count:1;
+};
+
+/**
+ * @brief bench_point method flood arguments structure.
+ *
+ * This structure contains bench_point method flood arguments values.
+ **/
+struct bench_point_flood_args {
+	/** arguments presence bit structure */
+	struct bench_point_flood_args_fields fields;
+	/** Number of events */
+	uint32_t count;
+};
+
+/**
+ * @brief initialize @ref bench_point_flood_args structure.
+ *
+ * This function initialize @ref bench_point_flood_args structure.
+ * Each argument field has its presence bit cleared.
+ *
+ * @param[in]  args  pointer to allocated @ref bench_point_flood_args structure.
+ **/
+void bench_point_flood_args_init(struct bench_point_flood_args *args);
+
+/**
+ * @brief check @ref bench_point_flood_args structure contents is empty.
+ *
+ * This function check if each argument field has its presence bit cleared.
+ *
+ * @param[in]  args  @ref bench_point_flood_args structure.
+ *
+ * @retval     1     Each argument field has its presence bit cleared.
+ * @retval     0     One argument field (or more) has its presence bit set.
+ **/
+int bench_point_flood_args_is_empty(const struct bench_point_flood_args *args);
+
+/**
+ * @brief call method 'flood'.
+ *
+ * This function call method 'flood' on a bench_point object
+ *
+ * Send moved events at once
+ *
+ * @param[in]   client  obus client context.
+ * @param[in]   object  bench_point object.
+ * @param[in]   args    call arguments.
+ * @param[in]   cb      call status callback.
+ * @param[out]  handle  call handle.
+ *
+ * @retval      0      Call request has been sent to server.
+ * @retval   -EINVAL   Invalid function arguments.
+ * @retval   -EPERM    Client is not connected.
+ * @retval   -EPERM    Object is not registered.
+ * @retval   -EPERM    Method is not ENABLED.
+ * @retval   -ENOMEM   Memory error.
+ **/
+int bench_point_call_flood(struct obus_client *client,
+			struct bench_point *object,
+			const struct bench_point_flood_args *args,
+			bench_point_method_status_cb_t cb,
+			uint16_t *handle);
+/**
+ * @brief bench_point method ping arguments presence structure.
+ *
+ * This structure contains a presence bit for each
+ * of bench_point method ping argument.
+ * When a bit is set, the corresponding argument in
+ * @ref bench_point_ping_args_fields structure must be taken into account.
+ **/
+struct bench_point_ping_args_fields {
+	/** presence bit for argument value */
+	unsigned int value:1;
+};
+
+/**
+ * @brief bench_point method ping arguments structure.
+ *
+ * This structure contains bench_point method ping arguments values.
+ **/
+struct bench_point_ping_args {
+	/** arguments presence bit structure */
+	struct bench_point_ping_args_fields fields;
+	/** Any value */
+	uint32_t value;
+};
+
+/**
+ * @brief initialize @ref bench_point_ping_args structure.
+ *
+ * This function initialize @ref bench_point_ping_args structure.
+ * Each argument field has its presence bit cleared.
+ *
+ * @param[in]  args  pointer to allocated @ref bench_point_ping_args structure.
+ **/
+void bench_point_ping_args_init(struct bench_point_ping_args *args);
+
+/**
+ * @brief check @ref bench_point_ping_args structure contents is empty.
+ *
+ * This function check if each argument field has its presence bit cleared.
+ *
+ * @param[in]  args  @ref bench_point_ping_args structure.
+ *
+ * @retval     1     Each argument field has its presence bit cleared.
+ * @retval     0     One argument field (or more) has its presence bit set.
+ **/
+int bench_point_ping_args_is_empty(const struct bench_point_ping_args *args);
+
+/**
+ * @brief call method 'ping'.
+ *
+ * This function call method 'ping' on a bench_point object
+ *
+ * Acked as soon as received
+ *
+ * @param[in]   client  obus client context.
+ * @param[in]   object  bench_point object.
+ * @param[in]   args    call arguments.
+ * @param[in]   cb      call status callback.
+ * @param[out]  handle  call handle.
+ *
+ * @retval      0      Call request has been sent to server.
+ * @retval   -EINVAL   Invalid function arguments.
+ * @retval   -EPERM    Client is not connected.
+ * @retval   -EPERM    Object is not registered.
+ * @retval   -EPERM    Method is not ENABLED.
+ * @retval   -ENOMEM   Memory error.
+ **/
+int bench_point_call_ping(struct obus_client *client,
+			struct bench_point *object,
+			const struct bench_point_ping_args *args,
+			bench_point_method_status_cb_t cb,
+			uint16_t *handle);
+
+/* bench_point object provider api */
+
+/**
+
+ * @struct bench_point_provider
+
+ * @brief callbacks for events on bench_point objects
+ */
+
+struct bench_point_provider {
+	/** for internal use only */
+	struct obus_provider *priv;
+	/** called on a bench_point object apparition */
+	void (*add) (struct bench_point *object, struct bench_bus_event *bus_event, void *user_data);
+	/** called on a bench_point object removal */
+	void (*remove) (struct bench_point *object, struct bench_bus_event *bus_event, void *user_data);
+	/** called on bench_point object events */
+	void (*event) (struct bench_point *object, struct bench_point_event *event, struct bench_bus_event *bus_event, void *user_data);
+};
+
+/**
+ * @brief subscribe to events concerning bench_point objects.
+ *
+ * @param[in] client bus client.
+ * @param[in] provider callback set for reacting on bench_point events.
+ * @param[in] user_data data passed to callbacks on events.
+ *
+ * @retval 0 success.
+ **/
+int bench_point_subscribe(struct obus_client *client, struct bench_point_provider *provider, void *user_data);
+
+/**
+ * @brief unsubscribe to events concerning bench_point objects.
+ *
+ * @param[in] client bus client.
+ * @param[in] provider passed to bench_point_subscribe.
+ *
+ * @retval 0 success.
+ **/int bench_point_unsubscribe(struct obus_client *client, struct bench_point_provider *provider);
+
+OBUS_END_DECLS
+
+#endif /*_BENCH_POINT_H_*/
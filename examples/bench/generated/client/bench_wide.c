@@ -0,0 +1,1215 @@
+/**
+ * @file bench_wide.c
+ *
+ * @brief obus bench_wide object client api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OBUS_USE_PRIVATE
+#include "libobus.h"
+#include "libobus_private.h"
+#include "bench_wide.h"
+
+
+enum bench_wide_field_type {
+	BENCH_WIDE_FIELD_F1 = 0,
+	BENCH_WIDE_FIELD_F2,
+	BENCH_WIDE_FIELD_F3,
+	BENCH_WIDE_FIELD_F4,
+	BENCH_WIDE_FIELD_F5,
+	BENCH_WIDE_FIELD_F6,
+	BENCH_WIDE_FIELD_F7,
+	BENCH_WIDE_FIELD_F8,
+	BENCH_WIDE_FIELD_F9,
+	BENCH_WIDE_FIELD_F10,
+	BENCH_WIDE_FIELD_F11,
+	BENCH_WIDE_FIELD_F12,
+	BENCH_WIDE_FIELD_F13,
+	BENCH_WIDE_FIELD_F14,
+	BENCH_WIDE_FIELD_F15,
+	BENCH_WIDE_FIELD_F16,
+	BENCH_WIDE_FIELD_F17,
+	BENCH_WIDE_FIELD_F18,
+	BENCH_WIDE_FIELD_F19,
+	BENCH_WIDE_FIELD_F20,
+	BENCH_WIDE_FIELD_F21,
+	BENCH_WIDE_FIELD_F22,
+	BENCH_WIDE_FIELD_F23,
+	BENCH_WIDE_FIELD_F24,
+	BENCH_WIDE_FIELD_F25,
+	BENCH_WIDE_FIELD_F26,
+	BENCH_WIDE_FIELD_F27,
+	BENCH_WIDE_FIELD_F28,
+	BENCH_WIDE_FIELD_F29,
+	BENCH_WIDE_FIELD_F30,
+	BENCH_WIDE_FIELD_F31,
+	BENCH_WIDE_FIELD_F32,
+	BENCH_WIDE_FIELD_F33,
+	BENCH_WIDE_FIELD_F34,
+	BENCH_WIDE_FIELD_F35,
+	BENCH_WIDE_FIELD_F36,
+	BENCH_WIDE_FIELD_F37,
+	BENCH_WIDE_FIELD_F38,
+	BENCH_WIDE_FIELD_F39,
+	BENCH_WIDE_FIELD_F40,
+	BENCH_WIDE_FIELD_F41,
+	BENCH_WIDE_FIELD_F42,
+	BENCH_WIDE_FIELD_F43,
+	BENCH_WIDE_FIELD_F44,
+	BENCH_WIDE_FIELD_F45,
+	BENCH_WIDE_FIELD_F46,
+	BENCH_WIDE_FIELD_F47,
+	BENCH_WIDE_FIELD_F48,
+	BENCH_WIDE_FIELD_F49,
+	BENCH_WIDE_FIELD_F50,
+	BENCH_WIDE_FIELD_F51,
+	BENCH_WIDE_FIELD_F52,
+	BENCH_WIDE_FIELD_F53,
+	BENCH_WIDE_FIELD_F54,
+	BENCH_WIDE_FIELD_F55,
+	BENCH_WIDE_FIELD_F56,
+	BENCH_WIDE_FIELD_F57,
+	BENCH_WIDE_FIELD_F58,
+	BENCH_WIDE_FIELD_F59,
+	BENCH_WIDE_FIELD_F60,
+	BENCH_WIDE_FIELD_F61,
+	BENCH_WIDE_FIELD_F62,
+	BENCH_WIDE_FIELD_F63,
+	BENCH_WIDE_FIELD_F64,
+};
+
+static const struct obus_field_desc bench_wide_info_fields[] = {
+	[BENCH_WIDE_FIELD_F1] = {
+		.uid = 1,
+		.name = "f1",
+		.offset = obus_offsetof(struct bench_wide_info, f1),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F2] = {
+		.uid = 2,
+		.name = "f2",
+		.offset = obus_offsetof(struct bench_wide_info, f2),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F3] = {
+		.uid = 3,
+		.name = "f3",
+		.offset = obus_offsetof(struct bench_wide_info, f3),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F4] = {
+		.uid = 4,
+		.name = "f4",
+		.offset = obus_offsetof(struct bench_wide_info, f4),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F5] = {
+		.uid = 5,
+		.name = "f5",
+		.offset = obus_offsetof(struct bench_wide_info, f5),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F6] = {
+		.uid = 6,
+		.name = "f6",
+		.offset = obus_offsetof(struct bench_wide_info, f6),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F7] = {
+		.uid = 7,
+		.name = "f7",
+		.offset = obus_offsetof(struct bench_wide_info, f7),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F8] = {
+		.uid = 8,
+		.name = "f8",
+		.offset = obus_offsetof(struct bench_wide_info, f8),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F9] = {
+		.uid = 9,
+		.name = "f9",
+		.offset = obus_offsetof(struct bench_wide_info, f9),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F10] = {
+		.uid = 10,
+		.name = "f10",
+		.offset = obus_offsetof(struct bench_wide_info, f10),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F11] = {
+		.uid = 11,
+		.name = "f11",
+		.offset = obus_offsetof(struct bench_wide_info, f11),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F12] = {
+		.uid = 12,
+		.name = "f12",
+		.offset = obus_offsetof(struct bench_wide_info, f12),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F13] = {
+		.uid = 13,
+		.name = "f13",
+		.offset = obus_offsetof(struct bench_wide_info, f13),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F14] = {
+		.uid = 14,
+		.name = "f14",
+		.offset = obus_offsetof(struct bench_wide_info, f14),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F15] = {
+		.uid = 15,
+		.name = "f15",
+		.offset = obus_offsetof(struct bench_wide_info, f15),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F16] = {
+		.uid = 16,
+		.name = "f16",
+		.offset = obus_offsetof(struct bench_wide_info, f16),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F17] = {
+		.uid = 17,
+		.name = "f17",
+		.offset = obus_offsetof(struct bench_wide_info, f17),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F18] = {
+		.uid = 18,
+		.name = "f18",
+		.offset = obus_offsetof(struct bench_wide_info, f18),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F19] = {
+		.uid = 19,
+		.name = "f19",
+		.offset = obus_offsetof(struct bench_wide_info, f19),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F20] = {
+		.uid = 20,
+		.name = "f20",
+		.offset = obus_offsetof(struct bench_wide_info, f20),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F21] = {
+		.uid = 21,
+		.name = "f21",
+		.offset = obus_offsetof(struct bench_wide_info, f21),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F22] = {
+		.uid = 22,
+		.name = "f22",
+		.offset = obus_offsetof(struct bench_wide_info, f22),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F23] = {
+		.uid = 23,
+		.name = "f23",
+		.offset = obus_offsetof(struct bench_wide_info, f23),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F24] = {
+		.uid = 24,
+		.name = "f24",
+		.offset = obus_offsetof(struct bench_wide_info, f24),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F25] = {
+		.uid = 25,
+		.name = "f25",
+		.offset = obus_offsetof(struct bench_wide_info, f25),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F26] = {
+		.uid = 26,
+		.name = "f26",
+		.offset = obus_offsetof(struct bench_wide_info, f26),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F27] = {
+		.uid = 27,
+		.name = "f27",
+		.offset = obus_offsetof(struct bench_wide_info, f27),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F28] = {
+		.uid = 28,
+		.name = "f28",
+		.offset = obus_offsetof(struct bench_wide_info, f28),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F29] = {
+		.uid = 29,
+		.name = "f29",
+		.offset = obus_offsetof(struct bench_wide_info, f29),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F30] = {
+		.uid = 30,
+		.name = "f30",
+		.offset = obus_offsetof(struct bench_wide_info, f30),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F31] = {
+		.uid = 31,
+		.name = "f31",
+		.offset = obus_offsetof(struct bench_wide_info, f31),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F32] = {
+		.uid = 32,
+		.name = "f32",
+		.offset = obus_offsetof(struct bench_wide_info, f32),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F33] = {
+		.uid = 33,
+		.name = "f33",
+		.offset = obus_offsetof(struct bench_wide_info, f33),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F34] = {
+		.uid = 34,
+		.name = "f34",
+		.offset = obus_offsetof(struct bench_wide_info, f34),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F35] = {
+		.uid = 35,
+		.name = "f35",
+		.offset = obus_offsetof(struct bench_wide_info, f35),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F36] = {
+		.uid = 36,
+		.name = "f36",
+		.offset = obus_offsetof(struct bench_wide_info, f36),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F37] = {
+		.uid = 37,
+		.name = "f37",
+		.offset = obus_offsetof(struct bench_wide_info, f37),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F38] = {
+		.uid = 38,
+		.name = "f38",
+		.offset = obus_offsetof(struct bench_wide_info, f38),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F39] = {
+		.uid = 39,
+		.name = "f39",
+		.offset = obus_offsetof(struct bench_wide_info, f39),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F40] = {
+		.uid = 40,
+		.name = "f40",
+		.offset = obus_offsetof(struct bench_wide_info, f40),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F41] = {
+		.uid = 41,
+		.name = "f41",
+		.offset = obus_offsetof(struct bench_wide_info, f41),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F42] = {
+		.uid = 42,
+		.name = "f42",
+		.offset = obus_offsetof(struct bench_wide_info, f42),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F43] = {
+		.uid = 43,
+		.name = "f43",
+		.offset = obus_offsetof(struct bench_wide_info, f43),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F44] = {
+		.uid = 44,
+		.name = "f44",
+		.offset = obus_offsetof(struct bench_wide_info, f44),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F45] = {
+		.uid = 45,
+		.name = "f45",
+		.offset = obus_offsetof(struct bench_wide_info, f45),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F46] = {
+		.uid = 46,
+		.name = "f46",
+		.offset = obus_offsetof(struct bench_wide_info, f46),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F47] = {
+		.uid = 47,
+		.name = "f47",
+		.offset = obus_offsetof(struct bench_wide_info, f47),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F48] = {
+		.uid = 48,
+		.name = "f48",
+		.offset = obus_offsetof(struct bench_wide_info, f48),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F49] = {
+		.uid = 49,
+		.name = "f49",
+		.offset = obus_offsetof(struct bench_wide_info, f49),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F50] = {
+		.uid = 50,
+		.name = "f50",
+		.offset = obus_offsetof(struct bench_wide_info, f50),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F51] = {
+		.uid = 51,
+		.name = "f51",
+		.offset = obus_offsetof(struct bench_wide_info, f51),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F52] = {
+		.uid = 52,
+		.name = "f52",
+		.offset = obus_offsetof(struct bench_wide_info, f52),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F53] = {
+		.uid = 53,
+		.name = "f53",
+		.offset = obus_offsetof(struct bench_wide_info, f53),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F54] = {
+		.uid = 54,
+		.name = "f54",
+		.offset = obus_offsetof(struct bench_wide_info, f54),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F55] = {
+		.uid = 55,
+		.name = "f55",
+		.offset = obus_offsetof(struct bench_wide_info, f55),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F56] = {
+		.uid = 56,
+		.name = "f56",
+		.offset = obus_offsetof(struct bench_wide_info, f56),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F57] = {
+		.uid = 57,
+		.name = "f57",
+		.offset = obus_offsetof(struct bench_wide_info, f57),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F58] = {
+		.uid = 58,
+		.name = "f58",
+		.offset = obus_offsetof(struct bench_wide_info, f58),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F59] = {
+		.uid = 59,
+		.name = "f59",
+		.offset = obus_offsetof(struct bench_wide_info, f59),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F60] = {
+		.uid = 60,
+		.name = "f60",
+		.offset = obus_offsetof(struct bench_wide_info, f60),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F61] = {
+		.uid = 61,
+		.name = "f61",
+		.offset = obus_offsetof(struct bench_wide_info, f61),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F62] = {
+		.uid = 62,
+		.name = "f62",
+		.offset = obus_offsetof(struct bench_wide_info, f62),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F63] = {
+		.uid = 63,
+		.name = "f63",
+		.offset = obus_offsetof(struct bench_wide_info, f63),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F64] = {
+		.uid = 64,
+		.name = "f64",
+		.offset = obus_offsetof(struct bench_wide_info, f64),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+
+};
+
+static const uint16_t bench_wide_info_uids[] = {
+	[1] = BENCH_WIDE_FIELD_F1 + 1,
+	[2] = BENCH_WIDE_FIELD_F2 + 1,
+	[3] = BENCH_WIDE_FIELD_F3 + 1,
+	[4] = BENCH_WIDE_FIELD_F4 + 1,
+	[5] = BENCH_WIDE_FIELD_F5 + 1,
+	[6] = BENCH_WIDE_FIELD_F6 + 1,
+	[7] = BENCH_WIDE_FIELD_F7 + 1,
+	[8] = BENCH_WIDE_FIELD_F8 + 1,
+	[9] = BENCH_WIDE_FIELD_F9 + 1,
+	[10] = BENCH_WIDE_FIELD_F10 + 1,
+	[11] = BENCH_WIDE_FIELD_F11 + 1,
+	[12] = BENCH_WIDE_FIELD_F12 + 1,
+	[13] = BENCH_WIDE_FIELD_F13 + 1,
+	[14] = BENCH_WIDE_FIELD_F14 + 1,
+	[15] = BENCH_WIDE_FIELD_F15 + 1,
+	[16] = BENCH_WIDE_FIELD_F16 + 1,
+	[17] = BENCH_WIDE_FIELD_F17 + 1,
+	[18] = BENCH_WIDE_FIELD_F18 + 1,
+	[19] = BENCH_WIDE_FIELD_F19 + 1,
+	[20] = BENCH_WIDE_FIELD_F20 + 1,
+	[21] = BENCH_WIDE_FIELD_F21 + 1,
+	[22] = BENCH_WIDE_FIELD_F22 + 1,
+	[23] = BENCH_WIDE_FIELD_F23 + 1,
+	[24] = BENCH_WIDE_FIELD_F24 + 1,
+	[25] = BENCH_WIDE_FIELD_F25 + 1,
+	[26] = BENCH_WIDE_FIELD_F26 + 1,
+	[27] = BENCH_WIDE_FIELD_F27 + 1,
+	[28] = BENCH_WIDE_FIELD_F28 + 1,
+	[29] = BENCH_WIDE_FIELD_F29 + 1,
+	[30] = BENCH_WIDE_FIELD_F30 + 1,
+	[31] = BENCH_WIDE_FIELD_F31 + 1,
+	[32] = BENCH_WIDE_FIELD_F32 + 1,
+	[33] = BENCH_WIDE_FIELD_F33 + 1,
+	[34] = BENCH_WIDE_FIELD_F34 + 1,
+	[35] = BENCH_WIDE_FIELD_F35 + 1,
+	[36] = BENCH_WIDE_FIELD_F36 + 1,
+	[37] = BENCH_WIDE_FIELD_F37 + 1,
+	[38] = BENCH_WIDE_FIELD_F38 + 1,
+	[39] = BENCH_WIDE_FIELD_F39 + 1,
+	[40] = BENCH_WIDE_FIELD_F40 + 1,
+	[41] = BENCH_WIDE_FIELD_F41 + 1,
+	[42] = BENCH_WIDE_FIELD_F42 + 1,
+	[43] = BENCH_WIDE_FIELD_F43 + 1,
+	[44] = BENCH_WIDE_FIELD_F44 + 1,
+	[45] = BENCH_WIDE_FIELD_F45 + 1,
+	[46] = BENCH_WIDE_FIELD_F46 + 1,
+	[47] = BENCH_WIDE_FIELD_F47 + 1,
+	[48] = BENCH_WIDE_FIELD_F48 + 1,
+	[49] = BENCH_WIDE_FIELD_F49 + 1,
+	[50] = BENCH_WIDE_FIELD_F50 + 1,
+	[51] = BENCH_WIDE_FIELD_F51 + 1,
+	[52] = BENCH_WIDE_FIELD_F52 + 1,
+	[53] = BENCH_WIDE_FIELD_F53 + 1,
+	[54] = BENCH_WIDE_FIELD_F54 + 1,
+	[55] = BENCH_WIDE_FIELD_F55 + 1,
+	[56] = BENCH_WIDE_FIELD_F56 + 1,
+	[57] = BENCH_WIDE_FIELD_F57 + 1,
+	[58] = BENCH_WIDE_FIELD_F58 + 1,
+	[59] = BENCH_WIDE_FIELD_F59 + 1,
+	[60] = BENCH_WIDE_FIELD_F60 + 1,
+	[61] = BENCH_WIDE_FIELD_F61 + 1,
+	[62] = BENCH_WIDE_FIELD_F62 + 1,
+	[63] = BENCH_WIDE_FIELD_F63 + 1,
+	[64] = BENCH_WIDE_FIELD_F64 + 1,
+};
+
+static const struct obus_struct_desc bench_wide_info_desc = {
+	.size = sizeof(struct bench_wide_info),
+	.fields_offset = obus_offsetof(struct bench_wide_info, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_wide_info_fields),
+	.fields = bench_wide_info_fields,
+	.uids = bench_wide_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_wide_info_uids),
+};
+
+static const struct obus_event_update_desc event_changed_updates[] = {
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F1],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F2],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F3],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F4],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F5],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F6],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F7],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F8],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F9],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F10],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F11],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F12],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F13],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F14],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F15],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F16],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F17],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F18],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F19],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F20],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F21],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F22],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F23],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F24],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F25],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F26],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F27],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F28],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F29],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F30],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F31],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F32],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F33],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F34],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F35],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F36],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F37],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F38],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F39],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F40],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F41],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F42],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F43],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F44],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F45],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F46],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F47],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F48],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F49],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F50],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F51],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F52],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F53],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F54],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F55],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F56],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F57],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F58],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F59],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F60],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F61],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F62],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F63],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F64],
+		.flags = 0,
+	}
+
+};
+
+static const struct obus_event_desc bench_wide_events_desc[] = {
+	{
+		.uid = 1,
+		.name = "changed",
+		.updates = event_changed_updates,
+		.n_updates = OBUS_SIZEOF_ARRAY(event_changed_updates),
+	}
+
+};
+
+const char *bench_wide_event_type_str(enum bench_wide_event_type type)
+{
+	if(type >= OBUS_SIZEOF_ARRAY(bench_wide_events_desc))
+		return "???";
+
+	return bench_wide_events_desc[type].name;
+}
+
+const struct obus_object_desc bench_wide_desc = {
+	.uid = BENCH_WIDE_UID,
+	.name = "wide",
+	.info_desc = &bench_wide_info_desc,
+	.n_events = OBUS_SIZEOF_ARRAY(bench_wide_events_desc),
+	.events = bench_wide_events_desc,
+	.n_methods = 0,
+	.methods = NULL,
+};
+
+static inline struct bench_wide *
+bench_wide_from_object(struct obus_object *object)
+{
+	const struct obus_object_desc *desc;
+
+	if (!object)
+		return NULL;
+
+	desc = obus_object_get_desc(object);
+	if (desc != &bench_wide_desc)
+		return NULL;
+
+	return (struct bench_wide *)object;
+}
+
+static inline struct obus_object *
+bench_wide_object(struct bench_wide *object)
+{
+	struct obus_object *obj;
+
+	obj = (struct obus_object *)object;
+	if (bench_wide_from_object(obj) != object)
+		return NULL;
+
+	return (struct obus_object *)object;
+}
+
+static inline const struct obus_object *
+bench_wide_const_object(const struct bench_wide *object)
+{
+	const struct obus_object *obj;
+
+	obj = (const struct obus_object *)object;
+	if (obus_object_get_desc(obj) != &bench_wide_desc)
+		return NULL;
+
+	return obj;
+}
+
+const struct bench_wide_info *
+bench_wide_get_info(const struct bench_wide *object)
+{
+	return (const struct bench_wide_info *)obus_object_get_info(bench_wide_const_object(object));
+}
+
+void bench_wide_log(const struct bench_wide *object, enum obus_log_level level)
+{
+	obus_object_log(bench_wide_const_object(object), level);
+}
+
+int bench_wide_set_user_data(struct bench_wide *object, void *user_data)
+{
+	return obus_object_set_user_data(bench_wide_object(object), user_data);
+}
+
+void *bench_wide_get_user_data(const struct bench_wide *object)
+{
+	return obus_object_get_user_data(bench_wide_const_object(object));
+}
+
+obus_handle_t bench_wide_get_handle(const struct bench_wide *object)
+{
+	return obus_object_get_handle(bench_wide_const_object(object));
+}
+
+struct bench_wide *
+bench_wide_from_handle(struct obus_client *client, obus_handle_t handle)
+{
+	struct obus_object *obj;
+
+	obj = obus_client_get_object(client, handle);	return bench_wide_from_object(obj);
+}
+
+struct bench_wide *
+bench_wide_next(struct obus_client *client, struct bench_wide *previous)
+{
+	struct obus_object *next, *prev;
+
+	prev = (struct obus_object *)previous;
+	next = obus_client_object_next(client, prev, bench_wide_desc.uid);
+	return bench_wide_from_object(next);
+}
+
+static inline struct obus_event *
+bench_wide_obus_event(struct bench_wide_event *event)
+{
+	return event && (obus_event_get_object_desc((struct obus_event *)event) == &bench_wide_desc) ? (struct obus_event *)event : NULL;
+}
+
+static inline const struct obus_event *
+bench_wide_const_obus_event(const struct bench_wide_event *event)
+{
+	return event && (obus_event_get_object_desc((const struct obus_event *)event) == &bench_wide_desc) ? (const struct obus_event *)event : NULL;
+}
+
+enum bench_wide_event_type
+bench_wide_event_get_type(const struct bench_wide_event *event)
+{
+	const struct obus_event_desc *desc;
+	desc = obus_event_get_desc(bench_wide_const_obus_event(event));
+	return desc ? (enum bench_wide_event_type)(desc - bench_wide_events_desc) : BENCH_WIDE_EVENT_COUNT;
+}
+
+void bench_wide_event_log(const struct bench_wide_event *event, enum obus_log_level level)
+{
+	obus_event_log(bench_wide_const_obus_event(event), level);
+}
+
+int bench_wide_event_is_empty(const struct bench_wide_event *event)
+{
+	return obus_event_is_empty(bench_wide_const_obus_event(event));
+}
+
+int bench_wide_event_commit(struct bench_wide_event *event)
+{
+	return obus_event_commit(bench_wide_obus_event(event));
+}
+
+const struct bench_wide_info *
+bench_wide_event_get_info(const struct bench_wide_event *event)
+{
+	return (const struct bench_wide_info *)obus_event_get_info(bench_wide_const_obus_event(event));
+}
+
+
+/**
+ * @brief subscribe to events concerning bench_wide objects.
+ *
+ * @param[in] client bus client.
+ * @param[in] provider callback set for reacting on bench_wide events.
+ * @param[in] user_data data passed to callbacks on events.
+ *
+ * @retval 0 success.
+ **/
+int bench_wide_subscribe(struct obus_client *client, struct bench_wide_provider *provider, void *user_data)
+{
+	struct obus_provider *p;
+	int ret;
+	if (!client || !provider || !provider->add || !provider->remove || !provider->event)
+		return -EINVAL;
+
+	p = calloc(1, sizeof(*p));
+	if (!p)
+		return -ENOMEM;
+
+	p->add = (obus_provider_add_cb_t)provider->add;
+	p->remove = (obus_provider_remove_cb_t)provider->remove;
+	p->event = (obus_provider_event_cb_t)provider->event;
+	p->desc = &bench_wide_desc;
+	p->user_data = user_data;
+
+	ret = obus_client_register_provider(client, p);
+	if (ret < 0) {
+		free(p);
+		return ret;
+	}
+
+	provider->priv = p;
+	return 0;
+}
+
+
+/**
+ * @brief unsubscribe to events concerning bench_wide objects.
+ *
+ * @param[in] client bus client.
+ * @param[in] provider passed to bench_wide_subscribe.
+ *
+ * @retval 0 success.
+ **/int bench_wide_unsubscribe(struct obus_client *client, struct bench_wide_provider *provider)
+{
+	int ret;
+	if (!client || !provider)
+		return -EINVAL;
+
+	ret = obus_client_unregister_provider(client, provider->priv);
+	if (ret < 0)
+		return ret;
+
+	free(provider->priv);
+	provider->priv = NULL;
+	return 0;
+}
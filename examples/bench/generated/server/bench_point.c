@@ -0,0 +1,632 @@
+/**
+ * @file bench_point.c
+ *
+ * @brief obus bench_point object server api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OBUS_USE_PRIVATE
+#include "libobus.h"
+#include "libobus_private.h"
+#include "bench_point.h"
+
+
+enum bench_point_field_type {
+	BENCH_POINT_FIELD_X = 0,
+	BENCH_POINT_FIELD_Y,
+	BENCH_POINT_FIELD_SEQ,
+	BENCH_POINT_FIELD_METHOD_FLOOD,
+	BENCH_POINT_FIELD_METHOD_PING,
+};
+
+static const struct obus_field_desc bench_point_info_fields[] = {
+	[BENCH_POINT_FIELD_X] = {
+		.uid = 1,
+		.name = "x",
+		.offset = obus_offsetof(struct bench_point_info, x),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_I32,
+	},
+	[BENCH_POINT_FIELD_Y] = {
+		.uid = 2,
+		.name = "y",
+		.offset = obus_offsetof(struct bench_point_info, y),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_I32,
+	},
+	[BENCH_POINT_FIELD_SEQ] = {
+		.uid = 3,
+		.name = "seq",
+		.offset = obus_offsetof(struct bench_point_info, seq),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_POINT_FIELD_METHOD_FLOOD] = {
+		.uid = 101,
+		.name = "flood",
+		.offset = obus_offsetof(struct bench_point_info, method_flood),
+		.role = OBUS_METHOD,
+		.type = OBUS_FIELD_ENUM,
+		.enum_drv = &obus_method_state_driver,
+	},
+	[BENCH_POINT_FIELD_METHOD_PING] = {
+		.uid = 102,
+		.name = "ping",
+		.offset = obus_offsetof(struct bench_point_info, method_ping),
+		.role = OBUS_METHOD,
+		.type = OBUS_FIELD_ENUM,
+		.enum_drv = &obus_method_state_driver,
+	},
+
+};
+
+static const uint16_t bench_point_info_uids[] = {
+	[1] = BENCH_POINT_FIELD_X + 1,
+	[2] = BENCH_POINT_FIELD_Y + 1,
+	[3] = BENCH_POINT_FIELD_SEQ + 1,
+	[101] = BENCH_POINT_FIELD_METHOD_FLOOD + 1,
+	[102] = BENCH_POINT_FIELD_METHOD_PING + 1,
+};
+
+static size_t bench_point_info_encoded_size(const struct obus_struct *st)
+{
+	const struct bench_point_info *info = st->u.const_addr;
+	size_t size = 2;
+
+	if (info->fields.x)
+		size += 3 + 4;
+	if (info->fields.y)
+		size += 3 + 4;
+	if (info->fields.seq)
+		size += 3 + 4;
+	if (info->fields.method_flood)
+		size += 3 + 4;
+	if (info->fields.method_ping)
+		size += 3 + 4;
+
+	return size;
+}
+
+static size_t bench_point_info_encode(const struct obus_struct *st, uint8_t *ptr)
+{
+	const struct bench_point_info *info = st->u.const_addr;
+	uint8_t *p = ptr + 2;
+	uint16_t n_fields = 0;
+
+	if (info->fields.x) {
+		p = obus_put_u16(p, 1);
+		p = obus_put_u8(p, OBUS_FIELD_I32);
+		p = obus_put_u32(p, (uint32_t)info->x);
+		n_fields++;
+	}
+	if (info->fields.y) {
+		p = obus_put_u16(p, 2);
+		p = obus_put_u8(p, OBUS_FIELD_I32);
+		p = obus_put_u32(p, (uint32_t)info->y);
+		n_fields++;
+	}
+	if (info->fields.seq) {
+		p = obus_put_u16(p, 3);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->seq);
+		n_fields++;
+	}
+	if (info->fields.method_flood) {
+		p = obus_put_u16(p, 101);
+		p = obus_put_u8(p, OBUS_FIELD_ENUM);
+		p = obus_put_u32(p, (uint32_t)info->method_flood);
+		n_fields++;
+	}
+	if (info->fields.method_ping) {
+		p = obus_put_u16(p, 102);
+		p = obus_put_u8(p, OBUS_FIELD_ENUM);
+		p = obus_put_u32(p, (uint32_t)info->method_ping);
+		n_fields++;
+	}
+
+	obus_put_u16(ptr, n_fields);
+	return (size_t)(p - ptr);
+}
+
+static size_t bench_point_info_decode_field(const struct obus_struct *st,
+		uint16_t uid, uint8_t type, const uint8_t *ptr, size_t len)
+{
+	struct bench_point_info *info = st->u.addr;
+
+	switch (uid) {
+	case 1:
+		if (type != OBUS_FIELD_I32 || len < 4)
+			return 0;
+		info->x = (int32_t)obus_get_u32(ptr);
+		return 4;
+	case 2:
+		if (type != OBUS_FIELD_I32 || len < 4)
+			return 0;
+		info->y = (int32_t)obus_get_u32(ptr);
+		return 4;
+	case 3:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->seq = obus_get_u32(ptr);
+		return 4;
+	case 101:
+		if (type != OBUS_FIELD_ENUM || len < 4)
+			return 0;
+		info->method_flood = (enum obus_method_state)(int32_t)obus_get_u32(ptr);
+		return 4;
+	case 102:
+		if (type != OBUS_FIELD_ENUM || len < 4)
+			return 0;
+		info->method_ping = (enum obus_method_state)(int32_t)obus_get_u32(ptr);
+		return 4;
+	default:
+		/* strings, arrays & unknown fields use generic decoder */
+		return 0;
+	}
+}
+
+static const struct obus_struct_desc bench_point_info_desc = {
+	.size = sizeof(struct bench_point_info),
+	.fields_offset = obus_offsetof(struct bench_point_info, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_point_info_fields),
+	.fields = bench_point_info_fields,
+	.uids = bench_point_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_point_info_uids),
+	.encoded_size = bench_point_info_encoded_size,
+	.encode = bench_point_info_encode,
+	.decode_field = bench_point_info_decode_field,
+};
+
+static const struct obus_event_update_desc event_moved_updates[] = {
+	{
+		.field = &bench_point_info_fields[BENCH_POINT_FIELD_X],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_point_info_fields[BENCH_POINT_FIELD_Y],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_point_info_fields[BENCH_POINT_FIELD_SEQ],
+		.flags = 0,
+	}
+
+};
+
+static const struct obus_event_desc bench_point_events_desc[] = {
+	{
+		.uid = 1,
+		.name = "moved",
+		.updates = event_moved_updates,
+		.n_updates = OBUS_SIZEOF_ARRAY(event_moved_updates),
+	}
+
+};
+
+const char *bench_point_event_type_str(enum bench_point_event_type type)
+{
+	if(type >= OBUS_SIZEOF_ARRAY(bench_point_events_desc))
+		return "???";
+
+	return bench_point_events_desc[type].name;
+}
+
+enum bench_point_method_type {
+	BENCH_POINT_METHOD_FLOOD = 0,
+	BENCH_POINT_METHOD_PING,
+	BENCH_POINT_METHOD_COUNT,
+};
+
+static const struct obus_field_desc bench_point_flood_args_fields[] = {
+	{		.uid = 1,
+		.name = "count",
+		.offset = obus_offsetof(struct bench_point_flood_args, count),
+		.role = OBUS_ARGUMENT,
+		.type = OBUS_FIELD_U32,
+	}
+};
+
+static const uint16_t bench_point_flood_args_uids[] = {
+	[1] = 1,
+};
+
+static size_t bench_point_flood_args_encoded_size(const struct obus_struct *st)
+{
+	const struct bench_point_flood_args *info = st->u.const_addr;
+	size_t size = 2;
+
+	if (info->fields.count)
+		size += 3 + 4;
+
+	return size;
+}
+
+static size_t bench_point_flood_args_encode(const struct obus_struct *st, uint8_t *ptr)
+{
+	const struct bench_point_flood_args *info = st->u.const_addr;
+	uint8_t *p = ptr + 2;
+	uint16_t n_fields = 0;
+
+	if (info->fields.count) {
+		p = obus_put_u16(p, 1);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->count);
+		n_fields++;
+	}
+
+	obus_put_u16(ptr, n_fields);
+	return (size_t)(p - ptr);
+}
+
+static size_t bench_point_flood_args_decode_field(const struct obus_struct *st,
+		uint16_t uid, uint8_t type, const uint8_t *ptr, size_t len)
+{
+	struct bench_point_flood_args *info = st->u.addr;
+
+	switch (uid) {
+	case 1:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->count = obus_get_u32(ptr);
+		return 4;
+	default:
+		/* strings, arrays & unknown fields use generic decoder */
+		return 0;
+	}
+}
+
+static const struct obus_struct_desc bench_point_flood_args_desc = {
+	.size = sizeof(struct bench_point_flood_args),
+	.fields_offset = obus_offsetof(struct bench_point_flood_args, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_point_flood_args_fields),
+	.fields = bench_point_flood_args_fields,
+	.uids = bench_point_flood_args_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_point_flood_args_uids),
+	.encoded_size = bench_point_flood_args_encoded_size,
+	.encode = bench_point_flood_args_encode,
+	.decode_field = bench_point_flood_args_decode_field,
+};
+
+static const struct obus_field_desc bench_point_ping_args_fields[] = {
+	{		.uid = 1,
+		.name = "value",
+		.offset = obus_offsetof(struct bench_point_ping_args, value),
+		.role = OBUS_ARGUMENT,
+		.type = OBUS_FIELD_U32,
+	}
+};
+
+static const uint16_t bench_point_ping_args_uids[] = {
+	[1] = 1,
+};
+
+static size_t bench_point_ping_args_encoded_size(const struct obus_struct *st)
+{
+	const struct bench_point_ping_args *info = st->u.const_addr;
+	size_t size = 2;
+
+	if (info->fields.value)
+		size += 3 + 4;
+
+	return size;
+}
+
+static size_t bench_point_ping_args_encode(const struct obus_struct *st, uint8_t *ptr)
+{
+	const struct bench_point_ping_args *info = st->u.const_addr;
+	uint8_t *p = ptr + 2;
+	uint16_t n_fields = 0;
+
+	if (info->fields.value) {
+		p = obus_put_u16(p, 1);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->value);
+		n_fields++;
+	}
+
+	obus_put_u16(ptr, n_fields);
+	return (size_t)(p - ptr);
+}
+
+static size_t bench_point_ping_args_decode_field(const struct obus_struct *st,
+		uint16_t uid, uint8_t type, const uint8_t *ptr, size_t len)
+{
+	struct bench_point_ping_args *info = st->u.addr;
+
+	switch (uid) {
+	case 1:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->value = obus_get_u32(ptr);
+		return 4;
+	default:
+		/* strings, arrays & unknown fields use generic decoder */
+		return 0;
+	}
+}
+
+static const struct obus_struct_desc bench_point_ping_args_desc = {
+	.size = sizeof(struct bench_point_ping_args),
+	.fields_offset = obus_offsetof(struct bench_point_ping_args, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_point_ping_args_fields),
+	.fields = bench_point_ping_args_fields,
+	.uids = bench_point_ping_args_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_point_ping_args_uids),
+	.encoded_size = bench_point_ping_args_encoded_size,
+	.encode = bench_point_ping_args_encode,
+	.decode_field = bench_point_ping_args_decode_field,
+};
+
+static const struct obus_method_desc bench_point_methods_desc[] = {
+	{		.uid = 101,
+		.name = "flood",
+		.args_desc = &bench_point_flood_args_desc,
+	}
+	,
+	{		.uid = 102,
+		.name = "ping",
+		.args_desc = &bench_point_ping_args_desc,
+	}
+};
+
+const struct obus_object_desc bench_point_desc = {
+	.uid = BENCH_POINT_UID,
+	.name = "point",
+	.info_desc = &bench_point_info_desc,
+	.n_events = OBUS_SIZEOF_ARRAY(bench_point_events_desc),
+	.events = bench_point_events_desc,
+	.n_methods = OBUS_SIZEOF_ARRAY(bench_point_methods_desc),
+	.methods = bench_point_methods_desc,
+};
+
+int bench_point_method_handlers_is_valid(const struct bench_point_method_handlers *handlers)
+{
+	return handlers &&
+		handlers->method_flood &&
+		handlers->method_ping;
+}
+
+int bench_point_flood_args_is_complete(const struct bench_point_flood_args *args)
+{
+	return args &&
+		args->fields.count;
+}
+
+int bench_point_ping_args_is_complete(const struct bench_point_ping_args *args)
+{
+	return args &&
+		args->fields.value;
+}
+
+void bench_point_info_init(struct bench_point_info *info)
+{
+	if (info)
+		memset(info, 0, sizeof(*info));
+}
+
+
+int bench_point_info_is_empty(const struct bench_point_info *info)
+{
+	return 	info &&
+		!info->fields.x &&
+		!info->fields.y &&
+		!info->fields.seq &&
+		!info->fields.method_flood &&
+		!info->fields.method_ping;
+}
+
+void bench_point_info_set_methods_state(struct bench_point_info *info, enum obus_method_state state)
+{
+	OBUS_SET(info, method_flood, state);
+	OBUS_SET(info, method_ping, state);
+}
+
+static inline struct bench_point *
+bench_point_from_object(struct obus_object *object)
+{
+	const struct obus_object_desc *desc;
+
+	if (!object)
+		return NULL;
+
+	desc = obus_object_get_desc(object);
+	if (desc != &bench_point_desc)
+		return NULL;
+
+	return (struct bench_point *)object;
+}
+
+static inline struct obus_object *
+bench_point_object(struct bench_point *object)
+{
+	struct obus_object *obj;
+
+	obj = (struct obus_object *)object;
+	if (bench_point_from_object(obj) != object)
+		return NULL;
+
+	return (struct obus_object *)object;
+}
+
+static inline const struct obus_object *
+bench_point_const_object(const struct bench_point *object)
+{
+	const struct obus_object *obj;
+
+	obj = (const struct obus_object *)object;
+	if (obus_object_get_desc(obj) != &bench_point_desc)
+		return NULL;
+
+	return obj;
+}
+
+struct bench_point *
+bench_point_new(struct obus_server *srv, const struct bench_point_info *info, const struct bench_point_method_handlers *handlers)
+{
+	obus_method_handler_cb_t cbs[BENCH_POINT_METHOD_COUNT];
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_point_desc.info_desc
+	};
+
+	cbs[BENCH_POINT_METHOD_FLOOD] = (obus_method_handler_cb_t)handlers->method_flood;
+	cbs[BENCH_POINT_METHOD_PING] = (obus_method_handler_cb_t)handlers->method_ping;
+
+	return (struct bench_point*)obus_server_new_object(srv, &bench_point_desc, cbs, info ? &st : NULL);
+}
+
+int bench_point_destroy(struct bench_point *object)
+{
+	return obus_object_destroy(bench_point_object(object));
+}
+
+int bench_point_register(struct obus_server *server, struct bench_point *object)
+{
+	struct obus_object *obj = (struct obus_object *)object;
+	return obus_server_register_object(server, obj);
+}
+int bench_point_unregister(struct obus_server *server, struct bench_point *object)
+{
+	struct obus_object *obj = (struct obus_object *)object;
+	return obus_server_unregister_object(server, obj);
+}
+int bench_point_is_registered(const struct bench_point *object)
+{
+	const struct obus_object *obj = (const struct obus_object *)object;
+	return obus_object_is_registered(obj);
+}
+
+const struct bench_point_info *
+bench_point_get_info(const struct bench_point *object)
+{
+	return (const struct bench_point_info *)obus_object_get_info(bench_point_const_object(object));
+}
+
+void bench_point_log(const struct bench_point *object, enum obus_log_level level)
+{
+	obus_object_log(bench_point_const_object(object), level);
+}
+
+int bench_point_set_user_data(struct bench_point *object, void *user_data)
+{
+	return obus_object_set_user_data(bench_point_object(object), user_data);
+}
+
+void *bench_point_get_user_data(const struct bench_point *object)
+{
+	return obus_object_get_user_data(bench_point_const_object(object));
+}
+
+obus_handle_t bench_point_get_handle(const struct bench_point *object)
+{
+	return obus_object_get_handle(bench_point_const_object(object));
+}
+
+struct bench_point *
+bench_point_from_handle(struct obus_server *server, obus_handle_t handle)
+{
+	struct obus_object *obj;
+
+	obj = obus_server_get_object(server, handle);	return bench_point_from_object(obj);
+}
+
+struct bench_point *
+bench_point_next(struct obus_server *server, struct bench_point *previous)
+{
+	struct obus_object *next, *prev;
+
+	prev = (struct obus_object *)previous;
+	next = obus_server_object_next(server, prev, bench_point_desc.uid);
+	return bench_point_from_object(next);
+}
+
+int bench_point_send_event(struct obus_server *server, struct bench_point *object, enum bench_point_event_type type, const struct bench_point_info *info)
+{
+	int ret;
+	struct obus_event event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_point_desc.info_desc
+	};
+
+	if (!object || !server || type >= BENCH_POINT_EVENT_COUNT)
+		return -EINVAL;
+
+	ret = obus_event_init(&event, bench_point_object(object), &bench_point_events_desc[type], &st);
+	if (ret < 0)
+		return ret;
+
+	return obus_server_send_event(server, &event);
+}
+
+
+int bench_point_submit_event(struct obus_server *server, struct bench_point *object, enum bench_point_event_type type, const struct bench_point_info *info)
+{
+	int ret;
+	struct obus_event *event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_point_desc.info_desc
+	};
+
+	if (!object || !server || type >= BENCH_POINT_EVENT_COUNT)
+		return -EINVAL;
+
+	event = obus_event_new(bench_point_object(object), &bench_point_events_desc[type], &st);
+	if (!event)
+		return -ENOMEM;
+
+	ret = obus_server_submit_event(server, event);
+	if (ret < 0)
+		obus_event_destroy(event);
+
+	return ret;
+}
+
+int bench_bus_event_add_point_event(struct bench_bus_event *bus_event, struct bench_point *object, enum bench_point_event_type type, const struct bench_point_info *info)
+{
+	int ret;
+	struct obus_event *event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_point_desc.info_desc
+	};
+
+	if (!object || !bus_event || type >= BENCH_POINT_EVENT_COUNT)
+		return -EINVAL;
+
+	event = obus_event_new(bench_point_object(object), &bench_point_events_desc[type], &st);
+	if (!event)
+		return -ENOMEM;
+
+	ret = obus_bus_event_add_event((struct obus_bus_event *)bus_event, event);
+	if (ret < 0)
+		obus_event_destroy(event);
+
+	return ret;
+}
+
+int bench_bus_event_register_point(struct bench_bus_event *bus_event, struct bench_point *object)
+{
+	return obus_bus_event_register_object((struct obus_bus_event *)bus_event, bench_point_object(object));
+}
+
+int bench_bus_event_unregister_point(struct bench_bus_event *bus_event, struct bench_point *object)
+{
+	return obus_bus_event_unregister_object((struct obus_bus_event *)bus_event, bench_point_object(object));
+}
+
@@ -0,0 +1,533 @@
+/**
+ * @file bench_point.h
+ *
+ * @brief obus bench_point object server api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _BENCH_POINT_H_
+#define _BENCH_POINT_H_
+
+#include "libobus.h"
+
+OBUS_BEGIN_DECLS
+
+/**
+ * @brief bench_point object uid
+ **/
+#define BENCH_POINT_UID 1
+
+/**
+ * @brief bench_point event type enumeration.
+ *
+ * This enumeration describes all kind of bench_point events.
+ **/
+enum bench_point_event_type {
+	/** Point moved */
+	BENCH_POINT_EVENT_MOVED = 0,
+	/** for internal use only*/
+	BENCH_POINT_EVENT_COUNT,
+};
+
+/**
+ * @brief get bench_point_event_type string value.
+ *
+ * @param[in]  type  event type to be converted into string.
+ *
+ * @retval non NULL constant string value.
+ **/
+const char *bench_point_event_type_str(enum bench_point_event_type type);
+
+/**
+ * @brief bench_point object structure
+ *
+ * This opaque structure represent an bench_point object.
+ **/
+struct bench_point;
+
+/**
+ * @brief bench bus event structure
+ *
+ * This opaque structure represent an bench bus event.
+ **/
+struct bench_bus_event;
+
+/**
+ * @brief bench_point object info fields structure.
+ *
+ * This structure contains a presence bit for each fields
+ * (property or method state) in bench_point object.
+ * When a bit is set, the corresponding field in
+ * @ref bench_point_info structure must be taken into account.
+ **/
+struct bench_point_info_fields {
+	/** x field presence bit */
+	unsigned int x:1;
+	/** y field presence bit */
+	unsigned int y:1;
+	/** seq field presence bit */
+	unsigned int seq:1;
+	/** flood method presence bit */
+	unsigned int method_flood:1;
+	/** ping method presence bit */
+	unsigned int method_ping:1;
+};
+
+/**
+ * @brief bench_point object info structure.
+ *
+ * This structure represent bench_point object contents.
+ **/
+struct bench_point_info {
+	/** fields presence bit structure */
+	struct bench_point_info_fields fields;
+	/** X coordinate */
+	int32_t x;
+	/** Y coordinate */
+	int32_t y;
+	/** Update sequence number */
+	uint32_t seq;
+	/** method flood state */
+	enum obus_method_state method_flood;
+	/** method ping state */
+	enum obus_method_state method_ping;
+};
+
+/**
+ * @brief bench_point method flood arguments presence structure.
+ *
+ * This structure contains a presence bit for each
+ * of bench_point method flood argument.
+ * When a bit is set, the corresponding argument in
+ * @ref bench_point_flood_args_fields structure must be taken into account.
+ **/
+struct bench_point_flood_args_fields {
+	/** presence bit for argument count */
+	unsigned int count:1;
+};
+
+/**
+ * @brief bench_point method flood arguments structure.
+ *
+ * This structure contains bench_point method flood arguments values.
+ **/
+struct bench_point_flood_args {
+	/** arguments presence bit structure */
+	struct bench_point_flood_args_fields fields;
+	/** Number of events */
+	uint32_t count;
+};
+/**
+ * @brief bench_point method ping arguments presence structure.
+ *
+ * This structure contains a presence bit for each
+ * of bench_point method ping argument.
+ * When a bit is set, the corresponding argument in
+ * @ref bench_point_ping_args_fields structure must be taken into account.
+ **/
+struct bench_point_ping_args_fields {
+	/** presence bit for argument value */
+	unsigned int value:1;
+};
+
+/**
+ * @brief bench_point method ping arguments structure.
+ *
+ * This structure contains bench_point method ping arguments values.
+ **/
+struct bench_point_ping_args {
+	/** arguments presence bit structure */
+	struct bench_point_ping_args_fields fields;
+	/** Any value */
+	uint32_t value;
+};
+
+/**
+ * @brief bench_point method handlers structure.
+ *
+ * This structure contains pointer to bench_point methods implementations.
+ * Server must implement theses callback and fill up
+ * this structure before creating a bench_point object.
+ **/
+struct bench_point_method_handlers {
+	/**
+	 * @brief bench_point method flood handler.
+	 *
+	 * Send moved events at once
+	 *
+	 * @param[in]  object  bench_point object.
+	 * @param[in]  handle  client call sequence id.
+	 * @param[in]  args    method flood call arguments.
+	 **/
+	void (*method_flood) (struct bench_point *object, obus_handle_t handle, const struct bench_point_flood_args *args);
+
+	/**
+	 * @brief bench_point method ping handler.
+	 *
+	 * Acked as soon as received
+	 *
+	 * @param[in]  object  bench_point object.
+	 * @param[in]  handle  client call sequence id.
+	 * @param[in]  args    method ping call arguments.
+	 **/
+	void (*method_ping) (struct bench_point *object, obus_handle_t handle, const struct bench_point_ping_args *args);
+};
+
+/**
+ * @brief check @ref bench_point_method_handlers structure is valid.
+ *
+ * @param[in]  handlers  bench_point methods handlers.
+ *
+ * @retval     1         all methods have non NULL handler.
+ * @retval     0         one method (or more) has a NULL handler.
+ **/
+int bench_point_method_handlers_is_valid(const struct bench_point_method_handlers *handlers);
+
+/**
+ * @brief check @ref bench_point_flood_args structure is complete (all arguments are present).
+ *
+ * @param[in]  args bench_point flood method arguments.
+ *
+ * @retval     1         all methods arguments are present.
+ * @retval     0         one method (or more) argument is missing.
+ **/
+int bench_point_flood_args_is_complete(const struct bench_point_flood_args *args);
+
+/**
+ * @brief check @ref bench_point_ping_args structure is complete (all arguments are present).
+ *
+ * @param[in]  args bench_point ping method arguments.
+ *
+ * @retval     1         all methods arguments are present.
+ * @retval     0         one method (or more) argument is missing.
+ **/
+int bench_point_ping_args_is_complete(const struct bench_point_ping_args *args);
+
+/**
+ * @brief initialize @ref bench_point_info structure.
+ *
+ * This function initialize @ref bench_point_info structure.
+ * Each field has its presence bit cleared.
+ *
+ * @param[in]  info  pointer to allocated @ref bench_point_info structure.
+ **/
+void bench_point_info_init(struct bench_point_info *info);
+
+/**
+ * @brief check @ref bench_point_info structure contents is empty.
+ *
+ * This function check if each field has its presence bit cleared
+ *
+ * @param[in]  info  @ref bench_point_info structure.
+ *
+ * @retval     1     Each field has its presence bit cleared.
+ * @retval     0     One field (or more) has its presence bit set.
+ **/
+int bench_point_info_is_empty(const struct bench_point_info *info);
+
+/**
+ * @brief set @ref bench_point_info methods state.
+ *
+ * This function set all bench_point methods state to given argument state
+ *
+ * @param[in]  info   @ref bench_point_info structure.
+ * @param[in]  state  new methods state.
+ **/
+void bench_point_info_set_methods_state(struct bench_point_info *info, enum obus_method_state state);
+
+/**
+ * @brief create a bench_point object.
+ *
+ * This function allocate bench_point object and initialize each
+ * object field with the given @ref info field value only if @ref info field
+ * presence bit is set (see @ref bench_point_info_fields).
+ * This function also set a unique handle for this object.
+ * Registering or unregistering object in bus do not alter handle value
+ *
+ * @param[in]  server    bench bus server.
+ * @param[in]  info      bench_point object initial values (may be NULL).
+ * @param[in]  handlers  bench_point method handlers.
+ *
+ * @retval  object  success.
+ * @retval  NULL    failure.
+ *
+ * @note: object does not keep any reference to @ref info so that user shall
+ * allocate it on the stack.
+ *
+ * @note: if @ref info param is NULL, bench_point object is initialized with
+ * default values.
+ *
+ * @note: object is not yet registered on bus,
+ * call one of theses functions below to register it:
+ * @ref bench_point_register
+ * @ref bench_bus_event_register_point
+ **/
+struct bench_point *
+bench_point_new(struct obus_server *srv, const struct bench_point_info *info, const struct bench_point_method_handlers *handlers);
+
+/**
+ * @brief destroy a bench_point object.
+ *
+ * This function release bench_point object memory.
+ * Only non registered objects can be destroyed.
+ *
+ * @param[in]  object  bench_point object to be destroyed.
+ *
+ * @retval  0       success.
+ * @retval  -EPERM  @ref object is registered.
+ * @retval  -EINVAL invalid @ref object.
+ **/
+int bench_point_destroy(struct bench_point *object);
+
+/**
+ * @brief register a bench_point object.
+ *
+ * This function register a bench_point object in bench bus.
+ *
+ * @param[in]  server  bench bus server.
+ * @param[in]  object  bench_point object to be registered.
+ *
+ * @retval  0       success.
+ * @retval  -EPERM  @ref object is already registered.
+ * @retval  -EINVAL invalid parameters.
+ * @retval  < 0     other errors.
+ **/
+int bench_point_register(struct obus_server *server, struct bench_point *object);
+
+/**
+ * @brief unregister a bench_point object.
+ *
+ * This function unregister a bench_point object in bench bus.
+ *
+ * @param[in]  server  bench bus server.
+ * @param[in]  object  bench_point object to be unregistered.
+ *
+ * @retval  0       success.
+ * @retval  -EPERM  @ref object is not registered.
+ * @retval  -EINVAL invalid parameters.
+ * @retval  < 0     other errors.
+ **/
+int bench_point_unregister(struct obus_server *server, struct bench_point *object);
+
+/**
+ * @brief check if is a bench_point object registered.
+ *
+ * This function check whether a bench_point object is registered or not.
+ *
+ * @param[in]  object  bench_point object to checked.
+ *
+ * @retval  0  object is not registered.
+ * @retval  1  object is registered.
+ **/
+int bench_point_is_registered(const struct bench_point *object);
+
+/**
+ * @brief read current bench_point object fields values.
+ *
+ * This function is used to read current object fields values.
+ *
+ * @param[in]  object  bench_point object.
+ *
+ * @retval  info  pointer to a constant object fields values.
+ * @retval  NULL  object is NULL or not an bench_point object.
+ *
+ * @note: object info pointer returned never changed during object life cycle
+ * so that user may keep a reference on this pointer until object destruction.
+ * this is not the case for info pointers members.
+ **/
+
+const struct bench_point_info *
+bench_point_get_info(const struct bench_point *object);
+
+/**
+ * @brief log bench_point object.
+ *
+ * This function log object and its current fields values.
+ *
+ * @param[in]  object  bench_point object.
+ * @param[in]  level   obus log level.
+ **/
+void bench_point_log(const struct bench_point *object, enum obus_log_level level);
+
+/**
+ * @brief set bench_point object user data pointer.
+ *
+ * This function store a user data pointer in a bench_point object.
+ * This pointer is never used by libobus and can be retrieved using
+ * @ref bench_point_get_user_data function.
+ *
+ * @param[in]  object      bench_point object.
+ * @param[in]  user_data   user data pointer.
+ *
+ * @retval  0        success.
+ * @retval  -EINVAL  object is NULL.
+ **/
+int bench_point_set_user_data(struct bench_point *object, void *user_data);
+
+/**
+ * @brief get bench_point object user data pointer.
+ *
+ * This function retrieve user data pointer stored in a bench_point object
+ * by a previous call to @ref bench_point_set_user_data function
+ *
+ * @param[in]  object  bench_point object.
+ *
+ * @retval  user_data  user data pointer.
+ **/
+void *bench_point_get_user_data(const struct bench_point *object);
+
+/**
+ * @brief get registered bench_point object obus handle.
+ *
+ * This function retrieve bench_point object obus handle.
+ * obus handle is an unsigned 16 bits integer.
+ * object handle is generated during object creation.
+ * object handle can be used to reference an object into another one.
+ *
+ * @param[in]  object  bench_point object.
+ *
+ * @retval  handle               registered object obus handle.
+ * @retval  OBUS_INVALID_HANDLE  if object is not registered.
+ **/
+obus_handle_t bench_point_get_handle(const struct bench_point *object);
+
+/**
+ * @brief get bench_point object from obus handle.
+ *
+ * This function retrieve bench_point object given its obus handle.
+ *
+ * @param[in]  server  bench bus server
+ * @param[in]  handle  bench_point object handle.
+ *
+ * @retval  object  bench_point object.
+ * @retval  NULL    invalid parameters.
+ * @retval  NULL    corresponding handle object is not a bench_point.
+ **/
+struct bench_point *
+bench_point_from_handle(struct obus_server *server, obus_handle_t handle);
+
+/**
+ * @brief get next registered bench_point object in bus.
+ *
+ * This function retrieve the next registered bench_point object in bus.
+ *
+ * @param[in]  server    bench bus server
+ * @param[in]  previous  previous bench_point object in list (may be NULL).
+ *
+ * @retval  object  next bench_point object.
+ * @retval  NULL    invalid parameters.
+ * @retval  NULL    no more bench_point objects in bus.
+ *
+ * @note: if @p previous is NULL, then the first
+ * registered bench_point object is returned.
+ **/
+struct bench_point *
+bench_point_next(struct obus_server *server, struct bench_point *previous);
+
+/**
+ * @brief send a bench_point object event.
+ *
+ * This function send an event on a bench_point object.
+ *
+ * @param[in]  server    bench bus server.
+ * @param[in]  object    bench_point object.
+ * @param[in]  type      bench_point event type.
+ * @param[in]  info      associated bench_point content to be updated.
+ *
+ * @retval  0          event sent and object content updated.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -EPERM     object is not registered in bus.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int bench_point_send_event(struct obus_server *server, struct bench_point *object, enum bench_point_event_type type, const struct bench_point_info *info);
+
+/**
+ * @brief submit a bench_point object event from any thread.
+ *
+ * This function queue an event on a bench_point object, it may be
+ * called from another thread than the server loop one.
+ * Event is sent and object content updated by server loop,
+ * submitted events of a thread are sent in submission order.
+ * Object must not be destroyed before its event is sent.
+ *
+ * @param[in]  server    bench bus server.
+ * @param[in]  object    bench_point object.
+ * @param[in]  type      bench_point event type.
+ * @param[in]  info      associated bench_point content to be updated.
+ *
+ * @retval  0          event queued.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -ENOMEM    memory error.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int bench_point_submit_event(struct obus_server *server, struct bench_point *object, enum bench_point_event_type type, const struct bench_point_info *info);
+
+/**
+ * @brief send a bench_point object event through a bench bus event.
+ *
+ * This function create a bench_point object event and attach it
+ * to an existing bench bus event. Created bench_point object event
+ * will be sent within corresponding bus event.
+ * Unlike @bench_point_send_event, object content will not be updated
+ * when this function returns but when
+ * @bench_point_bus_event_send will be invoked.
+ *
+ * @param[in]  bus_event  bench bus event.
+ * @param[in]  object     bench_point object.
+ * @param[in]  type       bench_point event type.
+ * @param[in]  info       associated bench_point content to be updated.
+ *
+ * @retval  0          event created and associated to bus event.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -ENOMEM    memory error.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int bench_bus_event_add_point_event(struct bench_bus_event *bus_event, struct bench_point *object, enum bench_point_event_type type, const struct bench_point_info *info);
+
+/**
+ * @brief register a bench_point object through a bench bus event.
+ *
+ * This function set a bench_point object to be registered when
+ * associated bench bus event will be sent. Unlike @bench_point_register,
+ * object will not be registered when this function returns but when
+ * @bench_point_bus_event_send will be invoked.
+ *
+ * @param[in]  bus_event  bench bus event.
+ * @param[in]  object     bench_point object to be registered.
+ *
+ * @retval  0          object registration request associated to bus event.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -EPERM     object is already attached to an existing bus event.
+ *
+ **/
+int bench_bus_event_register_point(struct bench_bus_event *bus_event, struct bench_point *object);
+
+/**
+ * @brief unregister a bench_point object through a bench bus event.
+ *
+ * This function set bench_point object to be unregistered when
+ * associated bench bus event will be sent. Unlike @bench_point_register,
+ * object will not be unregistered when this function returns but when
+ * @bench_point_bus_event_send will be invoked.
+ * Object is then automatically destroyed on
+ * @bench_point_bus_event_destroy call.
+ *
+ * @param[in]  bus_event  bench bus event.
+ * @param[in]  object     bench_point object to be registered.
+ *
+ * @retval  0          object registration request associated to bus event.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -EPERM     object is already attached to an existing bus event.
+ *
+ **/
+int bench_bus_event_unregister_point(struct bench_bus_event *bus_event, struct bench_point *object);
+
+OBUS_END_DECLS
+
+#endif /*_BENCH_POINT_H_*/
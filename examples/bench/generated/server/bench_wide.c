@@ -0,0 +1,2168 @@
+/**
+ * @file bench_wide.c
+ *
+ * @brief obus bench_wide object server api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OBUS_USE_PRIVATE
+#include "libobus.h"
+#include "libobus_private.h"
+#include "bench_wide.h"
+
+
+enum bench_wide_field_type {
+	BENCH_WIDE_FIELD_F1 = 0,
+	BENCH_WIDE_FIELD_F2,
+	BENCH_WIDE_FIELD_F3,
+	BENCH_WIDE_FIELD_F4,
+	BENCH_WIDE_FIELD_F5,
+	BENCH_WIDE_FIELD_F6,
+	BENCH_WIDE_FIELD_F7,
+	BENCH_WIDE_FIELD_F8,
+	BENCH_WIDE_FIELD_F9,
+	BENCH_WIDE_FIELD_F10,
+	BENCH_WIDE_FIELD_F11,
+	BENCH_WIDE_FIELD_F12,
+	BENCH_WIDE_FIELD_F13,
+	BENCH_WIDE_FIELD_F14,
+	BENCH_WIDE_FIELD_F15,
+	BENCH_WIDE_FIELD_F16,
+	BENCH_WIDE_FIELD_F17,
+	BENCH_WIDE_FIELD_F18,
+	BENCH_WIDE_FIELD_F19,
+	BENCH_WIDE_FIELD_F20,
+	BENCH_WIDE_FIELD_F21,
+	BENCH_WIDE_FIELD_F22,
+	BENCH_WIDE_FIELD_F23,
+	BENCH_WIDE_FIELD_F24,
+	BENCH_WIDE_FIELD_F25,
+	BENCH_WIDE_FIELD_F26,
+	BENCH_WIDE_FIELD_F27,
+	BENCH_WIDE_FIELD_F28,
+	BENCH_WIDE_FIELD_F29,
+	BENCH_WIDE_FIELD_F30,
+	BENCH_WIDE_FIELD_F31,
+	BENCH_WIDE_FIELD_F32,
+	BENCH_WIDE_FIELD_F33,
+	BENCH_WIDE_FIELD_F34,
+	BENCH_WIDE_FIELD_F35,
+	BENCH_WIDE_FIELD_F36,
+	BENCH_WIDE_FIELD_F37,
+	BENCH_WIDE_FIELD_F38,
+	BENCH_WIDE_FIELD_F39,
+	BENCH_WIDE_FIELD_F40,
+	BENCH_WIDE_FIELD_F41,
+	BENCH_WIDE_FIELD_F42,
+	BENCH_WIDE_FIELD_F43,
+	BENCH_WIDE_FIELD_F44,
+	BENCH_WIDE_FIELD_F45,
+	BENCH_WIDE_FIELD_F46,
+	BENCH_WIDE_FIELD_F47,
+	BENCH_WIDE_FIELD_F48,
+	BENCH_WIDE_FIELD_F49,
+	BENCH_WIDE_FIELD_F50,
+	BENCH_WIDE_FIELD_F51,
+	BENCH_WIDE_FIELD_F52,
+	BENCH_WIDE_FIELD_F53,
+	BENCH_WIDE_FIELD_F54,
+	BENCH_WIDE_FIELD_F55,
+	BENCH_WIDE_FIELD_F56,
+	BENCH_WIDE_FIELD_F57,
+	BENCH_WIDE_FIELD_F58,
+	BENCH_WIDE_FIELD_F59,
+	BENCH_WIDE_FIELD_F60,
+	BENCH_WIDE_FIELD_F61,
+	BENCH_WIDE_FIELD_F62,
+	BENCH_WIDE_FIELD_F63,
+	BENCH_WIDE_FIELD_F64,
+};
+
+static const struct obus_field_desc bench_wide_info_fields[] = {
+	[BENCH_WIDE_FIELD_F1] = {
+		.uid = 1,
+		.name = "f1",
+		.offset = obus_offsetof(struct bench_wide_info, f1),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F2] = {
+		.uid = 2,
+		.name = "f2",
+		.offset = obus_offsetof(struct bench_wide_info, f2),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F3] = {
+		.uid = 3,
+		.name = "f3",
+		.offset = obus_offsetof(struct bench_wide_info, f3),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F4] = {
+		.uid = 4,
+		.name = "f4",
+		.offset = obus_offsetof(struct bench_wide_info, f4),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F5] = {
+		.uid = 5,
+		.name = "f5",
+		.offset = obus_offsetof(struct bench_wide_info, f5),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F6] = {
+		.uid = 6,
+		.name = "f6",
+		.offset = obus_offsetof(struct bench_wide_info, f6),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F7] = {
+		.uid = 7,
+		.name = "f7",
+		.offset = obus_offsetof(struct bench_wide_info, f7),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F8] = {
+		.uid = 8,
+		.name = "f8",
+		.offset = obus_offsetof(struct bench_wide_info, f8),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F9] = {
+		.uid = 9,
+		.name = "f9",
+		.offset = obus_offsetof(struct bench_wide_info, f9),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F10] = {
+		.uid = 10,
+		.name = "f10",
+		.offset = obus_offsetof(struct bench_wide_info, f10),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F11] = {
+		.uid = 11,
+		.name = "f11",
+		.offset = obus_offsetof(struct bench_wide_info, f11),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F12] = {
+		.uid = 12,
+		.name = "f12",
+		.offset = obus_offsetof(struct bench_wide_info, f12),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F13] = {
+		.uid = 13,
+		.name = "f13",
+		.offset = obus_offsetof(struct bench_wide_info, f13),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F14] = {
+		.uid = 14,
+		.name = "f14",
+		.offset = obus_offsetof(struct bench_wide_info, f14),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F15] = {
+		.uid = 15,
+		.name = "f15",
+		.offset = obus_offsetof(struct bench_wide_info, f15),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F16] = {
+		.uid = 16,
+		.name = "f16",
+		.offset = obus_offsetof(struct bench_wide_info, f16),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F17] = {
+		.uid = 17,
+		.name = "f17",
+		.offset = obus_offsetof(struct bench_wide_info, f17),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F18] = {
+		.uid = 18,
+		.name = "f18",
+		.offset = obus_offsetof(struct bench_wide_info, f18),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F19] = {
+		.uid = 19,
+		.name = "f19",
+		.offset = obus_offsetof(struct bench_wide_info, f19),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F20] = {
+		.uid = 20,
+		.name = "f20",
+		.offset = obus_offsetof(struct bench_wide_info, f20),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F21] = {
+		.uid = 21,
+		.name = "f21",
+		.offset = obus_offsetof(struct bench_wide_info, f21),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F22] = {
+		.uid = 22,
+		.name = "f22",
+		.offset = obus_offsetof(struct bench_wide_info, f22),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F23] = {
+		.uid = 23,
+		.name = "f23",
+		.offset = obus_offsetof(struct bench_wide_info, f23),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F24] = {
+		.uid = 24,
+		.name = "f24",
+		.offset = obus_offsetof(struct bench_wide_info, f24),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F25] = {
+		.uid = 25,
+		.name = "f25",
+		.offset = obus_offsetof(struct bench_wide_info, f25),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F26] = {
+		.uid = 26,
+		.name = "f26",
+		.offset = obus_offsetof(struct bench_wide_info, f26),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F27] = {
+		.uid = 27,
+		.name = "f27",
+		.offset = obus_offsetof(struct bench_wide_info, f27),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F28] = {
+		.uid = 28,
+		.name = "f28",
+		.offset = obus_offsetof(struct bench_wide_info, f28),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F29] = {
+		.uid = 29,
+		.name = "f29",
+		.offset = obus_offsetof(struct bench_wide_info, f29),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F30] = {
+		.uid = 30,
+		.name = "f30",
+		.offset = obus_offsetof(struct bench_wide_info, f30),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F31] = {
+		.uid = 31,
+		.name = "f31",
+		.offset = obus_offsetof(struct bench_wide_info, f31),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F32] = {
+		.uid = 32,
+		.name = "f32",
+		.offset = obus_offsetof(struct bench_wide_info, f32),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F33] = {
+		.uid = 33,
+		.name = "f33",
+		.offset = obus_offsetof(struct bench_wide_info, f33),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F34] = {
+		.uid = 34,
+		.name = "f34",
+		.offset = obus_offsetof(struct bench_wide_info, f34),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F35] = {
+		.uid = 35,
+		.name = "f35",
+		.offset = obus_offsetof(struct bench_wide_info, f35),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F36] = {
+		.uid = 36,
+		.name = "f36",
+		.offset = obus_offsetof(struct bench_wide_info, f36),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F37] = {
+		.uid = 37,
+		.name = "f37",
+		.offset = obus_offsetof(struct bench_wide_info, f37),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F38] = {
+		.uid = 38,
+		.name = "f38",
+		.offset = obus_offsetof(struct bench_wide_info, f38),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F39] = {
+		.uid = 39,
+		.name = "f39",
+		.offset = obus_offsetof(struct bench_wide_info, f39),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F40] = {
+		.uid = 40,
+		.name = "f40",
+		.offset = obus_offsetof(struct bench_wide_info, f40),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F41] = {
+		.uid = 41,
+		.name = "f41",
+		.offset = obus_offsetof(struct bench_wide_info, f41),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F42] = {
+		.uid = 42,
+		.name = "f42",
+		.offset = obus_offsetof(struct bench_wide_info, f42),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F43] = {
+		.uid = 43,
+		.name = "f43",
+		.offset = obus_offsetof(struct bench_wide_info, f43),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F44] = {
+		.uid = 44,
+		.name = "f44",
+		.offset = obus_offsetof(struct bench_wide_info, f44),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F45] = {
+		.uid = 45,
+		.name = "f45",
+		.offset = obus_offsetof(struct bench_wide_info, f45),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F46] = {
+		.uid = 46,
+		.name = "f46",
+		.offset = obus_offsetof(struct bench_wide_info, f46),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F47] = {
+		.uid = 47,
+		.name = "f47",
+		.offset = obus_offsetof(struct bench_wide_info, f47),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F48] = {
+		.uid = 48,
+		.name = "f48",
+		.offset = obus_offsetof(struct bench_wide_info, f48),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F49] = {
+		.uid = 49,
+		.name = "f49",
+		.offset = obus_offsetof(struct bench_wide_info, f49),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F50] = {
+		.uid = 50,
+		.name = "f50",
+		.offset = obus_offsetof(struct bench_wide_info, f50),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F51] = {
+		.uid = 51,
+		.name = "f51",
+		.offset = obus_offsetof(struct bench_wide_info, f51),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F52] = {
+		.uid = 52,
+		.name = "f52",
+		.offset = obus_offsetof(struct bench_wide_info, f52),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F53] = {
+		.uid = 53,
+		.name = "f53",
+		.offset = obus_offsetof(struct bench_wide_info, f53),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F54] = {
+		.uid = 54,
+		.name = "f54",
+		.offset = obus_offsetof(struct bench_wide_info, f54),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F55] = {
+		.uid = 55,
+		.name = "f55",
+		.offset = obus_offsetof(struct bench_wide_info, f55),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F56] = {
+		.uid = 56,
+		.name = "f56",
+		.offset = obus_offsetof(struct bench_wide_info, f56),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F57] = {
+		.uid = 57,
+		.name = "f57",
+		.offset = obus_offsetof(struct bench_wide_info, f57),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F58] = {
+		.uid = 58,
+		.name = "f58",
+		.offset = obus_offsetof(struct bench_wide_info, f58),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F59] = {
+		.uid = 59,
+		.name = "f59",
+		.offset = obus_offsetof(struct bench_wide_info, f59),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F60] = {
+		.uid = 60,
+		.name = "f60",
+		.offset = obus_offsetof(struct bench_wide_info, f60),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F61] = {
+		.uid = 61,
+		.name = "f61",
+		.offset = obus_offsetof(struct bench_wide_info, f61),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F62] = {
+		.uid = 62,
+		.name = "f62",
+		.offset = obus_offsetof(struct bench_wide_info, f62),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F63] = {
+		.uid = 63,
+		.name = "f63",
+		.offset = obus_offsetof(struct bench_wide_info, f63),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+	[BENCH_WIDE_FIELD_F64] = {
+		.uid = 64,
+		.name = "f64",
+		.offset = obus_offsetof(struct bench_wide_info, f64),
+		.role = OBUS_PROPERTY,
+		.type = OBUS_FIELD_U32,
+	},
+
+};
+
+static const uint16_t bench_wide_info_uids[] = {
+	[1] = BENCH_WIDE_FIELD_F1 + 1,
+	[2] = BENCH_WIDE_FIELD_F2 + 1,
+	[3] = BENCH_WIDE_FIELD_F3 + 1,
+	[4] = BENCH_WIDE_FIELD_F4 + 1,
+	[5] = BENCH_WIDE_FIELD_F5 + 1,
+	[6] = BENCH_WIDE_FIELD_F6 + 1,
+	[7] = BENCH_WIDE_FIELD_F7 + 1,
+	[8] = BENCH_WIDE_FIELD_F8 + 1,
+	[9] = BENCH_WIDE_FIELD_F9 + 1,
+	[10] = BENCH_WIDE_FIELD_F10 + 1,
+	[11] = BENCH_WIDE_FIELD_F11 + 1,
+	[12] = BENCH_WIDE_FIELD_F12 + 1,
+	[13] = BENCH_WIDE_FIELD_F13 + 1,
+	[14] = BENCH_WIDE_FIELD_F14 + 1,
+	[15] = BENCH_WIDE_FIELD_F15 + 1,
+	[16] = BENCH_WIDE_FIELD_F16 + 1,
+	[17] = BENCH_WIDE_FIELD_F17 + 1,
+	[18] = BENCH_WIDE_FIELD_F18 + 1,
+	[19] = BENCH_WIDE_FIELD_F19 + 1,
+	[20] = BENCH_WIDE_FIELD_F20 + 1,
+	[21] = BENCH_WIDE_FIELD_F21 + 1,
+	[22] = BENCH_WIDE_FIELD_F22 + 1,
+	[23] = BENCH_WIDE_FIELD_F23 + 1,
+	[24] = BENCH_WIDE_FIELD_F24 + 1,
+	[25] = BENCH_WIDE_FIELD_F25 + 1,
+	[26] = BENCH_WIDE_FIELD_F26 + 1,
+	[27] = BENCH_WIDE_FIELD_F27 + 1,
+	[28] = BENCH_WIDE_FIELD_F28 + 1,
+	[29] = BENCH_WIDE_FIELD_F29 + 1,
+	[30] = BENCH_WIDE_FIELD_F30 + 1,
+	[31] = BENCH_WIDE_FIELD_F31 + 1,
+	[32] = BENCH_WIDE_FIELD_F32 + 1,
+	[33] = BENCH_WIDE_FIELD_F33 + 1,
+	[34] = BENCH_WIDE_FIELD_F34 + 1,
+	[35] = BENCH_WIDE_FIELD_F35 + 1,
+	[36] = BENCH_WIDE_FIELD_F36 + 1,
+	[37] = BENCH_WIDE_FIELD_F37 + 1,
+	[38] = BENCH_WIDE_FIELD_F38 + 1,
+	[39] = BENCH_WIDE_FIELD_F39 + 1,
+	[40] = BENCH_WIDE_FIELD_F40 + 1,
+	[41] = BENCH_WIDE_FIELD_F41 + 1,
+	[42] = BENCH_WIDE_FIELD_F42 + 1,
+	[43] = BENCH_WIDE_FIELD_F43 + 1,
+	[44] = BENCH_WIDE_FIELD_F44 + 1,
+	[45] = BENCH_WIDE_FIELD_F45 + 1,
+	[46] = BENCH_WIDE_FIELD_F46 + 1,
+	[47] = BENCH_WIDE_FIELD_F47 + 1,
+	[48] = BENCH_WIDE_FIELD_F48 + 1,
+	[49] = BENCH_WIDE_FIELD_F49 + 1,
+	[50] = BENCH_WIDE_FIELD_F50 + 1,
+	[51] = BENCH_WIDE_FIELD_F51 + 1,
+	[52] = BENCH_WIDE_FIELD_F52 + 1,
+	[53] = BENCH_WIDE_FIELD_F53 + 1,
+	[54] = BENCH_WIDE_FIELD_F54 + 1,
+	[55] = BENCH_WIDE_FIELD_F55 + 1,
+	[56] = BENCH_WIDE_FIELD_F56 + 1,
+	[57] = BENCH_WIDE_FIELD_F57 + 1,
+	[58] = BENCH_WIDE_FIELD_F58 + 1,
+	[59] = BENCH_WIDE_FIELD_F59 + 1,
+	[60] = BENCH_WIDE_FIELD_F60 + 1,
+	[61] = BENCH_WIDE_FIELD_F61 + 1,
+	[62] = BENCH_WIDE_FIELD_F62 + 1,
+	[63] = BENCH_WIDE_FIELD_F63 + 1,
+	[64] = BENCH_WIDE_FIELD_F64 + 1,
+};
+
+static size_t bench_wide_info_encoded_size(const struct obus_struct *st)
+{
+	const struct bench_wide_info *info = st->u.const_addr;
+	size_t size = 2;
+
+	if (info->fields.f1)
+		size += 3 + 4;
+	if (info->fields.f2)
+		size += 3 + 4;
+	if (info->fields.f3)
+		size += 3 + 4;
+	if (info->fields.f4)
+		size += 3 + 4;
+	if (info->fields.f5)
+		size += 3 + 4;
+	if (info->fields.f6)
+		size += 3 + 4;
+	if (info->fields.f7)
+		size += 3 + 4;
+	if (info->fields.f8)
+		size += 3 + 4;
+	if (info->fields.f9)
+		size += 3 + 4;
+	if (info->fields.f10)
+		size += 3 + 4;
+	if (info->fields.f11)
+		size += 3 + 4;
+	if (info->fields.f12)
+		size += 3 + 4;
+	if (info->fields.f13)
+		size += 3 + 4;
+	if (info->fields.f14)
+		size += 3 + 4;
+	if (info->fields.f15)
+		size += 3 + 4;
+	if (info->fields.f16)
+		size += 3 + 4;
+	if (info->fields.f17)
+		size += 3 + 4;
+	if (info->fields.f18)
+		size += 3 + 4;
+	if (info->fields.f19)
+		size += 3 + 4;
+	if (info->fields.f20)
+		size += 3 + 4;
+	if (info->fields.f21)
+		size += 3 + 4;
+	if (info->fields.f22)
+		size += 3 + 4;
+	if (info->fields.f23)
+		size += 3 + 4;
+	if (info->fields.f24)
+		size += 3 + 4;
+	if (info->fields.f25)
+		size += 3 + 4;
+	if (info->fields.f26)
+		size += 3 + 4;
+	if (info->fields.f27)
+		size += 3 + 4;
+	if (info->fields.f28)
+		size += 3 + 4;
+	if (info->fields.f29)
+		size += 3 + 4;
+	if (info->fields.f30)
+		size += 3 + 4;
+	if (info->fields.f31)
+		size += 3 + 4;
+	if (info->fields.f32)
+		size += 3 + 4;
+	if (info->fields.f33)
+		size += 3 + 4;
+	if (info->fields.f34)
+		size += 3 + 4;
+	if (info->fields.f35)
+		size += 3 + 4;
+	if (info->fields.f36)
+		size += 3 + 4;
+	if (info->fields.f37)
+		size += 3 + 4;
+	if (info->fields.f38)
+		size += 3 + 4;
+	if (info->fields.f39)
+		size += 3 + 4;
+	if (info->fields.f40)
+		size += 3 + 4;
+	if (info->fields.f41)
+		size += 3 + 4;
+	if (info->fields.f42)
+		size += 3 + 4;
+	if (info->fields.f43)
+		size += 3 + 4;
+	if (info->fields.f44)
+		size += 3 + 4;
+	if (info->fields.f45)
+		size += 3 + 4;
+	if (info->fields.f46)
+		size += 3 + 4;
+	if (info->fields.f47)
+		size += 3 + 4;
+	if (info->fields.f48)
+		size += 3 + 4;
+	if (info->fields.f49)
+		size += 3 + 4;
+	if (info->fields.f50)
+		size += 3 + 4;
+	if (info->fields.f51)
+		size += 3 + 4;
+	if (info->fields.f52)
+		size += 3 + 4;
+	if (info->fields.f53)
+		size += 3 + 4;
+	if (info->fields.f54)
+		size += 3 + 4;
+	if (info->fields.f55)
+		size += 3 + 4;
+	if (info->fields.f56)
+		size += 3 + 4;
+	if (info->fields.f57)
+		size += 3 + 4;
+	if (info->fields.f58)
+		size += 3 + 4;
+	if (info->fields.f59)
+		size += 3 + 4;
+	if (info->fields.f60)
+		size += 3 + 4;
+	if (info->fields.f61)
+		size += 3 + 4;
+	if (info->fields.f62)
+		size += 3 + 4;
+	if (info->fields.f63)
+		size += 3 + 4;
+	if (info->fields.f64)
+		size += 3 + 4;
+
+	return size;
+}
+
+static size_t bench_wide_info_encode(const struct obus_struct *st, uint8_t *ptr)
+{
+	const struct bench_wide_info *info = st->u.const_addr;
+	uint8_t *p = ptr + 2;
+	uint16_t n_fields = 0;
+
+	if (info->fields.f1) {
+		p = obus_put_u16(p, 1);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f1);
+		n_fields++;
+	}
+	if (info->fields.f2) {
+		p = obus_put_u16(p, 2);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f2);
+		n_fields++;
+	}
+	if (info->fields.f3) {
+		p = obus_put_u16(p, 3);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f3);
+		n_fields++;
+	}
+	if (info->fields.f4) {
+		p = obus_put_u16(p, 4);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f4);
+		n_fields++;
+	}
+	if (info->fields.f5) {
+		p = obus_put_u16(p, 5);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f5);
+		n_fields++;
+	}
+	if (info->fields.f6) {
+		p = obus_put_u16(p, 6);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f6);
+		n_fields++;
+	}
+	if (info->fields.f7) {
+		p = obus_put_u16(p, 7);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f7);
+		n_fields++;
+	}
+	if (info->fields.f8) {
+		p = obus_put_u16(p, 8);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f8);
+		n_fields++;
+	}
+	if (info->fields.f9) {
+		p = obus_put_u16(p, 9);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f9);
+		n_fields++;
+	}
+	if (info->fields.f10) {
+		p = obus_put_u16(p, 10);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f10);
+		n_fields++;
+	}
+	if (info->fields.f11) {
+		p = obus_put_u16(p, 11);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f11);
+		n_fields++;
+	}
+	if (info->fields.f12) {
+		p = obus_put_u16(p, 12);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f12);
+		n_fields++;
+	}
+	if (info->fields.f13) {
+		p = obus_put_u16(p, 13);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f13);
+		n_fields++;
+	}
+	if (info->fields.f14) {
+		p = obus_put_u16(p, 14);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f14);
+		n_fields++;
+	}
+	if (info->fields.f15) {
+		p = obus_put_u16(p, 15);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f15);
+		n_fields++;
+	}
+	if (info->fields.f16) {
+		p = obus_put_u16(p, 16);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f16);
+		n_fields++;
+	}
+	if (info->fields.f17) {
+		p = obus_put_u16(p, 17);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f17);
+		n_fields++;
+	}
+	if (info->fields.f18) {
+		p = obus_put_u16(p, 18);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f18);
+		n_fields++;
+	}
+	if (info->fields.f19) {
+		p = obus_put_u16(p, 19);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f19);
+		n_fields++;
+	}
+	if (info->fields.f20) {
+		p = obus_put_u16(p, 20);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f20);
+		n_fields++;
+	}
+	if (info->fields.f21) {
+		p = obus_put_u16(p, 21);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f21);
+		n_fields++;
+	}
+	if (info->fields.f22) {
+		p = obus_put_u16(p, 22);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f22);
+		n_fields++;
+	}
+	if (info->fields.f23) {
+		p = obus_put_u16(p, 23);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f23);
+		n_fields++;
+	}
+	if (info->fields.f24) {
+		p = obus_put_u16(p, 24);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f24);
+		n_fields++;
+	}
+	if (info->fields.f25) {
+		p = obus_put_u16(p, 25);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f25);
+		n_fields++;
+	}
+	if (info->fields.f26) {
+		p = obus_put_u16(p, 26);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f26);
+		n_fields++;
+	}
+	if (info->fields.f27) {
+		p = obus_put_u16(p, 27);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f27);
+		n_fields++;
+	}
+	if (info->fields.f28) {
+		p = obus_put_u16(p, 28);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f28);
+		n_fields++;
+	}
+	if (info->fields.f29) {
+		p = obus_put_u16(p, 29);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f29);
+		n_fields++;
+	}
+	if (info->fields.f30) {
+		p = obus_put_u16(p, 30);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f30);
+		n_fields++;
+	}
+	if (info->fields.f31) {
+		p = obus_put_u16(p, 31);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f31);
+		n_fields++;
+	}
+	if (info->fields.f32) {
+		p = obus_put_u16(p, 32);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f32);
+		n_fields++;
+	}
+	if (info->fields.f33) {
+		p = obus_put_u16(p, 33);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f33);
+		n_fields++;
+	}
+	if (info->fields.f34) {
+		p = obus_put_u16(p, 34);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f34);
+		n_fields++;
+	}
+	if (info->fields.f35) {
+		p = obus_put_u16(p, 35);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f35);
+		n_fields++;
+	}
+	if (info->fields.f36) {
+		p = obus_put_u16(p, 36);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f36);
+		n_fields++;
+	}
+	if (info->fields.f37) {
+		p = obus_put_u16(p, 37);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f37);
+		n_fields++;
+	}
+	if (info->fields.f38) {
+		p = obus_put_u16(p, 38);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f38);
+		n_fields++;
+	}
+	if (info->fields.f39) {
+		p = obus_put_u16(p, 39);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f39);
+		n_fields++;
+	}
+	if (info->fields.f40) {
+		p = obus_put_u16(p, 40);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f40);
+		n_fields++;
+	}
+	if (info->fields.f41) {
+		p = obus_put_u16(p, 41);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f41);
+		n_fields++;
+	}
+	if (info->fields.f42) {
+		p = obus_put_u16(p, 42);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f42);
+		n_fields++;
+	}
+	if (info->fields.f43) {
+		p = obus_put_u16(p, 43);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f43);
+		n_fields++;
+	}
+	if (info->fields.f44) {
+		p = obus_put_u16(p, 44);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f44);
+		n_fields++;
+	}
+	if (info->fields.f45) {
+		p = obus_put_u16(p, 45);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f45);
+		n_fields++;
+	}
+	if (info->fields.f46) {
+		p = obus_put_u16(p, 46);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f46);
+		n_fields++;
+	}
+	if (info->fields.f47) {
+		p = obus_put_u16(p, 47);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f47);
+		n_fields++;
+	}
+	if (info->fields.f48) {
+		p = obus_put_u16(p, 48);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f48);
+		n_fields++;
+	}
+	if (info->fields.f49) {
+		p = obus_put_u16(p, 49);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f49);
+		n_fields++;
+	}
+	if (info->fields.f50) {
+		p = obus_put_u16(p, 50);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f50);
+		n_fields++;
+	}
+	if (info->fields.f51) {
+		p = obus_put_u16(p, 51);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f51);
+		n_fields++;
+	}
+	if (info->fields.f52) {
+		p = obus_put_u16(p, 52);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f52);
+		n_fields++;
+	}
+	if (info->fields.f53) {
+		p = obus_put_u16(p, 53);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f53);
+		n_fields++;
+	}
+	if (info->fields.f54) {
+		p = obus_put_u16(p, 54);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f54);
+		n_fields++;
+	}
+	if (info->fields.f55) {
+		p = obus_put_u16(p, 55);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f55);
+		n_fields++;
+	}
+	if (info->fields.f56) {
+		p = obus_put_u16(p, 56);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f56);
+		n_fields++;
+	}
+	if (info->fields.f57) {
+		p = obus_put_u16(p, 57);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f57);
+		n_fields++;
+	}
+	if (info->fields.f58) {
+		p = obus_put_u16(p, 58);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f58);
+		n_fields++;
+	}
+	if (info->fields.f59) {
+		p = obus_put_u16(p, 59);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f59);
+		n_fields++;
+	}
+	if (info->fields.f60) {
+		p = obus_put_u16(p, 60);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f60);
+		n_fields++;
+	}
+	if (info->fields.f61) {
+		p = obus_put_u16(p, 61);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f61);
+		n_fields++;
+	}
+	if (info->fields.f62) {
+		p = obus_put_u16(p, 62);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f62);
+		n_fields++;
+	}
+	if (info->fields.f63) {
+		p = obus_put_u16(p, 63);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f63);
+		n_fields++;
+	}
+	if (info->fields.f64) {
+		p = obus_put_u16(p, 64);
+		p = obus_put_u8(p, OBUS_FIELD_U32);
+		p = obus_put_u32(p, (uint32_t)info->f64);
+		n_fields++;
+	}
+
+	obus_put_u16(ptr, n_fields);
+	return (size_t)(p - ptr);
+}
+
+static size_t bench_wide_info_decode_field(const struct obus_struct *st,
+		uint16_t uid, uint8_t type, const uint8_t *ptr, size_t len)
+{
+	struct bench_wide_info *info = st->u.addr;
+
+	switch (uid) {
+	case 1:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f1 = obus_get_u32(ptr);
+		return 4;
+	case 2:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f2 = obus_get_u32(ptr);
+		return 4;
+	case 3:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f3 = obus_get_u32(ptr);
+		return 4;
+	case 4:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f4 = obus_get_u32(ptr);
+		return 4;
+	case 5:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f5 = obus_get_u32(ptr);
+		return 4;
+	case 6:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f6 = obus_get_u32(ptr);
+		return 4;
+	case 7:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f7 = obus_get_u32(ptr);
+		return 4;
+	case 8:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f8 = obus_get_u32(ptr);
+		return 4;
+	case 9:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f9 = obus_get_u32(ptr);
+		return 4;
+	case 10:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f10 = obus_get_u32(ptr);
+		return 4;
+	case 11:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f11 = obus_get_u32(ptr);
+		return 4;
+	case 12:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f12 = obus_get_u32(ptr);
+		return 4;
+	case 13:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f13 = obus_get_u32(ptr);
+		return 4;
+	case 14:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f14 = obus_get_u32(ptr);
+		return 4;
+	case 15:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f15 = obus_get_u32(ptr);
+		return 4;
+	case 16:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f16 = obus_get_u32(ptr);
+		return 4;
+	case 17:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f17 = obus_get_u32(ptr);
+		return 4;
+	case 18:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f18 = obus_get_u32(ptr);
+		return 4;
+	case 19:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f19 = obus_get_u32(ptr);
+		return 4;
+	case 20:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f20 = obus_get_u32(ptr);
+		return 4;
+	case 21:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f21 = obus_get_u32(ptr);
+		return 4;
+	case 22:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f22 = obus_get_u32(ptr);
+		return 4;
+	case 23:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f23 = obus_get_u32(ptr);
+		return 4;
+	case 24:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f24 = obus_get_u32(ptr);
+		return 4;
+	case 25:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f25 = obus_get_u32(ptr);
+		return 4;
+	case 26:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f26 = obus_get_u32(ptr);
+		return 4;
+	case 27:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f27 = obus_get_u32(ptr);
+		return 4;
+	case 28:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f28 = obus_get_u32(ptr);
+		return 4;
+	case 29:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f29 = obus_get_u32(ptr);
+		return 4;
+	case 30:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f30 = obus_get_u32(ptr);
+		return 4;
+	case 31:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f31 = obus_get_u32(ptr);
+		return 4;
+	case 32:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f32 = obus_get_u32(ptr);
+		return 4;
+	case 33:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f33 = obus_get_u32(ptr);
+		return 4;
+	case 34:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f34 = obus_get_u32(ptr);
+		return 4;
+	case 35:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f35 = obus_get_u32(ptr);
+		return 4;
+	case 36:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f36 = obus_get_u32(ptr);
+		return 4;
+	case 37:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f37 = obus_get_u32(ptr);
+		return 4;
+	case 38:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f38 = obus_get_u32(ptr);
+		return 4;
+	case 39:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f39 = obus_get_u32(ptr);
+		return 4;
+	case 40:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f40 = obus_get_u32(ptr);
+		return 4;
+	case 41:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f41 = obus_get_u32(ptr);
+		return 4;
+	case 42:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f42 = obus_get_u32(ptr);
+		return 4;
+	case 43:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f43 = obus_get_u32(ptr);
+		return 4;
+	case 44:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f44 = obus_get_u32(ptr);
+		return 4;
+	case 45:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f45 = obus_get_u32(ptr);
+		return 4;
+	case 46:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f46 = obus_get_u32(ptr);
+		return 4;
+	case 47:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f47 = obus_get_u32(ptr);
+		return 4;
+	case 48:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f48 = obus_get_u32(ptr);
+		return 4;
+	case 49:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f49 = obus_get_u32(ptr);
+		return 4;
+	case 50:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f50 = obus_get_u32(ptr);
+		return 4;
+	case 51:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f51 = obus_get_u32(ptr);
+		return 4;
+	case 52:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f52 = obus_get_u32(ptr);
+		return 4;
+	case 53:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f53 = obus_get_u32(ptr);
+		return 4;
+	case 54:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f54 = obus_get_u32(ptr);
+		return 4;
+	case 55:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f55 = obus_get_u32(ptr);
+		return 4;
+	case 56:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f56 = obus_get_u32(ptr);
+		return 4;
+	case 57:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f57 = obus_get_u32(ptr);
+		return 4;
+	case 58:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f58 = obus_get_u32(ptr);
+		return 4;
+	case 59:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f59 = obus_get_u32(ptr);
+		return 4;
+	case 60:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f60 = obus_get_u32(ptr);
+		return 4;
+	case 61:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f61 = obus_get_u32(ptr);
+		return 4;
+	case 62:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f62 = obus_get_u32(ptr);
+		return 4;
+	case 63:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f63 = obus_get_u32(ptr);
+		return 4;
+	case 64:
+		if (type != OBUS_FIELD_U32 || len < 4)
+			return 0;
+		info->f64 = obus_get_u32(ptr);
+		return 4;
+	default:
+		/* strings, arrays & unknown fields use generic decoder */
+		return 0;
+	}
+}
+
+static const struct obus_struct_desc bench_wide_info_desc = {
+	.size = sizeof(struct bench_wide_info),
+	.fields_offset = obus_offsetof(struct bench_wide_info, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(bench_wide_info_fields),
+	.fields = bench_wide_info_fields,
+	.uids = bench_wide_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(bench_wide_info_uids),
+	.encoded_size = bench_wide_info_encoded_size,
+	.encode = bench_wide_info_encode,
+	.decode_field = bench_wide_info_decode_field,
+};
+
+static const struct obus_event_update_desc event_changed_updates[] = {
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F1],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F2],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F3],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F4],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F5],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F6],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F7],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F8],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F9],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F10],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F11],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F12],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F13],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F14],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F15],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F16],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F17],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F18],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F19],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F20],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F21],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F22],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F23],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F24],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F25],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F26],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F27],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F28],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F29],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F30],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F31],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F32],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F33],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F34],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F35],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F36],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F37],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F38],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F39],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F40],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F41],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F42],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F43],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F44],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F45],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F46],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F47],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F48],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F49],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F50],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F51],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F52],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F53],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F54],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F55],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F56],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F57],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F58],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F59],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F60],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F61],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F62],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F63],
+		.flags = 0,
+	}
+
+,
+	{
+		.field = &bench_wide_info_fields[BENCH_WIDE_FIELD_F64],
+		.flags = 0,
+	}
+
+};
+
+static const struct obus_event_desc bench_wide_events_desc[] = {
+	{
+		.uid = 1,
+		.name = "changed",
+		.updates = event_changed_updates,
+		.n_updates = OBUS_SIZEOF_ARRAY(event_changed_updates),
+	}
+
+};
+
+const char *bench_wide_event_type_str(enum bench_wide_event_type type)
+{
+	if(type >= OBUS_SIZEOF_ARRAY(bench_wide_events_desc))
+		return "???";
+
+	return bench_wide_events_desc[type].name;
+}
+
+const struct obus_object_desc bench_wide_desc = {
+	.uid = BENCH_WIDE_UID,
+	.name = "wide",
+	.info_desc = &bench_wide_info_desc,
+	.n_events = OBUS_SIZEOF_ARRAY(bench_wide_events_desc),
+	.events = bench_wide_events_desc,
+	.n_methods = 0,
+	.methods = NULL,
+};
+
+void bench_wide_info_init(struct bench_wide_info *info)
+{
+	if (info)
+		memset(info, 0, sizeof(*info));
+}
+
+
+int bench_wide_info_is_empty(const struct bench_wide_info *info)
+{
+	return 	info &&
+		!info->fields.f1 &&
+		!info->fields.f2 &&
+		!info->fields.f3 &&
+		!info->fields.f4 &&
+		!info->fields.f5 &&
+		!info->fields.f6 &&
+		!info->fields.f7 &&
+		!info->fields.f8 &&
+		!info->fields.f9 &&
+		!info->fields.f10 &&
+		!info->fields.f11 &&
+		!info->fields.f12 &&
+		!info->fields.f13 &&
+		!info->fields.f14 &&
+		!info->fields.f15 &&
+		!info->fields.f16 &&
+		!info->fields.f17 &&
+		!info->fields.f18 &&
+		!info->fields.f19 &&
+		!info->fields.f20 &&
+		!info->fields.f21 &&
+		!info->fields.f22 &&
+		!info->fields.f23 &&
+		!info->fields.f24 &&
+		!info->fields.f25 &&
+		!info->fields.f26 &&
+		!info->fields.f27 &&
+		!info->fields.f28 &&
+		!info->fields.f29 &&
+		!info->fields.f30 &&
+		!info->fields.f31 &&
+		!info->fields.f32 &&
+		!info->fields.f33 &&
+		!info->fields.f34 &&
+		!info->fields.f35 &&
+		!info->fields.f36 &&
+		!info->fields.f37 &&
+		!info->fields.f38 &&
+		!info->fields.f39 &&
+		!info->fields.f40 &&
+		!info->fields.f41 &&
+		!info->fields.f42 &&
+		!info->fields.f43 &&
+		!info->fields.f44 &&
+		!info->fields.f45 &&
+		!info->fields.f46 &&
+		!info->fields.f47 &&
+		!info->fields.f48 &&
+		!info->fields.f49 &&
+		!info->fields.f50 &&
+		!info->fields.f51 &&
+		!info->fields.f52 &&
+		!info->fields.f53 &&
+		!info->fields.f54 &&
+		!info->fields.f55 &&
+		!info->fields.f56 &&
+		!info->fields.f57 &&
+		!info->fields.f58 &&
+		!info->fields.f59 &&
+		!info->fields.f60 &&
+		!info->fields.f61 &&
+		!info->fields.f62 &&
+		!info->fields.f63 &&
+		!info->fields.f64;
+}
+
+static inline struct bench_wide *
+bench_wide_from_object(struct obus_object *object)
+{
+	const struct obus_object_desc *desc;
+
+	if (!object)
+		return NULL;
+
+	desc = obus_object_get_desc(object);
+	if (desc != &bench_wide_desc)
+		return NULL;
+
+	return (struct bench_wide *)object;
+}
+
+static inline struct obus_object *
+bench_wide_object(struct bench_wide *object)
+{
+	struct obus_object *obj;
+
+	obj = (struct obus_object *)object;
+	if (bench_wide_from_object(obj) != object)
+		return NULL;
+
+	return (struct obus_object *)object;
+}
+
+static inline const struct obus_object *
+bench_wide_const_object(const struct bench_wide *object)
+{
+	const struct obus_object *obj;
+
+	obj = (const struct obus_object *)object;
+	if (obus_object_get_desc(obj) != &bench_wide_desc)
+		return NULL;
+
+	return obj;
+}
+
+struct bench_wide *
+bench_wide_new(struct obus_server *srv, const struct bench_wide_info *info)
+{
+	obus_method_handler_cb_t *cbs = NULL;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_wide_desc.info_desc
+	};
+
+
+	return (struct bench_wide*)obus_server_new_object(srv, &bench_wide_desc, cbs, info ? &st : NULL);
+}
+
+int bench_wide_destroy(struct bench_wide *object)
+{
+	return obus_object_destroy(bench_wide_object(object));
+}
+
+int bench_wide_register(struct obus_server *server, struct bench_wide *object)
+{
+	struct obus_object *obj = (struct obus_object *)object;
+	return obus_server_register_object(server, obj);
+}
+int bench_wide_unregister(struct obus_server *server, struct bench_wide *object)
+{
+	struct obus_object *obj = (struct obus_object *)object;
+	return obus_server_unregister_object(server, obj);
+}
+int bench_wide_is_registered(const struct bench_wide *object)
+{
+	const struct obus_object *obj = (const struct obus_object *)object;
+	return obus_object_is_registered(obj);
+}
+
+const struct bench_wide_info *
+bench_wide_get_info(const struct bench_wide *object)
+{
+	return (const struct bench_wide_info *)obus_object_get_info(bench_wide_const_object(object));
+}
+
+void bench_wide_log(const struct bench_wide *object, enum obus_log_level level)
+{
+	obus_object_log(bench_wide_const_object(object), level);
+}
+
+int bench_wide_set_user_data(struct bench_wide *object, void *user_data)
+{
+	return obus_object_set_user_data(bench_wide_object(object), user_data);
+}
+
+void *bench_wide_get_user_data(const struct bench_wide *object)
+{
+	return obus_object_get_user_data(bench_wide_const_object(object));
+}
+
+obus_handle_t bench_wide_get_handle(const struct bench_wide *object)
+{
+	return obus_object_get_handle(bench_wide_const_object(object));
+}
+
+struct bench_wide *
+bench_wide_from_handle(struct obus_server *server, obus_handle_t handle)
+{
+	struct obus_object *obj;
+
+	obj = obus_server_get_object(server, handle);	return bench_wide_from_object(obj);
+}
+
+struct bench_wide *
+bench_wide_next(struct obus_server *server, struct bench_wide *previous)
+{
+	struct obus_object *next, *prev;
+
+	prev = (struct obus_object *)previous;
+	next = obus_server_object_next(server, prev, bench_wide_desc.uid);
+	return bench_wide_from_object(next);
+}
+
+int bench_wide_send_event(struct obus_server *server, struct bench_wide *object, enum bench_wide_event_type type, const struct bench_wide_info *info)
+{
+	int ret;
+	struct obus_event event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_wide_desc.info_desc
+	};
+
+	if (!object || !server || type >= BENCH_WIDE_EVENT_COUNT)
+		return -EINVAL;
+
+	ret = obus_event_init(&event, bench_wide_object(object), &bench_wide_events_desc[type], &st);
+	if (ret < 0)
+		return ret;
+
+	return obus_server_send_event(server, &event);
+}
+
+
+int bench_wide_submit_event(struct obus_server *server, struct bench_wide *object, enum bench_wide_event_type type, const struct bench_wide_info *info)
+{
+	int ret;
+	struct obus_event *event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_wide_desc.info_desc
+	};
+
+	if (!object || !server || type >= BENCH_WIDE_EVENT_COUNT)
+		return -EINVAL;
+
+	event = obus_event_new(bench_wide_object(object), &bench_wide_events_desc[type], &st);
+	if (!event)
+		return -ENOMEM;
+
+	ret = obus_server_submit_event(server, event);
+	if (ret < 0)
+		obus_event_destroy(event);
+
+	return ret;
+}
+
+int bench_bus_event_add_wide_event(struct bench_bus_event *bus_event, struct bench_wide *object, enum bench_wide_event_type type, const struct bench_wide_info *info)
+{
+	int ret;
+	struct obus_event *event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = bench_wide_desc.info_desc
+	};
+
+	if (!object || !bus_event || type >= BENCH_WIDE_EVENT_COUNT)
+		return -EINVAL;
+
+	event = obus_event_new(bench_wide_object(object), &bench_wide_events_desc[type], &st);
+	if (!event)
+		return -ENOMEM;
+
+	ret = obus_bus_event_add_event((struct obus_bus_event *)bus_event, event);
+	if (ret < 0)
+		obus_event_destroy(event);
+
+	return ret;
+}
+
+int bench_bus_event_register_wide(struct bench_bus_event *bus_event, struct bench_wide *object)
+{
+	return obus_bus_event_register_object((struct obus_bus_event *)bus_event, bench_wide_object(object));
+}
+
+int bench_bus_event_unregister_wide(struct bench_bus_event *bus_event, struct bench_wide *object)
+{
+	return obus_bus_event_unregister_object((struct obus_bus_event *)bus_event, bench_wide_object(object));
+}
+
@@ -0,0 +1,648 @@
+/**
+ * @file bench_wide.h
+ *
+ * @brief obus bench_wide object server api
+ *
+ * @author obusgen 1.0.3 generated file, do not modify it.
+ */
+#ifndef _BENCH_WIDE_H_
+#define _BENCH_WIDE_H_
+
+#include "libobus.h"
+
+OBUS_BEGIN_DECLS
+
+/**
+ * @brief bench_wide object uid
+ **/
+#define BENCH_WIDE_UID 2
+
+/**
+ * @brief bench_wide event type enumeration.
+ *
+ * This enumeration describes all kind of bench_wide events.
+ **/
+enum bench_wide_event_type {
+	/** Wide object changed */
+	BENCH_WIDE_EVENT_CHANGED = 0,
+	/** for internal use only*/
+	BENCH_WIDE_EVENT_COUNT,
+};
+
+/**
+ * @brief get bench_wide_event_type string value.
+ *
+ * @param[in]  type  event type to be converted into string.
+ *
+ * @retval non NULL constant string value.
+ **/
+const char *bench_wide_event_type_str(enum bench_wide_event_type type);
+
+/**
+ * @brief bench_wide object structure
+ *
+ * This opaque structure represent an bench_wide object.
+ **/
+struct bench_wide;
+
+/**
+ * @brief bench bus event structure
+ *
+ * This opaque structure represent an bench bus event.
+ **/
+struct bench_bus_event;
+
+/**
+ * @brief bench_wide object info fields structure.
+ *
+ * This structure contains a presence bit for each fields
+ * (property or method state) in bench_wide object.
+ * When a bit is set, the corresponding field in
+ * @ref bench_wide_info structure must be taken into account.
+ **/
+struct bench_wide_info_fields {
+	/** f1 field presence bit */
+	unsigned int f1:1;
+	/** f2 field presence bit */
+	unsigned int f2:1;
+	/** f3 field presence bit */
+	unsigned int f3:1;
+	/** f4 field presence bit */
+	unsigned int f4:1;
+	/** f5 field presence bit */
+	unsigned int f5:1;
+	/** f6 field presence bit */
+	unsigned int f6:1;
+	/** f7 field presence bit */
+	unsigned int f7:1;
+	/** f8 field presence bit */
+	unsigned int f8:1;
+	/** f9 field presence bit */
+	unsigned int f9:1;
+	/** f10 field presence bit */
+	unsigned int f10:1;
+	/** f11 field presence bit */
+	unsigned int f11:1;
+	/** f12 field presence bit */
+	unsigned int f12:1;
+	/** f13 field presence bit */
+	unsigned int f13:1;
+	/** f14 field presence bit */
+	unsigned int f14:1;
+	/** f15 field presence bit */
+	unsigned int f15:1;
+	/** f16 field presence bit */
+	unsigned int f16:1;
+	/** f17 field presence bit */
+	unsigned int f17:1;
+	/** f18 field presence bit */
+	unsigned int f18:1;
+	/** f19 field presence bit */
+	unsigned int f19:1;
+	/** f20 field presence bit */
+	unsigned int f20:1;
+	/** f21 field presence bit */
+	unsigned int f21:1;
+	/** f22 field presence bit */
+	unsigned int f22:1;
+	/** f23 field presence bit */
+	unsigned int f23:1;
+	/** f24 field presence bit */
+	unsigned int f24:1;
+	/** f25 field presence bit */
+	unsigned int f25:1;
+	/** f26 field presence bit */
+	unsigned int f26:1;
+	/** f27 field presence bit */
+	unsigned int f27:1;
+	/** f28 field presence bit */
+	unsigned int f28:1;
+	/** f29 field presence bit */
+	unsigned int f29:1;
+	/** f30 field presence bit */
+	unsigned int f30:1;
+	/** f31 field presence bit */
+	unsigned int f31:1;
+	/** f32 field presence bit */
+	unsigned int f32:1;
+	/** f33 field presence bit */
+	unsigned int f33:1;
+	/** f34 field presence bit */
+	unsigned int f34:1;
+	/** f35 field presence bit */
+	unsigned int f35:1;
+	/** f36 field presence bit */
+	unsigned int f36:1;
+	/** f37 field presence bit */
+	unsigned int f37:1;
+	/** f38 field presence bit */
+	unsigned int f38:1;
+	/** f39 field presence bit */
+	unsigned int f39:1;
+	/** f40 field presence bit */
+	unsigned int f40:1;
+	/** f41 field presence bit */
+	unsigned int f41:1;
+	/** f42 field presence bit */
+	unsigned int f42:1;
+	/** f43 field presence bit */
+	unsigned int f43:1;
+	/** f44 field presence bit */
+	unsigned int f44:1;
+	/** f45 field presence bit */
+	unsigned int f45:1;
+	/** f46 field presence bit */
+	unsigned int f46:1;
+	/** f47 field presence bit */
+	unsigned int f47:1;
+	/** f48 field presence bit */
+	unsigned int f48:1;
+	/** f49 field presence bit */
+	unsigned int f49:1;
+	/** f50 field presence bit */
+	unsigned int f50:1;
+	/** f51 field presence bit */
+	unsigned int f51:1;
+	/** f52 field presence bit */
+	unsigned int f52:1;
+	/** f53 field presence bit */
+	unsigned int f53:1;
+	/** f54 field presence bit */
+	unsigned int f54:1;
+	/** f55 field presence bit */
+	unsigned int f55:1;
+	/** f56 field presence bit */
+	unsigned int f56:1;
+	/** f57 field presence bit */
+	unsigned int f57:1;
+	/** f58 field presence bit */
+	unsigned int f58:1;
+	/** f59 field presence bit */
+	unsigned int f59:1;
+	/** f60 field presence bit */
+	unsigned int f60:1;
+	/** f61 field presence bit */
+	unsigned int f61:1;
+	/** f62 field presence bit */
+	unsigned int f62:1;
+	/** f63 field presence bit */
+	unsigned int f63:1;
+	/** f64 field presence bit */
+	unsigned int f64:1;
+};
+
+/**
+ * @brief bench_wide object info structure.
+ *
+ * This structure represent bench_wide object contents.
+ **/
+struct bench_wide_info {
+	/** fields presence bit structure */
+	struct bench_wide_info_fields fields;
+	/** Field 1 */
+	uint32_t f1;
+	/** Field 2 */
+	uint32_t f2;
+	/** Field 3 */
+	uint32_t f3;
+	/** Field 4 */
+	uint32_t f4;
+	/** Field 5 */
+	uint32_t f5;
+	/** Field 6 */
+	uint32_t f6;
+	/** Field 7 */
+	uint32_t f7;
+	/** Field 8 */
+	uint32_t f8;
+	/** Field 9 */
+	uint32_t f9;
+	/** Field 10 */
+	uint32_t f10;
+	/** Field 11 */
+	uint32_t f11;
+	/** Field 12 */
+	uint32_t f12;
+	/** Field 13 */
+	uint32_t f13;
+	/** Field 14 */
+	uint32_t f14;
+	/** Field 15 */
+	uint32_t f15;
+	/** Field 16 */
+	uint32_t f16;
+	/** Field 17 */
+	uint32_t f17;
+	/** Field 18 */
+	uint32_t f18;
+	/** Field 19 */
+	uint32_t f19;
+	/** Field 20 */
+	uint32_t f20;
+	/** Field 21 */
+	uint32_t f21;
+	/** Field 22 */
+	uint32_t f22;
+	/** Field 23 */
+	uint32_t f23;
+	/** Field 24 */
+	uint32_t f24;
+	/** Field 25 */
+	uint32_t f25;
+	/** Field 26 */
+	uint32_t f26;
+	/** Field 27 */
+	uint32_t f27;
+	/** Field 28 */
+	uint32_t f28;
+	/** Field 29 */
+	uint32_t f29;
+	/** Field 30 */
+	uint32_t f30;
+	/** Field 31 */
+	uint32_t f31;
+	/** Field 32 */
+	uint32_t f32;
+	/** Field 33 */
+	uint32_t f33;
+	/** Field 34 */
+	uint32_t f34;
+	/** Field 35 */
+	uint32_t f35;
+	/** Field 36 */
+	uint32_t f36;
+	/** Field 37 */
+	uint32_t f37;
+	/** Field 38 */
+	uint32_t f38;
+	/** Field 39 */
+	uint32_t f39;
+	/** Field 40 */
+	uint32_t f40;
+	/** Field 41 */
+	uint32_t f41;
+	/** Field 42 */
+	uint32_t f42;
+	/** Field 43 */
+	uint32_t f43;
+	/** Field 44 */
+	uint32_t f44;
+	/** Field 45 */
+	uint32_t f45;
+	/** Field 46 */
+	uint32_t f46;
+	/** Field 47 */
+	uint32_t f47;
+	/** Field 48 */
+	uint32_t f48;
+	/** Field 49 */
+	uint32_t f49;
+	/** Field 50 */
+	uint32_t f50;
+	/** Field 51 */
+	uint32_t f51;
+	/** Field 52 */
+	uint32_t f52;
+	/** Field 53 */
+	uint32_t f53;
+	/** Field 54 */
+	uint32_t f54;
+	/** Field 55 */
+	uint32_t f55;
+	/** Field 56 */
+	uint32_t f56;
+	/** Field 57 */
+	uint32_t f57;
+	/** Field 58 */
+	uint32_t f58;
+	/** Field 59 */
+	uint32_t f59;
+	/** Field 60 */
+	uint32_t f60;
+	/** Field 61 */
+	uint32_t f61;
+	/** Field 62 */
+	uint32_t f62;
+	/** Field 63 */
+	uint32_t f63;
+	/** Field 64 */
+	uint32_t f64;
+};
+
+/**
+ * @brief initialize @ref bench_wide_info structure.
+ *
+ * This function initialize @ref bench_wide_info structure.
+ * Each field has its presence bit cleared.
+ *
+ * @param[in]  info  pointer to allocated @ref bench_wide_info structure.
+ **/
+void bench_wide_info_init(struct bench_wide_info *info);
+
+/**
+ * @brief check @ref bench_wide_info structure contents is empty.
+ *
+ * This function check if each field has its presence bit cleared
+ *
+ * @param[in]  info  @ref bench_wide_info structure.
+ *
+ * @retval     1     Each field has its presence bit cleared.
+ * @retval     0     One field (or more) has its presence bit set.
+ **/
+int bench_wide_info_is_empty(const struct bench_wide_info *info);
+
+/**
+ * @brief create a bench_wide object.
+ *
+ * This function allocate bench_wide object and initialize each
+ * object field with the given @ref info field value only if @ref info field
+ * presence bit is set (see @ref bench_wide_info_fields).
+ * This function also set a unique handle for this object.
+ * Registering or unregistering object in bus do not alter handle value
+ *
+ * @param[in]  server    bench bus server.
+ * @param[in]  info      bench_wide object initial values (may be NULL).
+ *
+ * @retval  object  success.
+ * @retval  NULL    failure.
+ *
+ * @note: object does not keep any reference to @ref info so that user shall
+ * allocate it on the stack.
+ *
+ * @note: if @ref info param is NULL, bench_wide object is initialized with
+ * default values.
+ *
+ * @note: object is not yet registered on bus,
+ * call one of theses functions below to register it:
+ * @ref bench_wide_register
+ * @ref bench_bus_event_register_wide
+ **/
+struct bench_wide *
+bench_wide_new(struct obus_server *srv, const struct bench_wide_info *info);
+
+/**
+ * @brief destroy a bench_wide object.
+ *
+ * This function release bench_wide object memory.
+ * Only non registered objects can be destroyed.
+ *
+ * @param[in]  object  bench_wide object to be destroyed.
+ *
+ * @retval  0       success.
+ * @retval  -EPERM  @ref object is registered.
+ * @retval  -EINVAL invalid @ref object.
+ **/
+int bench_wide_destroy(struct bench_wide *object);
+
+/**
+ * @brief register a bench_wide object.
+ *
+ * This function register a bench_wide object in bench bus.
+ *
+ * @param[in]  server  bench bus server.
+ * @param[in]  object  bench_wide object to be registered.
+ *
+ * @retval  0       success.
+ * @retval  -EPERM  @ref object is already registered.
+ * @retval  -EINVAL invalid parameters.
+ * @retval  < 0     other errors.
+ **/
+int bench_wide_register(struct obus_server *server, struct bench_wide *object);
+
+/**
+ * @brief unregister a bench_wide object.
+ *
+ * This function unregister a bench_wide object in bench bus.
+ *
+ * @param[in]  server  bench bus server.
+ * @param[in]  object  bench_wide object to be unregistered.
+ *
+ * @retval  0       success.
+ * @retval  -EPERM  @ref object is not registered.
+ * @retval  -EINVAL invalid parameters.
+ * @retval  < 0     other errors.
+ **/
+int bench_wide_unregister(struct obus_server *server, struct bench_wide *object);
+
+/**
+ * @brief check if is a bench_wide object registered.
+ *
+ * This function check whether a bench_wide object is registered or not.
+ *
+ * @param[in]  object  bench_wide object to checked.
+ *
+ * @retval  0  object is not registered.
+ * @retval  1  object is registered.
+ **/
+int bench_wide_is_registered(const struct bench_wide *object);
+
+/**
+ * @brief read current bench_wide object fields values.
+ *
+ * This function is used to read current object fields values.
+ *
+ * @param[in]  object  bench_wide object.
+ *
+ * @retval  info  pointer to a constant object fields values.
+ * @retval  NULL  object is NULL or not an bench_wide object.
+ *
+ * @note: object info pointer returned never changed during object life cycle
+ * so that user may keep a reference on this pointer until object destruction.
+ * this is not the case for info pointers members.
+ **/
+
+const struct bench_wide_info *
+bench_wide_get_info(const struct bench_wide *object);
+
+/**
+ * @brief log bench_wide object.
+ *
+ * This function log object and its current fields values.
+ *
+ * @param[in]  object  bench_wide object.
+ * @param[in]  level   obus log level.
+ **/
+void bench_wide_log(const struct bench_wide *object, enum obus_log_level level);
+
+/**
+ * @brief set bench_wide object user data pointer.
+ *
+ * This function store a user data pointer in a bench_wide object.
+ * This pointer is never used by libobus and can be retrieved using
+ * @ref bench_wide_get_user_data function.
+ *
+ * @param[in]  object      bench_wide object.
+ * @param[in]  user_data   user data pointer.
+ *
+ * @retval  0        success.
+ * @retval  -EINVAL  object is NULL.
+ **/
+int bench_wide_set_user_data(struct bench_wide *object, void *user_data);
+
+/**
+ * @brief get bench_wide object user data pointer.
+ *
+ * This function retrieve user data pointer stored in a bench_wide object
+ * by a previous call to @ref bench_wide_set_user_data function
+ *
+ * @param[in]  object  bench_wide object.
+ *
+ * @retval  user_data  user data pointer.
+ **/
+void *bench_wide_get_user_data(const struct bench_wide *object);
+
+/**
+ * @brief get registered bench_wide object obus handle.
+ *
+ * This function retrieve bench_wide object obus handle.
+ * obus handle is an unsigned 16 bits integer.
+ * object handle is generated during object creation.
+ * object handle can be used to reference an object into another one.
+ *
+ * @param[in]  object  bench_wide object.
+ *
+ * @retval  handle               registered object obus handle.
+ * @retval  OBUS_INVALID_HANDLE  if object is not registered.
+ **/
+obus_handle_t bench_wide_get_handle(const struct bench_wide *object);
+
+/**
+ * @brief get bench_wide object from obus handle.
+ *
+ * This function retrieve bench_wide object given its obus handle.
+ *
+ * @param[in]  server  bench bus server
+ * @param[in]  handle  bench_wide object handle.
+ *
+ * @retval  object  bench_wide object.
+ * @retval  NULL    invalid parameters.
+ * @retval  NULL    corresponding handle object is not a bench_wide.
+ **/
+struct bench_wide *
+bench_wide_from_handle(struct obus_server *server, obus_handle_t handle);
+
+/**
+ * @brief get next registered bench_wide object in bus.
+ *
+ * This function retrieve the next registered bench_wide object in bus.
+ *
+ * @param[in]  server    bench bus server
+ * @param[in]  previous  previous bench_wide object in list (may be NULL).
+ *
+ * @retval  object  next bench_wide object.
+ * @retval  NULL    invalid parameters.
+ * @retval  NULL    no more bench_wide objects in bus.
+ *
+ * @note: if @p previous is NULL, then the first
+ * registered bench_wide object is returned.
+ **/
+struct bench_wide *
+bench_wide_next(struct obus_server *server, struct bench_wide *previous);
+
+/**
+ * @brief send a bench_wide object event.
+ *
+ * This function send an event on a bench_wide object.
+ *
+ * @param[in]  server    bench bus server.
+ * @param[in]  object    bench_wide object.
+ * @param[in]  type      bench_wide event type.
+ * @param[in]  info      associated bench_wide content to be updated.
+ *
+ * @retval  0          event sent and object content updated.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -EPERM     object is not registered in bus.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int bench_wide_send_event(struct obus_server *server, struct bench_wide *object, enum bench_wide_event_type type, const struct bench_wide_info *info);
+
+/**
+ * @brief submit a bench_wide object event from any thread.
+ *
+ * This function queue an event on a bench_wide object, it may be
+ * called from another thread than the server loop one.
+ * Event is sent and object content updated by server loop,
+ * submitted events of a thread are sent in submission order.
+ * Object must not be destroyed before its event is sent.
+ *
+ * @param[in]  server    bench bus server.
+ * @param[in]  object    bench_wide object.
+ * @param[in]  type      bench_wide event type.
+ * @param[in]  info      associated bench_wide content to be updated.
+ *
+ * @retval  0          event queued.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -ENOMEM    memory error.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int bench_wide_submit_event(struct obus_server *server, struct bench_wide *object, enum bench_wide_event_type type, const struct bench_wide_info *info);
+
+/**
+ * @brief send a bench_wide object event through a bench bus event.
+ *
+ * This function create a bench_wide object event and attach it
+ * to an existing bench bus event. Created bench_wide object event
+ * will be sent within corresponding bus event.
+ * Unlike @bench_wide_send_event, object content will not be updated
+ * when this function returns but when
+ * @bench_wide_bus_event_send will be invoked.
+ *
+ * @param[in]  bus_event  bench bus event.
+ * @param[in]  object     bench_wide object.
+ * @param[in]  type       bench_wide event type.
+ * @param[in]  info       associated bench_wide content to be updated.
+ *
+ * @retval  0          event created and associated to bus event.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -ENOMEM    memory error.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int bench_bus_event_add_wide_event(struct bench_bus_event *bus_event, struct bench_wide *object, enum bench_wide_event_type type, const struct bench_wide_info *info);
+
+/**
+ * @brief register a bench_wide object through a bench bus event.
+ *
+ * This function set a bench_wide object to be registered when
+ * associated bench bus event will be sent. Unlike @bench_wide_register,
+ * object will not be registered when this function returns but when
+ * @bench_wide_bus_event_send will be invoked.
+ *
+ * @param[in]  bus_event  bench bus event.
+ * @param[in]  object     bench_wide object to be registered.
+ *
+ * @retval  0          object registration request associated to bus event.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -EPERM     object is already attached to an existing bus event.
+ *
+ **/
+int bench_bus_event_register_wide(struct bench_bus_event *bus_event, struct bench_wide *object);
+
+/**
+ * @brief unregister a bench_wide object through a bench bus event.
+ *
+ * This function set bench_wide object to be unregistered when
+ * associated bench bus event will be sent. Unlike @bench_wide_register,
+ * object will not be unregistered when this function returns but when
+ * @bench_wide_bus_event_send will be invoked.
+ * Object is then automatically destroyed on
+ * @bench_wide_bus_event_destroy call.
+ *
+ * @param[in]  bus_event  bench bus event.
+ * @param[in]  object     bench_wide object to be registered.
+ *
+ * @retval  0          object registration request associated to bus event.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -EPERM     object is already attached to an existing bus event.
+ *
+ **/
+int bench_bus_event_unregister_wide(struct bench_bus_event *bus_event, struct bench_wide *object);
+
+OBUS_END_DECLS
+
+#endif /*_BENCH_WIDE_H_*/
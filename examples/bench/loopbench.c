@@ -0,0 +1,150 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file loopbench.c
+ *
+ * @brief obus fd loop wakeup benchmark
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+/* internal loop api, linked with static libobus */
+#include "obus_header.h"
+#include <sys/resource.h>
+#include <sys/eventfd.h>
+
+#include "bench.h"
+
+/* number of ready fds per wakeup */
+#define LOOPBENCH_N_READY 8
+
+/* loop iterations per registered fds count */
+#define LOOPBENCH_N_ITERATIONS 200000
+
+static const int loopbench_n_fds[] = {
+	16, 64, 256, 1024, 4096
+};
+
+static uint64_t n_dispatched;
+
+/* ready fds are never read, level triggered loop reports them each time */
+static void loopbench_fd_cb(struct obus_fd *ofd, int events, void *data)
+{
+	n_dispatched++;
+}
+
+static int loopbench_run(int n_fds)
+{
+	struct obus_loop *loop;
+	struct obus_fd *ofds;
+	uint64_t start, elapsed, value = 1;
+	int i, ret = 0;
+
+	loop = obus_loop_new();
+	ofds = calloc((size_t)n_fds, sizeof(*ofds));
+	if (!loop || !ofds) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	for (i = 0; i < n_fds; i++)
+		ofds[i].fd = -1;
+
+	/* register fds, only first ones are made ready */
+	for (i = 0; i < n_fds; i++) {
+		ret = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if (ret < 0) {
+			ret = -errno;
+			fprintf(stderr, "eventfd: %s\n", strerror(errno));
+			goto out;
+		}
+
+		obus_fd_init(&ofds[i], ret, OBUS_FD_IN, &loopbench_fd_cb, NULL);
+		ret = obus_loop_add(loop, &ofds[i]);
+		if (ret < 0)
+			goto out;
+
+		if (i < LOOPBENCH_N_READY &&
+		    write(ofds[i].fd, &value, sizeof(value)) < 0) {
+			ret = -errno;
+			goto out;
+		}
+	}
+
+	n_dispatched = 0;
+	start = bench_now_ns();
+	for (i = 0; i < LOOPBENCH_N_ITERATIONS; i++)
+		obus_loop_process(loop);
+	elapsed = bench_now_ns() - start;
+
+	printf("%8d %12.1f %12.1f\n", n_fds,
+	       (double)elapsed / LOOPBENCH_N_ITERATIONS,
+	       n_dispatched ? (double)elapsed / (double)n_dispatched : 0.);
+
+out:
+	for (i = 0; ofds && i < n_fds && ofds[i].fd >= 0; i++) {
+		if (obus_fd_is_used(&ofds[i]))
+			obus_loop_remove(loop, &ofds[i]);
+		close(ofds[i].fd);
+	}
+
+	free(ofds);
+	if (loop)
+		obus_loop_unref(loop);
+
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	struct rlimit rlim;
+	size_t i;
+	int ret;
+
+	/* allow as many fds as the hard limit */
+	if (getrlimit(RLIMIT_NOFILE, &rlim) == 0) {
+		rlim.rlim_cur = rlim.rlim_max;
+		(void)setrlimit(RLIMIT_NOFILE, &rlim);
+	}
+
+	printf("loop wakeup cost, %d ready fds, %d iterations\n",
+	       LOOPBENCH_N_READY, LOOPBENCH_N_ITERATIONS);
+	printf("%8s %12s %12s\n", "fds", "ns/wakeup", "ns/event");
+
+	for (i = 0; i < OBUS_SIZEOF_ARRAY(loopbench_n_fds); i++) {
+		ret = loopbench_run(loopbench_n_fds[i]);
+		if (ret < 0) {
+			fprintf(stderr, "%d fds: error=%d(%s)\n",
+				loopbench_n_fds[i], -ret, strerror(-ret));
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
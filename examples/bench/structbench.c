@@ -0,0 +1,187 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file structbench.c
+ *
+ * @brief obus struct fields lookup and codecs benchmark
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+/* internal struct api, linked with static libobus */
+#include "obus_header.h"
+
+#include "bench_bus.h"
+#include "bench_wide.h"
+#include "bench.h"
+
+/* iterations per measure */
+#define STRUCTBENCH_N_ITERATIONS 100000
+
+/* wide object info struct description */
+static const struct obus_struct_desc *get_wide_info_desc(void)
+{
+	uint16_t i;
+
+	for (i = 0; i < bench_bus_desc->n_objects; i++) {
+		if (bench_bus_desc->objects[i]->uid == BENCH_WIDE_UID)
+			return bench_bus_desc->objects[i]->info_desc;
+	}
+
+	return NULL;
+}
+
+/* look up all fields by uid, returns ns per lookup */
+static double bench_lookup(const struct obus_struct *st)
+{
+	const struct obus_field_desc *field;
+	uint64_t start, found = 0;
+	uint32_t i;
+	uint16_t uid;
+
+	start = bench_now_ns();
+	for (i = 0; i < STRUCTBENCH_N_ITERATIONS; i++) {
+		for (uid = 1; uid <= st->desc->n_fields; uid++) {
+			field = obus_struct_get_field_desc(st, uid);
+			found += field ? 1 : 0;
+		}
+	}
+
+	return (double)(bench_now_ns() - start) / (double)found;
+}
+
+/* encode struct, returns ns per encoded struct */
+static double bench_encode(const struct obus_struct *st,
+			   struct obus_buffer *buf)
+{
+	uint64_t start;
+	uint32_t i;
+
+	start = bench_now_ns();
+	for (i = 0; i < STRUCTBENCH_N_ITERATIONS; i++) {
+		obus_buffer_clear(buf);
+		if (obus_struct_encode(st, buf) < 0)
+			return 0.;
+	}
+
+	return (double)(bench_now_ns() - start) / STRUCTBENCH_N_ITERATIONS;
+}
+
+/* decode encoded struct, returns ns per decoded struct */
+static double bench_decode(const struct obus_struct *st,
+			   struct obus_buffer *buf)
+{
+	uint64_t start;
+	uint32_t i;
+
+	start = bench_now_ns();
+	for (i = 0; i < STRUCTBENCH_N_ITERATIONS; i++) {
+		obus_buffer_set_read_position(buf, 0);
+		if (obus_struct_decode(st, buf) < 0)
+			return 0.;
+	}
+
+	return (double)(bench_now_ns() - start) / STRUCTBENCH_N_ITERATIONS;
+}
+
+int main(int argc, char *argv[])
+{
+	const struct obus_struct_desc *desc;
+	struct obus_struct_desc generic_desc, scan_desc;
+	struct bench_wide_info info, decoded;
+	struct obus_struct st, generic_st, scan_st, decoded_st;
+	struct obus_buffer *buf, *encoded;
+	uint32_t i;
+
+	desc = get_wide_info_desc();
+	buf = obus_buffer_new(1024, NULL);
+	encoded = obus_buffer_new(1024, NULL);
+	if (!desc || !buf || !encoded || !desc->encode) {
+		fprintf(stderr, "bench files must be generated with codecs\n");
+		goto error;
+	}
+
+	/* same description without generated encoder and decoder */
+	generic_desc = *desc;
+	generic_desc.encoded_size = NULL;
+	generic_desc.encode = NULL;
+	generic_desc.decode_field = NULL;
+
+	/* generic description without uid lookup table */
+	scan_desc = generic_desc;
+	scan_desc.uids = NULL;
+	scan_desc.n_uids = 0;
+
+	/* set all wide fields */
+	memset(&info, 0, sizeof(info));
+	st.desc = desc;
+	st.u.addr = &info;
+	for (i = 0; i < desc->n_fields; i++)
+		*(uint32_t *)obus_field_address(&st, &desc->fields[i]) = i;
+	obus_struct_set_has_fields(&st);
+	generic_st.desc = &generic_desc;
+	generic_st.u.addr = &info;
+
+	if (obus_struct_encode(&st, encoded) < 0)
+		goto error;
+
+	memset(&decoded, 0, sizeof(decoded));
+	decoded_st.u.addr = &decoded;
+	scan_st.desc = &scan_desc;
+	scan_st.u.addr = &decoded;
+
+	printf("wide struct: %" PRIu32 " fields, %zu encoded bytes\n",
+	       desc->n_fields, obus_buffer_length(encoded));
+
+	/* generic decoder looks up each decoded field by uid */
+	printf("%-12s %14s %16s\n", "lookup", "ns/field", "ns/decode");
+	decoded_st.desc = &generic_desc;
+	printf("%-12s %14.1f %16.1f\n", "uid table",
+	       bench_lookup(&decoded_st), bench_decode(&decoded_st, encoded));
+	printf("%-12s %14.1f %16.1f\n", "linear scan",
+	       bench_lookup(&scan_st), bench_decode(&scan_st, encoded));
+
+	printf("%-12s %14s %16s\n", "codec", "ns/encode", "ns/decode");
+	decoded_st.desc = desc;
+	printf("%-12s %14.1f %16.1f\n", "generated",
+	       bench_encode(&st, buf), bench_decode(&decoded_st, encoded));
+	decoded_st.desc = &generic_desc;
+	printf("%-12s %14.1f %16.1f\n", "generic",
+	       bench_encode(&generic_st, buf),
+	       bench_decode(&decoded_st, encoded));
+
+	obus_buffer_destroy(encoded);
+	obus_buffer_destroy(buf);
+	return EXIT_SUCCESS;
+
+error:
+	obus_buffer_destroy(encoded);
+	obus_buffer_destroy(buf);
+	return EXIT_FAILURE;
+}
@@ -117,6 +117,25 @@ net_bus_event_from_obus_event(struct obus_bus_event *event);
  **/
 int net_bus_event_send(struct obus_server *server, struct net_bus_event *event);
 
+/**
+ * @brief submit a net bus event from any thread.
+ *
+ * This function queue a net bus event, it may be called
+ * from another thread than the server loop one.
+ * Bus event is sent then destroyed by server loop, submitted
+ * bus events of a thread are sent in submission order.
+ * Bus event must not be used anymore once submitted.
+ *
+ * @param[in]  server  net bus server.
+ * @param[in]  event   net bus event.
+ *
+ * @retval     0      bus event is queued
+ * @retval  -EINVAL   invalid parameters.
+ * @retval  -ENOMEM   memory error.
+ **/
+int net_bus_event_submit(struct obus_server *server,
+			 struct net_bus_event *event);
+
 OBUS_END_DECLS
 
 #endif /*_NET_BUS_H_*/
@@ -189,11 +189,25 @@ static const struct obus_field_desc net_interface_info_fields[] = {
 
 };
 
+static const uint16_t net_interface_info_uids[] = {
+	[1] = NET_INTERFACE_FIELD_NAME + 1,
+	[2] = NET_INTERFACE_FIELD_STATE + 1,
+	[3] = NET_INTERFACE_FIELD_HW_ADDR + 1,
+	[4] = NET_INTERFACE_FIELD_IP_ADDR + 1,
+	[5] = NET_INTERFACE_FIELD_BROADCAST + 1,
+	[6] = NET_INTERFACE_FIELD_NETMASK + 1,
+	[7] = NET_INTERFACE_FIELD_BYTES + 1,
+	[8] = NET_INTERFACE_FIELD_METHOD_UP + 1,
+	[9] = NET_INTERFACE_FIELD_METHOD_DOWN + 1,
+};
+
 static const struct obus_struct_desc net_interface_info_desc = {
 	.size = sizeof(struct net_interface_info),
 	.fields_offset = obus_offsetof(struct net_interface_info, fields),
 	.n_fields = OBUS_SIZEOF_ARRAY(net_interface_info_fields),
 	.fields = net_interface_info_fields,
+	.uids = net_interface_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(net_interface_info_uids),
 };
 
 static const struct obus_event_update_desc event_up_updates[] = {
@@ -398,11 +412,18 @@ static const struct obus_field_desc net_interface_up_args_fields[] = {
 	 }
 };
 
+static const uint16_t net_interface_up_args_uids[] = {
+	[1] = 1,
+	[2] = 2,
+};
+
 static const struct obus_struct_desc net_interface_up_args_desc = {
 	.size = sizeof(struct net_interface_up_args),
 	.fields_offset = obus_offsetof(struct net_interface_up_args, fields),
 	.n_fields = OBUS_SIZEOF_ARRAY(net_interface_up_args_fields),
 	.fields = net_interface_up_args_fields,
+	.uids = net_interface_up_args_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(net_interface_up_args_uids),
 };
 
 static const struct obus_struct_desc net_interface_down_args_desc = {
@@ -636,6 +657,34 @@ int net_interface_send_event(struct obus_server *server,
 	return obus_server_send_event(server, &event);
 }
 
+int net_interface_submit_event(struct obus_server *server,
+			       struct net_interface *object,
+			       enum net_interface_event_type type,
+			       const struct net_interface_info *info)
+{
+	int ret;
+	struct obus_event *event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = net_interface_desc.info_desc
+	};
+
+	if (!object || !server || type >= NET_INTERFACE_EVENT_COUNT)
+		return -EINVAL;
+
+	event =
+	    obus_event_new(net_interface_object(object),
+			   &net_interface_events_desc[type], &st);
+	if (!event)
+		return -ENOMEM;
+
+	ret = obus_server_submit_event(server, event);
+	if (ret < 0)
+		obus_event_destroy(event);
+
+	return ret;
+}
+
 int net_bus_event_add_interface_event(struct net_bus_event *bus_event,
 				      struct net_interface *object,
 				      enum net_interface_event_type type,
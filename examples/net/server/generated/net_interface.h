@@ -474,6 +474,32 @@ int net_interface_send_event(struct obus_server *server,
 			     enum net_interface_event_type type,
 			     const struct net_interface_info *info);
 
+/**
+ * @brief submit a net_interface object event from any thread.
+ *
+ * This function queue an event on a net_interface object, it may be
+ * called from another thread than the server loop one.
+ * Event is sent and object content updated by server loop,
+ * submitted events of a thread are sent in submission order.
+ * Object must not be destroyed before its event is sent.
+ *
+ * @param[in]  server    net bus server.
+ * @param[in]  object    net_interface object.
+ * @param[in]  type      net_interface event type.
+ * @param[in]  info      associated net_interface content to be updated.
+ *
+ * @retval  0          event queued.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -ENOMEM    memory error.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int net_interface_submit_event(struct obus_server *server,
+			       struct net_interface *object,
+			       enum net_interface_event_type type,
+			       const struct net_interface_info *info);
+
 /**
  * @brief send a net_interface object event through a net bus event.
  *
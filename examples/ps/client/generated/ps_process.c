@@ -152,11 +152,22 @@ static const struct obus_field_desc ps_process_info_fields[] = {
 
 };
 
+static const uint16_t ps_process_info_uids[] = {
+	[1] = PS_PROCESS_FIELD_PID + 1,
+	[2] = PS_PROCESS_FIELD_PPID + 1,
+	[3] = PS_PROCESS_FIELD_NAME + 1,
+	[4] = PS_PROCESS_FIELD_EXE + 1,
+	[5] = PS_PROCESS_FIELD_PCPU + 1,
+	[6] = PS_PROCESS_FIELD_STATE + 1,
+};
+
 static const struct obus_struct_desc ps_process_info_desc = {
 	.size = sizeof(struct ps_process_info),
 	.fields_offset = obus_offsetof(struct ps_process_info, fields),
 	.n_fields = OBUS_SIZEOF_ARRAY(ps_process_info_fields),
 	.fields = ps_process_info_fields,
+	.uids = ps_process_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(ps_process_info_uids),
 };
 
 static const struct obus_event_update_desc event_updated_updates[] = {
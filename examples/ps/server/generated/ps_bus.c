@@ -128,3 +128,9 @@ int ps_bus_event_send(struct obus_server *server, struct ps_bus_event *event)
 	struct obus_bus_event *evt = (struct obus_bus_event *)event;
 	return obus_server_send_bus_event(server, evt);
 }
+
+int ps_bus_event_submit(struct obus_server *server, struct ps_bus_event *event)
+{
+	struct obus_bus_event *evt = (struct obus_bus_event *)event;
+	return obus_server_submit_bus_event(server, evt);
+}
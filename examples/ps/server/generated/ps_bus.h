@@ -117,6 +117,24 @@ ps_bus_event_from_obus_event(struct obus_bus_event *event);
  **/
 int ps_bus_event_send(struct obus_server *server, struct ps_bus_event *event);
 
+/**
+ * @brief submit a ps bus event from any thread.
+ *
+ * This function queue a ps bus event, it may be called
+ * from another thread than the server loop one.
+ * Bus event is sent then destroyed by server loop, submitted
+ * bus events of a thread are sent in submission order.
+ * Bus event must not be used anymore once submitted.
+ *
+ * @param[in]  server  ps bus server.
+ * @param[in]  event   ps bus event.
+ *
+ * @retval     0      bus event is queued
+ * @retval  -EINVAL   invalid parameters.
+ * @retval  -ENOMEM   memory error.
+ **/
+int ps_bus_event_submit(struct obus_server *server, struct ps_bus_event *event);
+
 OBUS_END_DECLS
 
 #endif /*_PS_BUS_H_*/
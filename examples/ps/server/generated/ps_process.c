@@ -152,11 +152,22 @@ static const struct obus_field_desc ps_process_info_fields[] = {
 
 };
 
+static const uint16_t ps_process_info_uids[] = {
+	[1] = PS_PROCESS_FIELD_PID + 1,
+	[2] = PS_PROCESS_FIELD_PPID + 1,
+	[3] = PS_PROCESS_FIELD_NAME + 1,
+	[4] = PS_PROCESS_FIELD_EXE + 1,
+	[5] = PS_PROCESS_FIELD_PCPU + 1,
+	[6] = PS_PROCESS_FIELD_STATE + 1,
+};
+
 static const struct obus_struct_desc ps_process_info_desc = {
 	.size = sizeof(struct ps_process_info),
 	.fields_offset = obus_offsetof(struct ps_process_info, fields),
 	.n_fields = OBUS_SIZEOF_ARRAY(ps_process_info_fields),
 	.fields = ps_process_info_fields,
+	.uids = ps_process_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(ps_process_info_uids),
 };
 
 static const struct obus_event_update_desc event_updated_updates[] = {
@@ -385,6 +396,34 @@ int ps_process_send_event(struct obus_server *server, struct ps_process *object,
 	return obus_server_send_event(server, &event);
 }
 
+int ps_process_submit_event(struct obus_server *server,
+			    struct ps_process *object,
+			    enum ps_process_event_type type,
+			    const struct ps_process_info *info)
+{
+	int ret;
+	struct obus_event *event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = ps_process_desc.info_desc
+	};
+
+	if (!object || !server || type >= PS_PROCESS_EVENT_COUNT)
+		return -EINVAL;
+
+	event =
+	    obus_event_new(ps_process_object(object),
+			   &ps_process_events_desc[type], &st);
+	if (!event)
+		return -ENOMEM;
+
+	ret = obus_server_submit_event(server, event);
+	if (ret < 0)
+		obus_event_destroy(event);
+
+	return ret;
+}
+
 int ps_bus_event_add_process_event(struct ps_bus_event *bus_event,
 				   struct ps_process *object,
 				   enum ps_process_event_type type,
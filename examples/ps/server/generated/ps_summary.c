@@ -195,11 +195,26 @@ static const struct obus_field_desc ps_summary_info_fields[] = {
 
 };
 
+static const uint16_t ps_summary_info_uids[] = {
+	[1] = PS_SUMMARY_FIELD_PCPUS + 1,
+	[2] = PS_SUMMARY_FIELD_TASK_TOTAL + 1,
+	[3] = PS_SUMMARY_FIELD_TASK_RUNNING + 1,
+	[4] = PS_SUMMARY_FIELD_TASK_SLEEPING + 1,
+	[5] = PS_SUMMARY_FIELD_TASK_STOPPED + 1,
+	[6] = PS_SUMMARY_FIELD_TASK_ZOMBIE + 1,
+	[7] = PS_SUMMARY_FIELD_REFRESH_RATE + 1,
+	[8] = PS_SUMMARY_FIELD_MODE + 1,
+	[101] = PS_SUMMARY_FIELD_METHOD_SET_REFRESH_RATE + 1,
+	[102] = PS_SUMMARY_FIELD_METHOD_SET_MODE + 1,
+};
+
 static const struct obus_struct_desc ps_summary_info_desc = {
 	.size = sizeof(struct ps_summary_info),
 	.fields_offset = obus_offsetof(struct ps_summary_info, fields),
 	.n_fields = OBUS_SIZEOF_ARRAY(ps_summary_info_fields),
 	.fields = ps_summary_info_fields,
+	.uids = ps_summary_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(ps_summary_info_uids),
 };
 
 static const struct obus_event_update_desc event_updated_updates[] = {
@@ -307,12 +322,18 @@ static const struct obus_field_desc ps_summary_set_refresh_rate_args_fields[] =
 	 }
 };
 
+static const uint16_t ps_summary_set_refresh_rate_args_uids[] = {
+	[1] = 1,
+};
+
 static const struct obus_struct_desc ps_summary_set_refresh_rate_args_desc = {
 	.size = sizeof(struct ps_summary_set_refresh_rate_args),
 	.fields_offset =
 	    obus_offsetof(struct ps_summary_set_refresh_rate_args, fields),
 	.n_fields = OBUS_SIZEOF_ARRAY(ps_summary_set_refresh_rate_args_fields),
 	.fields = ps_summary_set_refresh_rate_args_fields,
+	.uids = ps_summary_set_refresh_rate_args_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(ps_summary_set_refresh_rate_args_uids),
 };
 
 static const struct obus_field_desc ps_summary_set_mode_args_fields[] = {
@@ -325,11 +346,17 @@ static const struct obus_field_desc ps_summary_set_mode_args_fields[] = {
 	 }
 };
 
+static const uint16_t ps_summary_set_mode_args_uids[] = {
+	[1] = 1,
+};
+
 static const struct obus_struct_desc ps_summary_set_mode_args_desc = {
 	.size = sizeof(struct ps_summary_set_mode_args),
 	.fields_offset = obus_offsetof(struct ps_summary_set_mode_args, fields),
 	.n_fields = OBUS_SIZEOF_ARRAY(ps_summary_set_mode_args_fields),
 	.fields = ps_summary_set_mode_args_fields,
+	.uids = ps_summary_set_mode_args_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(ps_summary_set_mode_args_uids),
 };
 
 static const struct obus_method_desc ps_summary_methods_desc[] = {
@@ -559,6 +586,34 @@ int ps_summary_send_event(struct obus_server *server, struct ps_summary *object,
 	return obus_server_send_event(server, &event);
 }
 
+int ps_summary_submit_event(struct obus_server *server,
+			    struct ps_summary *object,
+			    enum ps_summary_event_type type,
+			    const struct ps_summary_info *info)
+{
+	int ret;
+	struct obus_event *event;
+	struct obus_struct st = {
+		.u.const_addr = info,
+		.desc = ps_summary_desc.info_desc
+	};
+
+	if (!object || !server || type >= PS_SUMMARY_EVENT_COUNT)
+		return -EINVAL;
+
+	event =
+	    obus_event_new(ps_summary_object(object),
+			   &ps_summary_events_desc[type], &st);
+	if (!event)
+		return -ENOMEM;
+
+	ret = obus_server_submit_event(server, event);
+	if (ret < 0)
+		obus_event_destroy(event);
+
+	return ret;
+}
+
 int ps_bus_event_add_summary_event(struct ps_bus_event *bus_event,
 				   struct ps_summary *object,
 				   enum ps_summary_event_type type,
@@ -360,6 +360,32 @@ int ps_process_send_event(struct obus_server *server, struct ps_process *object,
 			  enum ps_process_event_type type,
 			  const struct ps_process_info *info);
 
+/**
+ * @brief submit a ps_process object event from any thread.
+ *
+ * This function queue an event on a ps_process object, it may be
+ * called from another thread than the server loop one.
+ * Event is sent and object content updated by server loop,
+ * submitted events of a thread are sent in submission order.
+ * Object must not be destroyed before its event is sent.
+ *
+ * @param[in]  server    ps bus server.
+ * @param[in]  object    ps_process object.
+ * @param[in]  type      ps_process event type.
+ * @param[in]  info      associated ps_process content to be updated.
+ *
+ * @retval  0          event queued.
+ * @retval  -EINVAL    invalid parameters.
+ * @retval  -ENOMEM    memory error.
+ *
+ * @note: Partial info members copy is done inside function.
+ * No reference to info members is kept.
+ **/
+int ps_process_submit_event(struct obus_server *server,
+			    struct ps_process *object,
+			    enum ps_process_event_type type,
+			    const struct ps_process_info *info);
+
 /**
  * @brief send a ps_process object event through a ps bus event.
  *
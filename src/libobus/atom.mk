@@ -15,6 +15,7 @@ include $(LOCAL_PATH)/libobus.mk
 LOCAL_EXPORT_C_INCLUDES := $(addprefix $(LOCAL_PATH)/,$(sort $(dir $(LIBOBUS_PUBLIC_HEADER_FILES))))
 LOCAL_CFLAGS := $(LIBOBUS_CFLAGS) -DHAVE_SYS_TIMERFD_H -DHAVE_EPOLL
 LOCAL_LDFLAGS := $(LIBOBUS_LDFLAGS)
+LOCAL_LDLIBS := $(LIBOBUS_LDLIBS)
 LOCAL_SRC_FILES := $(LIBOBUS_SOURCE_FILES)
 
 include $(BUILD_SHARED_LIBRARY)
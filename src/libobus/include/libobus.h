@@ -49,6 +49,9 @@
 /* needed for size_t */
 #include <stdlib.h>
 
+/* needed for mode_t */
+#include <sys/types.h>
+
 /* C++ needs to know that types and declarations are C, not C++.  */
 #ifdef	__cplusplus
 #define OBUS_BEGIN_DECLS extern "C" {
@@ -200,6 +203,64 @@ enum obus_call_status {
  */
 const char *obus_call_status_str(enum obus_call_status status);
 
+/**
+ * objects, events and hash entries allocation counters of a bus.
+ */
+struct obus_alloc_stats {
+	/* number of allocations */
+	uint64_t n_allocs;
+	/* number of allocations which needed heap memory */
+	uint64_t n_heap_allocs;
+	/* number of releases */
+	uint64_t n_frees;
+	/* number of releases which returned memory to heap */
+	uint64_t n_heap_frees;
+	/* number of allocated items */
+	uint32_t n_used;
+	/* number of cached free items */
+	uint32_t n_cached;
+};
+
+/**
+ * number of buckets of time histograms
+ */
+#define OBUS_TIME_HIST_SIZE 16
+
+/**
+ * time histogram, bucket 0 counts samples under 1 us, bucket i samples
+ * from 2^(i-1) us to 2^i us, last bucket all longer samples.
+ */
+struct obus_time_hist {
+	/* number of samples */
+	uint64_t n_samples;
+	/* sum of samples in ns */
+	uint64_t total_ns;
+	/* longest sample in ns */
+	uint64_t max_ns;
+	/* samples per duration range */
+	uint32_t buckets[OBUS_TIME_HIST_SIZE];
+};
+
+/**
+ * packets traffic counters, packets are counted as sent once handed to
+ * transport (written or queued)
+ */
+struct obus_traffic_stats {
+	/* bytes sent */
+	uint64_t tx_bytes;
+	/* packets sent */
+	uint64_t tx_packets;
+	/* bytes received */
+	uint64_t rx_bytes;
+	/* packets received */
+	uint64_t rx_packets;
+};
+
+/**
+ * uid of builtin server stats object, see obus_server_publish_stats
+ */
+#define OBUS_STATS_UID 0xffff
+
 /**
  * obus client structure.
  */
@@ -259,6 +320,13 @@ struct obus_client *obus_client_new(const char *name,
  *		example: 'unix:/tmp/obus/mybus'
  *		example: 'unix:@/obus/mybus'
  *
+ *	shm:	same as 'unix:', the unix socket is only used to exchange
+ *		a shared memory channel, packets are then transferred through
+ *		shared memory rings (same host peers only).
+ *		server and clients must use the same 'shm:' address
+ *
+ *		example: 'shm:@/obus/mybus'
+ *
  */
 int obus_client_start(struct obus_client *client, const char *addr);
 
@@ -278,6 +346,188 @@ int obus_client_destroy(struct obus_client *client);
  */
 int obus_client_is_connected(struct obus_client *client);
 
+/**
+ * check if obus client has received all objects registered on server
+ * when it connected.
+ *
+ * objects are streamed by server in several chunks after connection,
+ * interleaved with live objects events. Older servers send all objects
+ * in connection response, client is synchronized once connected.
+ *
+ * @param obus client.
+ * @return 1 if connected and synchronized 0 else.
+ */
+int obus_client_is_synced(struct obus_client *client);
+
+/**
+ * subscribe to objects of given type.
+ *
+ * once a client has subscribed to an object type, server only sends it
+ * objects of subscribed types. If events uids are given, only these
+ * object events are sent, object info is then not updated by other events.
+ * Subscribing again to a type replaces its events list.
+ *
+ * subscriptions can be set before starting client (they are then sent
+ * with connection request) or while connected. They are kept across
+ * reconnections. 'shm:' clients reading server broadcast log still
+ * receive all broadcast objects events.
+ *
+ * @param client obus client
+ * @param uid object type uid
+ * @param events subscribed events uids (NULL for all object events)
+ * @param n_events number of events uids
+ * @return 0 on success, -ENOENT if object or event uid is unknown
+ */
+int obus_client_subscribe(struct obus_client *client, uint16_t uid,
+			  const uint16_t *events, uint16_t n_events);
+
+/**
+ * only receive given fields of objects of given type.
+ *
+ * objects are added and updated with projected fields only, other fields
+ * are left unset. Methods states are always received. Object type is
+ * subscribed with all its events if not subscribed yet.
+ *
+ * @param client obus client
+ * @param uid object type uid
+ * @param fields projected fields uids (NULL for all object fields)
+ * @param n_fields number of fields uids
+ * @return 0 on success, -ENOENT if object or field uid is unknown
+ */
+int obus_client_subscribe_fields(struct obus_client *client, uint16_t uid,
+				 const uint16_t *fields, uint16_t n_fields);
+
+/**
+ * unsubscribe from objects of given type.
+ *
+ * objects of this type already received are removed, as if they were
+ * unregistered. Unsubscribing a client never subscribed to any object type
+ * makes it receive no objects at all.
+ *
+ * @param client obus client
+ * @param uid object type uid
+ * @return 0 on success
+ */
+int obus_client_unsubscribe(struct obus_client *client, uint16_t uid);
+
+/**
+ * remove all client subscriptions, server then sends all objects (default).
+ *
+ * @param client obus client
+ * @return 0 on success
+ */
+int obus_client_subscribe_all(struct obus_client *client);
+
+/**
+ * enable/disable borrowed decoding of received object events.
+ *
+ * when enabled, event strings and arrays are not copied on decode but
+ * point into client receive buffer when possible. They remain valid
+ * until event is destroyed, like copied values. They are copied only
+ * when event is committed into object. Disabled by default.
+ *
+ * @param client obus client
+ * @param enable set 1 or 0 to enable/disable borrowed decoding
+ * @return 0 on success
+ */
+int obus_client_set_borrowed_events(struct obus_client *client, int enable);
+
+/**
+ * start batching client calls.
+ *
+ * Calls issued after this function are only queued, they are written on
+ * obus_client_flush_calls with as few writes as possible. Calls acks are
+ * still tracked individually.
+ *
+ * @param client obus client
+ * @return 0 on success
+ */
+int obus_client_cork_calls(struct obus_client *client);
+
+/**
+ * write calls batched since obus_client_cork_calls and stop batching.
+ *
+ * @param client obus client
+ * @return 0 on success, negative errno on write error (client is then
+ * disconnected)
+ */
+int obus_client_flush_calls(struct obus_client *client);
+
+/**
+ * set max number of client calls waiting for their ack.
+ *
+ * When limit is reached, calls fail with -EBUSY until acks are received.
+ *
+ * @param client obus client
+ * @param max max number of pending calls (0 for no limit)
+ * @return 0 on success
+ */
+int obus_client_set_max_pending_calls(struct obus_client *client,
+				      uint32_t max);
+
+/**
+ * get number of client calls waiting for their ack.
+ *
+ * @param client obus client
+ * @return number of pending calls or negative errno
+ */
+int obus_client_get_pending_calls(struct obus_client *client);
+
+/**
+ * get client allocation counters.
+ *
+ * objects, events and hash entries are allocated from per bus caches,
+ * once caches are warm steady state event processing should not
+ * increase n_heap_allocs.
+ *
+ * @param client obus client
+ * @param stats counters to be filled
+ * @return 0 on success
+ */
+int obus_client_get_alloc_stats(struct obus_client *client,
+				struct obus_alloc_stats *stats);
+
+/**
+ * client runtime counters
+ */
+struct obus_client_stats {
+	/* packets traffic since client creation */
+	struct obus_traffic_stats traffic;
+	/* number of connections to server */
+	uint32_t n_connections;
+	/* calls waiting for their ack */
+	uint32_t n_pending_calls;
+	/* bytes waiting to be written */
+	size_t queued_bytes;
+	/* packets waiting to be written */
+	size_t queued_packets;
+	/* calls encoding time (if timing is enabled) */
+	struct obus_time_hist encode;
+	/* received packets decoding time (if timing is enabled) */
+	struct obus_time_hist decode;
+};
+
+/**
+ * enable/disable packets encoding and decoding time measurement.
+ *
+ * Each measured packet costs two clock reads. Disabled by default.
+ *
+ * @param client obus client
+ * @param enable set 1 or 0 to enable/disable timing
+ * @return 0 on success
+ */
+int obus_client_set_stats_timing(struct obus_client *client, int enable);
+
+/**
+ * get client runtime counters.
+ *
+ * @param client obus client
+ * @param stats counters to be filled
+ * @return 0 on success
+ */
+int obus_client_get_stats(struct obus_client *client,
+			  struct obus_client_stats *stats);
+
 /**
  * get obus client associated file descriptor.
  *
@@ -425,6 +675,233 @@ int obus_peer_set_user_data(struct obus_peer *peer, void *user_data);
  */
 void *obus_peer_get_user_data(const struct obus_peer *peer);
 
+/**
+ * policy applied when a peer write queue exceeds its limits
+ */
+enum obus_peer_queue_policy {
+	/* disconnect peer */
+	OBUS_PEER_QUEUE_DROP = 0,
+	/* merge object events, send them once peer queue is drained */
+	OBUS_PEER_QUEUE_COALESCE,
+	/* block producer until peer queue is back under limits */
+	OBUS_PEER_QUEUE_BLOCK,
+};
+
+/**
+ * peer write queue limits
+ */
+struct obus_peer_queue_limits {
+	/* max queued bytes (0 for no limit) */
+	size_t max_bytes;
+	/* max queued packets (0 for no limit) */
+	size_t max_packets;
+	/* policy applied when a limit is exceeded */
+	enum obus_peer_queue_policy policy;
+	/* max blocking time in ms for OBUS_PEER_QUEUE_BLOCK policy */
+	int block_timeout;
+};
+
+/**
+ * peer write queue counters
+ */
+struct obus_peer_queue_stats {
+	/* bytes waiting to be written */
+	size_t queued_bytes;
+	/* packets waiting to be written */
+	size_t queued_packets;
+	/* max queued bytes reached */
+	size_t peak_bytes;
+	/* max queued packets reached */
+	size_t peak_packets;
+	/* number of times queue limits were exceeded */
+	uint32_t n_overflows;
+	/* number of object events coalesced */
+	uint32_t n_coalesced;
+};
+
+/**
+ * peer runtime counters
+ */
+struct obus_peer_stats {
+	/* packets traffic since peer connection */
+	struct obus_traffic_stats traffic;
+	/* write queue counters */
+	struct obus_peer_queue_stats queue;
+	/* peer calls not yet acked */
+	uint32_t n_pending_calls;
+};
+
+/**
+ * server runtime counters
+ */
+struct obus_server_stats {
+	/* packets traffic of all peers since server creation, broadcasts
+	 * written in shm log are counted once */
+	struct obus_traffic_stats traffic;
+	/* number of connected peers */
+	uint32_t n_peers;
+	/* number of accepted peer connections */
+	uint64_t n_connections;
+	/* number of closed peer connections */
+	uint64_t n_disconnections;
+	/* calls not yet acked */
+	uint32_t n_pending_calls;
+	/* packets encoding time (if timing is enabled) */
+	struct obus_time_hist encode;
+	/* received packets decoding time (if timing is enabled) */
+	struct obus_time_hist decode;
+};
+
+/**
+ * set write queue limits applied to each server peer.
+ *
+ * by default peer write queues are not limited.
+ *
+ * @param srv obus server
+ * @param limits queue limits (NULL to remove limits)
+ * @return 0 on success
+ */
+int obus_server_set_peer_queue_limits(struct obus_server *srv,
+				      const struct obus_peer_queue_limits *limits);
+
+/**
+ * enable/disable object events conflation for slow peers.
+ *
+ * when enabled, object events sent while a peer write queue is not
+ * empty are not queued but merged per object, keeping only the latest
+ * value of each field. Merged events are sent once the peer write queue
+ * is drained. Disabled by default.
+ *
+ * @param srv obus server
+ * @param enable set 1 or 0 to enable/disable conflation
+ * @return 0 on success
+ */
+int obus_server_set_peer_conflation(struct obus_server *srv, int enable);
+
+/**
+ * set size of server shared memory broadcast log.
+ *
+ * when set, object and bus events are written once in a shared memory log
+ * read by each peer connected with a 'shm:' address, instead of being
+ * written to each of these peers. A peer reading the log too slowly is
+ * reconnected and resynchronized from a new objects snapshot.
+ * Disabled by default (size 0), must be set before @obus_server_start.
+ *
+ * @param srv obus server
+ * @param size log size in bytes (power of 2, 0 to disable)
+ * @return 0 on success
+ */
+int obus_server_set_shm_log_size(struct obus_server *srv, size_t size);
+
+/**
+ * set number of server writer threads.
+ *
+ * when set, packets of peers connected with a socket address are written
+ * by writer threads instead of server loop thread, each peer being
+ * attached to the thread serving fewest peers. Packets are still encoded
+ * once by server loop thread, which also keeps reading peers and owning
+ * all bus state. A peer write queue can not block server loop thread,
+ * OBUS_PEER_QUEUE_BLOCK policy then coalesces object events.
+ * Disabled by default (0), must be set before @obus_server_start.
+ *
+ * @param srv obus server
+ * @param n_workers number of writer threads (0 to disable)
+ * @return 0 on success
+ */
+int obus_server_set_workers(struct obus_server *srv, size_t n_workers);
+
+/**
+ * publish registered objects state in a read only shared memory file.
+ *
+ * the file at given path is updated each time an object is registered,
+ * unregistered or one of its events is committed, it can be read by any
+ * process with obus_mirror_open without connecting to server.
+ * Disabled by default.
+ *
+ * @param srv obus server
+ * @param path mirror file path (NULL to stop publishing)
+ * @param size size reserved for objects data in bytes
+ * @param mode mirror file permissions (e.g. 0644 for all local readers)
+ * @return 0 on success
+ */
+int obus_server_set_state_mirror(struct obus_server *srv, const char *path,
+				 size_t size, mode_t mode);
+
+/**
+ * get server allocation counters.
+ *
+ * @param srv obus server
+ * @param stats counters to be filled
+ * @return 0 on success
+ */
+int obus_server_get_alloc_stats(struct obus_server *srv,
+				struct obus_alloc_stats *stats);
+
+/**
+ * get peer write queue counters
+ * @param peer peer
+ * @param stats counters filled on success
+ * @return 0 on success
+ */
+int obus_peer_get_queue_stats(const struct obus_peer *peer,
+			      struct obus_peer_queue_stats *stats);
+
+/**
+ * enable/disable packets encoding and decoding time measurement.
+ *
+ * Each measured packet costs two clock reads. Disabled by default.
+ *
+ * @param srv obus server
+ * @param enable set 1 or 0 to enable/disable timing
+ * @return 0 on success
+ */
+int obus_server_set_stats_timing(struct obus_server *srv, int enable);
+
+/**
+ * get server runtime counters.
+ *
+ * @param srv obus server
+ * @param stats counters to be filled
+ * @return 0 on success
+ */
+int obus_server_get_stats(struct obus_server *srv,
+			  struct obus_server_stats *stats);
+
+/**
+ * get peer runtime counters.
+ *
+ * @param peer peer
+ * @param stats counters to be filled
+ * @return 0 on success
+ */
+int obus_peer_get_stats(const struct obus_peer *peer,
+			struct obus_peer_stats *stats);
+
+/**
+ * publish server runtime counters on the bus.
+ *
+ * a builtin stats object (uid OBUS_STATS_UID), known by every bus, is
+ * registered and updated with server counters at given period, so that
+ * clients can read them with obus_client_get_server_stats. Clients
+ * subscribing to some object types only must subscribe to OBUS_STATS_UID.
+ * Disabled by default.
+ *
+ * @param srv obus server
+ * @param period update period in ms (0 to stop publishing)
+ * @return 0 on success
+ */
+int obus_server_publish_stats(struct obus_server *srv, int period);
+
+/**
+ * get server runtime counters published on the bus.
+ *
+ * @param client obus client
+ * @param stats counters to be filled
+ * @return 0 on success, -ENOENT if server does not publish them
+ */
+int obus_client_get_server_stats(struct obus_client *client,
+				 struct obus_server_stats *stats);
+
 
 /**
  * start server.
@@ -494,20 +971,39 @@ int obus_server_posix_process_fd(struct obus_server *srv,
 
 /**
  * send call method ack status
+ *
+ * A call is pending until its ack is sent, either from its method handler
+ * or later if the handler deferred it (see obus_server_defer_ack).
+ *
  * @param srv obus server
  * @param handle call handle
  * @param status call ack status
- * @return 0 on success
+ * @return 0 on success, -ENOENT if call is not pending
  */
 int obus_server_send_ack(struct obus_server *srv, obus_handle_t handle,
 			 enum obus_call_status status);
 
+/**
+ * defer call method ack
+ *
+ * By default a call not acked when its method handler returns is refused.
+ * A method handler may call this function to keep the call pending and
+ * send its ack later with obus_server_send_ack, meanwhile other calls are
+ * processed. Pending calls are aborted when their object is unregistered
+ * and dropped when their peer disconnects.
+ *
+ * @param srv obus server
+ * @param handle call handle
+ * @return 0 on success, -ENOENT if call is not pending
+ */
+int obus_server_defer_ack(struct obus_server *srv, obus_handle_t handle);
+
 /**
  * get the peer of an obus call
  *
- * The peer is only valid during a method call :
- * the returned peer can be used safely in a method handler, but no reference
- * should be retained for a later use.
+ * The peer is only valid while the call is pending :
+ * the returned peer can be used safely until call ack is sent, but no
+ * reference should be retained for a later use.
  *
  * @param srv obus server
  * @param handle call handle
@@ -516,6 +1012,76 @@ int obus_server_send_ack(struct obus_server *srv, obus_handle_t handle,
 struct obus_peer *obus_server_get_call_peer(struct obus_server *srv,
 					    obus_handle_t handle);
 
+/**
+ * obus objects state mirror reader.
+ */
+struct obus_mirror;
+
+/**
+ * obus object description
+ */
+struct obus_object_desc;
+
+/**
+ * open objects state mirror published by a server.
+ *
+ * reading a mirror does not need any loop nor socket, objects are copied
+ * from shared memory without lock nor syscall.
+ *
+ * @param path mirror file path (see obus_server_set_state_mirror)
+ * @param desc bus description
+ * @return mirror or NULL on error (no file or bus mismatch)
+ */
+struct obus_mirror *obus_mirror_open(const char *path,
+				     const struct obus_bus_desc *desc);
+
+/**
+ * close objects state mirror.
+ *
+ * @param mirror mirror
+ * @return 0 on success
+ */
+int obus_mirror_close(struct obus_mirror *mirror);
+
+/**
+ * read object committed info.
+ *
+ * strings and arrays of info are allocated, info must be released with
+ * obus_mirror_release_info.
+ *
+ * @param mirror mirror
+ * @param desc object description
+ * @param handle object handle
+ * @param info object info struct filled on success
+ * @return 0 on success, -ENOENT if object is not registered,
+ * -EAGAIN if object was updated during each read attempt,
+ * -ENOTCONN if server stopped publishing (mirror must be reopened)
+ */
+int obus_mirror_read(struct obus_mirror *mirror,
+		     const struct obus_object_desc *desc,
+		     obus_handle_t handle, void *info);
+
+/**
+ * release object info read from mirror.
+ *
+ * @param desc object description
+ * @param info object info struct
+ */
+void obus_mirror_release_info(const struct obus_object_desc *desc,
+			      void *info);
+
+/**
+ * get next registered object handle of given type in mirror.
+ *
+ * @param mirror mirror
+ * @param desc object description
+ * @param prev previous handle (OBUS_INVALID_HANDLE to get first)
+ * @return next handle or OBUS_INVALID_HANDLE if none
+ */
+obus_handle_t obus_mirror_next(struct obus_mirror *mirror,
+			       const struct obus_object_desc *desc,
+			       obus_handle_t prev);
+
 /**
  * macro used by server to set object properties and methods arguments
  */
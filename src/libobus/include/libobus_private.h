@@ -154,6 +154,8 @@ struct obus_field_desc {
 	off_t nb_offset;
 };
 
+struct obus_struct;
+
 /**
  * struct field description
  */
@@ -166,6 +168,19 @@ struct obus_struct_desc {
 	uint32_t n_fields;
 	/* fields array */
 	const struct obus_field_desc *fields;
+	/* field index + 1 indexed by field uid (0 if no field), optional */
+	const uint16_t *uids;
+	/* number of entries in uids table */
+	uint32_t n_uids;
+	/* generated encoder (optional): encoded size of struct set fields */
+	size_t (*encoded_size) (const struct obus_struct *st);
+	/* generated encoder (optional): encode struct at given address,
+	 * returns encoded size */
+	size_t (*encode) (const struct obus_struct *st, uint8_t *ptr);
+	/* generated decoder (optional): decode a known field value,
+	 * returns decoded size or 0 if generic decoder must be used */
+	size_t (*decode_field) (const struct obus_struct *st, uint16_t uid,
+				uint8_t type, const uint8_t *ptr, size_t len);
 };
 
 /**
@@ -181,6 +196,120 @@ struct obus_struct {
 	} u;
 };
 
+/**
+ * big endian store helpers used by generated struct encoders,
+ * each one returns address following stored value
+ */
+static inline uint8_t *obus_put_u8(uint8_t *ptr, uint8_t value)
+{
+	ptr[0] = value;
+	return ptr + 1;
+}
+
+static inline uint8_t *obus_put_u16(uint8_t *ptr, uint16_t value)
+{
+	ptr[0] = (uint8_t)(value >> 8);
+	ptr[1] = (uint8_t)value;
+	return ptr + 2;
+}
+
+static inline uint8_t *obus_put_u32(uint8_t *ptr, uint32_t value)
+{
+	ptr[0] = (uint8_t)(value >> 24);
+	ptr[1] = (uint8_t)(value >> 16);
+	ptr[2] = (uint8_t)(value >> 8);
+	ptr[3] = (uint8_t)value;
+	return ptr + 4;
+}
+
+static inline uint8_t *obus_put_u64(uint8_t *ptr, uint64_t value)
+{
+	ptr = obus_put_u32(ptr, (uint32_t)(value >> 32));
+	return obus_put_u32(ptr, (uint32_t)value);
+}
+
+static inline uint8_t *obus_put_f32(uint8_t *ptr, float value)
+{
+	union {
+		float f;
+		uint32_t u32;
+	} val = { .f = value };
+
+	return obus_put_u32(ptr, val.u32);
+}
+
+static inline uint8_t *obus_put_f64(uint8_t *ptr, double value)
+{
+	union {
+		double d;
+		uint64_t u64;
+	} val = { .d = value };
+
+	return obus_put_u64(ptr, val.u64);
+}
+
+/* string size is encoded in u32 and includes null terminating byte */
+static inline size_t obus_string_encoded_size(const char *str)
+{
+	return 4 + (str ? strlen(str) + 1 : 0);
+}
+
+static inline uint8_t *obus_put_string(uint8_t *ptr, const char *str)
+{
+	uint32_t size;
+
+	size = str ? (uint32_t)(strlen(str) + 1) : 0;
+	ptr = obus_put_u32(ptr, size);
+	if (size > 0)
+		memcpy(ptr, str, size);
+
+	return ptr + size;
+}
+
+/**
+ * big endian load helpers used by generated struct decoders
+ */
+static inline uint8_t obus_get_u8(const uint8_t *ptr)
+{
+	return ptr[0];
+}
+
+static inline uint16_t obus_get_u16(const uint8_t *ptr)
+{
+	return (uint16_t)((ptr[0] << 8) | ptr[1]);
+}
+
+static inline uint32_t obus_get_u32(const uint8_t *ptr)
+{
+	return ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) |
+	       ((uint32_t)ptr[2] << 8) | (uint32_t)ptr[3];
+}
+
+static inline uint64_t obus_get_u64(const uint8_t *ptr)
+{
+	return ((uint64_t)obus_get_u32(ptr) << 32) | obus_get_u32(ptr + 4);
+}
+
+static inline float obus_get_f32(const uint8_t *ptr)
+{
+	union {
+		float f;
+		uint32_t u32;
+	} val = { .u32 = obus_get_u32(ptr) };
+
+	return val.f;
+}
+
+static inline double obus_get_f64(const uint8_t *ptr)
+{
+	union {
+		double d;
+		uint64_t u64;
+	} val = { .u64 = obus_get_u64(ptr) };
+
+	return val.d;
+}
+
 /**
  * obus object method description
  */
@@ -226,6 +355,7 @@ struct obus_event_desc {
 
 /* obus method handler callback */
 struct obus_object;
+struct obus_slab;
 
 typedef void (*obus_method_handler_cb_t) (struct obus_object *obj,
 			obus_handle_t handle, const void *args);
@@ -285,6 +415,11 @@ struct obus_event {
 	unsigned int is_committed:1;
 	/* event info struct (same type as object one) */
 	struct obus_struct info;
+	/* receive buffer range borrowed by info strings & arrays, if any */
+	const void *view_start;
+	const void *view_end;
+	/* event allocator (NULL if allocated from heap) */
+	struct obus_slab *slab;
 };
 
 typedef void (*obus_provider_add_cb_t) (void *priv_object,
@@ -345,6 +480,16 @@ int obus_server_send_event(struct obus_server *srv, struct obus_event *event);
 int obus_server_send_bus_event(struct obus_server *srv,
 			       struct obus_bus_event *event);
 
+/* submit functions may be called from any thread, the loop thread being the
+ * one which has created the server. submitted events must be allocated ones,
+ * they are sent then destroyed by loop thread in submission order. objects
+ * to be registered by a bus event which can't be sent are destroyed */
+int obus_server_submit_event(struct obus_server *srv,
+			     struct obus_event *event);
+
+int obus_server_submit_bus_event(struct obus_server *srv,
+				 struct obus_bus_event *event);
+
 struct obus_object *obus_server_new_object(struct obus_server *srv,
 					   const struct obus_object_desc *desc,
 					   const obus_method_handler_cb_t *cbs,
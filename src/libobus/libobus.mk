@@ -29,6 +29,10 @@ LIBOBUS_LDFLAGS := \
 	-Wl,-z,norelro,-z,now \
 	-Wl,--export-dynamic
 
+# peers writer threads
+LIBOBUS_LDLIBS := \
+	-lpthread
+
 LIBOBUS_PUBLIC_HEADER_FILES := \
 	include/libobus.h \
 	include/libobus_private.h
@@ -47,22 +51,35 @@ LIBOBUS_HEADER_FILES := \
 	src/obus_list.h \
 	src/obus_log.h \
 	src/obus_loop.h \
+	src/obus_mirror.h \
 	src/obus_object.h \
 	src/obus_packet.h \
 	src/obus_platform.h \
+	src/obus_shm.h \
+	src/obus_slab.h \
 	src/obus_socket.h \
+	src/obus_stats.h \
 	src/obus_struct.h \
+	src/obus_submit.h \
 	src/obus_timer.h \
-	src/obus_utils.h
+	src/obus_uring.h \
+	src/obus_utils.h \
+	src/obus_worker.h
 
 LIBOBUS_SOURCE_FILES := \
 	src/obus_log.c \
 	src/obus_utils.c \
+	src/obus_stats.c \
 	src/obus_loop.c \
 	src/obus_loop_posix.c \
+	src/obus_slab.c \
 	src/obus_hash.c \
 	src/obus_timer.c \
 	src/obus_timer_posix.c \
+	src/obus_submit.c \
+	src/obus_worker.c \
+	src/obus_uring.c \
+	src/obus_shm.c \
 	src/obus_io.c \
 	src/obus_socket.c \
 	src/obus_field.c \
@@ -73,6 +90,7 @@ LIBOBUS_SOURCE_FILES := \
 	src/obus_bus_event.c \
 	src/obus_bus_api.c \
 	src/obus_bus.c \
+	src/obus_mirror.c \
 	src/obus_packet.c \
 	src/obus_server.c \
 	src/obus_client.c
@@ -49,7 +49,7 @@ struct obus_buffer {
 	size_t length;		/* buffer length */
 	size_t pos;		/* current read position */
 	uint8_t *data;		/* data address of memory buffer */
-	int refcnt;		/* buffer reference counter */
+	int refcnt;		/* buffer reference counter (atomic) */
 };
 
 static inline
@@ -92,18 +92,21 @@ struct obus_buffer *obus_buffer_new(size_t size, struct obus_buffer_pool *pool)
 static inline
 struct obus_buffer *obus_buffer_ref(struct obus_buffer *buf)
 {
-	buf->refcnt++;
+	/* buffers may be shared with worker threads once encoded */
+	__atomic_add_fetch(&buf->refcnt, 1, __ATOMIC_RELAXED);
 	return buf;
 }
 
 static inline
 int obus_buffer_unref(struct obus_buffer *buf)
 {
-	buf->refcnt--;
-	if ((buf->refcnt == 0) && buf->pool)
+	int refcnt;
+
+	refcnt = __atomic_sub_fetch(&buf->refcnt, 1, __ATOMIC_ACQ_REL);
+	if ((refcnt == 0) && buf->pool)
 		obus_buffer_pool_put(buf->pool, buf);
 
-	return buf->refcnt;
+	return refcnt;
 }
 
 static inline
@@ -522,6 +525,37 @@ int obus_buffer_read_string(struct obus_buffer *buf, char **str)
 	return 0;
 }
 
+/* read string as a view in buffer data, string is not copied */
+static inline
+int obus_buffer_read_string_view(struct obus_buffer *buf, char **str)
+{
+	int ret;
+	uint32_t size;
+
+	if (!buf || !str)
+		return -EINVAL;
+
+	/* read next 4 bytes */
+	ret = obus_buffer_read_u32(buf, &size);
+	if (ret < 0)
+		return ret;
+
+	/* NULL string */
+	if (size == 0) {
+		*str = NULL;
+		return 0;
+	}
+
+	if ((buf->pos + size) > buf->length)
+		return -EAGAIN;
+
+	/* ensure NULL terminated string */
+	*str = (char *)&buf->data[buf->pos];
+	(*str)[size - 1] = '\0';
+	buf->pos += size;
+	return 0;
+}
+
 static inline
 int obus_buffer_append_f32(struct obus_buffer *buf, float value)
 {
@@ -38,6 +38,127 @@
 
 #define OBUS_BUS_HASH_SIZE 4093
 
+/* max number of cached free hash entries */
+#define OBUS_BUS_ENTRIES_CACHE 64
+/* max number of cached free objects per object type */
+#define OBUS_BUS_OBJECTS_CACHE 16
+/* max number of cached free events per object type */
+#define OBUS_BUS_EVENTS_CACHE 16
+/* max number of cached free calls per method */
+#define OBUS_BUS_CALLS_CACHE 32
+
+static void obus_bus_destroy_slabs(struct obus_bus *bus)
+{
+	const struct obus_object_desc *obj;
+	struct obus_bus_slabs *slabs;
+	uint16_t i, j;
+
+	if (bus->slabs) {
+		for (i = 0; i < bus->api.desc->n_objects; i++) {
+			obj = bus->api.desc->objects[i];
+			slabs = &bus->slabs[i];
+			if (slabs->objects)
+				obus_slab_release(slabs->objects);
+			if (slabs->events)
+				obus_slab_release(slabs->events);
+			for (j = 0; slabs->calls && j < obj->n_methods; j++) {
+				if (slabs->calls[j])
+					obus_slab_release(slabs->calls[j]);
+			}
+			free(slabs->calls);
+		}
+		free(bus->slabs);
+		bus->slabs = NULL;
+	}
+
+	obus_hash_destroy(&bus->slabs_hash);
+
+	if (bus->entries_slab) {
+		obus_slab_release(bus->entries_slab);
+		bus->entries_slab = NULL;
+	}
+}
+
+static int obus_bus_init_slabs(struct obus_bus *bus)
+{
+	const struct obus_bus_desc *desc = bus->api.desc;
+	const struct obus_object_desc *obj;
+	struct obus_bus_slabs *slabs;
+	size_t size;
+	uint16_t i, j;
+	int ret;
+
+	/* create hash entries allocator */
+	bus->entries_slab = obus_slab_new(sizeof(struct obus_hash_entry),
+					  OBUS_BUS_ENTRIES_CACHE);
+	if (!bus->entries_slab)
+		return -ENOMEM;
+
+	ret = obus_hash_init(&bus->slabs_hash, desc->n_objects);
+	if (ret < 0)
+		goto error;
+
+	bus->slabs = calloc(desc->n_objects, sizeof(*bus->slabs));
+	if (desc->n_objects && !bus->slabs) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	/* create objects & events allocators of each bus object type */
+	for (i = 0; i < desc->n_objects; i++) {
+		obj = desc->objects[i];
+		slabs = &bus->slabs[i];
+
+		slabs->objects = obus_slab_new(obus_object_alloc_size(obj),
+					       OBUS_BUS_OBJECTS_CACHE);
+		slabs->events = obus_slab_new(sizeof(struct obus_event) +
+					      obj->info_desc->size,
+					      OBUS_BUS_EVENTS_CACHE);
+		if (!slabs->objects || !slabs->events) {
+			ret = -ENOMEM;
+			goto error;
+		}
+
+		/* calls embed their decoded method arguments */
+		slabs->calls = calloc(obj->n_methods, sizeof(*slabs->calls));
+		if (obj->n_methods && !slabs->calls) {
+			ret = -ENOMEM;
+			goto error;
+		}
+
+		for (j = 0; j < obj->n_methods; j++) {
+			size = sizeof(struct obus_call);
+			if (obj->methods[j].args_desc)
+				size += obj->methods[j].args_desc->size;
+
+			slabs->calls[j] = obus_slab_new(size,
+							OBUS_BUS_CALLS_CACHE);
+			if (!slabs->calls[j]) {
+				ret = -ENOMEM;
+				goto error;
+			}
+		}
+
+		ret = obus_hash_insert(&bus->slabs_hash, obj->uid, slabs);
+		if (ret < 0)
+			goto error;
+	}
+
+	return 0;
+
+error:
+	obus_bus_destroy_slabs(bus);
+	return ret;
+}
+
+/* per thread tag, its address identifies calling thread */
+static __thread char obus_thread_tag;
+
+int obus_bus_is_owner(const struct obus_bus *bus)
+{
+	return bus && bus->owner == &obus_thread_tag;
+}
+
 int obus_bus_init(struct obus_bus *bus, const struct obus_bus_desc *desc)
 {
 	int ret;
@@ -45,12 +166,18 @@ int obus_bus_init(struct obus_bus *bus, const struct obus_bus_desc *desc)
 		return -EINVAL;
 
 	memset(bus, 0, sizeof(*bus));
+	bus->owner = &obus_thread_tag;
 
-	/* init bus api */
-	ret = obus_bus_api_init(&bus->api, desc);
+	/* add builtin stats object type to bus description */
+	ret = obus_stats_bus_desc_init(&bus->desc, desc);
 	if (ret < 0)
 		return ret;
 
+	/* init bus api */
+	ret = obus_bus_api_init(&bus->api, &bus->desc);
+	if (ret < 0)
+		goto release_desc;
+
 	/* init bus objects list */
 	obus_list_init(&bus->objects);
 
@@ -75,14 +202,27 @@ int obus_bus_init(struct obus_bus *bus, const struct obus_bus_desc *desc)
 	if (ret < 0)
 		goto destroy_calls_hash;
 
+	/* init bus allocators */
+	ret = obus_bus_init_slabs(bus);
+	if (ret < 0)
+		goto destroy_providers_hash;
+
+	/* allocate hash entries from bus allocator */
+	obus_hash_set_slab(&bus->objects_hash, bus->entries_slab);
+	obus_hash_set_slab(&bus->calls_hash, bus->entries_slab);
+	obus_hash_set_slab(&bus->providers_hash, bus->entries_slab);
 	return 0;
 
-destroy_calls_hash:
+destroy_providers_hash:
 	obus_hash_destroy(&bus->providers_hash);
+destroy_calls_hash:
+	obus_hash_destroy(&bus->calls_hash);
 destroy_objects_hash:
 	obus_hash_destroy(&bus->objects_hash);
 destroy_api:
 	obus_bus_api_destroy(&bus->api);
+release_desc:
+	obus_stats_bus_desc_release(&bus->desc);
 	return ret;
 }
 
@@ -92,14 +232,82 @@ int obus_bus_destroy(struct obus_bus *bus)
 		return -EINVAL;
 
 	obus_bus_clear(bus);
-	obus_bus_api_destroy(&bus->api);
 	obus_hash_destroy(&bus->objects_hash);
 	obus_hash_destroy(&bus->calls_hash);
 	obus_hash_destroy(&bus->providers_hash);
+	obus_bus_destroy_slabs(bus);
+	obus_bus_api_destroy(&bus->api);
+	obus_stats_bus_desc_release(&bus->desc);
 	memset(bus, 0, sizeof(*bus));
 	return 0;
 }
 
+static struct obus_bus_slabs *
+obus_bus_slabs(struct obus_bus *bus, const struct obus_object_desc *desc)
+{
+	void *slabs;
+	int ret;
+
+	/* allocators are not thread safe, other threads use heap */
+	if (!bus || !desc || !obus_bus_is_owner(bus))
+		return NULL;
+
+	ret = obus_hash_lookup(&bus->slabs_hash, desc->uid, &slabs);
+	return (ret == 0) ? slabs : NULL;
+}
+
+struct obus_slab *obus_bus_object_slab(struct obus_bus *bus,
+				       const struct obus_object_desc *desc)
+{
+	struct obus_bus_slabs *slabs = obus_bus_slabs(bus, desc);
+	return slabs ? slabs->objects : NULL;
+}
+
+struct obus_slab *obus_bus_event_slab(struct obus_bus *bus,
+				      const struct obus_object_desc *desc)
+{
+	struct obus_bus_slabs *slabs = obus_bus_slabs(bus, desc);
+	return slabs ? slabs->events : NULL;
+}
+
+struct obus_slab *obus_bus_call_slab(struct obus_bus *bus,
+				     const struct obus_object_desc *obj,
+				     const struct obus_method_desc *desc)
+{
+	struct obus_bus_slabs *slabs = obus_bus_slabs(bus, obj);
+
+	/* method descriptions are stored in object methods array */
+	if (!slabs || !desc || desc < obj->methods ||
+	    desc >= obj->methods + obj->n_methods)
+		return NULL;
+
+	return slabs->calls[desc - obj->methods];
+}
+
+int obus_bus_get_alloc_stats(struct obus_bus *bus,
+			     struct obus_alloc_stats *stats)
+{
+	const struct obus_object_desc *obj;
+	uint16_t i, j;
+
+	if (!bus || !stats)
+		return -EINVAL;
+
+	memset(stats, 0, sizeof(*stats));
+	if (bus->entries_slab)
+		obus_slab_add_stats(bus->entries_slab, stats);
+
+	for (i = 0; bus->slabs && i < bus->api.desc->n_objects; i++) {
+		obj = bus->api.desc->objects[i];
+		obus_slab_add_stats(bus->slabs[i].objects, stats);
+		obus_slab_add_stats(bus->slabs[i].events, stats);
+		for (j = 0; j < obj->n_methods; j++)
+			obus_slab_add_stats(bus->slabs[i].calls[j], stats);
+	}
+
+	return 0;
+}
+
 /**
  * abort bus pending call
  * @param bus bus
@@ -150,6 +358,7 @@ int obus_bus_clear(struct obus_bus *bus)
 		obus_object_destroy(obj);
 	}
 
+	obus_bus_invalidate_snapshot(bus);
 	return 0;
 }
 
@@ -191,6 +400,7 @@ int obus_bus_register_call(struct obus_bus *bus, struct obus_call *call)
 
 	/* add call in list */
 	obus_list_add_before(&bus->calls, &call->node);
+	bus->n_calls++;
 	return 0;
 }
 
@@ -210,6 +420,7 @@ int obus_bus_unregister_call(struct obus_bus *bus, struct obus_call *call)
 
 	/* remove calls from list */
 	obus_list_del(&call->node);
+	bus->n_calls--;
 	return 0;
 }
 
@@ -306,7 +517,7 @@ int obus_bus_add_object(struct obus_bus *bus, struct obus_object *obj)
 		return ret;
 	}
 
-	obj->bus = bus;
+	__atomic_store_n(&obj->bus, bus, __ATOMIC_RELAXED);
 	return 0;
 }
 
@@ -329,10 +540,25 @@ int obus_bus_remove_object(struct obus_bus *bus, struct obus_object *obj)
 	return 0;
 }
 
+void obus_bus_invalidate_snapshot(struct obus_bus *bus)
+{
+	/* peers still writing it keep their own reference */
+	if (bus->snapshot) {
+		obus_buffer_unref(bus->snapshot);
+		bus->snapshot = NULL;
+	}
+}
+
 int obus_bus_register_object(struct obus_bus *bus, struct obus_object *obj)
 {
 	obj->is_registered = 1;
+	obj->reg_seq = ++bus->objects_seq;
 	obus_list_add_before(&bus->objects, &obj->node);
+	obus_bus_invalidate_snapshot(bus);
+
+	/* publish object state */
+	if (bus->mirror)
+		obus_mirror_update(bus->mirror, obj);
 	return 0;
 }
 
@@ -340,6 +566,10 @@ int obus_bus_unregister_object(struct obus_bus *bus, struct obus_object *obj)
 {
 	obj->is_registered = 0;
 	obus_list_del(&obj->node);
+	obus_bus_invalidate_snapshot(bus);
+
+	if (bus->mirror)
+		obus_mirror_remove(bus->mirror, obj);
 	return 0;
 }
 
@@ -37,24 +37,59 @@
 #ifndef _OBUS_BUS_H_
 #define _OBUS_BUS_H_
 
+/* per object type allocators */
+struct obus_bus_slabs {
+	/* objects allocator */
+	struct obus_slab *objects;
+	/* events allocator */
+	struct obus_slab *events;
+	/* calls allocators (one per object method) */
+	struct obus_slab **calls;
+};
+
 /* obus bus */
 struct obus_bus {
+	/* generated bus description with builtin objects types appended */
+	struct obus_bus_desc desc;
 	/* bus api */
 	struct obus_bus_api api;
 	/* bus object calls hash */
 	struct obus_hash calls_hash;
 	/* bus object calls list */
 	struct obus_node calls;
+	/* number of registered calls */
+	uint32_t n_calls;
 	/* bus object hash */
 	struct obus_hash objects_hash;
 	/* bus registered object list */
 	struct obus_node objects;
+	/* last object registration order */
+	uint64_t objects_seq;
 	/* bus object provider hash */
 	struct obus_hash providers_hash;
 	/* bus object  providers list */
 	struct obus_node providers;
+	/* hash entries allocator */
+	struct obus_slab *entries_slab;
+	/* object types allocators (one per bus object type) */
+	struct obus_bus_slabs *slabs;
+	/* object types allocators hash (indexed by object uid) */
+	struct obus_hash slabs_hash;
+	/* registered objects state mirror (server only, NULL if none) */
+	struct obus_mirror *mirror;
+	/* cached connection response packet (server only, NULL if stale) */
+	struct obus_buffer *snapshot;
+	/* thread tag of bus owner, allocators are only used by this thread */
+	const void *owner;
 };
 
+/**
+ * check if caller runs in thread which has initialized bus
+ * @param bus bus
+ * @return 1 if caller is bus owner thread, 0 otherwise
+ */
+int obus_bus_is_owner(const struct obus_bus *bus);
+
 /**
  * create bus from bus description
  * @param log log context
@@ -151,6 +186,12 @@ int obus_bus_add_object(struct obus_bus *bus, struct obus_object *object);
  */
 int obus_bus_remove_object(struct obus_bus *bus, struct obus_object *object);
 
+/**
+ * drop cached connection response snapshot
+ * @param bus bus
+ */
+void obus_bus_invalidate_snapshot(struct obus_bus *bus);
+
 /**
  * register object in bus
  * @param bus bus
@@ -195,4 +236,42 @@ struct obus_object *obus_bus_object_next(struct obus_bus *bus,
 					 struct obus_object *prev,
 					 uint16_t uid);
 
+/**
+ * get allocator of given object type
+ * @param bus bus
+ * @param desc object description
+ * @return slab or NULL if object type is not part of bus
+ */
+struct obus_slab *obus_bus_object_slab(struct obus_bus *bus,
+				       const struct obus_object_desc *desc);
+
+/**
+ * get events allocator of given object type
+ * @param bus bus
+ * @param desc object description
+ * @return slab or NULL if object type is not part of bus
+ */
+struct obus_slab *obus_bus_event_slab(struct obus_bus *bus,
+				      const struct obus_object_desc *desc);
+
+/**
+ * get calls allocator of given object method
+ * @param bus bus
+ * @param obj object description
+ * @param desc method description (from obj methods array)
+ * @return slab or NULL if method is not part of bus
+ */
+struct obus_slab *obus_bus_call_slab(struct obus_bus *bus,
+				     const struct obus_object_desc *obj,
+				     const struct obus_method_desc *desc);
+
+/**
+ * get bus allocation counters
+ * @param bus bus
+ * @param stats stats to be filled
+ * @return 0 on success
+ */
+int obus_bus_get_alloc_stats(struct obus_bus *bus,
+			     struct obus_alloc_stats *stats);
+
 #endif /* _OBUS_BUS_H_ */
@@ -37,10 +37,10 @@
 #include "obus_header.h"
 
 #define MTD_KEY(objuid, uid) \
-	(uint32_t)((objuid) << 16 | (uid))
+	((uint32_t)(objuid) << 16 | (uid))
 
 #define EVT_KEY(objuid, uid) \
-	(uint32_t)((objuid) << 16 | (uid))
+	((uint32_t)(objuid) << 16 | (uid))
 
 static int obus_bus_api_add_object(struct obus_bus_api *api,
 				   const struct obus_object_desc *obj)
@@ -35,6 +35,25 @@
  *****************************************************************************/
 #include "obus_header.h"
 
+/**
+ * a submitted bus event is destroyed by server loop thread while objects
+ * it registered may already be attached to a new bus event by their thread:
+ * object attachment is only checked and released through its next pointer.
+ */
+static int obus_bus_event_object_is_attached(struct obus_object *obj)
+{
+	return __atomic_load_n(&obj->event_node.next, __ATOMIC_ACQUIRE) !=
+	       (struct obus_node *)OBUS_LIST_POISON1;
+}
+
+static void obus_bus_event_object_detach(struct obus_object *obj)
+{
+	obj->event_node.prev = (struct obus_node *)OBUS_LIST_POISON2;
+	__atomic_store_n(&obj->event_node.next,
+			 (struct obus_node *)OBUS_LIST_POISON1,
+			 __ATOMIC_RELEASE);
+}
+
 void obus_bus_event_init(struct obus_bus_event *event,
 			const struct obus_bus_event_desc *desc)
 {
@@ -61,7 +80,7 @@ int obus_bus_event_register_object(struct obus_bus_event *bus_event,
 		return -EINVAL;
 
 	/* object can only be added once in a bus event */
-	if (obus_node_is_ref(&object->event_node)) {
+	if (obus_bus_event_object_is_attached(object)) {
 		obus_error("%s: object '%s' already attached to a bus event",
 			   __func__, object->desc->name);
 		return -EPERM;
@@ -80,7 +99,7 @@ int obus_bus_event_unregister_object(struct obus_bus_event *bus_event,
 		return -EINVAL;
 
 	/* object can only be added once in a bus event */
-	if (obus_node_is_ref(&object->event_node)) {
+	if (obus_bus_event_object_is_attached(object)) {
 		obus_error("%s: object '%s' already attached to a bus event",
 			   __func__, object->desc->name);
 		return -EPERM;
@@ -147,10 +166,11 @@ OBUS_API int obus_bus_event_destroy(struct obus_bus_event *event)
 	/**
 	 * only unref object from bus event.
 	 * object added or removed in bus event are owned by server.
+	 * whole list is dropped, neighbour nodes are left untouched.
 	 * */
 	obus_list_walk_entry_forward_safe(&event->add_objs, obj, otmp,
 					  event_node) {
-		obus_list_del(&obj->event_node);
+		obus_bus_event_object_detach(obj);
 	}
 
 	obus_list_walk_entry_forward_safe(&event->remove_objs, obj, otmp,
@@ -205,8 +225,48 @@ void obus_bus_event_log(struct obus_bus_event *event,
 	}
 }
 
+static inline int obus_bus_event_keep_object(
+				const struct obus_bus_event_filter *filter,
+				struct obus_object *obj)
+{
+	return !filter || !filter->object || filter->object(filter->data, obj);
+}
+
+static inline int obus_bus_event_keep_event(
+				const struct obus_bus_event_filter *filter,
+				struct obus_event *evt)
+{
+	return !filter || !filter->event || filter->event(filter->data, evt);
+}
+
+static inline const uint32_t *obus_bus_event_mask(
+				const struct obus_bus_event_filter *filter,
+				struct obus_object *obj)
+{
+	return (filter && filter->mask) ? filter->mask(filter->data, obj) :
+					  NULL;
+}
+
+static uint32_t obus_bus_event_count_objects(struct obus_node *list,
+				const struct obus_bus_event_filter *filter)
+{
+	uint32_t n_items = 0;
+	struct obus_object *obj;
+
+	if (!filter)
+		return (uint32_t)obus_list_length(list);
+
+	obus_list_walk_entry_forward(list, obj, event_node) {
+		if (obus_bus_event_keep_object(filter, obj))
+			n_items++;
+	}
+
+	return n_items;
+}
+
 int obus_bus_event_encode(struct obus_bus_event *event,
-			  struct obus_buffer *buf)
+			  struct obus_buffer *buf,
+			  const struct obus_bus_event_filter *filter)
 {
 	int ret;
 	uint32_t n_items;
@@ -219,33 +279,49 @@ int obus_bus_event_encode(struct obus_bus_event *event,
 		return ret;
 
 	/* add number of registered objects */
-	n_items = (uint32_t)obus_list_length(&event->add_objs);
+	n_items = obus_bus_event_count_objects(&event->add_objs, filter);
 	ret = obus_buffer_append_u32(buf, n_items);
 	if (ret < 0)
 		return ret;
 
 	/* add number of unregistered objects */
-	n_items = (uint32_t)obus_list_length(&event->remove_objs);
+	n_items = obus_bus_event_count_objects(&event->remove_objs, filter);
 	ret = obus_buffer_append_u32(buf, n_items);
 	if (ret < 0)
 		return ret;
 
 	/* add number of objects events */
-	n_items = (uint32_t)obus_list_length(&event->obj_events);
+	if (!filter) {
+		n_items = (uint32_t)obus_list_length(&event->obj_events);
+	} else {
+		n_items = 0;
+		obus_list_walk_entry_forward(&event->obj_events, evt,
+					     event_node) {
+			if (obus_bus_event_keep_event(filter, evt))
+				n_items++;
+		}
+	}
 	ret = obus_buffer_append_u32(buf, n_items);
 	if (ret < 0)
 		return ret;
 
 	/* encode object */
 	obus_list_walk_entry_forward(&event->add_objs, obj, event_node) {
+		if (!obus_bus_event_keep_object(filter, obj))
+			continue;
+
 		/* encode object */
-		ret = obus_object_add_encode(obj, buf);
+		ret = obus_object_add_encode_masked(obj, buf,
+				obus_bus_event_mask(filter, obj));
 		if (ret < 0)
 			return ret;
 	}
 
 	/* encode number of unregistered object */
 	obus_list_walk_entry_forward(&event->remove_objs, obj, event_node) {
+		if (!obus_bus_event_keep_object(filter, obj))
+			continue;
+
 		/* encode unregister object */
 		ret = obus_object_remove_encode(obj, buf);
 		if (ret < 0)
@@ -254,8 +330,12 @@ int obus_bus_event_encode(struct obus_bus_event *event,
 
 	/* encode object event */
 	obus_list_walk_entry_forward(&event->obj_events, evt, event_node) {
+		if (!obus_bus_event_keep_event(filter, evt))
+			continue;
+
 		/* encode object */
-		ret = obus_event_encode(evt, buf);
+		ret = obus_event_encode_masked(evt, buf,
+				obus_bus_event_mask(filter, evt->obj));
 		if (ret < 0)
 			return ret;
 	}
@@ -264,7 +344,8 @@ int obus_bus_event_encode(struct obus_bus_event *event,
 }
 
 struct obus_bus_event *obus_bus_event_decode(struct obus_bus *bus,
-					     struct obus_buffer *buf)
+					     struct obus_buffer *buf,
+					     int borrow)
 {
 	int ret;
 	uint16_t uid;
@@ -306,7 +387,7 @@ struct obus_bus_event *obus_bus_event_decode(struct obus_bus *bus,
 
 	/* parse add objects */
 	for (i = 0; i < n_add_objs; i++) {
-		obj = obus_object_add_decode(&bus->api, buf);
+		obj = obus_object_add_decode(bus, buf);
 		if (!obj)
 			continue;
 
@@ -326,7 +407,7 @@ struct obus_bus_event *obus_bus_event_decode(struct obus_bus *bus,
 
 	/* parse event objects */
 	for (i = 0; i < n_obj_events; i++) {
-		evt = obus_event_decode(bus, buf);
+		evt = obus_event_decode(bus, buf, borrow);
 		if (!evt)
 			continue;
 
@@ -52,6 +52,18 @@ struct obus_bus_event {
 	unsigned int is_allocated:1;
 };
 
+/* per receiver bus event content filter (callbacks return 1 to keep item) */
+struct obus_bus_event_filter {
+	/* registered or unregistered object filter */
+	int (*object)(void *data, struct obus_object *obj);
+	/* object event filter */
+	int (*event)(void *data, struct obus_event *evt);
+	/* object fields mask (optional, NULL mask for all fields) */
+	const uint32_t *(*mask)(void *data, struct obus_object *obj);
+	/* filter callbacks data */
+	void *data;
+};
+
 const struct obus_bus_event_desc *
 obus_bus_event_get_desc(const struct obus_bus_event *event);
 
@@ -68,10 +80,12 @@ int obus_bus_event_add_event(struct obus_bus_event *bus_event,
 			     struct obus_event *event);
 
 int obus_bus_event_encode(struct obus_bus_event *event,
-			  struct obus_buffer *buf);
+			  struct obus_buffer *buf,
+			  const struct obus_bus_event_filter *filter);
 
 struct obus_bus_event *
-obus_bus_event_decode(struct obus_bus *bus, struct obus_buffer *buf);
+obus_bus_event_decode(struct obus_bus *bus, struct obus_buffer *buf,
+		      int borrow);
 
 void obus_bus_event_log(struct obus_bus_event *event,
 			enum obus_log_level level,
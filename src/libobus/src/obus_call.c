@@ -42,21 +42,20 @@ struct obus_call *obus_call_new(struct obus_object *obj,
 				const struct obus_struct *args)
 {
 	struct obus_call *call;
-	off_t args_offset;
+	struct obus_slab *slab;
 	size_t size;
 
 	if (!obj || !desc)
 		return NULL;
 
+	/* method may have no args !*/
 	size = sizeof(*call);
-	if (!args) {
-		args_offset = (off_t)size;
-		/* method may have no args !*/
-		if (desc->args_desc)
-			size += desc->args_desc->size;
-	}
+	if (desc->args_desc)
+		size += desc->args_desc->size;
 
-	call = calloc(size, sizeof(*call));
+	/* allocate call from object bus if any */
+	slab = obj->bus ? obus_bus_call_slab(obj->bus, obj->desc, desc) : NULL;
+	call = slab ? obus_slab_alloc(slab) : calloc(1, size);
 	if (!call)
 		return NULL;
 
@@ -66,13 +65,14 @@ struct obus_call *obus_call_new(struct obus_object *obj,
 	call->obj = obj;
 	call->status = OBUS_CALL_INVALID;
 	call->cb = cb;
+	call->slab = slab;
 	call->args.desc = desc->args_desc;
 
 	if (call->args.desc) {
 		if (args)
 			call->args.u.addr = args->u.addr;
 		else
-			call->args.u.addr = ((uint8_t *)call + args_offset);
+			call->args.u.addr = ((uint8_t *)call + sizeof(*call));
 	}
 
 	return call;
@@ -86,7 +86,10 @@ int obus_call_destroy(struct obus_call *call)
 	if (call->args.desc && call->args.u.addr)
 		obus_struct_destroy(&call->args);
 
-	free(call);
+	if (call->slab)
+		obus_slab_free(call->slab, call);
+	else
+		free(call);
 	return 0;
 }
 
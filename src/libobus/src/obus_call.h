@@ -48,12 +48,18 @@ struct obus_call {
 	obus_handle_t handle;
 	/* peer which do the call */
 	struct obus_peer *peer;
+	/* call handle given by peer (server side) */
+	obus_handle_t peer_handle;
+	/* ack will be sent later by method handler (server side) */
+	int is_deferred;
 	/* call status */
 	enum obus_call_status status;
 	/* method call arguments */
 	struct obus_struct args;
 	/* call ack handler */
 	obus_method_call_status_handler_cb_t cb;
+	/* call allocator (NULL if allocated from heap) */
+	struct obus_slab *slab;
 };
 
 struct obus_call *obus_call_new(struct obus_object *obj,
@@ -89,6 +89,12 @@ struct obus_client {
 	struct obus_buffer_pool pool;
 	/* client packet decoder */
 	struct obus_packet_decoder decoder;
+	/* server broadcast log ('shm:' address, NULL if none) */
+	struct obus_shm_log *shm_log;
+	/* broadcast log read position */
+	uint64_t log_pos;
+	/* broadcast log packet decoder */
+	struct obus_packet_decoder log_decoder;
 	/* connected event desc */
 	const struct obus_bus_event_desc *connected_desc;
 	/* disconnected event desc */
@@ -97,6 +103,22 @@ struct obus_client {
 	const struct obus_bus_event_desc *connection_refused_desc;
 	/* log flags */
 	uint32_t log_flags;
+	/* borrow received events strings & arrays from rx buffer */
+	int borrowed_events;
+	/* calls are batched until flushed */
+	int corked;
+	/* max number of calls waiting for ack (0 for no limit) */
+	uint32_t max_pending_calls;
+	/* all objects registered at connection have been received */
+	int synced;
+	/* objects subscriptions sent to server */
+	struct obus_packet_subscribe sub;
+	/* encoding/decoding time counters */
+	struct obus_stats stats;
+	/* packets counters */
+	struct obus_traffic_stats traffic;
+	/* number of connections to server */
+	uint32_t n_connections;
 };
 
 static void obus_client_handle_bus_event(struct obus_client *client,
@@ -140,6 +162,12 @@ static void obus_client_disconnect(struct obus_client *client, int reconnect)
 		/* destroy decoder */
 		obus_packet_decoder_destroy(&client->decoder);
 
+		/* log is owned by socket client */
+		if (client->shm_log) {
+			obus_packet_decoder_destroy(&client->log_decoder);
+			client->shm_log = NULL;
+		}
+
 		/* destroy io */
 		obus_io_destroy(client->io);
 		client->io = NULL;
@@ -173,7 +201,8 @@ static void obus_client_io_write_done(enum obus_io_status status,
 	/* unref buffer */
 	obus_buffer_unref(buf);
 
-	if (status != OBUS_IO_OK) {
+	/* aborted buffers are given back while io is destroyed */
+	if (status != OBUS_IO_OK && status != OBUS_IO_ABORT) {
 		/* write failed => disconnect client */
 		obus_info("obus client write failed: status=%d", status);
 		obus_client_disconnect(client, 1);
@@ -291,8 +320,11 @@ static void obus_client_connection_response(struct obus_client *client,
 		return;
 	}
 
-	/* update client state to connected */
+	/* update client state to connected, objects registered on server
+	 * are received in response or in sync chunks following it */
 	client->state = STATE_CONNECTED;
+	client->n_connections++;
+	client->synced = pkt->streamed ? 0 : 1;
 
 	if (client->log_flags & OBUS_LOG_CONNECTION)
 		obus_info("client connected to '%s' bus",
@@ -312,6 +344,33 @@ static void obus_client_connection_response(struct obus_client *client,
 	obus_client_handle_bus_event(client, &event);
 }
 
+static void obus_client_sync(struct obus_client *client,
+			     struct obus_packet_sync *pkt)
+{
+	struct obus_object *obj, *tmp;
+
+	if (client->log_flags & OBUS_LOG_BUS)
+		obus_info("server objects sync: %zu objects%s",
+			  obus_list_length(&pkt->objects),
+			  pkt->last ? " (last)" : "");
+
+	/* add objects as they arrive */
+	obus_list_walk_entry_forward_safe(&pkt->objects, obj, tmp, node) {
+		obus_list_del(&obj->node);
+		if (client->state == STATE_CONNECTED)
+			obus_client_add_object(client, obj, NULL, 1);
+		else
+			obus_object_destroy(obj);
+	}
+
+	if (pkt->last && client->state == STATE_CONNECTED) {
+		client->synced = 1;
+		if (client->log_flags & OBUS_LOG_CONNECTION)
+			obus_info("client synchronized with '%s' bus",
+				  client->bus.api.desc->name);
+	}
+}
+
 static void obus_client_remove_object(struct obus_client *client,
 				      struct obus_object *obj,
 				      const struct obus_bus_event *event)
@@ -438,11 +497,107 @@ static void obus_client_handle_bus_event(struct obus_client *client,
 	obus_bus_event_destroy(event);
 }
 
+static void obus_client_handle_packet(struct obus_client *client,
+				      struct obus_packet_info *info)
+{
+	switch (info->type) {
+	case OBUS_PKT_CONRESP:
+		obus_client_connection_response(client, &info->conresp);
+	break;
+
+	case OBUS_PKT_ADD:
+		obus_client_add_object(client, info->object, NULL, 1);
+	break;
+
+	case OBUS_PKT_REMOVE:
+		obus_client_remove_object(client, info->object, NULL);
+	break;
+
+	case OBUS_PKT_EVENT:
+		obus_client_event(client, info->event, NULL);
+	break;
+
+	case OBUS_PKT_BUS_EVENT:
+		obus_client_handle_bus_event(client, info->bus_event);
+	break;
+
+	case OBUS_PKT_ACK:
+		obus_client_ack(client, &info->ack);
+	break;
+
+	case OBUS_PKT_SYNC:
+		obus_client_sync(client, &info->sync);
+	break;
+
+	/* packets from clients, should not be received */
+	case OBUS_PKT_SUBSCRIBE:
+		obus_packet_subscribe_release(&info->sub);
+	break;
+
+	/* other packet should not be received by clients */
+	case OBUS_PKT_CONREQ:
+	case OBUS_PKT_CALL:
+	case OBUS_PKT_COUNT:
+	default:
+	break;
+	}
+}
+
+/* process server broadcast log packets up to its current head, if wait is
+ * set server is asked to wake up client on next log packet.
+ * return -ESTALE if client is lagging and must resync */
+static int obus_client_read_log(struct obus_client *client, int wait)
+{
+	struct obus_packet_decoder *d = &client->log_decoder;
+	struct obus_packet_info info;
+	size_t len;
+	int ret;
+
+again:
+	/* log is read once connection response gave its start position */
+	if (!client->shm_log || client->state != STATE_CONNECTED)
+		return 0;
+
+	while ((ret = obus_shm_log_peek(client->shm_log, client->log_pos,
+					&len)) == 0) {
+		/* copy packet in decoder buffer */
+		ret = obus_buffer_ensure_write_space(d->buf, len);
+		if (ret < 0)
+			return ret;
+
+		ret = obus_shm_log_read(client->shm_log, &client->log_pos,
+					obus_buffer_write_ptr(d->buf), len);
+		if (ret < 0)
+			return ret;
+
+		obus_buffer_inc_write_ptr(d->buf, len);
+
+		/* decode and process packet */
+		while (obus_packet_decoder_read(d, &info) == 0) {
+			obus_client_handle_packet(client, &info);
+			if (client->state != STATE_CONNECTED)
+				return 0;
+		}
+	}
+
+	if (ret != -EAGAIN)
+		return ret;
+
+	/* ask for a wake up, then check no packet was appended meanwhile */
+	if (wait) {
+		obus_shm_log_wait(obus_socket_client_shm(client->sk));
+		wait = 0;
+		goto again;
+	}
+
+	return 0;
+}
+
 static void obus_client_io_read_event(int events, void *user_data)
 {
 	struct obus_client *client = user_data;
 	struct obus_packet_info info;
-	int ret;
+	int ret, log_ret;
 
 	if (obus_fd_event_error(events)) {
 		/* disconnect client on error */
@@ -460,8 +615,11 @@ static void obus_client_io_read_event(int events, void *user_data)
 		/* read packet */
 		ret = obus_packet_decoder_read(&client->decoder, &info);
 		/* if no more data available wait ... */
-		if (ret == -EAGAIN)
-			return;
+		if (ret == -EAGAIN) {
+			/* ... after having processed broadcast log */
+			log_ret = obus_client_read_log(client, 1);
+			goto check_log;
+		}
 
 		if (ret < 0) {
 			/* read error occurs: disconnect client */
@@ -470,41 +628,58 @@ static void obus_client_io_read_event(int events, void *user_data)
 			return;
 		}
 
-		/* packet read ok, now decode it */
-		switch (info.type) {
-		case OBUS_PKT_CONRESP:
-			obus_client_connection_response(client, &info.conresp);
-		break;
-
-		case OBUS_PKT_ADD:
-			obus_client_add_object(client, info.object, NULL, 1);
-		break;
-
-		case OBUS_PKT_REMOVE:
-			obus_client_remove_object(client, info.object, NULL);
-		break;
-
-		case OBUS_PKT_EVENT:
-			obus_client_event(client, info.event, NULL);
-		break;
-
-		case OBUS_PKT_BUS_EVENT:
-			obus_client_handle_bus_event(client, info.bus_event);
-		break;
-
-		case OBUS_PKT_ACK:
-			obus_client_ack(client, &info.ack);
-		break;
-
-		/* other packet should not be received by clients */
-		case OBUS_PKT_CONREQ:
-		case OBUS_PKT_CALL:
-		case OBUS_PKT_COUNT:
-		default:
-		break;
+		/* log packets written before this one are processed first,
+		 * connection response gives log start position */
+		if (info.type == OBUS_PKT_CONRESP && client->shm_log) {
+			client->log_pos = obus_shm_get_log_start(
+					obus_socket_client_shm(client->sk));
+			log_ret = 0;
+		} else {
+			log_ret = obus_client_read_log(client, 0);
+		}
+
+check_log:
+		/* a log event callback may have disconnected client */
+		if (!client->io)
+			return;
+
+		if (log_ret < 0) {
+			/* resync from a new connection objects snapshot */
+			obus_info("obus client lagging behind bus log (%d)",
+				  log_ret);
+			obus_client_disconnect(client, 1);
+			return;
 		}
 
-	} while (ret == 0);
+		/* packet read ok, now decode it */
+		if (ret == 0)
+			obus_client_handle_packet(client, &info);
+
+	} while (ret == 0 && client->io);
+}
+
+/* write packet to server, buffer ref is released once written */
+static int obus_client_write(struct obus_client *client,
+			     struct obus_buffer *buf)
+{
+	size_t length = obus_buffer_length(buf);
+	int ret;
+
+	ret = obus_io_write(client->io, buf);
+	if (ret == 0) {
+		/* buffer written, unref it */
+		obus_buffer_unref(buf);
+	} else if (ret == -EAGAIN) {
+		/* buffer put in write queue don't unref it */
+		ret = 0;
+	} else {
+		/* buffer write failure */
+		obus_buffer_unref(buf);
+		return ret;
+	}
+
+	obus_traffic_tx(&client->traffic, length);
+	return 0;
 }
 
 static int obus_client_send_connection_request(struct obus_client *client)
@@ -520,7 +695,8 @@ static int obus_client_send_connection_request(struct obus_client *client)
 	/* encode packet */
 	ret = obus_packet_conreq_encode(buf, client->name,
 					client->bus.api.desc->name,
-					client->bus.api.desc->crc);
+					client->bus.api.desc->crc,
+					&client->sub);
 	if (ret < 0) {
 		obus_error("can't encode connection request packet error=%d",
 			   ret);
@@ -529,19 +705,46 @@ static int obus_client_send_connection_request(struct obus_client *client)
 	}
 
 	/* write packet */
-	ret = obus_io_write(client->io, buf);
-	if (ret == 0) {
-		/* buffer written, unref it */
-		obus_buffer_unref(buf);
-	} else if (ret == -EAGAIN) {
-		/* buffer put in write queue don't unref it */
-		ret = 0;
-	} else {
-		/* buffer write failure */
+	return obus_client_write(client, buf);
+}
+
+static int obus_client_send_subscriptions(struct obus_client *client)
+{
+	struct obus_buffer *buf;
+	int ret;
+
+	/* subscriptions are sent with connection request */
+	if (!obus_client_is_connected(client))
+		return 0;
+
+	/* peek buffer */
+	buf = obus_buffer_pool_peek(&client->pool);
+	if (!buf)
+		return -ENOMEM;
+
+	/* encode packet */
+	ret = obus_packet_subscribe_encode(buf, &client->sub);
+	if (ret < 0) {
+		obus_error("can't encode subscribe packet error=%d", ret);
 		obus_buffer_unref(buf);
+		return ret;
 	}
 
-	return ret;
+	/* write packet */
+	return obus_client_write(client, buf);
+}
+
+static struct obus_subscription *
+obus_client_find_subscription(struct obus_client *client, uint16_t uid)
+{
+	uint16_t i;
+
+	for (i = 0; i < client->sub.n_subs; i++) {
+		if (client->sub.subs[i].uid == uid)
+			return &client->sub.subs[i];
+	}
+
+	return NULL;
 }
 
 static void obus_client_socket_connected(struct obus_socket_client *sk,
@@ -564,6 +767,16 @@ static void obus_client_socket_connected(struct obus_socket_client *sk,
 		return;
 	}
 
+	/* switch io to shared memory channel if any */
+	if (obus_socket_client_shm(client->sk)) {
+		ret = obus_io_set_shm(client->io,
+				      obus_socket_client_shm(client->sk));
+		if (ret < 0) {
+			obus_client_disconnect(client, 1);
+			return;
+		}
+	}
+
 	/* get rx buffer for decoder */
 	buf = obus_buffer_pool_peek(&client->pool);
 	if (!buf) {
@@ -580,14 +793,39 @@ static void obus_client_socket_connected(struct obus_socket_client *sk,
 	/* init decoder */
 	obus_packet_decoder_init(&client->decoder, buf, &client->bus,
 				 client->io, log_io);
+	obus_packet_decoder_set_stats(&client->decoder, &client->stats,
+				      &client->traffic);
+	client->decoder.borrow = client->borrowed_events;
 	obus_buffer_unref(buf);
 
+	/* init server broadcast log decoder, fed by client */
+	if (obus_socket_client_shm_log(client->sk)) {
+		buf = obus_buffer_pool_peek(&client->pool);
+		if (!buf) {
+			obus_client_disconnect(client, 1);
+			return;
+		}
+
+		client->shm_log = obus_socket_client_shm_log(client->sk);
+		obus_packet_decoder_init(&client->log_decoder, buf,
+					 &client->bus, NULL, log_io);
+		obus_packet_decoder_set_stats(&client->log_decoder,
+					      &client->stats, &client->traffic);
+		client->log_decoder.borrow = client->borrowed_events;
+		obus_buffer_unref(buf);
+	}
+
 	/* send bus connection request */
 	ret = obus_client_send_connection_request(client);
 	if (ret < 0) {
 		obus_error("can't send connection request");
 		obus_client_disconnect(client, 1);
+		return;
 	}
+
+	/* keep batching calls if requested */
+	if (client->corked)
+		obus_io_set_cork(client->io, 1);
 }
 
 OBUS_API
@@ -693,6 +931,7 @@ OBUS_API int obus_client_destroy(struct obus_client *client)
 	obus_bus_destroy(&client->bus);
 	obus_loop_unref(client->loop);
 	obus_buffer_pool_destroy(&client->pool);
+	obus_packet_subscribe_release(&client->sub);
 	free(client->name);
 	free(client);
 	return 0;
@@ -703,6 +942,244 @@ OBUS_API int obus_client_is_connected(struct obus_client *client)
 	return (client && client->state == STATE_CONNECTED) ? 1 : 0;
 }
 
+OBUS_API int obus_client_is_synced(struct obus_client *client)
+{
+	return (obus_client_is_connected(client) && client->synced) ? 1 : 0;
+}
+
+OBUS_API int obus_client_subscribe(struct obus_client *client, uint16_t uid,
+				   const uint16_t *events, uint16_t n_events)
+{
+	const struct obus_object_desc *desc;
+	struct obus_subscription *sub, *subs;
+	uint16_t *evts = NULL;
+	uint16_t i;
+
+	if (!client || (n_events && !events))
+		return -EINVAL;
+
+	desc = obus_bus_api_object(&client->bus.api, uid);
+	if (!desc)
+		return -ENOENT;
+
+	for (i = 0; i < n_events; i++) {
+		if (!obus_bus_api_event(&client->bus.api, uid, events[i]))
+			return -ENOENT;
+	}
+
+	if (n_events) {
+		evts = malloc(n_events * sizeof(*evts));
+		if (!evts)
+			return -ENOMEM;
+		memcpy(evts, events, n_events * sizeof(*evts));
+	}
+
+	sub = obus_client_find_subscription(client, uid);
+	if (!sub) {
+		subs = realloc(client->sub.subs, (client->sub.n_subs + 1) *
+			       sizeof(*subs));
+		if (!subs) {
+			free(evts);
+			return -ENOMEM;
+		}
+		client->sub.subs = subs;
+		sub = &subs[client->sub.n_subs++];
+		memset(sub, 0, sizeof(*sub));
+		sub->uid = uid;
+	}
+
+	free(sub->events);
+	sub->events = evts;
+	sub->n_events = n_events;
+	client->sub.filtered = 1;
+	return obus_client_send_subscriptions(client);
+}
+
+OBUS_API int obus_client_subscribe_fields(struct obus_client *client,
+					  uint16_t uid, const uint16_t *fields,
+					  uint16_t n_fields)
+{
+	const struct obus_object_desc *desc;
+	struct obus_struct st;
+	struct obus_subscription *sub;
+	uint16_t *flds = NULL;
+	uint16_t i;
+	int ret;
+
+	if (!client || (n_fields && !fields))
+		return -EINVAL;
+
+	desc = obus_bus_api_object(&client->bus.api, uid);
+	if (!desc)
+		return -ENOENT;
+
+	st.desc = desc->info_desc;
+	st.u.addr = NULL;
+	for (i = 0; i < n_fields; i++) {
+		if (!obus_struct_get_field_desc(&st, fields[i]))
+			return -ENOENT;
+	}
+
+	/* subscribe to all object events if not subscribed yet */
+	sub = obus_client_find_subscription(client, uid);
+	if (!sub) {
+		ret = obus_client_subscribe(client, uid, NULL, 0);
+		if (ret < 0)
+			return ret;
+
+		sub = obus_client_find_subscription(client, uid);
+	}
+
+	if (n_fields) {
+		flds = malloc(n_fields * sizeof(*flds));
+		if (!flds)
+			return -ENOMEM;
+		memcpy(flds, fields, n_fields * sizeof(*flds));
+	}
+
+	free(sub->fields);
+	sub->fields = flds;
+	sub->n_fields = n_fields;
+	return obus_client_send_subscriptions(client);
+}
+
+OBUS_API int obus_client_unsubscribe(struct obus_client *client, uint16_t uid)
+{
+	struct obus_subscription *sub;
+	uint16_t idx;
+
+	if (!client)
+		return -EINVAL;
+
+	sub = obus_client_find_subscription(client, uid);
+	if (sub) {
+		/* replace entry by last one */
+		idx = (uint16_t)(sub - client->sub.subs);
+		free(sub->events);
+		free(sub->fields);
+		client->sub.subs[idx] = client->sub.subs[--client->sub.n_subs];
+	}
+
+	client->sub.filtered = 1;
+	return obus_client_send_subscriptions(client);
+}
+
+OBUS_API int obus_client_subscribe_all(struct obus_client *client)
+{
+	if (!client)
+		return -EINVAL;
+
+	obus_packet_subscribe_release(&client->sub);
+	client->sub.filtered = 0;
+	return obus_client_send_subscriptions(client);
+}
+
+OBUS_API int obus_client_set_borrowed_events(struct obus_client *client,
+					     int enable)
+{
+	if (!client)
+		return -EINVAL;
+
+	client->borrowed_events = enable ? 1 : 0;
+	client->decoder.borrow = client->borrowed_events;
+	client->log_decoder.borrow = client->borrowed_events;
+	return 0;
+}
+
+OBUS_API int obus_client_cork_calls(struct obus_client *client)
+{
+	if (!client)
+		return -EINVAL;
+
+	client->corked = 1;
+	return client->io ? obus_io_set_cork(client->io, 1) : 0;
+}
+
+OBUS_API int obus_client_flush_calls(struct obus_client *client)
+{
+	if (!client)
+		return -EINVAL;
+
+	/* io may be destroyed on write error */
+	client->corked = 0;
+	return client->io ? obus_io_set_cork(client->io, 0) : 0;
+}
+
+OBUS_API int obus_client_set_max_pending_calls(struct obus_client *client,
+					       uint32_t max)
+{
+	if (!client)
+		return -EINVAL;
+
+	client->max_pending_calls = max;
+	return 0;
+}
+
+OBUS_API int obus_client_get_pending_calls(struct obus_client *client)
+{
+	return client ? (int)client->bus.n_calls : -EINVAL;
+}
+
+OBUS_API
+int obus_client_get_alloc_stats(struct obus_client *client,
+				struct obus_alloc_stats *stats)
+{
+	if (!client)
+		return -EINVAL;
+
+	return obus_bus_get_alloc_stats(&client->bus, stats);
+}
+
+OBUS_API
+int obus_client_set_stats_timing(struct obus_client *client, int enable)
+{
+	if (!client)
+		return -EINVAL;
+
+	client->stats.timing = enable ? 1 : 0;
+	return 0;
+}
+
+OBUS_API
+int obus_client_get_stats(struct obus_client *client,
+			  struct obus_client_stats *stats)
+{
+	if (!client || !stats)
+		return -EINVAL;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->traffic = client->traffic;
+	stats->n_connections = client->n_connections;
+	stats->n_pending_calls = client->bus.n_calls;
+	if (client->io) {
+		stats->queued_bytes = obus_io_get_pending_bytes(client->io);
+		stats->queued_packets = obus_io_get_pending_count(client->io);
+	}
+
+	stats->encode = client->stats.encode;
+	stats->decode = client->stats.decode;
+	return 0;
+}
+
+OBUS_API
+int obus_client_get_server_stats(struct obus_client *client,
+				 struct obus_server_stats *stats)
+{
+	struct obus_object *obj;
+
+	if (!client || !stats)
+		return -EINVAL;
+
+	/* stats object is only known if bus does not use its uid */
+	obj = obus_bus_object_first(&client->bus, OBUS_STATS_UID);
+	if (!obj || obj->desc != &obus_stats_desc ||
+	    !obus_object_is_registered(obj))
+		return -ENOENT;
+
+	obus_stats_info_get(obus_object_get_info(obj), stats);
+	return 0;
+}
+
 OBUS_API int obus_client_fd(struct obus_client *client)
 {
 	return client ? obus_loop_fd(client->loop) : -1;
@@ -774,6 +1251,7 @@ OBUS_API int obus_client_call(struct obus_client *client,
 	struct obus_call *call;
 	struct obus_buffer *buf;
 	enum obus_method_state state;
+	uint64_t start;
 	int ret;
 
 	if (!client || !obj || !desc)
@@ -801,6 +1279,11 @@ OBUS_API int obus_client_call(struct obus_client *client,
 		return -EPERM;
 	}
 
+	/* check outstanding calls limit */
+	if (client->max_pending_calls &&
+	    client->bus.n_calls >= client->max_pending_calls)
+		return -EBUSY;
+
 	/* create call object */
 	call = obus_call_new(obj, desc, cb, args);
 	if (!call)
@@ -819,24 +1302,18 @@ OBUS_API int obus_client_call(struct obus_client *client,
 	}
 
 	/* encode object call packet */
+	start = obus_stats_start(&client->stats);
 	ret = obus_packet_call_encode(buf, call);
+	obus_time_hist_add(&client->stats.encode, start);
 	if (ret < 0) {
 		obus_error("can't encode call packet");
 		goto unref_buffer;
 	}
 
 	/* write buffer */
-	ret = obus_io_write(client->io, buf);
-	if (ret == 0) {
-		/* buffer written, unref it */
-		obus_buffer_unref(buf);
-	} else if (ret == -EAGAIN) {
-		/* buffer put in write queue don't unref it */
-		ret = 0;
-	} else {
-		/* buffer write failure */
-		goto unref_buffer;
-	}
+	ret = obus_client_write(client, buf);
+	if (ret < 0)
+		goto unregister_call;
 
 	if (client->log_flags & OBUS_LOG_BUS)
 		obus_call_log(call, OBUS_LOG_INFO);
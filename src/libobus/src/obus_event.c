@@ -62,14 +62,22 @@ OBUS_API int obus_event_init(struct obus_event *event,
 	return 0;
 }
 
+static void obus_event_free(struct obus_event *event)
+{
+	if (event->slab)
+		obus_slab_free(event->slab, event);
+	else
+		free(event);
+}
+
 OBUS_API
 struct obus_event *obus_event_new(struct obus_object *obj,
 				  const struct obus_event_desc *desc,
 				  const struct obus_struct *info)
 {
 	struct obus_event *event;
-	off_t info_offset;
-	size_t size;
+	struct obus_slab *slab;
+	struct obus_bus *bus;
 	int ret;
 
 	if (!obj || !desc)
@@ -80,13 +88,12 @@ struct obus_event *obus_event_new(struct obus_object *obj,
 		return NULL;
 	}
 
-	/* compute event size allocation */
-	size = sizeof(*event);
-	info_offset = (off_t)size;
-	size += obj->desc->info_desc->size;
-
-	/* allocate object */
-	event = calloc(1, size);
+	/* allocate event and its info struct from object bus if any, object
+	 * created by another thread may be added in bus meanwhile */
+	bus = __atomic_load_n(&obj->bus, __ATOMIC_RELAXED);
+	slab = bus ? obus_bus_event_slab(bus, obj->desc) : NULL;
+	event = slab ? obus_slab_alloc(slab) :
+		       calloc(1, sizeof(*event) + obj->desc->info_desc->size);
 	if (!event)
 		return NULL;
 
@@ -97,8 +104,9 @@ struct obus_event *obus_event_new(struct obus_object *obj,
 	event->obj = obj;
 	event->is_committed = 0;
 	event->is_allocated = 1;
+	event->slab = slab;
 	event->info.desc = obj->desc->info_desc;
-	event->info.u.addr = ((uint8_t *)event + info_offset);
+	event->info.u.addr = ((uint8_t *)event + sizeof(*event));
 
 	/* init event info struct */
 	ret = obus_struct_init(&event->info);
@@ -115,7 +123,7 @@ struct obus_event *obus_event_new(struct obus_object *obj,
 	return event;
 
 error:
-	free(event);
+	obus_event_free(event);
 	return NULL;
 }
 
@@ -136,8 +144,13 @@ OBUS_API int obus_event_destroy(struct obus_event *event)
 	if (obus_node_is_ref(&event->event_node))
 		obus_list_del(&event->event_node);
 
+	/* do not free values borrowed from receive buffer */
+	if (event->view_start)
+		obus_struct_release_view(&event->info, event->view_start,
+					 event->view_end);
+
 	obus_struct_destroy(&event->info);
-	free(event);
+	obus_event_free(event);
 	return 0;
 }
 
@@ -185,34 +198,61 @@ void obus_event_log(const struct obus_event *event, enum obus_log_level level)
 	obus_struct_log(&event->info, level);
 }
 
+/* number of fields bitmap words kept on stack when sanitizing events */
+#define OBUS_EVENT_SANITIZE_WORDS 8
+
+/* get index of an event update field in object struct fields */
+static long int obus_event_update_index(const struct obus_struct *st,
+					const struct obus_field_desc *field)
+{
+	long int idx;
+
+	/* generated update fields point in struct fields array */
+	idx = field - st->desc->fields;
+	if (idx >= 0 && (size_t)idx < st->desc->n_fields)
+		return idx;
+
+	field = obus_struct_get_field_desc(st, field->uid);
+	return field ? field - st->desc->fields : -1;
+}
+
 int obus_event_sanitize(struct obus_event *event, int is_server)
 {
+	uint32_t stack_words[OBUS_EVENT_SANITIZE_WORDS];
 	const struct obus_event_desc *desc;
 	struct obus_struct *st;
-	int found;
+	uint32_t *updates;
+	size_t i, n_words;
+	long int idx;
 	int ret;
-	size_t i, j;
 
 	st = &event->info;
 	desc = event->desc;
 
+	/* build bitmap of fields updated by event */
+	n_words = (st->desc->n_fields + 31) / 32;
+	updates = stack_words;
+	if (n_words > OBUS_EVENT_SANITIZE_WORDS) {
+		updates = malloc(n_words * sizeof(*updates));
+		if (!updates)
+			return -ENOMEM;
+	}
+
+	memset(updates, 0, n_words * sizeof(*updates));
+	for (i = 0; i < desc->n_updates; i++) {
+		idx = obus_event_update_index(st, desc->updates[i].field);
+		if (idx >= 0)
+			updates[idx / 32] |= 1u << (idx % 32);
+	}
+
 	/* iterate on each fields and remove those not described in events */
 	ret = 0;
 	for (i = 0; i < st->desc->n_fields; i++) {
 		if (!obus_struct_has_field(st, &st->desc->fields[i]))
 			continue;
 
-		/* find field in update list */
-		found = 0;
-		for (j = 0; j < desc->n_updates; j++) {
-			if (st->desc->fields[i].uid ==
-			    desc->updates[j].field->uid) {
-				found = 1;
-				break;
-			}
-		}
-
-		if (found)
+		/* check field in update bitmap */
+		if (updates[i / 32] & (1u << (i % 32)))
 			continue;
 
 		if (is_server) {
@@ -242,10 +282,21 @@ int obus_event_sanitize(struct obus_event *event, int is_server)
 
 		ret++;
 	}
+
+	if (updates != stack_words)
+		free(updates);
+
 	return ret;
 }
 
 int obus_event_encode(struct obus_event *event, struct obus_buffer *buf)
+{
+	return obus_event_encode_masked(event, buf, NULL);
+}
+
+/* encode event with only fields set in mask (NULL for all fields) */
+int obus_event_encode_masked(struct obus_event *event, struct obus_buffer *buf,
+			     const uint32_t *mask)
 {
 	int ret;
 	size_t offset, length;
@@ -274,7 +325,7 @@ int obus_event_encode(struct obus_event *event, struct obus_buffer *buf)
 		return ret;
 
 	/* add event struct content */
-	ret = obus_struct_encode(&event->info, buf);
+	ret = obus_struct_encode_masked(&event->info, buf, mask);
 	if (ret < 0)
 		return ret;
 
@@ -287,7 +338,7 @@ int obus_event_encode(struct obus_event *event, struct obus_buffer *buf)
 }
 
 struct obus_event *obus_event_decode(struct obus_bus *bus,
-				     struct obus_buffer *buf)
+				     struct obus_buffer *buf, int borrow)
 {
 	int ret;
 	const struct obus_event_desc *desc;
@@ -360,8 +411,15 @@ struct obus_event *obus_event_decode(struct obus_bus *bus,
 	if (!event)
 		goto eat_bytes;
 
-	/* decode event struct content */
-	ret = obus_struct_decode(&event->info, buf);
+	/* decode event struct content, strings & arrays may be borrowed
+	 * from buffer until event is destroyed */
+	if (borrow) {
+		event->view_start = obus_buffer_ptr(buf);
+		event->view_end = obus_buffer_ptr(buf) + obus_buffer_length(buf);
+		ret = obus_struct_decode_view(&event->info, buf);
+	} else {
+		ret = obus_struct_decode(&event->info, buf);
+	}
 	if (ret < 0) {
 		obus_warn("can't decode object {uid=%d, name='%s'} event "
 			  "{uid=%d, name='%s'} data", obj->desc->uid,
@@ -404,6 +462,16 @@ int obus_event_commit(struct obus_event *event)
 	if (ret < 0)
 		return ret;
 
+	/* drop cached encodings of previous object state */
+	obus_object_invalidate(event->obj);
+	if (event->obj->bus && event->obj->is_registered)
+		obus_bus_invalidate_snapshot(event->obj->bus);
+
+	/* publish new object state */
+	if (event->obj->bus && event->obj->bus->mirror &&
+	    event->obj->is_registered)
+		obus_mirror_update(event->obj->bus->mirror, event->obj);
+
 	event->is_committed = 1;
 	return 0;
 }
@@ -62,8 +62,11 @@ struct obus_object *obus_event_get_object(struct obus_event *event);
 
 int obus_event_encode(struct obus_event *event, struct obus_buffer *buf);
 
+int obus_event_encode_masked(struct obus_event *event, struct obus_buffer *buf,
+			     const uint32_t *mask);
+
 struct obus_event *obus_event_decode(struct obus_bus *bus,
-				     struct obus_buffer *buf);
+				     struct obus_buffer *buf, int borrow);
 
 void obus_event_log(const struct obus_event *event, enum obus_log_level level);
 
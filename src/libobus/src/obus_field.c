@@ -568,9 +568,74 @@ static int obus_field_array_encode(const struct obus_struct *st,
 	return ret;
 }
 
+static size_t
+obus_field_array_view_item_size(const struct obus_field_desc *desc)
+{
+	/* items size in memory must be the same as in buffer */
+	switch (desc->type & OBUS_FIELD_MASK) {
+	case OBUS_FIELD_U8:
+	case OBUS_FIELD_I8:
+	case OBUS_FIELD_BOOL:
+		return sizeof(uint8_t);
+	case OBUS_FIELD_U16:
+	case OBUS_FIELD_I16:
+		return sizeof(uint16_t);
+	case OBUS_FIELD_U32:
+	case OBUS_FIELD_I32:
+		return sizeof(uint32_t);
+	case OBUS_FIELD_U64:
+	case OBUS_FIELD_I64:
+		return sizeof(uint64_t);
+	case OBUS_FIELD_ENUM:
+		/* enum are encoded in u32 */
+		return (desc->enum_drv->size == sizeof(uint32_t)) ?
+			sizeof(uint32_t) : 0;
+	case OBUS_FIELD_F32:
+		return sizeof(float);
+	case OBUS_FIELD_F64:
+		return sizeof(double);
+	default:
+		return 0;
+	}
+}
+
+static int obus_field_array_decode_view(const struct obus_field_desc *desc,
+					uint32_t n_items, uint8_t **array,
+					struct obus_buffer *buf)
+{
+	uint64_t value;
+	uint8_t *items;
+	size_t size;
+	uint32_t i;
+	int ret;
+
+	size = obus_field_array_view_item_size(desc);
+	if (size == 0)
+		return -ENOTSUP;
+
+	/* check items are available and aligned in buffer */
+	items = &buf->data[obus_buffer_get_read_position(buf)];
+	if (n_items > obus_buffer_read_length(buf) / size ||
+	    ((uintptr_t)items % size) != 0)
+		return -ENOTSUP;
+
+	/* convert items to host representation in place */
+	for (i = 0; i < n_items; i++) {
+		value = 0;
+		ret = obus_decode_value(desc, &value, buf);
+		if (ret < 0)
+			return ret;
+
+		memcpy(items + i * size, &value, size);
+	}
+
+	*array = items;
+	return 0;
+}
+
 static int obus_field_array_decode(const struct obus_struct *st,
 				   const struct obus_field_desc *desc,
-				   struct obus_buffer *buf)
+				   struct obus_buffer *buf, int borrow)
 {
 	void *addr;
 	uint8_t **array;
@@ -588,6 +653,13 @@ static int obus_field_array_decode(const struct obus_struct *st,
 	if (ret < 0)
 		return ret;
 
+	/* borrow items from buffer if possible */
+	if (borrow && *n_items > 0) {
+		ret = obus_field_array_decode_view(desc, *n_items, array, buf);
+		if (ret != -ENOTSUP)
+			return ret;
+	}
+
 	/* allocate item array */
 	if (*n_items > 0) {
 		*array = obus_field_array_alloc(desc, *n_items);
@@ -607,7 +679,11 @@ static int obus_field_array_decode(const struct obus_struct *st,
 		}
 
 		/* decode item value */
-		ret = obus_decode_value(desc, addr, buf);
+		if (borrow && (desc->type & OBUS_FIELD_MASK) ==
+		    OBUS_FIELD_STRING)
+			ret = obus_buffer_read_string_view(buf, addr);
+		else
+			ret = obus_decode_value(desc, addr, buf);
 		if (ret < 0)
 			break;
 	}
@@ -654,11 +730,12 @@ int obus_field_encode(const struct obus_struct *st,
 }
 
 const struct obus_field_desc *
-obus_field_decode(const struct obus_struct *st, struct obus_buffer *buf)
+obus_field_decode(const struct obus_struct *st, struct obus_buffer *buf,
+		  int borrow)
 {
 	const struct obus_field_desc *desc;
 	void *addr;
-	size_t pos;
+	size_t pos, size;
 	uint16_t uid;
 	uint8_t type;
 	int ret;
@@ -676,6 +753,17 @@ obus_field_decode(const struct obus_struct *st, struct obus_buffer *buf)
 	/* get field position */
 	pos = obus_buffer_get_read_position(buf);
 
+	/* try generated decoder first */
+	if (st->desc->decode_field) {
+		size = (*st->desc->decode_field) (st, uid, type,
+						  buf->data + pos,
+						  obus_buffer_read_length(buf));
+		if (size > 0) {
+			obus_buffer_inc_read_position(buf, size);
+			return obus_struct_get_field_desc(st, uid);
+		}
+	}
+
 	/* get field description from uid */
 	desc = obus_struct_get_field_desc(st, uid);
 	if (!desc) {
@@ -693,13 +781,16 @@ obus_field_decode(const struct obus_struct *st, struct obus_buffer *buf)
 
 	/* decode field array */
 	if (type & OBUS_FIELD_ARRAY) {
-		ret = obus_field_array_decode(st, desc, buf);
+		ret = obus_field_array_decode(st, desc, buf, borrow);
 	} else {
 		/* get field address */
 		addr = obus_field_address(st, desc);
 
 		/* decode field value */
-		ret = obus_decode_value(desc, addr, buf);
+		if (borrow && (type & OBUS_FIELD_MASK) == OBUS_FIELD_STRING)
+			ret = obus_buffer_read_string_view(buf, addr);
+		else
+			ret = obus_decode_value(desc, addr, buf);
 	}
 
 	/* on decode failure, restore buffer read position and
@@ -824,6 +915,53 @@ void obus_field_destroy(const struct obus_struct *st,
 	}
 }
 
+static int obus_field_is_view(const void *ptr, const void *start,
+			      const void *end)
+{
+	return (uintptr_t)ptr >= (uintptr_t)start &&
+	       (uintptr_t)ptr < (uintptr_t)end;
+}
+
+void obus_field_release_view(const struct obus_struct *st,
+			     const struct obus_field_desc *desc,
+			     const void *start, const void *end)
+{
+	uint32_t i, *n_items;
+	uint8_t **array;
+	char **str;
+
+	/* only strings & arrays can be borrowed */
+	if (!(desc->type & OBUS_FIELD_ARRAY) &&
+	    (desc->type & OBUS_FIELD_MASK) != OBUS_FIELD_STRING)
+		return;
+
+	if (!(desc->type & OBUS_FIELD_ARRAY)) {
+		str = obus_field_address(st, desc);
+		if (obus_field_is_view(*str, start, end))
+			*str = NULL;
+		return;
+	}
+
+	array = (uint8_t **)obus_field_address(st, desc);
+	n_items = obus_field_array_nb_address(st, desc);
+
+	/* whole array borrowed */
+	if (obus_field_is_view(*array, start, end)) {
+		*array = NULL;
+		*n_items = 0;
+		return;
+	}
+
+	/* string array items borrowed */
+	if ((desc->type & OBUS_FIELD_MASK) != OBUS_FIELD_STRING || !*array)
+		return;
+
+	for (i = 0; i < *n_items; i++) {
+		str = (char **)*array + i;
+		if (obus_field_is_view(*str, start, end))
+			*str = NULL;
+	}
+}
 
 void obus_field_format(const struct obus_struct *st,
 		       const struct obus_field_desc *desc,
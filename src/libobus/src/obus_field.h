@@ -60,7 +60,11 @@ int obus_field_encode(const struct obus_struct *st,
 
 const struct obus_field_desc *
 obus_field_decode(const struct obus_struct *st,
-		  struct obus_buffer *buf);
+		  struct obus_buffer *buf, int borrow);
+
+void obus_field_release_view(const struct obus_struct *st,
+			     const struct obus_field_desc *desc,
+			     const void *start, const void *end);
 
 int obus_field_copy(const struct obus_struct *dst,
 		    const struct obus_struct *src,
@@ -108,6 +108,28 @@ error:
 	return 0;
 }
 
+void obus_hash_set_slab(struct obus_hash *hash, struct obus_slab *slab)
+{
+	hash->slab = slab;
+}
+
+static struct obus_hash_entry *obus_hash_entry_new(struct obus_hash *hash)
+{
+	if (hash->slab)
+		return obus_slab_alloc(hash->slab);
+
+	return calloc(1, sizeof(struct obus_hash_entry));
+}
+
+static void obus_hash_entry_destroy(struct obus_hash *hash,
+				    struct obus_hash_entry *entry)
+{
+	if (hash->slab)
+		obus_slab_free(hash->slab, entry);
+	else
+		free(entry);
+}
+
 int obus_hash_destroy(struct obus_hash *hash)
 {
 	size_t i;
@@ -121,7 +143,7 @@ int obus_hash_destroy(struct obus_hash *hash)
 		while (entry) {
 			next = entry->next;
 			obus_list_del(&entry->node);
-			free(entry);
+			obus_hash_entry_destroy(hash, entry);
 			entry = next;
 		}
 	}
@@ -171,7 +193,7 @@ int obus_hash_insert(struct obus_hash *hash, uint32_t key, void *data)
 	if (!hash)
 		return -EINVAL;
 
-	entry = calloc(1, sizeof(*entry));
+	entry = obus_hash_entry_new(hash);
 	if (!entry)
 		return -ENOMEM;
 
@@ -182,7 +204,7 @@ int obus_hash_insert(struct obus_hash *hash, uint32_t key, void *data)
 
 	ret = obus_hash_insert_entry(hash, key, entry);
 	if (ret < 0)
-		free(entry);
+		obus_hash_entry_destroy(hash, entry);
 
 	return ret;
 }
@@ -196,7 +218,7 @@ int obus_hash_insert_const(struct obus_hash *hash, uint32_t key,
 	if (!hash)
 		return -EINVAL;
 
-	entry = calloc(1, sizeof(*entry));
+	entry = obus_hash_entry_new(hash);
 	if (!entry)
 		return -ENOMEM;
 
@@ -207,7 +229,7 @@ int obus_hash_insert_const(struct obus_hash *hash, uint32_t key,
 
 	ret = obus_hash_insert_entry(hash, key, entry);
 	if (ret < 0)
-		free(entry);
+		obus_hash_entry_destroy(hash, entry);
 
 	return ret;
 }
@@ -303,7 +325,7 @@ int obus_hash_remove(struct obus_hash *tab, uint32_t key)
 		prev->next = entry->next;
 
 	obus_list_del(&entry->node);
-	free(entry);
+	obus_hash_entry_destroy(tab, entry);
 	return 0;
 }
 
@@ -59,6 +59,7 @@ struct obus_hash {
 	struct obus_hash_entry **buckets;	/* hash table buckets */
 	uint32_t size;				/* hash table size */
 	struct obus_node entries;		/* node entries */
+	struct obus_slab *slab;			/* entries allocator (optional) */
 };
 
 /**
@@ -69,6 +70,13 @@ struct obus_hash {
  */
 int obus_hash_init(struct obus_hash *hash, size_t size);
 
+/**
+ * allocate hash entries from given slab instead of heap
+ * @param hash hash table
+ * @param slab entries slab (sized for struct obus_hash_entry)
+ */
+void obus_hash_set_slab(struct obus_hash *hash, struct obus_slab *slab);
+
 /**
  * destroy hash table
  * @param hash
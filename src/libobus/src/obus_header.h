@@ -67,16 +67,21 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <time.h>
+#include <pthread.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #ifdef HAVE_EPOLL
 #include <sys/epoll.h>
 #endif /* HAVE_EPOLL */
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#endif /* HAVE_IO_URING */
 #include <sys/poll.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <netinet/tcp.h>
 #include <netinet/in.h>
 #include <sys/un.h>
@@ -97,12 +102,18 @@
 #include "obus_platform.h"
 #include "obus_list.h"
 #include "obus_buffer.h"
+#include "obus_shm.h"
 #include "obus_io.h"
+#include "obus_slab.h"
 #include "obus_hash.h"
 #include "obus_utils.h"
+#include "obus_stats.h"
 #include "obus_loop.h"
+#include "obus_uring.h"
 #include "obus_socket.h"
 #include "obus_timer.h"
+#include "obus_submit.h"
+#include "obus_worker.h"
 #include "obus_struct.h"
 #include "obus_field.h"
 #include "obus_packet.h"
@@ -112,5 +123,6 @@
 #include "obus_event.h"
 #include "obus_call.h"
 #include "obus_bus.h"
+#include "obus_mirror.h"
 
 #endif /* _OBUS_HEADER_H_ */
@@ -39,6 +39,9 @@
 /* set default write ready timeout to 5s */
 #define OBUS_IO_WRITE_READY_DEFAULT_TIMEOUT 5000
 
+/* max number of pending buffers flushed with a single writev */
+#define OBUS_IO_WRITE_IOV_MAX 32
+
 /* io buffer node */
 struct obus_io_buffer {
 	struct obus_node node;
@@ -54,11 +57,21 @@ struct obus_io {
 	struct obus_fd write_fd;
 	obus_io_read_event_cb_t read_cb;
 	obus_io_write_cb_t write_cb;
+	obus_io_drained_cb_t drained_cb;
 	struct obus_buffer *current;
 	size_t nbr_written;
 	struct obus_node write_buffers;
+	size_t n_write_buffers;
+	size_t write_buffers_length;
 	struct obus_timer *write_timer;
 	int write_ready_timeout;
+	int corked;
+	struct obus_shm *shm;
+	struct obus_fd hup_fd;
+	struct obus_uring *uring;	/* loop ring writing buffers or NULL */
+	struct obus_uring_op op;	/* ring writev of pending buffers */
+	struct iovec iov[OBUS_IO_WRITE_IOV_MAX];	/* ring writev iovecs */
+	int blocked;			/* ring writev was short */
 	void *user_data;
 };
 
@@ -79,6 +92,14 @@ static struct obus_io_buffer *obus_io_buffer_new(struct obus_buffer *buf)
 	return iobuf;
 };
 
+static void obus_io_queue_buffer(struct obus_io *io,
+				 struct obus_io_buffer *iobuf)
+{
+	obus_list_add_before(&io->write_buffers, &iobuf->node);
+	io->n_write_buffers++;
+	io->write_buffers_length += obus_buffer_length(iobuf->buf);
+}
+
 ssize_t obus_io_read(struct obus_io *io, struct obus_buffer *buf, size_t size)
 {
 	int fd, ret;
@@ -99,7 +120,8 @@ ssize_t obus_io_read(struct obus_io *io, struct obus_buffer *buf, size_t size)
 
 	/* read without blocking */
 	do {
-		nbytes = read(fd, ptr, size);
+		nbytes = io->shm ? obus_shm_read(io->shm, ptr, size) :
+				   read(fd, ptr, size);
 	} while (nbytes == -1 && errno == EINTR);
 
 	if (nbytes == -1) {
@@ -126,9 +148,22 @@ ssize_t obus_io_read(struct obus_io *io, struct obus_buffer *buf, size_t size)
 static void obus_io_read_events(struct obus_fd *fd, int events, void *data)
 {
 	struct obus_io *io = (struct obus_io *)data;
+
+	/* acknowledge shm doorbell before reading ring */
+	if (io->shm && obus_fd_event_read(events))
+		obus_shm_clear_event(fd->fd);
+
 	(*io->read_cb) (events, io->user_data);
 }
 
+static void obus_io_hup_events(struct obus_fd *fd, int events, void *data)
+{
+	struct obus_io *io = (struct obus_io *)data;
+
+	/* in shm mode nothing is expected on socket but peer hang up */
+	(*io->read_cb) (OBUS_FD_ERR, io->user_data);
+}
+
 static void obus_io_write_buffer_complete(struct obus_io *io,
 					  enum obus_io_status status)
 {
@@ -143,31 +178,21 @@ static void obus_io_write_buffer_complete(struct obus_io *io,
 	first = obus_list_first(&io->write_buffers);
 	iobuf = obus_list_entry(first, struct obus_io_buffer, node);
 
-	/* decrement buffer refcnt */
-	buf = iobuf->buf;
-	obus_buffer_unref(buf);
-
 	/* remove buffer from list*/
+	buf = iobuf->buf;
 	obus_list_del(&iobuf->node);
 	obus_io_buffer_destroy(iobuf);
+	io->n_write_buffers--;
+	io->write_buffers_length -= obus_buffer_length(buf);
 
 	/* clear written bytes */
 	io->nbr_written = 0;
 
 	/* call write complete callback */
 	(*io->write_cb) (status, buf, io->user_data);
-}
-
-static void obus_io_write_timer(struct obus_timer *timer,
-				uint64_t *nbexpired, void *data)
-{
-	struct obus_io *io = (struct obus_io *)data;
 
-	/* clear timer */
-	obus_timer_clear(io->write_timer);
-
-	/* complete write buffer */
-	obus_io_write_buffer_complete(io, OBUS_IO_TIMEOUT);
+	/* decrement buffer refcnt */
+	obus_buffer_unref(buf);
 }
 
 static int obus_io_write_buffer(struct obus_io *io, struct obus_buffer *buf,
@@ -176,6 +201,7 @@ static int obus_io_write_buffer(struct obus_io *io, struct obus_buffer *buf,
 	int ret, fd;
 	uint8_t *base;
 	size_t size, length;
+	struct iovec iov;
 	ssize_t nbytes;
 
 	if (!io || !buf || !nbr_written)
@@ -189,7 +215,13 @@ static int obus_io_write_buffer(struct obus_io *io, struct obus_buffer *buf,
 	while (size > 0) {
 		/* write without blocking */
 		do {
-			nbytes = write(fd, base, size);
+			if (io->shm) {
+				iov.iov_base = base;
+				iov.iov_len = size;
+				nbytes = obus_shm_writev(io->shm, &iov, 1);
+			} else {
+				nbytes = write(fd, base, size);
+			}
 		} while (nbytes == -1 && errno == EINTR);
 
 		if (nbytes < 0) {
@@ -216,13 +248,216 @@ static int obus_io_write_buffer(struct obus_io *io, struct obus_buffer *buf,
 	return 0;
 }
 
+/* gather pending buffers in iov (OBUS_IO_WRITE_IOV_MAX entries), first
+ * one may be partially written. return number of iovecs set */
+static int obus_io_write_gather(struct obus_io *io, struct iovec *iov)
+{
+	struct obus_io_buffer *iobuf;
+	size_t length;
+	int iovcnt = 0;
+
+	obus_list_walk_entry_forward(&io->write_buffers, iobuf, node) {
+		length = obus_buffer_length(iobuf->buf);
+		iov[iovcnt].iov_base = obus_buffer_ptr(iobuf->buf);
+		iov[iovcnt].iov_len = length;
+		if (iovcnt == 0) {
+			iov[0].iov_base = (uint8_t *)iov[0].iov_base +
+					  io->nbr_written;
+			iov[0].iov_len -= io->nbr_written;
+		}
+
+		iovcnt++;
+		if (iovcnt == OBUS_IO_WRITE_IOV_MAX)
+			break;
+	}
+
+	return iovcnt;
+}
+
+/* account bytes written from gathered iovecs, fully written buffers are
+ * completed with OBUS_IO_OK status. return 0 if all iovecs have been
+ * written or -EAGAIN on short write */
+static int obus_io_write_account(struct obus_io *io, const struct iovec *iov,
+				 int iovcnt, size_t length)
+{
+	size_t written;
+	int i;
+
+	for (i = 0; i < iovcnt; i++) {
+		written = length < iov[i].iov_len ? length : iov[i].iov_len;
+		if (io->lograw)
+			obus_log_raw(OBUS_LOG_DEBUG, iov[i].iov_base, written,
+				     "%s write fd=%d length=%zu",
+				     io->name, io->write_fd.fd, written);
+
+		if (length < iov[i].iov_len) {
+			/* short write, buffer partially written */
+			io->nbr_written += length;
+			return -EAGAIN;
+		}
+
+		/* buffer fully written, complete it */
+		length -= iov[i].iov_len;
+		obus_io_write_buffer_complete(io, OBUS_IO_OK);
+	}
+
+	return 0;
+}
+
+/* flush pending buffers using one writev per batch of buffers,
+ * completed buffers are given back with OBUS_IO_OK status.
+ * return 0 when all buffers have been written, -EAGAIN if fd is busy
+ * or negative errno on error (first pending buffer not completed) */
+static int obus_io_write_pending(struct obus_io *io)
+{
+	struct iovec iov[OBUS_IO_WRITE_IOV_MAX];
+	ssize_t nbytes;
+	int fd, iovcnt, ret;
+
+	fd = io->write_fd.fd;
+	while (!obus_list_is_empty(&io->write_buffers)) {
+		iovcnt = obus_io_write_gather(io, iov);
+
+		/* write without blocking */
+		do {
+			nbytes = io->shm ?
+				 obus_shm_writev(io->shm, iov, iovcnt) :
+				 writev(fd, iov, iovcnt);
+		} while (nbytes == -1 && errno == EINTR);
+
+		if (nbytes < 0) {
+			ret = -errno;
+			/* log error */
+			if (errno != EAGAIN)
+				obus_log_fd_errno("writev", fd);
+
+			/* return -errno */
+			return ret;
+		}
+
+		/* account written bytes across pending buffers */
+		ret = obus_io_write_account(io, iov, iovcnt, (size_t)nbytes);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* ring prepare callback, pending buffers are gathered at submission to
+ * write all buffers queued during loop dispatch */
+static int obus_io_uring_prep(struct obus_uring_op *op, void *data)
+{
+	struct obus_io *io = (struct obus_io *)data;
+
+	return obus_io_write_gather(io, io->iov);
+}
+
+/* account ring writev result, return 0 if all gathered buffers have been
+ * written, -EAGAIN if some remain or negative errno on error */
+static int obus_io_uring_result(struct obus_io *io, int res)
+{
+	/* operation cancelled before anything was written */
+	if (res == -ECANCELED || res == -EINTR || res == -EAGAIN)
+		return -EAGAIN;
+
+	if (res < 0) {
+		obus_error("%s writev(fd=%d) error=%d(%s)", io->name,
+			   io->write_fd.fd, -res, strerror(-res));
+		return res;
+	}
+
+	return obus_io_write_account(io, io->iov, io->op.iovcnt, (size_t)res);
+}
+
+/* give pending buffers to loop ring, they are written with its next
+ * submission */
+static void obus_io_uring_start(struct obus_io *io)
+{
+	if (io->corked || obus_uring_op_is_busy(&io->op) ||
+	    obus_fd_is_used(&io->write_fd) ||
+	    obus_list_is_empty(&io->write_buffers))
+		return;
+
+	obus_timer_set(io->write_timer, io->write_ready_timeout);
+	obus_uring_queue(io->uring, &io->op);
+}
+
+/* take ring writev back from ring, written bytes are accounted.
+ * return 0 or negative errno if writev failed */
+static int obus_io_uring_stop(struct obus_io *io)
+{
+	int ret;
+
+	if (!io->uring || !obus_uring_op_is_busy(&io->op))
+		return 0;
+
+	ret = obus_io_uring_result(io, obus_uring_cancel(io->uring,
+							 &io->op));
+	return ret == -EAGAIN ? 0 : ret;
+}
+
+static void obus_io_uring_done(struct obus_uring_op *op, int res, void *data)
+{
+	struct obus_io *io = (struct obus_io *)data;
+	int ret;
+
+	/* socket not writable, wait write ready event for pending buffers */
+	if (res == -EAGAIN) {
+		io->blocked = 1;
+		(void)obus_loop_add(io->loop, &io->write_fd);
+		return;
+	}
+
+	ret = obus_io_uring_result(io, res);
+	if (ret < 0 && ret != -EAGAIN) {
+		/* complete write buffer, io may be destroyed in callback */
+		obus_io_write_buffer_complete(io, OBUS_IO_ERROR);
+		return;
+	}
+
+	/* write remaining and newly queued buffers */
+	io->blocked = ret == -EAGAIN;
+	if (obus_list_is_empty(&io->write_buffers))
+		obus_timer_clear(io->write_timer);
+	else
+		obus_io_uring_start(io);
+
+	/* all given buffers written, notify drain even if new buffers have
+	 * been queued meanwhile. io may be destroyed in callback */
+	if (!io->blocked && io->drained_cb)
+		(*io->drained_cb) (io->user_data);
+}
+
+static void obus_io_write_timer(struct obus_timer *timer,
+				uint64_t *nbexpired, void *data)
+{
+	struct obus_io *io = (struct obus_io *)data;
+	int ret;
+
+	/* clear timer */
+	obus_timer_clear(io->write_timer);
+
+	/* take ring writev back, buffers may have been written meanwhile */
+	ret = obus_io_uring_stop(io);
+	if (ret < 0) {
+		obus_io_write_buffer_complete(io, OBUS_IO_ERROR);
+		return;
+	} else if (obus_list_is_empty(&io->write_buffers)) {
+		/* notify drain, io may be destroyed in callback */
+		if (io->drained_cb)
+			(*io->drained_cb) (io->user_data);
+		return;
+	}
+
+	/* complete write buffer */
+	obus_io_write_buffer_complete(io, OBUS_IO_TIMEOUT);
+}
+
 static void obus_io_write_events(struct obus_fd *fd, int events, void *data)
 {
 	struct obus_io *io = (struct obus_io *)data;
-	struct obus_node *first;
-	struct obus_io_buffer *iobuf;
 	int ret;
-	size_t nbr_written;
 
 	/* clear write timer */
 	obus_timer_clear(io->write_timer);
@@ -233,29 +468,19 @@ static void obus_io_write_events(struct obus_fd *fd, int events, void *data)
 		return;
 	}
 
-	/* do not treat event other than write available */
-	if (!obus_fd_event_write(events))
+	/* do not treat event other than write available, shm space
+	 * doorbell is a read event */
+	if (io->shm && obus_fd_event_read(events))
+		obus_shm_clear_event(fd->fd);
+	else if (!obus_fd_event_write(events))
 		return;
 
 	/* write pending buffers */
-	while (!obus_list_is_empty(&io->write_buffers)) {
-		/* get first buffer from list */
-		first = obus_list_first(&io->write_buffers);
-		iobuf = obus_list_entry(first, struct obus_io_buffer, node);
-
-		/* write buffer */
-		ret = obus_io_write_buffer(io, iobuf->buf, io->nbr_written,
-					   &nbr_written);
-		if (ret == -EAGAIN) {
-			/* if buffer has been partially written write number
-			 * of bytes already written */
-			io->nbr_written += nbr_written;
-			break;
-		}
-
-		/* complete write buffer */
-		obus_io_write_buffer_complete(io, (ret == 0) ? OBUS_IO_OK :
-					      OBUS_IO_ERROR);
+	ret = obus_io_write_pending(io);
+	if (ret < 0 && ret != -EAGAIN) {
+		/* complete write buffer, io may be destroyed in callback */
+		obus_io_write_buffer_complete(io, OBUS_IO_ERROR);
+		return;
 	}
 
 	/* if write buffer list is non empty trigger timer */
@@ -267,10 +492,15 @@ static void obus_io_write_events(struct obus_fd *fd, int events, void *data)
 
 		/* remove wait write ready event */
 		obus_loop_remove(io->loop, &io->write_fd);
+		io->blocked = 0;
 
 		/* log exit async mode */
 		obus_debug("io %s fd=%d write exit async mode",
 			   io->name, io->write_fd.fd);
+
+		/* notify drain, io may be destroyed in callback */
+		if (io->drained_cb)
+			(*io->drained_cb) (io->user_data);
 	}
 }
 
@@ -282,7 +512,7 @@ struct obus_io *obus_io_new(struct obus_loop *loop, const char *name, int fd,
 	struct obus_io *io;
 	int ret;
 
-	if (!loop || (fd < 0) || !write_cb || !read_cb)
+	if (!loop || (fd < 0) || !write_cb)
 		return NULL;
 
 	io = calloc(1, sizeof(*io));
@@ -300,9 +530,15 @@ struct obus_io *obus_io_new(struct obus_loop *loop, const char *name, int fd,
 	if (!io->write_timer)
 		goto unref_loop;
 
-	/* add read fd in loop */
+	/* write through loop io_uring if available */
+	io->uring = obus_uring_get(io->loop);
+	obus_uring_op_init(&io->op, fd, &obus_io_uring_prep,
+			   &obus_io_uring_done, io);
+	io->op.iov = io->iov;
+
+	/* add read fd in loop (write only io has no read callback) */
 	obus_fd_init(&io->read_fd, fd, OBUS_FD_IN, &obus_io_read_events, io);
-	ret = obus_loop_add(io->loop, &io->read_fd);
+	ret = read_cb ? obus_loop_add(io->loop, &io->read_fd) : 0;
 	if (ret < 0)
 		goto destroy_timer;
 
@@ -311,6 +547,7 @@ struct obus_io *obus_io_new(struct obus_loop *loop, const char *name, int fd,
 	return io;
 
 destroy_timer:
+	obus_uring_put(io->uring);
 	obus_timer_destroy(io->write_timer);
 
 unref_loop:
@@ -322,28 +559,30 @@ unref_loop:
 
 int obus_io_destroy(struct obus_io *io)
 {
-	struct obus_io_buffer *iobuf, *tmp;
-
 	if (!io)
 		return -EINVAL;
 
+	/* kernel must not access buffers anymore */
+	if (io->uring) {
+		(void)obus_uring_cancel(io->uring, &io->op);
+		obus_uring_put(io->uring);
+	}
+
 	/* remove fd read from loop */
-	obus_loop_remove(io->loop, &io->read_fd);
+	if (obus_fd_is_used(&io->read_fd))
+		obus_loop_remove(io->loop, &io->read_fd);
+
+	/* remove shm peer socket from loop */
+	if (obus_fd_is_used(&io->hup_fd))
+		obus_loop_remove(io->loop, &io->hup_fd);
 
 	/* remove fd write from loop*/
 	if (obus_fd_is_used(&io->write_fd))
 		obus_loop_remove(io->loop, &io->write_fd);
 
-	/* give back pending non written buffer */
-	obus_list_walk_entry_forward_safe(&io->write_buffers,
-					  iobuf, tmp, node) {
-		/* unref buffer */
-		obus_buffer_unref(iobuf->buf);
-
-		/* destroy io buf wrapper */
-		obus_list_del(&iobuf->node);
-		obus_io_buffer_destroy(iobuf);
-	}
+	/* give back pending non written buffers */
+	while (!obus_list_is_empty(&io->write_buffers))
+		obus_io_write_buffer_complete(io, OBUS_IO_ABORT);
 
 	/* destroy timer */
 	obus_timer_destroy(io->write_timer);
@@ -355,6 +594,38 @@ int obus_io_destroy(struct obus_io *io)
 	return 0;
 }
 
+int obus_io_set_shm(struct obus_io *io, struct obus_shm *shm)
+{
+	int ret;
+
+	if (!io || !shm)
+		return -EINVAL;
+
+	/* must be done before first write */
+	if (!obus_list_is_empty(&io->write_buffers))
+		return -EBUSY;
+
+	/* shared memory rings are written directly */
+	obus_uring_put(io->uring);
+	io->uring = NULL;
+
+	/* socket is only watched for peer hang up */
+	obus_loop_remove(io->loop, &io->read_fd);
+	obus_fd_init(&io->hup_fd, io->read_fd.fd, OBUS_FD_IN,
+		     &obus_io_hup_events, io);
+	ret = obus_loop_add(io->loop, &io->hup_fd);
+	if (ret < 0)
+		return ret;
+
+	/* read & write in shared memory rings, waiting on their doorbells */
+	io->shm = shm;
+	obus_fd_init(&io->read_fd, obus_shm_read_fd(shm), OBUS_FD_IN,
+		     &obus_io_read_events, io);
+	obus_fd_init(&io->write_fd, obus_shm_write_fd(shm), OBUS_FD_IN,
+		     &obus_io_write_events, io);
+	return obus_loop_add(io->loop, &io->read_fd);
+}
+
 int obus_io_log_traffic(struct obus_io *io, int enable)
 {
 	if (!io)
@@ -373,15 +644,20 @@ int obus_io_write(struct obus_io *io, struct obus_buffer *buf)
 	if (!io || !buf)
 		return -EINVAL;
 
-	/* add buffer in pending write buffers list for async write */
-	if (!obus_list_is_empty(&io->write_buffers)) {
+	/* add buffer in pending write buffers list for async write,
+	 * corked io queue buffers until uncorked. with loop ring all
+	 * buffers are written async */
+	if (io->corked || !obus_list_is_empty(&io->write_buffers) ||
+	    io->uring) {
 		/* create io buf wrapper */
 		iobuf = obus_io_buffer_new(buf);
 		if (!iobuf)
 			return -ENOMEM;
 
 		/* add io buf in pending list */
-		obus_list_add_before(&io->write_buffers, &iobuf->node);
+		obus_io_queue_buffer(io, iobuf);
+		if (io->uring)
+			obus_io_uring_start(io);
 		return -EAGAIN;
 	}
 
@@ -404,7 +680,7 @@ int obus_io_write(struct obus_io *io, struct obus_buffer *buf)
 		obus_timer_set(io->write_timer, io->write_ready_timeout);
 
 		/* add io buf in pending list */
-		obus_list_add_before(&io->write_buffers, &iobuf->node);
+		obus_io_queue_buffer(io, iobuf);
 
 		/* if buffer has been partially written write number of bytes
 		 * already written */
@@ -413,3 +689,136 @@ int obus_io_write(struct obus_io *io, struct obus_buffer *buf)
 
 	return ret;
 }
+
+int obus_io_set_cork(struct obus_io *io, int enable)
+{
+	int ret;
+
+	if (!io)
+		return -EINVAL;
+
+	io->corked = enable ? 1 : 0;
+	if (io->corked || obus_list_is_empty(&io->write_buffers))
+		return 0;
+
+	/* queued buffers are written with next ring submission */
+	if (io->uring) {
+		obus_io_uring_start(io);
+		return 0;
+	}
+
+	/* write queued buffers with as few writev as possible */
+	ret = obus_io_write_pending(io);
+	if (ret == -EAGAIN) {
+		/* wait write ready event for remaining buffers */
+		if (!obus_fd_is_used(&io->write_fd))
+			(void)obus_loop_add(io->loop, &io->write_fd);
+		obus_timer_set(io->write_timer, io->write_ready_timeout);
+		ret = 0;
+	} else if (ret < 0) {
+		/* complete write buffer, io may be destroyed in callback */
+		obus_io_write_buffer_complete(io, OBUS_IO_ERROR);
+	}
+
+	return ret;
+}
+
+int obus_io_set_drained_cb(struct obus_io *io, obus_io_drained_cb_t drained_cb)
+{
+	if (!io)
+		return -EINVAL;
+
+	io->drained_cb = drained_cb;
+	return 0;
+}
+
+size_t obus_io_get_pending_count(const struct obus_io *io)
+{
+	return io ? io->n_write_buffers : 0;
+}
+
+size_t obus_io_get_pending_bytes(const struct obus_io *io)
+{
+	return io ? io->write_buffers_length - io->nbr_written : 0;
+}
+
+int obus_io_is_blocked(const struct obus_io *io)
+{
+	if (!io)
+		return 0;
+
+	/* buffers given to ring are written with next loop iteration */
+	return io->uring ? io->blocked : io->n_write_buffers > 0;
+}
+
+static int obus_io_is_over(const struct obus_io *io, size_t max_bytes,
+			   size_t max_count)
+{
+	return io->n_write_buffers > max_count ||
+	       obus_io_get_pending_bytes(io) > max_bytes;
+}
+
+int obus_io_flush(struct obus_io *io, size_t max_bytes, size_t max_count,
+		  int timeout)
+{
+	struct pollfd pfd;
+	uint64_t end, now;
+	int ret;
+
+	if (!io)
+		return -EINVAL;
+
+	/* take ring writev back to write synchronously */
+	ret = obus_io_uring_stop(io);
+	if (ret < 0)
+		return ret;
+
+	end = obus_get_monotonic_ms() + (uint64_t)timeout;
+	while (obus_io_is_over(io, max_bytes, max_count)) {
+		/* write what can be written without blocking */
+		ret = obus_io_write_pending(io);
+		if (ret < 0 && ret != -EAGAIN)
+			return ret;
+
+		if (!obus_io_is_over(io, max_bytes, max_count))
+			break;
+
+		/* wait fd write ready until deadline */
+		now = obus_get_monotonic_ms();
+		if (now >= end)
+			return -ETIMEDOUT;
+
+		pfd.fd = io->write_fd.fd;
+		pfd.events = io->shm ? POLLIN : POLLOUT;
+		pfd.revents = 0;
+		do {
+			ret = poll(&pfd, 1, (int)(end - now));
+		} while (ret < 0 && errno == EINTR);
+
+		/* acknowledge shm space doorbell */
+		if (ret > 0 && io->shm && (pfd.revents & POLLIN))
+			obus_shm_clear_event(pfd.fd);
+
+		if (ret < 0) {
+			ret = -errno;
+			obus_log_fd_errno("poll", io->write_fd.fd);
+			return ret;
+		} else if (ret == 0) {
+			return -ETIMEDOUT;
+		} else if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			return -EPIPE;
+		}
+	}
+
+	/* write ready event no more needed */
+	if (obus_list_is_empty(&io->write_buffers)) {
+		obus_timer_clear(io->write_timer);
+		if (obus_fd_is_used(&io->write_fd))
+			obus_loop_remove(io->loop, &io->write_fd);
+	} else if (io->uring) {
+		/* remaining buffers are written by ring again */
+		obus_io_uring_start(io);
+	}
+
+	return 0;
+}
@@ -43,6 +43,7 @@
 struct obus_io;
 struct obus_loop;
 struct obus_buffer;
+struct obus_shm;
 
 /**
  * obus io operation status
@@ -68,6 +69,14 @@ enum obus_io_status {
 typedef void (*obus_io_write_cb_t) (enum obus_io_status status,
 				    struct obus_buffer *buf,
 				    void *user_data);
+/**
+ * obus io callback invoked when all pending async writes are completed,
+ * or when io writes through loop io_uring, each time a ring writev has
+ * written all buffers given to it. io can be destroyed in this callback
+ * @param user_data
+ */
+typedef void (*obus_io_drained_cb_t) (void *user_data);
+
 /**
  * obus read event callback
  * @param events (read event)
@@ -81,6 +90,7 @@ typedef void (*obus_io_read_event_cb_t) (int events, void *user_data);
  * @param name io name (label)
  * @param fd io file descriptor used to read/write
  * @param write_cb io write async callback
+ * @param read_cb io read event callback (NULL for a write only io)
  * @param user_data callback user_data
  */
 struct obus_io *obus_io_new(struct obus_loop *loop, const char *name, int fd,
@@ -89,7 +99,8 @@ struct obus_io *obus_io_new(struct obus_loop *loop, const char *name, int fd,
 			    void *user_data);
 
 /**
- * destroy io
+ * destroy io, pending write buffers are given back to write callback
+ * with OBUS_IO_ABORT status
  * @param io
  * @return
  */
@@ -112,6 +123,70 @@ ssize_t obus_io_read(struct obus_io *io, struct obus_buffer *buf, size_t size);
  */
 int obus_io_write(struct obus_io *io, struct obus_buffer *buf);
 
+/**
+ * switch io to a shared memory channel: data is then read from and written
+ * to channel rings, io fd is only monitored for peer hang up. Must be
+ * called before any write, channel must outlive io.
+ * @param io obus io
+ * @param shm shared memory channel
+ * @return 0 on success
+ */
+int obus_io_set_shm(struct obus_io *io, struct obus_shm *shm);
+
+/**
+ * cork/uncork io: while corked written buffers are only queued, they are
+ * written on uncork using one writev per batch of queued buffers
+ * @param io obus io
+ * @param enable set 1 or 0 to cork/uncork io
+ * @return 0 on success or negative errno if uncork write failed (io write
+ * callback has been invoked with OBUS_IO_ERROR, io may be destroyed)
+ */
+int obus_io_set_cork(struct obus_io *io, int enable);
+
+/**
+ * set callback invoked when pending write buffers have been drained
+ * @param io obus io
+ * @param drained_cb callback or NULL
+ * @return 0 on success
+ */
+int obus_io_set_drained_cb(struct obus_io *io, obus_io_drained_cb_t drained_cb);
+
+/**
+ * get number of buffers waiting to be written
+ * @param io obus io
+ * @return number of pending write buffers
+ */
+size_t obus_io_get_pending_count(const struct obus_io *io);
+
+/**
+ * get number of bytes waiting to be written
+ * @param io obus io
+ * @return number of pending write bytes
+ */
+size_t obus_io_get_pending_bytes(const struct obus_io *io);
+
+/**
+ * check if io write queue is blocked: buffers are pending, or when io
+ * writes through loop io_uring, last ring writev could not write all
+ * buffers given to it
+ * @param io obus io
+ * @return 1 if blocked, 0 otherwise
+ */
+int obus_io_is_blocked(const struct obus_io *io);
+
+/**
+ * write pending buffers synchronously until at most max_bytes and
+ * max_count buffers remain, pending buffers written are completed
+ * with OBUS_IO_OK status. On error, pending buffers are kept.
+ * @param io obus io
+ * @param max_bytes max pending bytes
+ * @param max_count max pending buffers
+ * @param timeout max blocking time in ms
+ * @return 0 on success, -ETIMEDOUT on timeout or negative errno
+ */
+int obus_io_flush(struct obus_io *io, size_t max_bytes, size_t max_count,
+		  int timeout);
+
 /**
  * enable/disable io data log traffic
  * @param io obus io
@@ -48,8 +48,13 @@ struct obus_loop {
 	struct epoll_event *events;	/* epoll events array */
 	int nallocevents;		/* number of allocated events */
 	int nfds;			/* number of fds */
+	int nready;			/* number of ready events dispatched */
+	int current;			/* index of event being dispatched */
 	size_t ref;			/* loop reference count */
 	int epfd;			/* epoll fd */
+	struct obus_timer_wheel *timers;	/* loop timers, see obus_timer.c */
+	struct obus_uring *uring;	/* loop io_uring, see obus_uring.c */
+	int dispatching;		/* fd callbacks being invoked */
 };
 
 static uint32_t fd_to_epoll_events(int events)
@@ -167,6 +172,39 @@ int obus_loop_unref(struct obus_loop *loop)
 	return 0;
 }
 
+/* get loop timers wheel */
+struct obus_timer_wheel *obus_loop_get_timers(struct obus_loop *loop)
+{
+	return loop ? loop->timers : NULL;
+}
+
+/* set loop timers wheel */
+void obus_loop_set_timers(struct obus_loop *loop,
+			  struct obus_timer_wheel *timers)
+{
+	if (loop)
+		loop->timers = timers;
+}
+
+/* get loop io_uring */
+struct obus_uring *obus_loop_get_uring(struct obus_loop *loop)
+{
+	return loop ? loop->uring : NULL;
+}
+
+/* set loop io_uring */
+void obus_loop_set_uring(struct obus_loop *loop, struct obus_uring *uring)
+{
+	if (loop)
+		loop->uring = uring;
+}
+
+/* check if loop is invoking fd callbacks */
+int obus_loop_is_dispatching(struct obus_loop *loop)
+{
+	return loop && loop->dispatching ? 1 : 0;
+}
+
 /* get loop fd */
 int obus_loop_fd(struct obus_loop *loop)
 {
@@ -177,10 +215,17 @@ int obus_loop_fd(struct obus_loop *loop)
 static int obus_loop_do_process(struct obus_loop *loop, int timeout)
 {
 	struct epoll_event *ep_events;
-	struct obus_fd *current, *ofd;
+	struct obus_fd *ofd;
 	int events;
 	size_t size;
-	int ret, j, i;
+	int ret, i;
+
+	/* events array and dispatch range are not reentrant: processing
+	 * the loop from one of its fd callbacks is not supported */
+	if (loop->nready) {
+		obus_error("%s", "loop processed from its own fd callback");
+		return -EBUSY;
+	}
 
 	/* grow up poll events array if needed */
 	if (loop->nfds > loop->nallocevents) {
@@ -211,39 +256,35 @@ static int obus_loop_do_process(struct obus_loop *loop, int timeout)
 	/* avoid loop to be destroyed in fd object callback */
 	obus_loop_ref(loop);
 
-	/* iterate on all events */
-	j = 0;
-	for (i = 0; i < loop->nfds && j < ret; i++) {
-		/* check if fd is ready for I/O request */
-		if (!loop->events[i].events)
-			continue;
-
-		events = epoll_to_fd_events(loop->events[i].events);
-		j++;
-		ofd = NULL;
-		if (!events)
-			continue;
-
-		/* check if fd object is well in our list (not removed)*/
-		obus_list_walk_entry_forward(&loop->ofds, current, node) {
-			if (current == loop->events[i].data.ptr) {
-				/* get fd object */
-				ofd = loop->events[i].data.ptr;
-				break;
-			}
-		}
+	/* iterate on ready events, epoll packs them at start of array.
+	 * fd objects removed from a callback have their pending events
+	 * cleared by obus_loop_remove so data.ptr can be trusted here */
+	loop->nready = ret;
+	loop->dispatching++;
+	for (i = 0; i < loop->nready; i++) {
+		loop->current = i;
+		ofd = loop->events[i].data.ptr;
 
 		/* fd object has been removed ?*/
 		if (obus_unlikely(!ofd)) {
-			obus_debug("fd ready on ofd %p removed !",
-				   ofd);
+			obus_debug("%s", "fd ready on removed ofd !");
 			continue;
 		}
 
+		events = epoll_to_fd_events(loop->events[i].events);
+		if (!events)
+			continue;
+
 		/* invoke fd object callback */
 		(*ofd->cb) (ofd, events, ofd->data);
 	}
 
+	loop->nready = 0;
+	loop->current = 0;
+	loop->dispatching--;
+
+	/* submit io_uring writes queued by callbacks at once */
+	obus_uring_submit(loop->uring);
 	obus_loop_unref(loop);
 	return 0;
 }
@@ -265,7 +306,6 @@ int obus_loop_wait(struct obus_loop *loop)
 int obus_loop_add(struct obus_loop *loop, struct obus_fd *ofd)
 {
 	int ret;
-	struct obus_fd *current;
 	struct epoll_event evt;
 
 	if (!loop || !ofd || (ofd->fd < 0) || ofd->events == 0 ||
@@ -275,21 +315,13 @@ int obus_loop_add(struct obus_loop *loop, struct obus_fd *ofd)
 		goto error;
 	}
 
+	/* fd object owned by a loop is already in its list */
 	if (ofd->loop) {
 		ret = -EEXIST;
 		obus_error("ofd %p already used", ofd);
 		goto error;
 	}
 
-	/* check fd object is not already in list */
-	obus_list_walk_entry_forward(&loop->ofds, current, node) {
-		if (current == ofd) {
-			obus_error("ofd %p already added", ofd);
-			ret = -EEXIST;
-			goto error;
-		}
-	}
-
 	/* init epoll event */
 	memset(&evt, 0, sizeof(evt));
 	evt.data.ptr = ofd;
@@ -338,7 +370,6 @@ error:
 int obus_loop_update(struct obus_loop *loop, struct obus_fd *ofd)
 {
 	int ret;
-	struct obus_fd *current;
 	struct epoll_event evt;
 
 	if (!loop || !ofd) {
@@ -348,15 +379,8 @@ int obus_loop_update(struct obus_loop *loop, struct obus_fd *ofd)
 	}
 
 	/* check fd object is in our list */
-	ret = -ENOENT;
-	obus_list_walk_entry_forward(&loop->ofds, current, node) {
-		if (current == ofd) {
-			ret = 0;
-			break;
-		}
-	}
-
-	if (ret == -ENOENT) {
+	if (ofd->loop != loop) {
+		ret = -ENOENT;
 		obus_error("update a ofd %p not added", ofd);
 		goto error;
 	}
@@ -368,7 +392,7 @@ int obus_loop_update(struct obus_loop *loop, struct obus_fd *ofd)
 
 	/* update fd object from poll */
 	ret = epoll_ctl(loop->epfd, EPOLL_CTL_MOD,
-			ofd->dupfd == -1 ? ofd->fd : ofd->dupfd, NULL);
+			ofd->dupfd == -1 ? ofd->fd : ofd->dupfd, &evt);
 	if (ret < 0) {
 		obus_log_fd_errno("epoll_ctl(EPOLL_CTL_MOD)",
 				  loop->epfd);
@@ -384,7 +408,7 @@ error:
 int obus_loop_remove(struct obus_loop *loop, struct obus_fd *ofd)
 {
 	int ret;
-	struct obus_fd *current;
+	int i;
 
 	if (!loop || !ofd) {
 		ret = -EINVAL;
@@ -393,15 +417,8 @@ int obus_loop_remove(struct obus_loop *loop, struct obus_fd *ofd)
 	}
 
 	/* check fd object is in our list */
-	ret = -ENOENT;
-	obus_list_walk_entry_forward(&loop->ofds, current, node) {
-		if (current == ofd) {
-			ret = 0;
-			break;
-		}
-	}
-
-	if (ret == -ENOENT) {
+	if (ofd->loop != loop) {
+		ret = -ENOENT;
 		obus_error("remove a ofd %p not added", ofd);
 		goto error;
 	}
@@ -422,6 +439,13 @@ int obus_loop_remove(struct obus_loop *loop, struct obus_fd *ofd)
 		ofd->dupfd = -1;
 	}
 
+	/* drop events not yet dispatched for this fd object, it may be
+	 * freed (and its address reused) before dispatch reaches them */
+	for (i = loop->current + 1; i < loop->nready; i++) {
+		if (loop->events[i].data.ptr == ofd)
+			loop->events[i].data.ptr = NULL;
+	}
+
 	/* remove fd object from list */
 	obus_list_del(&ofd->node);
 	ofd->loop = NULL;
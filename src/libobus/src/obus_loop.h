@@ -43,6 +43,12 @@ struct obus_fd;
 /* event fd loop object */
 struct obus_loop;
 
+/* timers of a loop */
+struct obus_timer_wheel;
+
+/* io_uring of a loop */
+struct obus_uring;
+
 /* fd events callback */
 typedef void (*obus_fd_event_cb_t) (struct obus_fd *fd, int events, void *data);
 
@@ -53,6 +59,7 @@ struct obus_fd {
 	int dupfd;
 	int fd;
 	int events;
+	int slot;	/* index in poll array of posix loop */
 	obus_fd_event_cb_t cb;
 	void *data;
 };
@@ -79,6 +86,7 @@ int obus_fd_init(struct obus_fd *ofd, int fd, int events,
 	ofd->data = data;
 	ofd->fd = fd;
 	ofd->dupfd = -1;
+	ofd->slot = -1;
 	return 0;
 }
 
@@ -115,6 +123,22 @@ int obus_loop_unref(struct obus_loop *loop);
 /* get loop fd */
 int obus_loop_fd(struct obus_loop *loop);
 
+/* get loop timers wheel, NULL until a timer is created in loop */
+struct obus_timer_wheel *obus_loop_get_timers(struct obus_loop *loop);
+
+/* set loop timers wheel */
+void obus_loop_set_timers(struct obus_loop *loop,
+			  struct obus_timer_wheel *timers);
+
+/* get loop io_uring, NULL until an io uses it */
+struct obus_uring *obus_loop_get_uring(struct obus_loop *loop);
+
+/* set loop io_uring */
+void obus_loop_set_uring(struct obus_loop *loop, struct obus_uring *uring);
+
+/* check if loop is invoking fd callbacks */
+int obus_loop_is_dispatching(struct obus_loop *loop);
+
 /* process loop fd */
 int obus_loop_process(struct obus_loop *loop);
 
@@ -44,14 +44,18 @@
 /* extra number of event allocated when events array growth  */
 #define EXTRA_ALLOC_EVENT_NB 10
 
-/* event loop object */
+/* event loop object, poll array is kept up to date on add/update/remove
+ * with fd objects in a parallel array (index given by obus_fd slot) */
 struct obus_loop {
 	struct obus_hash ofds;	/* registered fd hash (key=fd data=obus_fd) */
 	struct pollfd *pfds;	/* poll array */
+	struct obus_fd **slots;	/* fd object of each poll array entry */
 	int nallocevents;	/* number of allocated events */
 	int nfds;		/* number of fds */
 	size_t ref;		/* loop reference count */
-
+	struct obus_timer_wheel *timers;	/* loop timers, see obus_timer.c */
+	struct obus_uring *uring;	/* loop io_uring, see obus_uring.c */
+	int dispatching;	/* fd callbacks being invoked */
 };
 
 static short int fd_to_poll_events(int events)
@@ -130,6 +134,7 @@ static int obus_loop_destroy(struct obus_loop *loop)
 
 	obus_hash_destroy(&loop->ofds);
 	free(loop->pfds);
+	free(loop->slots);
 	free(loop);
 	return 0;
 }
@@ -149,6 +154,39 @@ int obus_loop_unref(struct obus_loop *loop)
 	return 0;
 }
 
+/* get loop timers wheel */
+struct obus_timer_wheel *obus_loop_get_timers(struct obus_loop *loop)
+{
+	return loop ? loop->timers : NULL;
+}
+
+/* set loop timers wheel */
+void obus_loop_set_timers(struct obus_loop *loop,
+			  struct obus_timer_wheel *timers)
+{
+	if (loop)
+		loop->timers = timers;
+}
+
+/* get loop io_uring */
+struct obus_uring *obus_loop_get_uring(struct obus_loop *loop)
+{
+	return loop ? loop->uring : NULL;
+}
+
+/* set loop io_uring */
+void obus_loop_set_uring(struct obus_loop *loop, struct obus_uring *uring)
+{
+	if (loop)
+		loop->uring = uring;
+}
+
+/* check if loop is invoking fd callbacks */
+int obus_loop_is_dispatching(struct obus_loop *loop)
+{
+	return loop && loop->dispatching ? 1 : 0;
+}
+
 /* get loop fd */
 int obus_loop_fd(struct obus_loop *loop)
 {
@@ -156,30 +194,69 @@ int obus_loop_fd(struct obus_loop *loop)
 	return -ENOSYS;
 }
 
-/* do process loop */
-static int obus_loop_do_process(struct obus_loop *loop, int timeout)
+/* grow up poll and fd objects arrays if needed */
+static int obus_loop_grow(struct obus_loop *loop)
 {
 	struct pollfd *pfds;
-	int revents;
-	size_t size;
-	int ret, j, i;
+	struct obus_fd **slots;
+	int nalloc;
+
+	if (loop->nfds < loop->nallocevents)
+		return 0;
+
+	nalloc = EXTRA_ALLOC_EVENT_NB + loop->nfds;
+	pfds = realloc(loop->pfds, (size_t)nalloc * sizeof(*pfds));
+	if (!pfds)
+		return -ENOMEM;
 
-	/* grow up poll array if needed */
-	if (loop->nfds > loop->nallocevents) {
-		size = (EXTRA_ALLOC_EVENT_NB + (size_t)loop->nfds) *
-						sizeof(struct pollfd);
-		pfds = realloc(loop->pfds, size);
-		if (!pfds)
-			return -ENOMEM;
+	loop->pfds = pfds;
+	slots = realloc(loop->slots, (size_t)nalloc * sizeof(*slots));
+	if (!slots)
+		return -ENOMEM;
+
+	loop->slots = slots;
+	loop->nallocevents = nalloc;
+	return 0;
+}
 
-		loop->pfds = pfds;
-		loop->nallocevents = EXTRA_ALLOC_EVENT_NB + loop->nfds;
+/* remove poll array entry, last entry is moved in its place. an entry
+ * moved while dispatching has already been dispatched or has just been
+ * added, its events are cleared to not dispatch it again */
+static void obus_loop_del_slot(struct obus_loop *loop, int slot)
+{
+	int last = loop->nfds - 1;
+
+	if (slot != last) {
+		loop->pfds[slot] = loop->pfds[last];
+		loop->slots[slot] = loop->slots[last];
+		loop->slots[slot]->slot = slot;
+		if (loop->dispatching)
+			loop->pfds[slot].revents = 0;
 	}
 
-	/* fill poll array */
-	ret = obus_loop_posix_get_fds(loop, loop->pfds, loop->nfds);
-	if (ret < 0)
-		return ret;
+	loop->nfds--;
+}
+
+/* invoke fd object callback */
+static void obus_loop_dispatch(struct obus_loop *loop, struct obus_fd *ofd,
+			       short int revents)
+{
+	int events;
+
+	events = poll_to_fd_events(revents);
+	if (!events)
+		return;
+
+	loop->dispatching++;
+	(*ofd->cb) (ofd, events, ofd->data);
+	loop->dispatching--;
+}
+
+/* do process loop */
+static int obus_loop_do_process(struct obus_loop *loop, int timeout)
+{
+	short int revents;
+	int ret, j, i;
 
 	/* wait without blocking */
 	do {
@@ -198,19 +275,25 @@ static int obus_loop_do_process(struct obus_loop *loop, int timeout)
 	/* avoid loop to be destroyed in fd object callback */
 	obus_loop_ref(loop);
 
-	/* iterate on all events */
+	/* iterate on ready entries from last one: entries removed from a
+	 * callback are replaced by last entry, already dispatched */
+	loop->dispatching++;
 	j = 0;
-	for (i = 0; i < loop->nfds && j < ret; i++) {
-		/* check if fd is ready for I/O request */
-		if (!loop->pfds[i].revents)
+	for (i = loop->nfds - 1; i >= 0 && j < ret; i--) {
+		/* entries may have been removed by previous callback */
+		if (i >= loop->nfds || !loop->pfds[i].revents)
 			continue;
 
-		revents = poll_to_fd_events(loop->pfds[i].revents);
+		revents = loop->pfds[i].revents;
+		loop->pfds[i].revents = 0;
 		j++;
-		if (revents)
-			obus_loop_posix_process_fd(loop, &loop->pfds[i]);
+		obus_loop_dispatch(loop, loop->slots[i], revents);
 	}
 
+	loop->dispatching--;
+
+	/* submit io_uring writes queued by callbacks at once */
+	obus_uring_submit(loop->uring);
 	obus_loop_unref(loop);
 	return 0;
 }
@@ -246,6 +329,11 @@ int obus_loop_add(struct obus_loop *loop, struct obus_fd *ofd)
 		goto error;
 	}
 
+	/* make room for fd in poll array */
+	ret = obus_loop_grow(loop);
+	if (ret < 0)
+		goto error;
+
 	/* check if fd is already in hash */
 	ofd_check = NULL;
 	ret = obus_hash_lookup(&loop->ofds, (uint32_t)ofd->fd,
@@ -274,6 +362,13 @@ int obus_loop_add(struct obus_loop *loop, struct obus_fd *ofd)
 		goto error;
 	}
 
+	/* append fd in poll array */
+	ofd->slot = loop->nfds;
+	loop->pfds[ofd->slot].fd = ofd->dupfd != -1 ? ofd->dupfd : ofd->fd;
+	loop->pfds[ofd->slot].events = fd_to_poll_events(ofd->events);
+	loop->pfds[ofd->slot].revents = 0;
+	loop->slots[ofd->slot] = ofd;
+
 	/* Associate fd with loop */
 	ofd->loop = loop;
 	loop->nfds++;
@@ -286,8 +381,7 @@ error:
 /* update fd in loop */
 int obus_loop_update(struct obus_loop *loop, struct obus_fd *ofd)
 {
-	int ret, fd;
-	struct obus_fd *ofd_check;
+	int ret;
 
 	if (!loop || !ofd) {
 		ret = -EINVAL;
@@ -295,17 +389,15 @@ int obus_loop_update(struct obus_loop *loop, struct obus_fd *ofd)
 		goto error;
 	}
 
-	/* check fd object is in our hash */
-	fd = ofd->dupfd != -1 ? ofd->dupfd : ofd->fd;
-	ofd_check = NULL;
-	ret = obus_hash_lookup(&loop->ofds, (uint32_t)fd, (void **)&ofd_check);
-	if (ret != EEXIST || ofd_check != ofd) {
+	/* check fd object is in our poll array */
+	if (ofd->loop != loop) {
 		ret = -ENOENT;
 		obus_error("update a ofd %p not added", ofd);
 		goto error;
 	}
 
-	/* Nothing more to do, wait for next call to obus_loop_posix_get_fds */
+	/* update fd object events in poll array */
+	loop->pfds[ofd->slot].events = fd_to_poll_events(ofd->events);
 	return 0;
 
 error:
@@ -322,14 +414,19 @@ int obus_loop_remove(struct obus_loop *loop, struct obus_fd *ofd)
 		goto error;
 	}
 
-	/* remove fd object from hash */
-	fd = ofd->dupfd != -1 ? ofd->dupfd : ofd->fd;
-	ret = obus_hash_remove(&loop->ofds, (uint32_t)fd);
-	if (ret < 0) {
+	/* check fd object is in our poll array */
+	if (ofd->loop != loop) {
+		ret = -ENOENT;
 		obus_error("remove a ofd %p not added", ofd);
 		goto error;
 	}
 
+	/* remove fd object from hash and poll array */
+	fd = ofd->dupfd != -1 ? ofd->dupfd : ofd->fd;
+	(void)obus_hash_remove(&loop->ofds, (uint32_t)fd);
+	obus_loop_del_slot(loop, ofd->slot);
+	ofd->slot = -1;
+
 	/* close duplicate fd if exist */
 	if (ofd->dupfd != -1) {
 		close(ofd->dupfd);
@@ -338,7 +435,6 @@ int obus_loop_remove(struct obus_loop *loop, struct obus_fd *ofd)
 
 	/* remove association */
 	ofd->loop = NULL;
-	loop->nfds--;
 	return 0;
 
 error:
@@ -355,27 +451,20 @@ int obus_loop_posix_get_fd_count(struct obus_loop *loop)
 int obus_loop_posix_get_fds(struct obus_loop *loop,
 			    struct pollfd *pfds, int size)
 {
-	int i = 0;
-	struct obus_hash_entry *entry;
-	struct obus_fd *ofd;
+	int i;
 
 	if (!loop || !pfds || !size)
 		return -EINVAL;
 
-	/* walk fd object in hash */
-	obus_list_walk_entry_forward(&loop->ofds.entries, entry, node) {
-		ofd = (struct obus_fd *)entry->data;
-		if (i < size) {
-			pfds[i].fd = (int)entry->key;
-			pfds[i].events = fd_to_poll_events(ofd->events);
-			pfds[i].revents = 0;
-			i++;
-		}
+	/* copy poll array */
+	for (i = 0; i < size && i < loop->nfds; i++) {
+		pfds[i].fd = loop->pfds[i].fd;
+		pfds[i].events = loop->pfds[i].events;
+		pfds[i].revents = 0;
 	}
 
 	/* return number of entries added */
 	return i;
-
 }
 
 int obus_loop_posix_process_fd(struct obus_loop *loop, const struct pollfd *pfd)
@@ -397,9 +486,17 @@ int obus_loop_posix_process_fd(struct obus_loop *loop, const struct pollfd *pfd)
 		return ret;
 	}
 
+	/* avoid loop to be destroyed in fd object callback */
+	obus_loop_ref(loop);
+
 	/* invoke fd object callback */
-	(*ofd->cb) (ofd, poll_to_fd_events(pfd->revents), ofd->data);
+	obus_loop_dispatch(loop, ofd, pfd->revents);
 
+	/* submit io_uring writes queued by callback */
+	if (!loop->dispatching)
+		obus_uring_submit(loop->uring);
+
+	obus_loop_unref(loop);
 	return 0;
 }
 
@@ -0,0 +1,582 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_mirror.c
+ *
+ * @brief obus shared memory objects state mirror
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "obus_header.h"
+
+/* mirror file magic and layout version */
+#define OBUS_MIRROR_MAGIC 0x524d424f
+#define OBUS_MIRROR_VERSION 1
+
+/* one slot per possible object handle */
+#define OBUS_MIRROR_N_SLOTS 65536
+
+/* smallest data block size class (64 bytes) */
+#define OBUS_MIRROR_BLOCK_SHIFT 6
+#define OBUS_MIRROR_N_CLASSES 26
+
+/* initial encode/copy buffer size */
+#define OBUS_MIRROR_BUFFER_SIZE 1024
+
+/* reader copy attempts while writer updates a slot */
+#define OBUS_MIRROR_READ_RETRIES 1000
+
+/* slot holds an object */
+#define OBUS_MIRROR_SLOT_USED 0x01
+
+/* mirror file header */
+struct obus_mirror_hdr {
+	uint32_t magic;
+	uint32_t version;
+	/* bus api crc */
+	uint32_t crc;
+	/* 1 while server publishes state, 0 once mirror is destroyed */
+	uint32_t alive;
+	/* number of slots */
+	uint32_t n_slots;
+	/* objects data size */
+	uint32_t data_size;
+	uint8_t pad[40];
+};
+
+/* object slot, seq is odd while slot is updated */
+struct obus_mirror_slot {
+	uint32_t seq;
+	/* object uid */
+	uint16_t uid;
+	/* data block size class */
+	uint8_t class;
+	uint8_t flags;
+	/* encoded info offset in data and length */
+	uint32_t offset;
+	uint32_t len;
+};
+
+/* free data blocks of a size class (writer only), offsets array can hold
+ * all blocks of the class so that freeing a block never fails */
+struct obus_mirror_free_list {
+	uint32_t *offsets;
+	uint32_t count;
+	uint32_t size;
+	uint32_t n_blocks;
+};
+
+struct obus_mirror {
+	/* mirror file */
+	int fd;
+	char *path;
+	dev_t dev;
+	ino_t ino;
+	/* mirror file mapping */
+	void *map;
+	size_t map_size;
+	struct obus_mirror_hdr *hdr;
+	struct obus_mirror_slot *slots;
+	uint8_t *data;
+	/* data size (local copy, never read from shared memory) */
+	uint32_t data_size;
+	/* bus description */
+	const struct obus_bus_desc *desc;
+	/* encode buffer (writer) or copy buffer (reader) */
+	struct obus_buffer *buf;
+	/* writer data break and free blocks */
+	uint32_t brk;
+	struct obus_mirror_free_list free[OBUS_MIRROR_N_CLASSES];
+	/* writer already reported full data */
+	int full;
+};
+
+static size_t obus_mirror_map_size(uint32_t data_size)
+{
+	return sizeof(struct obus_mirror_hdr) +
+	       OBUS_MIRROR_N_SLOTS * sizeof(struct obus_mirror_slot) +
+	       (size_t)data_size;
+}
+
+static void obus_mirror_init_map(struct obus_mirror *mirror)
+{
+	mirror->hdr = mirror->map;
+	mirror->slots = (struct obus_mirror_slot *)(mirror->hdr + 1);
+	mirror->data = (uint8_t *)(mirror->slots + OBUS_MIRROR_N_SLOTS);
+}
+
+static struct obus_mirror *obus_mirror_alloc(const struct obus_bus_desc *desc)
+{
+	struct obus_mirror *mirror;
+
+	mirror = calloc(1, sizeof(*mirror));
+	if (!mirror)
+		return NULL;
+
+	mirror->fd = -1;
+	mirror->map = MAP_FAILED;
+	mirror->desc = desc;
+	mirror->buf = obus_buffer_new(OBUS_MIRROR_BUFFER_SIZE, NULL);
+	if (!mirror->buf) {
+		free(mirror);
+		return NULL;
+	}
+
+	return mirror;
+}
+
+static void obus_mirror_free(struct obus_mirror *mirror)
+{
+	size_t i;
+
+	if (mirror->map != MAP_FAILED)
+		munmap(mirror->map, mirror->map_size);
+	if (mirror->fd >= 0)
+		close(mirror->fd);
+
+	for (i = 0; i < OBUS_MIRROR_N_CLASSES; i++)
+		free(mirror->free[i].offsets);
+
+	obus_buffer_destroy(mirror->buf);
+	free(mirror->path);
+	free(mirror);
+}
+
+int obus_mirror_new(const char *path, size_t size, mode_t mode,
+		    const struct obus_bus_desc *desc,
+		    struct obus_mirror **mirror)
+{
+	struct obus_mirror *m;
+	char *tmp = NULL;
+	struct stat st;
+	int ret;
+
+	if (!path || !desc || !mirror || size == 0 || size > UINT32_MAX)
+		return -EINVAL;
+
+	m = obus_mirror_alloc(desc);
+	if (!m)
+		return -ENOMEM;
+
+	m->path = strdup(path);
+	tmp = malloc(strlen(path) + sizeof(".XXXXXX"));
+	if (!m->path || !tmp) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	snprintf(tmp, strlen(path) + sizeof(".XXXXXX"), "%s.XXXXXX", path);
+
+	/* file is built aside in a new unique file then renamed, so that
+	 * readers of a previous mirror keep a valid mapping */
+	m->fd = mkostemp(tmp, O_CLOEXEC);
+	if (m->fd < 0) {
+		ret = -errno;
+		obus_log_errno("mkostemp");
+		goto error;
+	}
+
+	if (fchmod(m->fd, mode) < 0 || fstat(m->fd, &st) < 0) {
+		ret = -errno;
+		obus_log_fd_errno("fchmod", m->fd);
+		goto unlink_tmp;
+	}
+
+	m->dev = st.st_dev;
+	m->ino = st.st_ino;
+
+	m->data_size = (uint32_t)size;
+	m->map_size = obus_mirror_map_size(m->data_size);
+	if (ftruncate(m->fd, (off_t)m->map_size) < 0) {
+		ret = -errno;
+		obus_log_fd_errno("ftruncate", m->fd);
+		goto unlink_tmp;
+	}
+
+	m->map = mmap(NULL, m->map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+		      m->fd, 0);
+	if (m->map == MAP_FAILED) {
+		ret = -errno;
+		obus_log_errno("mmap");
+		goto unlink_tmp;
+	}
+
+	obus_mirror_init_map(m);
+	m->hdr->version = OBUS_MIRROR_VERSION;
+	m->hdr->crc = desc->crc;
+	m->hdr->n_slots = OBUS_MIRROR_N_SLOTS;
+	m->hdr->data_size = m->data_size;
+	m->hdr->alive = 1;
+	__atomic_store_n(&m->hdr->magic, OBUS_MIRROR_MAGIC, __ATOMIC_RELEASE);
+
+	if (rename(tmp, path) < 0) {
+		ret = -errno;
+		obus_log_errno("rename");
+		goto unlink_tmp;
+	}
+
+	free(tmp);
+	*mirror = m;
+	return 0;
+
+unlink_tmp:
+	unlink(tmp);
+error:
+	free(tmp);
+	obus_mirror_free(m);
+	return ret;
+}
+
+void obus_mirror_destroy(struct obus_mirror *mirror)
+{
+	struct stat st;
+
+	if (!mirror)
+		return;
+
+	/* let readers know state is no more published */
+	__atomic_store_n(&mirror->hdr->alive, 0, __ATOMIC_RELEASE);
+
+	/* path may have been replaced by another server mirror since */
+	if (stat(mirror->path, &st) == 0 && st.st_dev == mirror->dev &&
+	    st.st_ino == mirror->ino)
+		unlink(mirror->path);
+
+	obus_mirror_free(mirror);
+}
+
+static uint8_t obus_mirror_class(size_t len)
+{
+	uint8_t class = 0;
+
+	while (((size_t)1 << (class + OBUS_MIRROR_BLOCK_SHIFT)) < len)
+		class++;
+
+	return class;
+}
+
+/* get a data block of given size class, return -ENOSPC if data is full */
+static int obus_mirror_alloc_block(struct obus_mirror *mirror, uint8_t class,
+				   uint32_t *offset)
+{
+	struct obus_mirror_free_list *list;
+	uint32_t *offsets;
+	uint32_t size, n;
+
+	if (class >= OBUS_MIRROR_N_CLASSES)
+		return -ENOSPC;
+
+	list = &mirror->free[class];
+	if (list->count > 0) {
+		*offset = list->offsets[--list->count];
+		return 0;
+	}
+
+	size = (uint32_t)1 << (class + OBUS_MIRROR_BLOCK_SHIFT);
+	if (size > mirror->data_size - mirror->brk)
+		return -ENOSPC;
+
+	/* reserve room for new block in free list */
+	if (list->n_blocks == list->size) {
+		n = list->size ? 2 * list->size : 16;
+		offsets = realloc(list->offsets, n * sizeof(*offsets));
+		if (!offsets)
+			return -ENOMEM;
+
+		list->offsets = offsets;
+		list->size = n;
+	}
+
+	list->n_blocks++;
+	*offset = mirror->brk;
+	mirror->brk += size;
+	return 0;
+}
+
+static void obus_mirror_free_block(struct obus_mirror *mirror, uint8_t class,
+				   uint32_t offset)
+{
+	struct obus_mirror_free_list *list = &mirror->free[class];
+
+	/* room was reserved when block was allocated */
+	list->offsets[list->count++] = offset;
+}
+
+/* seqlock write side: slot is odd while updated */
+static void obus_mirror_write_begin(struct obus_mirror_slot *slot)
+{
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void obus_mirror_write_end(struct obus_mirror_slot *slot)
+{
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+}
+
+static void obus_mirror_clear_slot(struct obus_mirror *mirror,
+				   struct obus_mirror_slot *slot)
+{
+	if (!(slot->flags & OBUS_MIRROR_SLOT_USED))
+		return;
+
+	obus_mirror_write_begin(slot);
+	slot->flags = 0;
+	slot->uid = OBUS_INVALID_UID;
+	slot->len = 0;
+	obus_mirror_write_end(slot);
+
+	/* block may be reused, readers of old block will see seq change */
+	obus_mirror_free_block(mirror, slot->class, slot->offset);
+}
+
+int obus_mirror_update(struct obus_mirror *mirror, struct obus_object *obj)
+{
+	struct obus_mirror_slot *slot;
+	uint32_t len, offset;
+	uint8_t class;
+	int ret, used;
+
+	if (!mirror || !obj)
+		return -EINVAL;
+
+	/* encode committed info */
+	obus_buffer_clear(mirror->buf);
+	ret = obus_struct_encode(&obj->info, mirror->buf);
+	if (ret < 0)
+		return ret;
+
+	slot = &mirror->slots[obj->handle];
+	len = (uint32_t)obus_buffer_length(mirror->buf);
+	class = obus_mirror_class(len);
+	used = slot->flags & OBUS_MIRROR_SLOT_USED;
+
+	/* reuse slot block when large enough */
+	if (used && slot->class >= class) {
+		offset = slot->offset;
+		class = slot->class;
+	} else {
+		ret = obus_mirror_alloc_block(mirror, class, &offset);
+		if (ret < 0) {
+			if (ret == -ENOSPC && !mirror->full)
+				obus_warn("state mirror '%s' is full",
+					  mirror->path);
+			mirror->full |= (ret == -ENOSPC);
+			obus_mirror_clear_slot(mirror, slot);
+			return ret;
+		}
+
+		/* old block is released once slot points to new one */
+		if (used)
+			obus_mirror_free_block(mirror, slot->class,
+					       slot->offset);
+	}
+
+	obus_mirror_write_begin(slot);
+	memcpy(mirror->data + offset, obus_buffer_ptr(mirror->buf), len);
+	slot->uid = obj->desc->uid;
+	slot->class = class;
+	slot->offset = offset;
+	slot->len = len;
+	slot->flags = OBUS_MIRROR_SLOT_USED;
+	obus_mirror_write_end(slot);
+	return 0;
+}
+
+void obus_mirror_remove(struct obus_mirror *mirror, struct obus_object *obj)
+{
+	if (mirror && obj)
+		obus_mirror_clear_slot(mirror, &mirror->slots[obj->handle]);
+}
+
+OBUS_API
+struct obus_mirror *obus_mirror_open(const char *path,
+				     const struct obus_bus_desc *desc)
+{
+	struct obus_mirror *mirror;
+	struct stat st;
+
+	if (!path || !desc)
+		return NULL;
+
+	mirror = obus_mirror_alloc(desc);
+	if (!mirror)
+		return NULL;
+
+	mirror->fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (mirror->fd < 0 || fstat(mirror->fd, &st) < 0 ||
+	    (size_t)st.st_size < obus_mirror_map_size(0))
+		goto error;
+
+	/* readers only map mirror read only */
+	mirror->map_size = (size_t)st.st_size;
+	mirror->map = mmap(NULL, mirror->map_size, PROT_READ, MAP_SHARED,
+			   mirror->fd, 0);
+	if (mirror->map == MAP_FAILED)
+		goto error;
+
+	obus_mirror_init_map(mirror);
+	if (__atomic_load_n(&mirror->hdr->magic, __ATOMIC_ACQUIRE) !=
+	    OBUS_MIRROR_MAGIC ||
+	    mirror->hdr->version != OBUS_MIRROR_VERSION ||
+	    mirror->hdr->n_slots != OBUS_MIRROR_N_SLOTS ||
+	    obus_mirror_map_size(mirror->hdr->data_size) > mirror->map_size) {
+		obus_error("invalid state mirror '%s'", path);
+		goto error;
+	}
+
+	if (mirror->hdr->crc != desc->crc) {
+		obus_error("state mirror '%s' bus crc mismatch", path);
+		goto error;
+	}
+
+	mirror->data_size = mirror->hdr->data_size;
+	return mirror;
+
+error:
+	obus_mirror_free(mirror);
+	return NULL;
+}
+
+OBUS_API int obus_mirror_close(struct obus_mirror *mirror)
+{
+	if (!mirror)
+		return -EINVAL;
+
+	obus_mirror_free(mirror);
+	return 0;
+}
+
+/* seqlock read side: copy slot encoded info in mirror buffer */
+static int obus_mirror_copy_slot(struct obus_mirror *mirror,
+				 obus_handle_t handle, uint16_t uid)
+{
+	const struct obus_mirror_slot *slot = &mirror->slots[handle];
+	uint32_t seq, offset, len;
+	int ret, retries = OBUS_MIRROR_READ_RETRIES;
+
+	while (retries-- > 0) {
+		seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1)
+			continue;
+
+		ret = 0;
+		offset = slot->offset;
+		len = slot->len;
+		obus_buffer_clear(mirror->buf);
+		if (!(slot->flags & OBUS_MIRROR_SLOT_USED) || slot->uid != uid)
+			ret = -ENOENT;
+		else if (offset > mirror->data_size ||
+			 len > mirror->data_size - offset)
+			ret = -EPROTO;
+		else if (obus_buffer_ensure_write_space(mirror->buf, len) < 0)
+			return -ENOMEM;
+
+		if (ret == 0) {
+			memcpy(obus_buffer_ptr(mirror->buf),
+			       mirror->data + offset, len);
+			obus_buffer_inc_write_ptr(mirror->buf, len);
+		}
+
+		/* check slot was not updated while copied */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+			return ret;
+	}
+
+	return -EAGAIN;
+}
+
+OBUS_API int obus_mirror_read(struct obus_mirror *mirror,
+			      const struct obus_object_desc *desc,
+			      obus_handle_t handle, void *info)
+{
+	struct obus_struct st;
+	int ret;
+
+	if (!mirror || !desc || !info || handle == OBUS_INVALID_HANDLE)
+		return -EINVAL;
+
+	if (!__atomic_load_n(&mirror->hdr->alive, __ATOMIC_ACQUIRE))
+		return -ENOTCONN;
+
+	ret = obus_mirror_copy_slot(mirror, handle, desc->uid);
+	if (ret < 0)
+		return ret;
+
+	/* decode private copy of object info */
+	st.desc = desc->info_desc;
+	st.u.addr = info;
+	memset(info, 0, desc->info_desc->size);
+	ret = obus_struct_init(&st);
+	if (ret < 0)
+		return ret;
+
+	obus_buffer_set_read_position(mirror->buf, 0);
+	ret = obus_struct_decode(&st, mirror->buf);
+	if (ret < 0)
+		obus_struct_destroy(&st);
+
+	return ret;
+}
+
+OBUS_API void obus_mirror_release_info(const struct obus_object_desc *desc,
+				       void *info)
+{
+	struct obus_struct st;
+
+	if (!desc || !info)
+		return;
+
+	st.desc = desc->info_desc;
+	st.u.addr = info;
+	obus_struct_destroy(&st);
+}
+
+OBUS_API obus_handle_t obus_mirror_next(struct obus_mirror *mirror,
+					const struct obus_object_desc *desc,
+					obus_handle_t prev)
+{
+	const struct obus_mirror_slot *slot;
+	uint32_t handle;
+
+	if (!mirror || !desc)
+		return OBUS_INVALID_HANDLE;
+
+	for (handle = (uint32_t)prev + 1; handle < OBUS_MIRROR_N_SLOTS;
+	     handle++) {
+		slot = &mirror->slots[handle];
+		if ((__atomic_load_n(&slot->flags, __ATOMIC_ACQUIRE) &
+		     OBUS_MIRROR_SLOT_USED) && slot->uid == desc->uid)
+			return (obus_handle_t)handle;
+	}
+
+	return OBUS_INVALID_HANDLE;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_mirror.h
+ *
+ * @brief obus shared memory objects state mirror
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _OBUS_MIRROR_H_
+#define _OBUS_MIRROR_H_
+
+/**
+ * read only objects state mirror.
+ *
+ * The server publishes the committed info of each registered object in a
+ * shared memory file. Each object is stored in a slot indexed by its handle
+ * and protected by a seqlock, readers map the file read only and copy an
+ * object without any lock or syscall (see obus_mirror_open).
+ */
+
+/**
+ * create server state mirror file
+ * @param path mirror file path
+ * @param size objects data size
+ * @param mode mirror file permissions
+ * @param desc bus description
+ * @param mirror created mirror
+ * @return 0 on success
+ */
+int obus_mirror_new(const char *path, size_t size, mode_t mode,
+		    const struct obus_bus_desc *desc,
+		    struct obus_mirror **mirror);
+
+/**
+ * destroy server state mirror, file is removed and readers are notified
+ * @param mirror mirror
+ */
+void obus_mirror_destroy(struct obus_mirror *mirror);
+
+/**
+ * publish object committed info
+ * @param mirror mirror
+ * @param obj registered object
+ * @return 0 on success
+ */
+int obus_mirror_update(struct obus_mirror *mirror, struct obus_object *obj);
+
+/**
+ * remove object from mirror
+ * @param mirror mirror
+ * @param obj unregistered object
+ */
+void obus_mirror_remove(struct obus_mirror *mirror, struct obus_object *obj);
+
+#endif /* _OBUS_MIRROR_H_ */
@@ -84,14 +84,30 @@ OBUS_API const struct obus_enum_driver obus_method_state_driver = {
 	obus_method_state_format,
 };
 
+size_t obus_object_alloc_size(const struct obus_object_desc *desc)
+{
+	/* object, method handlers and info struct in one block */
+	return sizeof(struct obus_object) +
+	       desc->n_methods * sizeof(obus_method_handler_cb_t) +
+	       desc->info_desc->size;
+}
+
+static void obus_object_free(struct obus_object *obj)
+{
+	if (obj->slab)
+		obus_slab_free(obj->slab, obj);
+	else
+		free(obj);
+}
+
 struct obus_object *obus_object_new(const struct obus_object_desc *desc,
 				    const obus_method_handler_cb_t *cbs,
-				    const struct obus_struct *info)
+				    const struct obus_struct *info,
+				    struct obus_slab *slab)
 {
 	struct obus_object *obj;
 	off_t info_offset;
 	uint32_t i;
-	size_t size;
 	int ret;
 
 	if (!desc)
@@ -102,14 +118,13 @@ struct obus_object *obus_object_new(const struct obus_object_desc *desc,
 		return NULL;
 	}
 
-	/* compute object size allocation */
-	size = sizeof(*obj);
-	size += (desc->n_methods * sizeof(obus_method_handler_cb_t));
-	info_offset = (off_t)size;
-	size += desc->info_desc->size;
+	/* compute info struct offset */
+	info_offset = (off_t)(sizeof(*obj) +
+			      desc->n_methods * sizeof(obus_method_handler_cb_t));
 
 	/* allocate object */
-	obj = calloc(1, size);
+	obj = slab ? obus_slab_alloc(slab) :
+		     calloc(1, obus_object_alloc_size(desc));
 	if (!obj)
 		return NULL;
 
@@ -117,6 +132,7 @@ struct obus_object *obus_object_new(const struct obus_object_desc *desc,
 	obus_node_unref(&obj->node);
 	obus_node_unref(&obj->event_node);
 	obj->desc = desc;
+	obj->slab = slab;
 	obj->handle = OBUS_INVALID_HANDLE;
 	obj->info.desc = desc->info_desc;
 	obj->info.u.addr = ((uint8_t *)obj + info_offset);
@@ -145,7 +161,7 @@ struct obus_object *obus_object_new(const struct obus_object_desc *desc,
 	return obj;
 
 error:
-	free(obj);
+	obus_object_free(obj);
 	return NULL;
 }
 
@@ -171,8 +187,9 @@ OBUS_API int obus_object_destroy(struct obus_object *obj)
 		obus_list_del(&obj->event_node);
 
 	/* release object memory */
+	obus_buffer_destroy(obj->add_blob);
 	obus_struct_destroy(&obj->info);
-	free(obj);
+	obus_object_free(obj);
 	return 0;
 }
 
@@ -313,6 +330,14 @@ error:
 }
 
 int obus_object_add_encode(struct obus_object *obj, struct obus_buffer *buf)
+{
+	return obus_object_add_encode_masked(obj, buf, NULL);
+}
+
+/* encode object with only fields set in mask (NULL for all fields) */
+int obus_object_add_encode_masked(struct obus_object *obj,
+				  struct obus_buffer *buf,
+				  const uint32_t *mask)
 {
 	int ret;
 	size_t offset, length;
@@ -336,7 +361,7 @@ int obus_object_add_encode(struct obus_object *obj, struct obus_buffer *buf)
 		return ret;
 
 	/* add object struct content */
-	ret = obus_struct_encode(&obj->info, buf);
+	ret = obus_struct_encode_masked(&obj->info, buf, mask);
 	if (ret < 0)
 		return ret;
 
@@ -348,7 +373,37 @@ int obus_object_add_encode(struct obus_object *obj, struct obus_buffer *buf)
 	return 0;
 }
 
-struct obus_object *obus_object_add_decode(struct obus_bus_api *api,
+/* encode object once and copy cached encoding until next invalidate */
+int obus_object_add_encode_cached(struct obus_object *obj,
+				  struct obus_buffer *buf)
+{
+	int ret;
+
+	if (!obj->add_blob) {
+		obj->add_blob = obus_buffer_new(OBUS_OBJECT_BLOB_SIZE, NULL);
+		if (!obj->add_blob)
+			return -ENOMEM;
+	}
+
+	if (obus_buffer_length(obj->add_blob) == 0) {
+		ret = obus_object_add_encode(obj, obj->add_blob);
+		if (ret < 0) {
+			obus_buffer_clear(obj->add_blob);
+			return ret;
+		}
+	}
+
+	return obus_buffer_append(buf, obus_buffer_ptr(obj->add_blob),
+				  obus_buffer_length(obj->add_blob));
+}
+
+void obus_object_invalidate(struct obus_object *obj)
+{
+	if (obj->add_blob)
+		obus_buffer_clear(obj->add_blob);
+}
+
+struct obus_object *obus_object_add_decode(struct obus_bus *bus,
 					   struct obus_buffer *buf)
 {
 	int ret;
@@ -390,7 +445,7 @@ struct obus_object *obus_object_add_decode(struct obus_bus_api *api,
 	}
 
 	/* find object descriptor */
-	desc = obus_bus_api_object(api, uid);
+	desc = obus_bus_api_object(&bus->api, uid);
 	if (!desc) {
 		obus_warn("can't decode object uid=%d, descriptor not found",
 			  uid);
@@ -398,7 +453,8 @@ struct obus_object *obus_object_add_decode(struct obus_bus_api *api,
 	}
 
 	/* create object */
-	obj = obus_object_new(desc, NULL, NULL);
+	obj = obus_object_new(desc, NULL, NULL,
+			      obus_bus_object_slab(bus, desc));
 	if (!obj)
 		goto eat_bytes;
 
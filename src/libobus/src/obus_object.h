@@ -37,6 +37,9 @@
 #ifndef _OBUS_OBJECT_H_
 #define _OBUS_OBJECT_H_
 
+/* initial size of object encoded add cache */
+#define OBUS_OBJECT_BLOB_SIZE 256
+
 struct obus_object {
 	/* object node */
 	struct obus_node node;
@@ -50,17 +53,26 @@ struct obus_object {
 	obus_handle_t handle;
 	/* is object registered */
 	unsigned int is_registered:1;
+	/* registration order in bus */
+	uint64_t reg_seq;
 	/* user data */
 	void *user_data;
 	/* object info struct */
 	struct obus_struct info;
+	/* object allocator (NULL if allocated from heap) */
+	struct obus_slab *slab;
+	/* encoded object add cache (empty if invalidated) */
+	struct obus_buffer *add_blob;
 	/* call handlers array */
 	obus_method_handler_cb_t handlers[0];
 };
 
+size_t obus_object_alloc_size(const struct obus_object_desc *desc);
+
 struct obus_object *obus_object_new(const struct obus_object_desc *desc,
 				    const obus_method_handler_cb_t *cbs,
-				    const struct obus_struct *info);
+				    const struct obus_struct *info,
+				    struct obus_slab *slab);
 
 int obus_object_destroy(struct obus_object *obj);
 
@@ -86,7 +98,16 @@ struct obus_object *obus_object_remove_decode(struct obus_bus *bus,
 
 int obus_object_add_encode(struct obus_object *obj, struct obus_buffer *buf);
 
-struct obus_object *obus_object_add_decode(struct obus_bus_api *api,
+int obus_object_add_encode_masked(struct obus_object *obj,
+				  struct obus_buffer *buf,
+				  const uint32_t *mask);
+
+int obus_object_add_encode_cached(struct obus_object *obj,
+				  struct obus_buffer *buf);
+
+void obus_object_invalidate(struct obus_object *obj);
+
+struct obus_object *obus_object_add_decode(struct obus_bus *bus,
 					   struct obus_buffer *buf);
 
 void obus_object_log(const struct obus_object *obj, enum obus_log_level level);
@@ -56,6 +56,8 @@ static const char *const obus_pkt_types[OBUS_PKT_COUNT] = {
 	[OBUS_PKT_CALL]		= "CALL",
 	[OBUS_PKT_ACK]		= "ACK",
 	[OBUS_PKT_BUS_EVENT]	= "BUS_EVENT",
+	[OBUS_PKT_SYNC]		= "SYNC",
+	[OBUS_PKT_SUBSCRIBE]	= "SUBSCRIBE",
 };
 
 /* log header */
@@ -86,6 +88,9 @@ const char *obus_conresp_status_str(enum obus_conresp_status status)
 #define OBUS_PKT_HDR_SIZE_OFFSET 4
 #define OBUS_PKT_HDR_TYPE_OFFSET 8
 
+/* max accepted packet size, bounds memory a peer can make us allocate */
+#define OBUS_PKT_MAX_SIZE (64 * 1024 * 1024)
+
 static int obus_packet_encode_header(struct obus_buffer *buf, uint8_t type)
 {
 	int ret;
@@ -109,6 +114,195 @@ static int obus_packet_encode_header(struct obus_buffer *buf, uint8_t type)
 	return 0;
 }
 
+/******** subscriptions block format ***
+ ***************************************************************
+ *  filtered | n_subs | uid | n_events | event uid | n_fields | field uid
+ *     1B        2B     2B      2B          2B         2B          2B
+ ***************************************************************/
+void obus_packet_subscribe_release(struct obus_packet_subscribe *sub)
+{
+	uint16_t i;
+
+	if (!sub || !sub->subs)
+		return;
+
+	for (i = 0; i < sub->n_subs; i++) {
+		free(sub->subs[i].events);
+		free(sub->subs[i].fields);
+	}
+
+	free(sub->subs);
+	sub->subs = NULL;
+	sub->n_subs = 0;
+}
+
+static int obus_packet_uids_decode(struct obus_packet_decoder *d,
+				   uint16_t n_uids, uint16_t **uids)
+{
+	uint16_t i;
+	int ret;
+
+	*uids = NULL;
+	if (n_uids == 0)
+		return 0;
+
+	*uids = calloc(n_uids, sizeof(**uids));
+	if (!*uids)
+		return -ENOMEM;
+
+	for (i = 0; i < n_uids; i++) {
+		ret = obus_buffer_read_u16(d->buf, &(*uids)[i]);
+		if (ret < 0) {
+			free(*uids);
+			*uids = NULL;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int obus_packet_subscribe_block_decode(struct obus_packet_decoder *d,
+					struct obus_packet_subscribe *sub)
+{
+	int ret;
+	uint8_t filtered;
+	uint16_t i;
+	struct obus_subscription *s;
+
+	memset(sub, 0, sizeof(*sub));
+
+	ret = obus_buffer_read_u8(d->buf, &filtered);
+	if (ret < 0)
+		return ret;
+
+	ret = obus_buffer_read_u16(d->buf, &sub->n_subs);
+	if (ret < 0)
+		return ret;
+
+	sub->filtered = filtered ? 1 : 0;
+	if (sub->n_subs == 0)
+		return 0;
+
+	sub->subs = calloc(sub->n_subs, sizeof(*sub->subs));
+	if (!sub->subs) {
+		sub->n_subs = 0;
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < sub->n_subs; i++) {
+		s = &sub->subs[i];
+		ret = obus_buffer_read_u16(d->buf, &s->uid);
+		if (ret < 0)
+			goto error;
+
+		ret = obus_buffer_read_u16(d->buf, &s->n_events);
+		if (ret < 0)
+			goto error;
+
+		ret = obus_packet_uids_decode(d, s->n_events, &s->events);
+		if (ret < 0) {
+			s->n_events = 0;
+			goto error;
+		}
+
+		ret = obus_buffer_read_u16(d->buf, &s->n_fields);
+		if (ret < 0)
+			goto error;
+
+		ret = obus_packet_uids_decode(d, s->n_fields, &s->fields);
+		if (ret < 0) {
+			s->n_fields = 0;
+			goto error;
+		}
+	}
+
+	return 0;
+
+error:
+	obus_packet_subscribe_release(sub);
+	return ret;
+}
+
+static int obus_packet_subscribe_block_encode(struct obus_buffer *buf,
+				const struct obus_packet_subscribe *sub)
+{
+	int ret;
+	uint16_t i, j;
+	const struct obus_subscription *s;
+
+	ret = obus_buffer_append_u8(buf, sub->filtered ? 1 : 0);
+	if (ret < 0)
+		return ret;
+
+	ret = obus_buffer_append_u16(buf, sub->n_subs);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < sub->n_subs; i++) {
+		s = &sub->subs[i];
+		ret = obus_buffer_append_u16(buf, s->uid);
+		if (ret < 0)
+			return ret;
+
+		ret = obus_buffer_append_u16(buf, s->n_events);
+		if (ret < 0)
+			return ret;
+
+		for (j = 0; j < s->n_events; j++) {
+			ret = obus_buffer_append_u16(buf, s->events[j]);
+			if (ret < 0)
+				return ret;
+		}
+
+		ret = obus_buffer_append_u16(buf, s->n_fields);
+		if (ret < 0)
+			return ret;
+
+		for (j = 0; j < s->n_fields; j++) {
+			ret = obus_buffer_append_u16(buf, s->fields[j]);
+			if (ret < 0)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int obus_packet_subscribe_decode(struct obus_packet_decoder *d,
+					struct obus_packet_subscribe *sub)
+{
+	if (!d || !sub)
+		return -EINVAL;
+
+	return obus_packet_subscribe_block_decode(d, sub);
+}
+
+/* encode subscriptions update */
+int obus_packet_subscribe_encode(struct obus_buffer *buf,
+				 const struct obus_packet_subscribe *sub)
+{
+	int ret;
+
+	if (!buf || !sub)
+		return -EINVAL;
+
+	/* clear buffer */
+	obus_buffer_clear(buf);
+
+	/* reserve extra space for header */
+	ret = obus_buffer_reserve(buf, OBUS_PKT_HDR_SIZE);
+	if (ret < 0)
+		return ret;
+
+	ret = obus_packet_subscribe_block_encode(buf, sub);
+	if (ret < 0)
+		return ret;
+
+	/* encode header */
+	return obus_packet_encode_header(buf, OBUS_PKT_SUBSCRIBE);
+}
+
 static int obus_packet_conreq_decode(struct obus_packet_decoder *d,
 				     struct obus_packet_conreq *req)
 {
@@ -137,12 +331,29 @@ static int obus_packet_conreq_decode(struct obus_packet_decoder *d,
 	if (ret < 0)
 		return ret;
 
+	/* optional capabilities, not sent by older clients */
+	req->caps = 0;
+	if (obus_buffer_get_read_position(d->buf) < d->start + d->hdr.size) {
+		ret = obus_buffer_read_u32(d->buf, &req->caps);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* optional subscriptions, sent only by filtering clients */
+	memset(&req->sub, 0, sizeof(req->sub));
+	if (obus_buffer_get_read_position(d->buf) < d->start + d->hdr.size) {
+		ret = obus_packet_subscribe_block_decode(d, &req->sub);
+		if (ret < 0)
+			return ret;
+	}
+
 	return 0;
 }
 
 /* encode connection request info from read packet */
 int obus_packet_conreq_encode(struct obus_buffer *buf, const char *client,
-			      const char *bus, uint32_t crc)
+			      const char *bus, uint32_t crc,
+			      const struct obus_packet_subscribe *sub)
 {
 	int ret;
 
@@ -177,6 +388,18 @@ int obus_packet_conreq_encode(struct obus_buffer *buf, const char *client,
 	if (ret < 0)
 		return ret;
 
+	/* add client capabilities */
+	ret = obus_buffer_append_u32(buf, OBUS_CONREQ_CAPS);
+	if (ret < 0)
+		return ret;
+
+	/* add subscriptions if client filters objects */
+	if (sub && sub->filtered) {
+		ret = obus_packet_subscribe_block_encode(buf, sub);
+		if (ret < 0)
+			return ret;
+	}
+
 	/* encode header */
 	return obus_packet_encode_header(buf, OBUS_PKT_CONREQ);
 }
@@ -215,19 +438,31 @@ static int obus_packet_conresp_decode(struct obus_packet_decoder *d,
 	/* create objects */
 	for (i = 0; i < n_objects; i++) {
 		/* decode object */
-		obj = obus_object_add_decode(&d->bus->api, d->buf);
+		obj = obus_object_add_decode(d->bus, d->buf);
 		/* add object in list */
 		if (obj)
 			obus_list_add_before(&resp->objects, &obj->node);
 	}
 
+	/* optional streamed flag, only sent with empty objects list */
+	resp->streamed = 0;
+	if (n_objects == 0 &&
+	    obus_buffer_get_read_position(d->buf) < d->start + d->hdr.size) {
+		ret = obus_buffer_read_u8(d->buf, &status);
+		if (ret < 0)
+			return ret;
+		resp->streamed = status ? 1 : 0;
+	}
+
 	return 0;
 }
 
 /* encode connection response info to packet buffer */
 int obus_packet_conresp_encode(struct obus_buffer *buf,
 			       enum obus_conresp_status status,
-			       struct obus_node *objects)
+			       struct obus_node *objects,
+			       const struct obus_bus_event_filter *filter,
+			       int streamed)
 {
 	int ret;
 	struct obus_object *obj;
@@ -250,7 +485,15 @@ int obus_packet_conresp_encode(struct obus_buffer *buf,
 		return ret;
 
 	/* add number of objects in list */
-	n_objects = objects ? (uint32_t)obus_list_length(objects) : 0;
+	n_objects = 0;
+	if (objects && !filter) {
+		n_objects = (uint32_t)obus_list_length(objects);
+	} else if (objects) {
+		obus_list_walk_entry_forward(objects, obj, node) {
+			n_objects += (*filter->object)(filter->data, obj) ? 1 : 0;
+		}
+	}
+
 	ret = obus_buffer_append_u32(buf, n_objects);
 	if (ret < 0)
 		return ret;
@@ -258,17 +501,123 @@ int obus_packet_conresp_encode(struct obus_buffer *buf,
 	/* encode each objects */
 	if (n_objects > 0) {
 		obus_list_walk_entry_forward(objects, obj, node) {
-			/* encode object */
-			ret = obus_object_add_encode(obj, buf);
+			if (filter && !(*filter->object)(filter->data, obj))
+				continue;
+
+			/* copy object cached encoding unless projected */
+			if (filter && filter->mask)
+				ret = obus_packet_sync_add(buf, obj,
+					(*filter->mask)(filter->data, obj));
+			else
+				ret = obus_object_add_encode_cached(obj, buf);
 			if (ret < 0)
 				return ret;
 		}
 	}
 
+	/* tell client objects follow in sync chunks, older clients
+	 * ignore this trailing flag */
+	if (streamed && n_objects == 0) {
+		ret = obus_buffer_append_u8(buf, 1);
+		if (ret < 0)
+			return ret;
+	}
+
 	/* encode header */
 	return obus_packet_encode_header(buf, OBUS_PKT_CONRESP);
 }
 
+/* sync chunk layout after header: last flag (u8), number of objects (u32)
+ * and objects encoded as in connection response */
+#define OBUS_PKT_SYNC_LAST_OFFSET OBUS_PKT_HDR_SIZE
+#define OBUS_PKT_SYNC_COUNT_OFFSET (OBUS_PKT_SYNC_LAST_OFFSET + 1)
+
+static int obus_packet_sync_decode(struct obus_packet_decoder *d,
+				   struct obus_packet_sync *sync)
+{
+	int ret;
+	struct obus_object *obj;
+	uint32_t i, n_objects;
+	uint8_t last;
+
+	if (!d || !sync)
+		return -EINVAL;
+
+	obus_list_init(&sync->objects);
+
+	/* read last chunk flag */
+	ret = obus_buffer_read_u8(d->buf, &last);
+	if (ret < 0)
+		return ret;
+
+	sync->last = last ? 1 : 0;
+
+	/* read number of objects in chunk */
+	ret = obus_buffer_read_u32(d->buf, &n_objects);
+	if (ret < 0)
+		return ret;
+
+	/* create objects */
+	for (i = 0; i < n_objects; i++) {
+		/* decode object */
+		obj = obus_object_add_decode(d->bus, d->buf);
+		/* add object in list */
+		if (obj)
+			obus_list_add_before(&sync->objects, &obj->node);
+	}
+
+	return 0;
+}
+
+int obus_packet_sync_init(struct obus_buffer *buf)
+{
+	if (!buf)
+		return -EINVAL;
+
+	/* clear buffer */
+	obus_buffer_clear(buf);
+
+	/* reserve extra space for header, last flag and objects count */
+	return obus_buffer_reserve(buf, OBUS_PKT_SYNC_COUNT_OFFSET +
+				   sizeof(uint32_t));
+}
+
+int obus_packet_sync_add(struct obus_buffer *buf, struct obus_object *obj,
+			 const uint32_t *mask)
+{
+	if (!buf || !obj)
+		return -EINVAL;
+
+	/* projected objects are not cached */
+	if (mask)
+		return obus_object_add_encode_masked(obj, buf, mask);
+
+	/* copy object cached encoding */
+	return obus_object_add_encode_cached(obj, buf);
+}
+
+int obus_packet_sync_end(struct obus_buffer *buf, uint32_t n_objects,
+			 int last)
+{
+	int ret;
+
+	if (!buf)
+		return -EINVAL;
+
+	ret = obus_buffer_write_u8(buf, last ? 1 : 0,
+				   OBUS_PKT_SYNC_LAST_OFFSET);
+	if (ret < 0)
+		return ret;
+
+	ret = obus_buffer_write_u32(buf, n_objects,
+				    OBUS_PKT_SYNC_COUNT_OFFSET);
+	if (ret < 0)
+		return ret;
+
+	/* encode header */
+	return obus_packet_encode_header(buf, OBUS_PKT_SYNC);
+}
+
 static int obus_packet_add_decode(struct obus_packet_decoder *d,
 				  struct obus_object **obj)
 {
@@ -276,7 +625,7 @@ static int obus_packet_add_decode(struct obus_packet_decoder *d,
 		return -EINVAL;
 
 	/* decode object */
-	*obj = obus_object_add_decode(&d->bus->api, d->buf);
+	*obj = obus_object_add_decode(d->bus, d->buf);
 	if (!*obj) {
 		obus_error("can't decode object from packet");
 		return -ENOENT;
@@ -285,7 +634,8 @@ static int obus_packet_add_decode(struct obus_packet_decoder *d,
 	return 0;
 }
 
-int obus_packet_add_encode(struct obus_buffer *buf, struct obus_object *obj)
+int obus_packet_add_encode(struct obus_buffer *buf, struct obus_object *obj,
+			   const uint32_t *mask)
 {
 	int ret;
 
@@ -301,7 +651,7 @@ int obus_packet_add_encode(struct obus_buffer *buf, struct obus_object *obj)
 		return ret;
 
 	/* encode object */
-	ret = obus_object_add_encode(obj, buf);
+	ret = obus_object_add_encode_masked(obj, buf, mask);
 	if (ret < 0) {
 		obus_error("can't encode object (uid=%d) handle=%d",
 			   obj->desc->uid, obj->handle);
@@ -355,7 +705,7 @@ obus_packet_event_decode(struct obus_packet_decoder *d,
 		return -EINVAL;
 
 	/* decode object event */
-	*event = obus_event_decode(d->bus, d->buf);
+	*event = obus_event_decode(d->bus, d->buf, d->borrow);
 	if (!*event) {
 		obus_error("can't decode object event from packet");
 		return -ENOENT;
@@ -365,7 +715,7 @@ obus_packet_event_decode(struct obus_packet_decoder *d,
 }
 
 int obus_packet_event_encode(struct obus_buffer *buf,
-				    struct obus_event *event)
+			     struct obus_event *event, const uint32_t *mask)
 {
 	int ret;
 
@@ -381,7 +731,7 @@ int obus_packet_event_encode(struct obus_buffer *buf,
 		return ret;
 
 	/* encode object event */
-	ret = obus_event_encode(event, buf);
+	ret = obus_event_encode_masked(event, buf, mask);
 	if (ret < 0) {
 		obus_error("can't encode object %s event %s",
 			   event->obj->desc->name, event->desc->name);
@@ -394,7 +744,8 @@ int obus_packet_event_encode(struct obus_buffer *buf,
 
 /* encode bus event */
 int obus_packet_bus_event_encode(struct obus_buffer *buf,
-				 struct obus_bus_event *event)
+				 struct obus_bus_event *event,
+				 const struct obus_bus_event_filter *filter)
 {
 	int ret;
 
@@ -410,7 +761,7 @@ int obus_packet_bus_event_encode(struct obus_buffer *buf,
 		return ret;
 
 	/* encode bus event */
-	ret = obus_bus_event_encode(event, buf);
+	ret = obus_bus_event_encode(event, buf, filter);
 	if (ret < 0) {
 		obus_error("can't encode bus event %s", event->desc->name);
 		return ret;
@@ -428,7 +779,7 @@ obus_packet_bus_event_decode(struct obus_packet_decoder *d,
 		return -EINVAL;
 
 	/* decode object event */
-	*event = obus_bus_event_decode(d->bus, d->buf);
+	*event = obus_bus_event_decode(d->bus, d->buf, d->borrow);
 	if (!*event) {
 		obus_error("can't decode bus event from packet");
 		return -ENOENT;
@@ -563,32 +914,75 @@ static int obus_packet_decode_header(struct obus_packet_decoder *d)
 		/* read packet type */
 		(void)obus_buffer_read_u8(d->buf, &d->hdr.type);
 
-		/* check packet type */
-		if (d->hdr.type >= OBUS_PKT_COUNT) {
-			/* invalid packet type */
+		/* check packet type and size */
+		if (d->hdr.type >= OBUS_PKT_COUNT ||
+		    d->hdr.size < OBUS_PKT_HDR_SIZE ||
+		    d->hdr.size > OBUS_PKT_MAX_SIZE) {
+			/* invalid packet header */
 			obus_buffer_set_read_position(d->buf, pos + 1);
 			continue;
 		}
 
-		/* header found:
-		 * 1. remove all unused bytes before header
-		 * 2. set header pointer to start of buffer */
-		obus_buffer_remove_first(d->buf, pos);
+		/* header found, bytes before it are skipped and
+		 * dropped at next buffer compaction */
+		d->start = pos;
 		d->hdr_valid = 1;
 		return 0;
 	}
 
-	/* header not found, clear buffer, keep last bytes
+	/* header not found, skip buffer, keep last bytes
 	 * maybe start of new packet header */
-	if (obus_buffer_length(d->buf) >= OBUS_PKT_HDR_SIZE) {
-		obus_buffer_remove_first(d->buf,
-					 obus_buffer_length(d->buf) -
-					 (OBUS_PKT_HDR_SIZE - 1));
+	if (obus_buffer_read_length(d->buf) >= OBUS_PKT_HDR_SIZE) {
+		obus_buffer_set_read_position(d->buf,
+					      obus_buffer_length(d->buf) -
+					      (OBUS_PKT_HDR_SIZE - 1));
 	}
 
 	return -EAGAIN;
 }
 
+/* drop already decoded bytes from buffer start */
+static void obus_packet_decoder_compact(struct obus_packet_decoder *d)
+{
+	size_t pos, off;
+
+	/* keep current packet if its header is decoded */
+	pos = obus_buffer_get_read_position(d->buf);
+	off = d->hdr_valid ? d->start : pos;
+	if (off == 0)
+		return;
+
+	obus_buffer_remove_first(d->buf, off);
+	obus_buffer_set_read_position(d->buf, pos - off);
+	d->start = 0;
+}
+
+/* get size to be read in buffer free region */
+static size_t obus_packet_decoder_read_size(struct obus_packet_decoder *d)
+{
+	size_t len, missing;
+
+	/* check remaining write space in buffer */
+	len = obus_buffer_write_space(d->buf);
+
+	/* make room for rest of packet if header is decoded, growing
+	 * at most by buffer capacity so memory follows received data */
+	if (d->hdr_valid) {
+		missing = d->hdr.size - (obus_buffer_length(d->buf) - d->start);
+		if (missing > obus_buffer_size(d->buf))
+			missing = obus_buffer_size(d->buf);
+		if (missing > len)
+			len = missing;
+	}
+
+	/* if no more space available,
+	 * double buffer capacity */
+	if (len == 0)
+		len = obus_buffer_size(d->buf);
+
+	return len;
+}
+
 /* init decoder */
 int obus_packet_decoder_init(struct obus_packet_decoder *d,
 			     struct obus_buffer *buf,
@@ -597,11 +991,16 @@ int obus_packet_decoder_init(struct obus_packet_decoder *d,
 			     int log_hdr)
 {
 	d->hdr_valid = 0;
+	d->start = 0;
 	d->bus = bus;
 	d->io = io;
 	d->buf = obus_buffer_ref(buf);
 	d->log_hdr = log_hdr ? 1 : 0;
+	d->borrow = 0;
+	d->stats = NULL;
+	d->traffic = NULL;
 	obus_buffer_clear(d->buf);
+	obus_buffer_set_read_position(d->buf, 0);
 	return 0;
 }
 
@@ -618,16 +1017,27 @@ int obus_packet_decoder_destroy(struct obus_packet_decoder *d)
 int obus_packet_decoder_reset(struct obus_packet_decoder *d)
 {
 	d->hdr_valid = 0;
+	d->start = 0;
 	obus_buffer_clear(d->buf);
+	obus_buffer_set_read_position(d->buf, 0);
 	return 0;
 }
 
+/* account decoded packets in given counters */
+void obus_packet_decoder_set_stats(struct obus_packet_decoder *d,
+				   struct obus_stats *stats,
+				   struct obus_traffic_stats *traffic)
+{
+	d->stats = stats;
+	d->traffic = traffic;
+}
 
 /* read from decoder */
 int obus_packet_decoder_read(struct obus_packet_decoder *d,
 			     struct obus_packet_info *info)
 {
 	int ret, read_more;
+	uint64_t start;
 	size_t len;
 	ssize_t nbytes;
 
@@ -638,13 +1048,15 @@ int obus_packet_decoder_read(struct obus_packet_decoder *d,
 	while (1) {
 		ret = -1;
 		if (read_more) {
-			/* check remaining write space in buffer */
-			len = obus_buffer_write_space(d->buf);
+			/* compact buffer once before reading so that free
+			 * region is contiguous at buffer end */
+			obus_packet_decoder_compact(d);
+
+			/* decoder without io is fed by its owner */
+			if (!d->io)
+				return -EAGAIN;
 
-			/* if no more space available,
-			 * double buffer capacity */
-			if (len == 0)
-				len = obus_buffer_size(d->buf);
+			len = obus_packet_decoder_read_size(d);
 
 			/* read io */
 			nbytes = obus_io_read(d->io, d->buf, len);
@@ -665,7 +1077,7 @@ int obus_packet_decoder_read(struct obus_packet_decoder *d,
 		}
 
 		/* header parsed & valid, check whole packet read */
-		if (obus_buffer_length(d->buf) < d->hdr.size) {
+		if (obus_buffer_length(d->buf) - d->start < d->hdr.size) {
 			read_more = 1;
 			continue;
 		}
@@ -675,6 +1087,7 @@ int obus_packet_decoder_read(struct obus_packet_decoder *d,
 			obus_packet_log_header(&d->hdr);
 
 		/* decode packet */
+		start = d->stats ? obus_stats_start(d->stats) : 0;
 		info->type = (enum obus_packet_type)d->hdr.type;
 		switch (info->type) {
 		case OBUS_PKT_CONREQ:
@@ -701,15 +1114,29 @@ int obus_packet_decoder_read(struct obus_packet_decoder *d,
 		case OBUS_PKT_ACK:
 			ret = obus_packet_ack_decode(d, &info->ack);
 			break;
+		case OBUS_PKT_SYNC:
+			ret = obus_packet_sync_decode(d, &info->sync);
+			break;
+		case OBUS_PKT_SUBSCRIBE:
+			ret = obus_packet_subscribe_decode(d, &info->sub);
+			break;
 		case OBUS_PKT_COUNT:
 		default:
 			ret = -ENOENT;
 			break;
 		}
 
-		/* remove decoded packet data from buffer */
-		obus_buffer_remove_first(d->buf, d->hdr.size);
-		obus_buffer_set_read_position(d->buf, 0);
+		if (d->stats)
+			obus_time_hist_add(&d->stats->decode, start);
+
+		if (d->traffic) {
+			d->traffic->rx_packets++;
+			d->traffic->rx_bytes += d->hdr.size;
+		}
+
+		/* skip decoded packet data, buffer is compacted only when
+		 * more data needs to be read */
+		obus_buffer_set_read_position(d->buf, d->start + d->hdr.size);
 		d->hdr_valid = 0;
 		if (ret == 0)
 			return 0;
@@ -40,6 +40,18 @@
 /* current obus protocol version */
 #define OBUS_PROTOCOL_VERSION 0x02
 
+/* connection request capabilities, sent after client name where servers
+ * not knowing them ignore them, so protocol version is kept unchanged */
+/* client handles objects streamed in sync chunks */
+#define OBUS_CONREQ_CAP_SYNC (1 << 0)
+/* client knows builtin stats object type */
+#define OBUS_CONREQ_CAP_STATS (1 << 1)
+
+/* capabilities of this library clients */
+#define OBUS_CONREQ_CAPS (OBUS_CONREQ_CAP_SYNC | OBUS_CONREQ_CAP_STATS)
+
+struct obus_bus_event_filter;
+
 /* packet type */
 enum obus_packet_type {
 	/**
@@ -74,9 +86,40 @@ enum obus_packet_type {
 	 * method call acknowledgment, from server to client
 	 */
 	OBUS_PKT_ACK,
+	/**
+	 * registered objects sync chunk, from server to client
+	 */
+	OBUS_PKT_SYNC,
+	/**
+	 * objects subscriptions update, from client to server
+	 */
+	OBUS_PKT_SUBSCRIBE,
 	OBUS_PKT_COUNT,
 };
 
+/* object type subscription */
+struct obus_subscription {
+	/* object uid */
+	uint16_t uid;
+	/* number of subscribed events (0 for all object events) */
+	uint16_t n_events;
+	/* subscribed events uids */
+	uint16_t *events;
+	/* number of projected fields (0 for all object fields) */
+	uint16_t n_fields;
+	/* projected fields uids */
+	uint16_t *fields;
+};
+
+struct obus_packet_subscribe {
+	/* objects are filtered by subscriptions */
+	int filtered;
+	/* number of subscriptions */
+	uint16_t n_subs;
+	/* subscriptions array */
+	struct obus_subscription *subs;
+};
+
 struct obus_packet_conreq {
 	/* protocol version */
 	uint8_t version;
@@ -86,6 +129,10 @@ struct obus_packet_conreq {
 	uint32_t crc;
 	/* bus client name */
 	char *client;
+	/* client capabilities (none if not sent) */
+	uint32_t caps;
+	/* client subscriptions (not filtered if not sent) */
+	struct obus_packet_subscribe sub;
 };
 
 enum obus_conresp_status {
@@ -108,6 +155,15 @@ struct obus_packet_conresp {
 	enum obus_conresp_status status;
 	/* object list sync */
 	struct obus_node objects;
+	/* objects follow in sync chunks */
+	int streamed;
+};
+
+struct obus_packet_sync {
+	/* last chunk of objects sync */
+	int last;
+	/* object list chunk */
+	struct obus_node objects;
 };
 
 struct obus_packet_info {
@@ -115,6 +171,8 @@ struct obus_packet_info {
 	union {
 		struct obus_packet_conreq conreq;
 		struct obus_packet_conresp conresp;
+		struct obus_packet_sync sync;
+		struct obus_packet_subscribe sub;
 		struct obus_bus_event *bus_event;
 		struct obus_event *event;
 		struct obus_call *call;
@@ -135,14 +193,22 @@ struct obus_packet_decoder {
 	struct obus_packet_header hdr;
 	/* has valid header */
 	int hdr_valid;
+	/* offset of current packet start in buffer */
+	size_t start;
 	/* associated bus */
 	struct obus_bus *bus;
 	/* associated buffer */
 	struct obus_buffer *buf;
-	/* associated io */
+	/* associated io (NULL if buffer is filled by decoder owner) */
 	struct obus_io *io;
 	/* packet log header flag */
 	int log_hdr;
+	/* decode events strings & arrays as views in buffer */
+	int borrow;
+	/* decoding time counters (NULL if none) */
+	struct obus_stats *stats;
+	/* received packets counters (NULL if none) */
+	struct obus_traffic_stats *traffic;
 };
 
 /* init decoder */
@@ -158,34 +224,62 @@ int obus_packet_decoder_destroy(struct obus_packet_decoder *dec);
 /* reset decoder */
 int obus_packet_decoder_reset(struct obus_packet_decoder *d);
 
+/* account decoded packets in given counters */
+void obus_packet_decoder_set_stats(struct obus_packet_decoder *d,
+				   struct obus_stats *stats,
+				   struct obus_traffic_stats *traffic);
+
 /* read from decoder */
 int obus_packet_decoder_read(struct obus_packet_decoder *d,
 			     struct obus_packet_info *info);
 
 /* encode connection request info to packet buffer */
 int obus_packet_conreq_encode(struct obus_buffer *buf, const char *client,
-			      const char *bus, uint32_t crc);
+			      const char *bus, uint32_t crc,
+			      const struct obus_packet_subscribe *sub);
 
-/* encode connection response info to packet buffer */
+/* encode subscriptions update */
+int obus_packet_subscribe_encode(struct obus_buffer *buf,
+				 const struct obus_packet_subscribe *sub);
+
+/* release decoded subscriptions */
+void obus_packet_subscribe_release(struct obus_packet_subscribe *sub);
+
+/* encode connection response info to packet buffer, objects are
+ * filtered and projected by optional filter */
 int obus_packet_conresp_encode(struct obus_buffer *buf,
 			       enum obus_conresp_status status,
-			       struct obus_node *objects);
+			       struct obus_node *objects,
+			       const struct obus_bus_event_filter *filter,
+			       int streamed);
+
+/* start objects sync chunk encoding */
+int obus_packet_sync_init(struct obus_buffer *buf);
+
+/* add object to sync chunk, with only fields set in mask (NULL for all) */
+int obus_packet_sync_add(struct obus_buffer *buf, struct obus_object *obj,
+			 const uint32_t *mask);
+
+/* complete sync chunk with its number of objects */
+int obus_packet_sync_end(struct obus_buffer *buf, uint32_t n_objects,
+			 int last);
 
-/* encode add object */
+/* encode add object, with only fields set in mask (NULL for all) */
 int obus_packet_add_encode(struct obus_buffer *buf,
-			   struct obus_object *obj);
+			   struct obus_object *obj, const uint32_t *mask);
 
 /* encode remove object */
 int obus_packet_remove_encode(struct obus_buffer *buf,
 			      struct obus_object *obj);
 
-/* encode object event */
+/* encode object event, with only fields set in mask (NULL for all) */
 int obus_packet_event_encode(struct obus_buffer *buf,
-			     struct obus_event *event);
+			     struct obus_event *event, const uint32_t *mask);
 
-/* encode bus event */
+/* encode bus event, filter may be NULL */
 int obus_packet_bus_event_encode(struct obus_buffer *buf,
-				 struct obus_bus_event *event);
+				 struct obus_bus_event *event,
+				 const struct obus_bus_event_filter *filter);
 
 /* encode object call */
 int obus_packet_call_encode(struct obus_buffer *buf,
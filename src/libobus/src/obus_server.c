@@ -39,6 +39,15 @@
 /* sizeof buffer */
 #define OBUS_DEFAULT_BUFFER_SIZE 1024
 
+/* size of peer merged object events hash table */
+#define OBUS_PEER_HASH_SIZE 31
+
+/* objects sync chunk packets are completed once above this size */
+#define OBUS_SYNC_CHUNK_SIZE (32 * 1024)
+
+/* size of object type subscribers hash table */
+#define OBUS_SUBSCRIBERS_HASH_SIZE 31
+
 /* obus server state */
 enum obus_server_state {
 	SERVER_STATE_IDLE = 0,
@@ -61,11 +70,48 @@ struct obus_peer {
 	enum obus_peer_state state;
 	struct obus_server *srv;
 	struct obus_io *io;
+	struct obus_worker_io *wio;	/* io of writer thread if any */
 	struct obus_socket_peer *sk;
 	struct obus_packet_decoder decoder;
+	struct obus_peer_queue_stats qstats;	/* write queue counters */
+	struct obus_traffic_stats traffic;	/* packets counters */
+	int coalescing;			/* object events are coalesced */
+	struct obus_hash coalesced;	/* merged object events by handle */
+	int log;			/* broadcasts are read in shm log */
+	uint32_t caps;			/* peer connection capabilities */
+	int syncing;			/* registered objects are streamed */
+	struct obus_object *sync_next;	/* next object to stream */
+	uint64_t sync_pos;		/* last streamed object order */
+	uint64_t sync_end;		/* first order registered after sync */
+	struct obus_hash synced;	/* objects sent ahead of stream */
+	struct obus_buffer *sync_buf;	/* chunk not yet written */
+	int filtered;			/* only subscribed objects are sent */
+	struct obus_hash subs;		/* subscriptions by object uid */
 	void *user_data;
 };
 
+/* object type fields projection, shared by peers with identical masks */
+struct obus_projection {
+	struct obus_node node;		/* node in server projections */
+	struct obus_node send_node;	/* node in projected broadcast list */
+	uint16_t uid;			/* object type uid */
+	uint32_t n_refs;
+	int sending;			/* broadcast packet is projected */
+	struct obus_buffer *buf;	/* projected broadcast packet */
+	uint32_t n_words;
+	uint32_t mask[0];		/* projected fields bitset */
+};
+
+/* peer subscription to an object type */
+struct obus_peer_sub {
+	struct obus_node node;		/* node in object type subscribers */
+	struct obus_peer *peer;
+	uint16_t uid;
+	uint16_t n_events;		/* 0 for all object events */
+	uint16_t *events;
+	struct obus_projection *proj;	/* NULL for all object fields */
+};
+
 /* obus server */
 struct obus_server {
 	struct obus_node peers;
@@ -74,14 +120,39 @@ struct obus_server {
 	struct obus_socket_server **sks;
 	size_t n_sks;
 	struct obus_buffer_pool pool;
-	struct obus_call *call;
 	enum obus_server_state state;
 	size_t n_peers_connected;
+	struct obus_peer_queue_limits qlimits;
+	int conflation;
+	struct obus_shm_log *shm_log;	/* broadcast log of shm peers */
+	size_t shm_log_size;
 	uint32_t log_flags;
+	struct obus_node *sub_lists;	/* subscribers of each object type */
+	struct obus_hash subscribers;	/* subscribers list by object uid */
+	size_t n_filtered;		/* number of filtering peers */
+	struct obus_node projections;	/* peers fields projections */
+	struct obus_submit *submit;	/* events submitted by other threads */
+	struct obus_worker **workers;	/* socket peers writer threads */
+	size_t n_workers;
+	struct obus_stats stats;	/* encoding/decoding time counters */
+	struct obus_traffic_stats traffic;	/* closed peers and shm log */
+	uint64_t n_connections;
+	uint64_t n_disconnections;
+	struct obus_object *stats_obj;	/* published stats object or NULL */
+	struct obus_timer *stats_timer;	/* stats object update timer */
+	int stats_period;
+	struct obus_peer *reading;	/* peer whose packets are handled */
 	obus_peer_connection_cb_t peer_connection_cb;
 	void *user_data;
 };
 
+/* event or bus event submitted from another thread */
+struct obus_server_submission {
+	struct obus_submit_node node;
+	struct obus_event *event;
+	struct obus_bus_event *bus_event;
+};
+
 static int obus_peer_is_connected(struct obus_peer *peer)
 {
 	return peer && (peer->state == PEER_STATE_CONNECTED);
@@ -162,6 +233,353 @@ static void obus_peer_notify_user(struct obus_peer *peer,
 						  peer->srv->user_data);
 }
 
+/* destroy merged object events not sent to peer */
+static void obus_peer_clear_coalesced(struct obus_peer *peer)
+{
+	struct obus_hash_entry *entry, *tmp;
+	struct obus_event *event;
+
+	obus_list_walk_entry_forward_safe(&peer->coalesced.entries, entry,
+					  tmp, node) {
+		event = entry->data;
+		obus_hash_remove(&peer->coalesced, event->obj->handle);
+		obus_event_destroy(event);
+	}
+
+	peer->coalescing = 0;
+}
+
+/* get peers subscribed to given object type */
+static struct obus_node *obus_server_subscribers(struct obus_server *srv,
+						 uint16_t uid)
+{
+	void *list;
+
+	if (obus_hash_lookup(&srv->subscribers, uid, &list) < 0)
+		return NULL;
+
+	return list;
+}
+
+static struct obus_peer_sub *obus_peer_get_sub(struct obus_peer *peer,
+					       uint16_t uid)
+{
+	void *sub;
+
+	if (obus_hash_lookup(&peer->subs, uid, &sub) < 0)
+		return NULL;
+
+	return sub;
+}
+
+/* get projection of given fields, shared with other peers subscriptions */
+static struct obus_projection *
+obus_server_get_projection(struct obus_server *srv,
+			   const struct obus_subscription *s)
+{
+	const struct obus_object_desc *desc;
+	const struct obus_field_desc *field;
+	struct obus_projection *proj, *it;
+	struct obus_struct st;
+	uint32_t n_words, idx, i;
+
+	desc = obus_bus_api_object(&srv->bus.api, s->uid);
+	if (!desc)
+		return NULL;
+
+	n_words = OBUS_STRUCT_MASK_WORDS(desc->info_desc->n_fields);
+	proj = calloc(1, sizeof(*proj) + n_words * sizeof(uint32_t));
+	if (!proj)
+		return NULL;
+
+	proj->uid = s->uid;
+	proj->n_refs = 1;
+	proj->n_words = n_words;
+
+	/* methods states are always sent */
+	for (i = 0; i < desc->info_desc->n_fields; i++) {
+		if (desc->info_desc->fields[i].role == OBUS_METHOD)
+			proj->mask[i / 32] |= 1u << (i % 32);
+	}
+
+	st.desc = desc->info_desc;
+	st.u.addr = NULL;
+	for (i = 0; i < s->n_fields; i++) {
+		field = obus_struct_get_field_desc(&st, s->fields[i]);
+		if (!field)
+			continue;
+
+		idx = (uint32_t)(field - desc->info_desc->fields);
+		proj->mask[idx / 32] |= 1u << (idx % 32);
+	}
+
+	/* share identical projection */
+	obus_list_walk_entry_forward(&srv->projections, it, node) {
+		if (it->uid == proj->uid &&
+		    memcmp(it->mask, proj->mask,
+			   n_words * sizeof(uint32_t)) == 0) {
+			free(proj);
+			it->n_refs++;
+			return it;
+		}
+	}
+
+	obus_list_add_before(&srv->projections, &proj->node);
+	return proj;
+}
+
+static void obus_projection_unref(struct obus_projection *proj)
+{
+	if (!proj || --proj->n_refs > 0)
+		return;
+
+	obus_list_del(&proj->node);
+	free(proj);
+}
+
+/* check projection sends fields not sent by previous one */
+static int obus_projection_widens(const struct obus_projection *from,
+				  const struct obus_projection *to)
+{
+	uint32_t i;
+
+	if (!from)
+		return 0;
+
+	if (!to)
+		return 1;
+
+	for (i = 0; i < to->n_words; i++) {
+		if (to->mask[i] & ~from->mask[i])
+			return 1;
+	}
+
+	return 0;
+}
+
+static int obus_peer_sub_has_event(const struct obus_peer_sub *sub,
+				   uint16_t uid)
+{
+	uint16_t i;
+
+	if (sub->n_events == 0)
+		return 1;
+
+	for (i = 0; i < sub->n_events; i++) {
+		if (sub->events[i] == uid)
+			return 1;
+	}
+
+	return 0;
+}
+
+/* check peer receives objects of given type */
+static int obus_peer_wants_type(struct obus_peer *peer, uint16_t uid)
+{
+	/* published stats object type is unknown to older peers */
+	if (uid == OBUS_STATS_UID && peer->srv->stats_obj &&
+	    !(peer->caps & OBUS_CONREQ_CAP_STATS))
+		return 0;
+
+	return !peer->filtered || obus_peer_get_sub(peer, uid) != NULL;
+}
+
+/* bus event filter callbacks */
+static int obus_peer_wants_object(void *data, struct obus_object *obj)
+{
+	return obus_peer_wants_type(data, obj->desc->uid);
+}
+
+static int obus_peer_wants_event(void *data, struct obus_event *evt)
+{
+	struct obus_peer *peer = data;
+	struct obus_peer_sub *sub;
+
+	if (!peer->filtered)
+		return 1;
+
+	sub = obus_peer_get_sub(peer, evt->obj->desc->uid);
+	return sub && obus_peer_sub_has_event(sub, evt->desc->uid);
+}
+
+/* get peer fields mask of object, NULL for all fields */
+static const uint32_t *obus_peer_mask(void *data, struct obus_object *obj)
+{
+	struct obus_peer_sub *sub;
+
+	/* unfiltered peers have no subscriptions */
+	sub = obus_peer_get_sub(data, obj->desc->uid);
+	return (sub && sub->proj) ? sub->proj->mask : NULL;
+}
+
+static void obus_peer_remove_sub(struct obus_peer *peer,
+				 struct obus_peer_sub *sub)
+{
+	obus_list_del(&sub->node);
+	obus_hash_remove(&peer->subs, sub->uid);
+	obus_projection_unref(sub->proj);
+	free(sub->events);
+	free(sub);
+}
+
+/* set peer subscription to an object type, replacing previous one */
+static int obus_peer_add_sub(struct obus_peer *peer,
+			     const struct obus_subscription *s)
+{
+	struct obus_peer_sub *sub;
+	struct obus_node *list;
+	int ret;
+
+	/* ignore object types unknown by server */
+	list = obus_server_subscribers(peer->srv, s->uid);
+	if (!list)
+		return 0;
+
+	sub = obus_peer_get_sub(peer, s->uid);
+	if (sub)
+		obus_peer_remove_sub(peer, sub);
+
+	sub = calloc(1, sizeof(*sub));
+	if (!sub)
+		return -ENOMEM;
+
+	sub->peer = peer;
+	sub->uid = s->uid;
+	if (s->n_events) {
+		sub->events = malloc(s->n_events * sizeof(*sub->events));
+		if (!sub->events) {
+			free(sub);
+			return -ENOMEM;
+		}
+		memcpy(sub->events, s->events,
+		       s->n_events * sizeof(*sub->events));
+		sub->n_events = s->n_events;
+	}
+
+	if (s->n_fields) {
+		sub->proj = obus_server_get_projection(peer->srv, s);
+		if (!sub->proj) {
+			free(sub->events);
+			free(sub);
+			return -ENOMEM;
+		}
+	}
+
+	ret = obus_hash_insert(&peer->subs, sub->uid, sub);
+	if (ret < 0) {
+		obus_projection_unref(sub->proj);
+		free(sub->events);
+		free(sub);
+		return ret;
+	}
+
+	obus_list_add_before(list, &sub->node);
+	return 0;
+}
+
+static void obus_peer_clear_subs(struct obus_peer *peer)
+{
+	struct obus_hash_entry *entry, *tmp;
+
+	obus_list_walk_entry_forward_safe(&peer->subs.entries, entry,
+					  tmp, node) {
+		obus_peer_remove_sub(peer, entry->data);
+	}
+}
+
+static void obus_peer_set_filtered(struct obus_peer *peer, int filtered)
+{
+	if (peer->filtered == filtered)
+		return;
+
+	peer->filtered = filtered;
+	if (filtered)
+		peer->srv->n_filtered++;
+	else
+		peer->srv->n_filtered--;
+}
+
+/* get object registered after given one */
+static struct obus_object *obus_server_next_object(struct obus_server *srv,
+						   struct obus_object *obj)
+{
+	if (!obj || obj->node.next == &srv->bus.objects)
+		return NULL;
+
+	return obus_list_entry(obj->node.next, struct obus_object, node);
+}
+
+/* start streaming objects registered before peer connection */
+static void obus_peer_sync_start(struct obus_peer *peer)
+{
+	struct obus_server *srv = peer->srv;
+
+	peer->syncing = 1;
+	peer->sync_pos = 0;
+	peer->sync_end = srv->bus.objects_seq + 1;
+	peer->sync_next = NULL;
+	if (!obus_list_is_empty(&srv->bus.objects))
+		peer->sync_next = obus_list_entry(
+				obus_list_first(&srv->bus.objects),
+				struct obus_object, node);
+}
+
+static void obus_peer_sync_done(struct obus_peer *peer)
+{
+	struct obus_hash_entry *entry, *tmp;
+
+	obus_list_walk_entry_forward_safe(&peer->synced.entries, entry,
+					  tmp, node) {
+		obus_hash_remove(&peer->synced, entry->key);
+	}
+
+	peer->syncing = 0;
+	peer->sync_next = NULL;
+}
+
+/* check object is known by server but not yet streamed to peer */
+static int obus_peer_sync_pending(struct obus_peer *peer,
+				  const struct obus_object *obj)
+{
+	void *data;
+
+	if (!peer->syncing || obj->reg_seq <= peer->sync_pos ||
+	    obj->reg_seq >= peer->sync_end)
+		return 0;
+
+	/* object may have been sent ahead of stream */
+	return obus_hash_lookup(&peer->synced, obj->handle, &data) < 0;
+}
+
+/* unregister object from bus, peers objects sync continues after it */
+static int obus_server_unregister_bus_object(struct obus_server *srv,
+					     struct obus_object *obj)
+{
+	struct obus_peer *peer;
+
+	obus_list_walk_entry_forward(&srv->peers, peer, node) {
+		if (peer->sync_next == obj)
+			peer->sync_next = obus_server_next_object(srv, obj);
+	}
+
+	return obus_bus_unregister_object(&srv->bus, obj);
+}
+
+static void obus_server_drop_calls(struct obus_server *srv,
+				   struct obus_peer *peer)
+{
+	struct obus_call *call, *tmp;
+
+	/* peer is gone, no ack can be sent anymore */
+	obus_list_walk_entry_forward_safe(&srv->bus.calls, call, tmp, node) {
+		if (call->peer != peer)
+			continue;
+
+		obus_bus_unregister_call(&srv->bus, call);
+		obus_call_destroy(call);
+	}
+}
+
 static int obus_peer_destroy(struct obus_peer *peer)
 {
 	struct obus_server *srv = peer->srv;
@@ -169,46 +587,1092 @@ static int obus_peer_destroy(struct obus_peer *peer)
 	if (peer->state == PEER_STATE_CONNECTED) {
 		peer->state = PEER_STATE_DISCONNECTED;
 		srv->n_peers_connected--;
+		srv->n_disconnections++;
 		obus_peer_notify_user(peer, OBUS_PEER_EVENT_DISCONNECTED);
 	}
 
+	/* keep peer traffic in server counters */
+	obus_traffic_add(&srv->traffic, &peer->traffic);
+
+	/* let packets reader know peer is gone */
+	if (srv->reading == peer)
+		srv->reading = NULL;
+
 	if (peer->srv->log_flags & OBUS_LOG_CONNECTION)
 		obus_info("peer {addr='%s', name='%s'} disconnected from "
 			  "'%s' bus", obus_socket_peer_name(peer->sk),
 			  peer->name,  srv->bus.api.desc->name);
 
+	/* destroy peer pending calls */
+	obus_server_drop_calls(srv, peer);
+
 	/* remove peer from list */
 	obus_list_del(&peer->node);
 	obus_io_destroy(peer->io);
 	obus_packet_decoder_destroy(&peer->decoder);
+	obus_peer_clear_coalesced(peer);
+	obus_hash_destroy(&peer->coalesced);
+	obus_peer_sync_done(peer);
+	obus_hash_destroy(&peer->synced);
+	obus_peer_clear_subs(peer);
+	obus_peer_set_filtered(peer, 0);
+	obus_hash_destroy(&peer->subs);
+
+	/* socket is closed once writer thread released it */
+	if (peer->wio) {
+		obus_worker_io_destroy(peer->wio);
+		return 0;
+	}
+
 	obus_socket_peer_disconnect(peer->sk);
 	free(peer->name);
 	free(peer);
 	return 0;
 }
 
-static void obus_server_send_peers(struct obus_server *srv,
-				   struct obus_buffer *buf)
+static void obus_peer_worker_closed(void *user_data)
 {
-	struct obus_peer *peer, *tmp;
+	struct obus_peer *peer = user_data;
+
+	obus_socket_peer_disconnect(peer->sk);
+	free(peer->name);
+	free(peer);
+}
+
+static size_t obus_peer_pending_count(const struct obus_peer *peer)
+{
+	return peer->wio ? obus_worker_io_get_pending_count(peer->wio) :
+			   obus_io_get_pending_count(peer->io);
+}
+
+static size_t obus_peer_pending_bytes(const struct obus_peer *peer)
+{
+	return peer->wio ? obus_worker_io_get_pending_bytes(peer->wio) :
+			   obus_io_get_pending_bytes(peer->io);
+}
+
+OBUS_API
+int obus_server_set_peer_queue_limits(struct obus_server *srv,
+				      const struct obus_peer_queue_limits *limits)
+{
+	if (!srv)
+		return -EINVAL;
+
+	if (limits)
+		srv->qlimits = *limits;
+	else
+		memset(&srv->qlimits, 0, sizeof(srv->qlimits));
+
+	return 0;
+}
+
+OBUS_API
+int obus_server_set_peer_conflation(struct obus_server *srv, int enable)
+{
+	if (!srv)
+		return -EINVAL;
+
+	srv->conflation = enable ? 1 : 0;
+	return 0;
+}
+
+OBUS_API
+int obus_server_set_shm_log_size(struct obus_server *srv, size_t size)
+{
+	if (!srv)
+		return -EINVAL;
+
+	if (srv->state == SERVER_STATE_STARTED)
+		return -EPERM;
+
+	srv->shm_log_size = size;
+	return 0;
+}
+
+OBUS_API
+int obus_server_set_workers(struct obus_server *srv, size_t n_workers)
+{
+	if (!srv)
+		return -EINVAL;
+
+	if (srv->state == SERVER_STATE_STARTED)
+		return -EPERM;
+
+	srv->n_workers = n_workers;
+	return 0;
+}
+
+static void obus_server_destroy_workers(struct obus_server *srv)
+{
+	size_t i;
+
+	if (!srv->workers)
+		return;
+
+	for (i = 0; i < srv->n_workers; i++)
+		obus_worker_destroy(srv->workers[i]);
+
+	free(srv->workers);
+	srv->workers = NULL;
+}
+
+static int obus_server_create_workers(struct obus_server *srv)
+{
+	size_t i;
+
+	if (srv->n_workers == 0)
+		return 0;
+
+	srv->workers = calloc(srv->n_workers, sizeof(*srv->workers));
+	if (!srv->workers)
+		return -ENOMEM;
+
+	for (i = 0; i < srv->n_workers; i++) {
+		srv->workers[i] = obus_worker_new(srv->loop);
+		if (!srv->workers[i]) {
+			obus_server_destroy_workers(srv);
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+OBUS_API
+int obus_server_set_state_mirror(struct obus_server *srv, const char *path,
+				 size_t size, mode_t mode)
+{
+	struct obus_object *obj;
 	int ret;
 
-	/* notify peers of un registered object */
-	obus_list_walk_entry_forward_safe(&srv->peers, peer, tmp, node) {
-		/* only notify connected peers */
-		if (!obus_peer_is_connected(peer))
-			continue;
+	if (!srv || (path && size == 0))
+		return -EINVAL;
+
+	/* replace previous mirror */
+	obus_mirror_destroy(srv->bus.mirror);
+	srv->bus.mirror = NULL;
+	if (!path)
+		return 0;
+
+	ret = obus_mirror_new(path, size, mode, srv->bus.api.desc,
+			      &srv->bus.mirror);
+	if (ret < 0)
+		return ret;
+
+	/* publish already registered objects */
+	obus_list_walk_entry_forward(&srv->bus.objects, obj, node) {
+		obus_mirror_update(srv->bus.mirror, obj);
+	}
+
+	return 0;
+}
+
+OBUS_API
+int obus_server_get_alloc_stats(struct obus_server *srv,
+				struct obus_alloc_stats *stats)
+{
+	if (!srv)
+		return -EINVAL;
+
+	return obus_bus_get_alloc_stats(&srv->bus, stats);
+}
+
+OBUS_API
+int obus_peer_get_queue_stats(const struct obus_peer *peer,
+			      struct obus_peer_queue_stats *stats)
+{
+	if (!peer || !stats)
+		return -EINVAL;
+
+	*stats = peer->qstats;
+	stats->queued_bytes = obus_peer_pending_bytes(peer);
+	stats->queued_packets = obus_peer_pending_count(peer);
+	return 0;
+}
+
+OBUS_API
+int obus_server_set_stats_timing(struct obus_server *srv, int enable)
+{
+	if (!srv)
+		return -EINVAL;
+
+	srv->stats.timing = enable ? 1 : 0;
+	return 0;
+}
+
+OBUS_API
+int obus_server_get_stats(struct obus_server *srv,
+			  struct obus_server_stats *stats)
+{
+	struct obus_peer *peer;
+
+	if (!srv || !stats)
+		return -EINVAL;
+
+	/* peers counters are only summed here */
+	memset(stats, 0, sizeof(*stats));
+	stats->traffic = srv->traffic;
+	obus_list_walk_entry_forward(&srv->peers, peer, node) {
+		obus_traffic_add(&stats->traffic, &peer->traffic);
+	}
+
+	stats->n_peers = (uint32_t)srv->n_peers_connected;
+	stats->n_connections = srv->n_connections;
+	stats->n_disconnections = srv->n_disconnections;
+	stats->n_pending_calls = srv->bus.n_calls;
+	stats->encode = srv->stats.encode;
+	stats->decode = srv->stats.decode;
+	return 0;
+}
+
+OBUS_API
+int obus_peer_get_stats(const struct obus_peer *peer,
+			struct obus_peer_stats *stats)
+{
+	struct obus_call *call;
+
+	if (!peer || !stats)
+		return -EINVAL;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->traffic = peer->traffic;
+	obus_peer_get_queue_stats(peer, &stats->queue);
+	obus_list_walk_entry_forward(&peer->srv->bus.calls, call, node) {
+		if (call->peer == peer)
+			stats->n_pending_calls++;
+	}
+
+	return 0;
+}
+
+/* send server counters in stats object 'updated' event */
+static int obus_server_update_stats(struct obus_server *srv)
+{
+	struct obus_server_stats stats;
+	struct obus_stats_info info;
+	struct obus_event event;
+	struct obus_struct st = {
+		.u.addr = &info,
+		.desc = obus_stats_desc.info_desc
+	};
+	int ret;
+
+	obus_server_get_stats(srv, &stats);
+	obus_stats_info_set(&info, &stats);
+	ret = obus_event_init(&event, srv->stats_obj,
+			      &obus_stats_updated_desc, &st);
+	if (ret < 0)
+		return ret;
+
+	return obus_server_send_event(srv, &event);
+}
+
+static void obus_server_stats_timer(struct obus_timer *timer,
+				    uint64_t *nbexpired, void *data)
+{
+	struct obus_server *srv = data;
+
+	if (obus_server_update_stats(srv) < 0)
+		obus_error("can't update server stats object");
+
+	obus_timer_set(srv->stats_timer, srv->stats_period);
+}
+
+/* unregister and destroy published stats object */
+static void obus_server_stop_stats(struct obus_server *srv)
+{
+	obus_timer_destroy(srv->stats_timer);
+	srv->stats_timer = NULL;
+	srv->stats_period = 0;
+	if (!srv->stats_obj)
+		return;
+
+	obus_server_unregister_object(srv, srv->stats_obj);
+	obus_object_destroy(srv->stats_obj);
+	srv->stats_obj = NULL;
+}
+
+OBUS_API
+int obus_server_publish_stats(struct obus_server *srv, int period)
+{
+	struct obus_server_stats stats;
+	struct obus_stats_info info;
+	struct obus_struct st = {
+		.u.addr = &info,
+		.desc = obus_stats_desc.info_desc
+	};
+	int ret;
+
+	if (!srv || period < 0)
+		return -EINVAL;
+
+	if (period == 0) {
+		obus_server_stop_stats(srv);
+		return 0;
+	}
+
+	/* generated bus may already use stats object uid */
+	if (obus_bus_api_object(&srv->bus.api, OBUS_STATS_UID) !=
+	    &obus_stats_desc)
+		return -EEXIST;
+
+	if (!srv->stats_timer) {
+		srv->stats_timer = obus_timer_new(srv->loop,
+						  &obus_server_stats_timer,
+						  srv);
+		if (!srv->stats_timer)
+			return -ENOMEM;
+	}
+
+	if (!srv->stats_obj) {
+		obus_server_get_stats(srv, &stats);
+		obus_stats_info_set(&info, &stats);
+		srv->stats_obj = obus_server_new_object(srv, &obus_stats_desc,
+							NULL, &st);
+		if (!srv->stats_obj) {
+			ret = -ENOMEM;
+			goto stop_stats;
+		}
+
+		ret = obus_server_register_object(srv, srv->stats_obj);
+		if (ret < 0) {
+			obus_object_destroy(srv->stats_obj);
+			srv->stats_obj = NULL;
+			goto stop_stats;
+		}
+	}
+
+	srv->stats_period = period;
+	obus_timer_set(srv->stats_timer, period);
+	return 0;
+
+stop_stats:
+	obus_server_stop_stats(srv);
+	return ret;
+}
+
+/* write packet to peer, a buffer ref is taken if write is queued.
+ * return 0 if written or queued, negative errno on write error */
+static int obus_peer_write(struct obus_peer *peer, struct obus_buffer *buf)
+{
+	size_t count, bytes;
+	int ret;
+
+	if (peer->wio) {
+		/* writer thread keeps a ref until written */
+		ret = obus_worker_io_write(peer->wio, buf);
+		if (ret < 0)
+			return ret;
+	} else {
+		ret = obus_io_write(peer->io, buf);
+		if (ret == 0) {
+			obus_traffic_tx(&peer->traffic, obus_buffer_length(buf));
+			return 0;
+		}
+
+		if (ret != -EAGAIN)
+			return ret;
+
+		/* buffer write async get a ref on it */
+		obus_buffer_ref(buf);
+	}
+
+	obus_traffic_tx(&peer->traffic, obus_buffer_length(buf));
+
+	/* update queue high water marks */
+	count = obus_peer_pending_count(peer);
+	bytes = obus_peer_pending_bytes(peer);
+	if (count > peer->qstats.peak_packets)
+		peer->qstats.peak_packets = count;
+	if (bytes > peer->qstats.peak_bytes)
+		peer->qstats.peak_bytes = bytes;
+
+	return 0;
+}
+
+/* find first object event description updating given field */
+static int obus_object_desc_first_event(const struct obus_object_desc *desc,
+					uint16_t uid)
+{
+	size_t i, j;
+
+	for (i = 0; i < desc->n_events; i++) {
+		for (j = 0; j < desc->events[i].n_updates; j++) {
+			if (desc->events[i].updates[j].field->uid == uid)
+				return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+/* write object fields to peer using object event packets, each field is
+ * sent once in the first object event description that updates it, only
+ * fields projected for peer are written */
+static int obus_peer_write_object_fields(struct obus_peer *peer,
+					 struct obus_object *obj,
+					 const struct obus_struct *info)
+{
+	const struct obus_struct_desc *st_desc = obj->desc->info_desc;
+	const uint32_t *mask = obus_peer_mask(peer, obj);
+	const struct obus_field_desc *field;
+	struct obus_stats *stats = &peer->srv->stats;
+	struct obus_event *event;
+	struct obus_buffer *buf;
+	uint64_t start;
+	size_t i, j;
+	int ret = 0;
+
+	for (i = 0; i < obj->desc->n_events && ret == 0; i++) {
+		event = obus_event_new(obj, &obj->desc->events[i], info);
+		if (!event)
+			return -ENOMEM;
+
+		/* keep only fields owned by this event */
+		for (j = 0; j < st_desc->n_fields; j++) {
+			field = &st_desc->fields[j];
+			if (obus_object_desc_first_event(obj->desc,
+							 field->uid) != (int)i)
+				obus_struct_clear_has_field(&event->info,
+							    field);
+		}
+
+		if (obus_struct_is_masked_empty(&event->info, mask))
+			goto destroy_event;
+
+		/* peek buffer */
+		buf = obus_buffer_pool_peek(&peer->srv->pool);
+		if (!buf) {
+			ret = -ENOMEM;
+			goto destroy_event;
+		}
+
+		/* encode object event packet */
+		start = obus_stats_start(stats);
+		ret = obus_packet_event_encode(buf, event, mask);
+		obus_time_hist_add(&stats->encode, start);
+		if (ret == 0)
+			ret = obus_peer_write(peer, buf);
+
+		obus_buffer_unref(buf);
+destroy_event:
+		obus_event_destroy(event);
+	}
+
+	return ret;
+}
+
+/* write merged object events to peer */
+static int obus_peer_flush_coalesced(struct obus_peer *peer)
+{
+	struct obus_hash_entry *entry, *tmp;
+	struct obus_event *event;
+	int ret = 0;
+
+	peer->coalescing = 0;
+	obus_list_walk_entry_forward_safe(&peer->coalesced.entries, entry,
+					  tmp, node) {
+		event = entry->data;
+		if (ret == 0)
+			ret = obus_peer_write_object_fields(peer, event->obj,
+							    &event->info);
+
+		obus_hash_remove(&peer->coalesced, event->obj->handle);
+		obus_event_destroy(event);
+	}
+
+	return ret;
+}
+
+/* merge object event in peer pending object updates */
+static int obus_peer_coalesce_event(struct obus_peer *peer,
+				    struct obus_event *event)
+{
+	struct obus_event *pending;
+	int ret;
+
+	/* get pending update of event object */
+	ret = obus_hash_lookup(&peer->coalesced, event->obj->handle,
+			       (void **)&pending);
+	if (ret < 0) {
+		pending = obus_event_new(event->obj, event->desc, NULL);
+		if (!pending)
+			return -ENOMEM;
+
+		ret = obus_hash_insert(&peer->coalesced, event->obj->handle,
+				       pending);
+		if (ret < 0) {
+			obus_event_destroy(pending);
+			return ret;
+		}
+	}
+
+	/* only keep latest value of each field */
+	peer->qstats.n_coalesced++;
+	return obus_struct_merge(&pending->info, &event->info);
+}
+
+/* check peer queue against server limits and apply overflow policy,
+ * return negative errno if peer must be destroyed */
+static int obus_peer_check_queue(struct obus_peer *peer)
+{
+	const struct obus_peer_queue_limits *limits = &peer->srv->qlimits;
+	size_t max_bytes, max_packets;
+
+	max_bytes = limits->max_bytes ? limits->max_bytes : SIZE_MAX;
+	max_packets = limits->max_packets ? limits->max_packets : SIZE_MAX;
+	if (obus_peer_pending_bytes(peer) <= max_bytes &&
+	    obus_peer_pending_count(peer) <= max_packets)
+		return 0;
+
+	peer->qstats.n_overflows++;
+	switch (limits->policy) {
+	case OBUS_PEER_QUEUE_COALESCE:
+		peer->coalescing = 1;
+		return 0;
+	case OBUS_PEER_QUEUE_BLOCK:
+		/* server loop can not wait for writer thread, merge object
+		 * events instead */
+		if (peer->wio) {
+			peer->coalescing = 1;
+			return 0;
+		}
+
+		return obus_io_flush(peer->io, max_bytes, max_packets,
+				     limits->block_timeout);
+	case OBUS_PEER_QUEUE_DROP:
+	default:
+		obus_warn("peer {addr='%s', name='%s'} write queue full",
+			  obus_socket_peer_name(peer->sk), peer->name);
+		return -ENOBUFS;
+	}
+}
+
+/* write next chunk of objects sync, last chunk completes peer sync */
+static int obus_peer_sync_chunk(struct obus_peer *peer)
+{
+	struct obus_object *obj = peer->sync_next;
+	struct obus_stats *stats = &peer->srv->stats;
+	struct obus_buffer *buf;
+	uint32_t n_objects = 0;
+	uint64_t start;
+	void *data;
+	int ret, last;
+
+	/* peek buffer */
+	buf = obus_buffer_pool_peek(&peer->srv->pool);
+	if (!buf)
+		return -ENOMEM;
+
+	start = obus_stats_start(stats);
+	ret = obus_packet_sync_init(buf);
+	while (ret == 0 && obj && obj->reg_seq < peer->sync_end &&
+	       obus_buffer_length(buf) < OBUS_SYNC_CHUNK_SIZE) {
+		/* skip objects already sent ahead of stream or not
+		 * subscribed */
+		if (obus_peer_wants_type(peer, obj->desc->uid) &&
+		    obus_hash_lookup(&peer->synced, obj->handle, &data) < 0) {
+			ret = obus_packet_sync_add(buf, obj,
+						   obus_peer_mask(peer, obj));
+			n_objects++;
+		}
+
+		peer->sync_pos = obj->reg_seq;
+		obj = obus_server_next_object(peer->srv, obj);
+	}
+
+	last = !obj || obj->reg_seq >= peer->sync_end;
+	peer->sync_next = last ? NULL : obj;
+
+	if (ret == 0)
+		ret = obus_packet_sync_end(buf, n_objects, last);
+	obus_time_hist_add(&stats->encode, start);
+	if (ret < 0)
+		obus_error("can't encode objects sync packet");
+	else
+		ret = obus_peer_write(peer, buf);
+
+	/* queued chunk is completed before next one is encoded */
+	if (ret == 0 && (peer->wio || obus_io_get_pending_count(peer->io)))
+		peer->sync_buf = buf;
+
+	obus_buffer_unref(buf);
+	if (ret == 0 && last)
+		obus_peer_sync_done(peer);
+
+	return ret;
+}
+
+/* check peer write queue is blocked, packets handed to writer thread or
+ * to loop io_uring are only pending if its io was blocked */
+static int obus_peer_is_blocked(const struct obus_peer *peer)
+{
+	return peer->wio ? obus_worker_io_is_blocked(peer->wio) :
+			   obus_io_is_blocked(peer->io);
+}
+
+/* stream objects chunks as long as peer io does not block, next chunks
+ * are written once peer write queue is drained so that live packets are
+ * interleaved with sync */
+static int obus_peer_sync(struct obus_peer *peer)
+{
+	int ret = 0;
+
+	while (ret == 0 && peer->syncing && !peer->sync_buf &&
+	       !obus_peer_is_blocked(peer))
+		ret = obus_peer_sync_chunk(peer);
+
+	return ret;
+}
+
+/* add object in chunk sent ahead of stream if not yet streamed */
+static int obus_peer_sync_ahead_object(struct obus_peer *peer,
+				       struct obus_object *obj,
+				       struct obus_buffer **buf,
+				       uint32_t *n_objects)
+{
+	int ret;
+
+	if (!obus_peer_sync_pending(peer, obj) ||
+	    !obus_peer_wants_type(peer, obj->desc->uid))
+		return 0;
+
+	if (!*buf) {
+		/* peek buffer */
+		*buf = obus_buffer_pool_peek(&peer->srv->pool);
+		if (!*buf)
+			return -ENOMEM;
+
+		ret = obus_packet_sync_init(*buf);
+		if (ret < 0)
+			return ret;
+	}
+
+	ret = obus_packet_sync_add(*buf, obj, obus_peer_mask(peer, obj));
+	if (ret < 0)
+		return ret;
+
+	(*n_objects)++;
+	return obus_hash_insert(&peer->synced, obj->handle, obj);
+}
+
+/* send objects referenced by bus event and not yet streamed ahead of it */
+static int obus_peer_sync_ahead(struct obus_peer *peer,
+				struct obus_bus_event *event)
+{
+	struct obus_buffer *buf = NULL;
+	struct obus_object *obj;
+	struct obus_event *evt;
+	uint32_t n_objects = 0;
+	int ret = 0;
+
+	obus_list_walk_entry_forward(&event->obj_events, evt, event_node) {
+		if (ret == 0)
+			ret = obus_peer_sync_ahead_object(peer, evt->obj, &buf,
+							  &n_objects);
+	}
+
+	obus_list_walk_entry_forward(&event->remove_objs, obj, event_node) {
+		if (ret == 0)
+			ret = obus_peer_sync_ahead_object(peer, obj, &buf,
+							  &n_objects);
+	}
+
+	if (!buf)
+		return ret;
+
+	if (ret == 0)
+		ret = obus_packet_sync_end(buf, n_objects, 0);
+	if (ret == 0)
+		ret = obus_peer_write(peer, buf);
+
+	obus_buffer_unref(buf);
+	return ret;
+}
+
+/* check packet against peer objects sync, packets of objects not streamed
+ * yet are skipped (return 1) or sent ahead of packet */
+static int obus_peer_sync_filter(struct obus_peer *peer,
+				 const struct obus_packet_info *info)
+{
+	switch (info->type) {
+	case OBUS_PKT_EVENT:
+		/* object will be streamed with event applied */
+		return obus_peer_sync_pending(peer, info->event->obj);
+	case OBUS_PKT_REMOVE:
+		/* object has never been sent to peer */
+		return obus_peer_sync_pending(peer, info->object);
+	case OBUS_PKT_BUS_EVENT:
+		return obus_peer_sync_ahead(peer, info->bus_event);
+	default:
+		return 0;
+	}
+}
+
+/* send packet to peer, object events are coalesced if peer queue
+ * overflowed, return negative errno if peer must be destroyed */
+static int obus_peer_send(struct obus_peer *peer, struct obus_buffer *buf,
+			  struct obus_event *event)
+{
+	int ret;
+
+	/* in conflation mode, object events are merged as long as peer
+	 * write queue is blocked */
+	if (event && peer->srv->conflation && obus_peer_is_blocked(peer))
+		peer->coalescing = 1;
+
+	if (peer->coalescing) {
+		if (event)
+			return obus_peer_coalesce_event(peer, event);
+
+		/* keep packets order: send merged object events first */
+		ret = obus_peer_flush_coalesced(peer);
+		if (ret < 0)
+			return ret;
+	}
+
+	ret = obus_peer_write(peer, buf);
+	if (ret < 0)
+		return ret;
+
+	return obus_peer_check_queue(peer);
+}
+
+/* send bus event to filtering peer, with only subscribed objects and
+ * events and projected fields. Shared packet is sent if nothing is
+ * filtered out */
+static int obus_peer_send_bus_event(struct obus_peer *peer,
+				    struct obus_buffer *buf,
+				    struct obus_bus_event *event)
+{
+	struct obus_stats *stats = &peer->srv->stats;
+	struct obus_bus_event_filter filter;
+	struct obus_buffer *fbuf;
+	struct obus_object *obj;
+	struct obus_event *evt;
+	size_t n_items = 0, n_kept = 0;
+	int ret, projected = 0;
+	uint64_t start;
+
+	obus_list_walk_entry_forward(&event->add_objs, obj, event_node) {
+		n_items++;
+		n_kept += obus_peer_wants_object(peer, obj);
+		projected |= obus_peer_mask(peer, obj) != NULL;
+	}
+
+	obus_list_walk_entry_forward(&event->remove_objs, obj, event_node) {
+		n_items++;
+		n_kept += obus_peer_wants_object(peer, obj);
+	}
+
+	obus_list_walk_entry_forward(&event->obj_events, evt, event_node) {
+		n_items++;
+		n_kept += obus_peer_wants_event(peer, evt);
+		projected |= obus_peer_mask(peer, evt->obj) != NULL;
+	}
+
+	if (n_kept == n_items && !projected)
+		return obus_peer_send(peer, buf, NULL);
+
+	/* nothing subscribed in bus event */
+	if (n_kept == 0)
+		return 0;
+
+	/* peek buffer */
+	fbuf = obus_buffer_pool_peek(&peer->srv->pool);
+	if (!fbuf)
+		return -ENOMEM;
+
+	filter.object = &obus_peer_wants_object;
+	filter.event = &obus_peer_wants_event;
+	filter.mask = &obus_peer_mask;
+	filter.data = peer;
+	start = obus_stats_start(stats);
+	ret = obus_packet_bus_event_encode(fbuf, event, &filter);
+	obus_time_hist_add(&stats->encode, start);
+	if (ret < 0)
+		obus_error("can't encode bus event packet");
+	else
+		ret = obus_peer_send(peer, fbuf, NULL);
+
+	obus_buffer_unref(fbuf);
+	return ret;
+}
+
+/* send packet to a connected peer, peer is destroyed on error */
+static void obus_server_send_peer(struct obus_peer *peer,
+				  struct obus_buffer *buf,
+				  const struct obus_packet_info *info,
+				  struct obus_event *event, int logged)
+{
+	int ret;
+
+	/* wake up shm peer if it waits for log data */
+	if (peer->log && logged) {
+		obus_shm_log_wake(obus_socket_peer_shm(peer->sk));
+		return;
+	}
+
+	/* objects not yet streamed to peer are synced first */
+	ret = peer->syncing ? obus_peer_sync_filter(peer, info) : 0;
+	if (ret > 0)
+		return;
+
+	/* write packet to peer */
+	if (ret == 0 && peer->filtered && info->type == OBUS_PKT_BUS_EVENT)
+		ret = obus_peer_send_bus_event(peer, buf, info->bus_event);
+	else if (ret == 0)
+		ret = obus_peer_send(peer, buf, event);
+	if (ret < 0) {
+		/* peer write error => disconnect peer */
+		obus_peer_destroy(peer);
+	}
+}
+
+/* get broadcast packet with projected fields, encoded once for all peers
+ * sharing projection. NULL if packet must not be sent */
+static struct obus_buffer *obus_server_project(struct obus_server *srv,
+					struct obus_projection *proj,
+					const struct obus_packet_info *info,
+					struct obus_node *projected)
+{
+	uint64_t start;
+	int ret;
+
+	if (proj->sending)
+		return proj->buf;
+
+	/* projection is kept until broadcast end */
+	proj->sending = 1;
+	proj->n_refs++;
+	obus_list_add_before(projected, &proj->send_node);
+
+	/* skip object event without projected fields */
+	if (info->type == OBUS_PKT_EVENT &&
+	    obus_struct_is_masked_empty(&info->event->info, proj->mask))
+		return NULL;
+
+	/* peek buffer */
+	proj->buf = obus_buffer_pool_peek(&srv->pool);
+	if (!proj->buf)
+		return NULL;
+
+	start = obus_stats_start(&srv->stats);
+	if (info->type == OBUS_PKT_EVENT)
+		ret = obus_packet_event_encode(proj->buf, info->event,
+					       proj->mask);
+	else
+		ret = obus_packet_add_encode(proj->buf, info->object,
+					     proj->mask);
+	obus_time_hist_add(&srv->stats.encode, start);
+
+	if (ret < 0) {
+		obus_error("can't encode projected packet");
+		obus_buffer_unref(proj->buf);
+		proj->buf = NULL;
+	}
+
+	return proj->buf;
+}
+
+static void obus_server_send_peers(struct obus_server *srv,
+				   struct obus_buffer *buf,
+				   const struct obus_packet_info *info)
+{
+	struct obus_peer *peer, *tmp;
+	struct obus_peer_sub *sub, *tsub;
+	struct obus_projection *proj, *tproj;
+	struct obus_node *subscribers = NULL;
+	struct obus_node projected;
+	struct obus_buffer *pbuf;
+	struct obus_event *event;
+	int logged = 0, stats = 0;
+	uint16_t uid = OBUS_INVALID_UID;
+
+	/* object events may be coalesced */
+	event = (info->type == OBUS_PKT_EVENT) ? info->event : NULL;
+	if (info->type != OBUS_PKT_BUS_EVENT)
+		uid = event ? event->obj->desc->uid : info->object->desc->uid;
+
+	/* published stats object is only sent to peers knowing its type */
+	stats = uid == OBUS_STATS_UID && srv->stats_obj;
+
+	/* object packets are sent to filtering peers through their object
+	 * type subscribers list */
+	if (srv->n_filtered > 0 && info->type != OBUS_PKT_BUS_EVENT)
+		subscribers = obus_server_subscribers(srv, uid);
+
+	/* write packet once for all shm peers, packets too large for log
+	 * are written to each peer */
+	if (srv->shm_log)
+		logged = obus_shm_log_append(srv->shm_log,
+					     obus_buffer_ptr(buf),
+					     obus_buffer_length(buf)) == 0;
+	if (logged)
+		obus_traffic_tx(&srv->traffic, obus_buffer_length(buf));
+
+	/* notify peers of un registered object */
+	obus_list_walk_entry_forward_safe(&srv->peers, peer, tmp, node) {
+		/* only notify connected peers */
+		if (!obus_peer_is_connected(peer))
+			continue;
+
+		/* filtering peers are notified below */
+		if (peer->filtered && info->type != OBUS_PKT_BUS_EVENT)
+			continue;
+
+		if (stats && !obus_peer_wants_type(peer, uid))
+			continue;
+
+		obus_server_send_peer(peer, buf, info, event, logged);
+	}
+
+	if (!subscribers)
+		return;
+
+	obus_list_init(&projected);
+	obus_list_walk_entry_forward_safe(subscribers, sub, tsub, node) {
+		if (!obus_peer_is_connected(sub->peer))
+			continue;
+
+		if (event && !obus_peer_sub_has_event(sub, event->desc->uid))
+			continue;
+
+		if (stats && !obus_peer_wants_type(sub->peer, uid))
+			continue;
+
+		/* removed objects have no fields */
+		pbuf = buf;
+		if (sub->proj && info->type != OBUS_PKT_REMOVE) {
+			pbuf = obus_server_project(srv, sub->proj, info,
+						   &projected);
+			if (!pbuf)
+				continue;
+		}
+
+		obus_server_send_peer(sub->peer, pbuf, info, event, logged);
+	}
+
+	/* release projected packets */
+	obus_list_walk_entry_forward_safe(&projected, proj, tproj, send_node) {
+		obus_list_del(&proj->send_node);
+		if (proj->buf)
+			obus_buffer_unref(proj->buf);
+		proj->buf = NULL;
+		proj->sending = 0;
+		obus_projection_unref(proj);
+	}
+}
+
+/* send objects of given type to peer after its subscriptions change */
+static int obus_peer_update_type(struct obus_peer *peer, uint16_t uid,
+				 int subscribed)
+{
+	struct obus_stats *stats = &peer->srv->stats;
+	struct obus_object *obj;
+	struct obus_buffer *buf;
+	uint64_t start;
+	int ret = 0;
+
+	obus_list_walk_entry_forward(&peer->srv->bus.objects, obj, node) {
+		/* objects not streamed yet are checked when streamed */
+		if (ret < 0 || obj->desc->uid != uid ||
+		    obus_peer_sync_pending(peer, obj))
+			continue;
+
+		/* peek buffer */
+		buf = obus_buffer_pool_peek(&peer->srv->pool);
+		if (!buf)
+			return -ENOMEM;
+
+		start = obus_stats_start(stats);
+		if (subscribed)
+			ret = obus_packet_add_encode(buf, obj,
+						     obus_peer_mask(peer, obj));
+		else
+			ret = obus_packet_remove_encode(buf, obj);
+		obus_time_hist_add(&stats->encode, start);
+
+		if (ret == 0)
+			ret = obus_peer_send(peer, buf, NULL);
+
+		obus_buffer_unref(buf);
+	}
+
+	return ret;
+}
+
+/* write fields of already sent objects of given type to peer */
+static int obus_peer_refresh_type(struct obus_peer *peer, uint16_t uid)
+{
+	struct obus_object *obj;
+	int ret = 0;
+
+	obus_list_walk_entry_forward(&peer->srv->bus.objects, obj, node) {
+		if (ret < 0 || obj->desc->uid != uid ||
+		    obus_peer_sync_pending(peer, obj))
+			continue;
+
+		ret = obus_peer_write_object_fields(peer, obj, &obj->info);
+	}
+
+	return ret;
+}
+
+/* replace peer subscriptions, objects of newly (un)subscribed types are
+ * added or removed and fields newly projected are sent if peer is
+ * connected */
+static int obus_peer_subscribe(struct obus_peer *peer,
+			       const struct obus_packet_subscribe *pkt)
+{
+	const struct obus_bus_desc *desc = peer->srv->bus.api.desc;
+	struct obus_projection *proj;
+	struct obus_peer_sub *sub;
+	uint16_t uid, i, j;
+	int ret = 0, was, is;
+
+	/* shm peers read all broadcasts in log */
+	if (peer->log)
+		return 0;
 
-		/* write packet to peer */
-		ret = obus_io_write(peer->io, buf);
-		if (ret == -EAGAIN) {
-			/* buffer write async get a ref on it */
-			obus_buffer_ref(buf);
-		} else if (ret != 0) {
-			/* peer write error => disconnect peer */
-			obus_peer_destroy(peer);
+	for (i = 0; i < desc->n_objects && ret == 0; i++) {
+		uid = desc->objects[i]->uid;
+		was = obus_peer_wants_type(peer, uid);
+		is = !pkt->filtered;
+
+		/* update subscription, keeping previous projection */
+		proj = NULL;
+		sub = obus_peer_get_sub(peer, uid);
+		if (sub) {
+			proj = sub->proj;
+			if (proj)
+				proj->n_refs++;
+			obus_peer_remove_sub(peer, sub);
+		}
+
+		for (j = 0; j < pkt->n_subs && ret == 0; j++) {
+			if (pkt->subs[j].uid != uid)
+				continue;
+
+			is = 1;
+			if (pkt->filtered)
+				ret = obus_peer_add_sub(peer, &pkt->subs[j]);
 		}
+
+		if (ret == 0 && was != is && obus_peer_is_connected(peer))
+			ret = obus_peer_update_type(peer, uid, is);
+
+		/* send values of fields newly projected */
+		sub = obus_peer_get_sub(peer, uid);
+		if (ret == 0 && was && is && obus_peer_is_connected(peer) &&
+		    obus_projection_widens(proj, sub ? sub->proj : NULL))
+			ret = obus_peer_refresh_type(peer, uid);
+
+		obus_projection_unref(proj);
 	}
+
+	obus_peer_set_filtered(peer, pkt->filtered);
+	return ret;
 }
 
 static void obus_peer_io_write_done(enum obus_io_status status,
@@ -216,50 +1680,140 @@ static void obus_peer_io_write_done(enum obus_io_status status,
 {
 	struct obus_peer *peer = user_data;
 
+	if (buf == peer->sync_buf)
+		peer->sync_buf = NULL;
+
 	/* unref buffer */
 	obus_buffer_unref(buf);
 
+	/* destroy peer on error, aborted buffers are given back while peer
+	 * is destroyed */
+	if (status != OBUS_IO_OK && status != OBUS_IO_ABORT)
+		obus_peer_destroy(peer);
+}
+
+static void obus_peer_io_drained(void *user_data)
+{
+	struct obus_peer *peer = user_data;
+	int ret = 0;
+
+	/* peer is ready again, send merged object events */
+	if (peer->coalescing)
+		ret = obus_peer_flush_coalesced(peer);
+
+	/* then next objects sync chunk */
+	if (ret == 0 && peer->syncing)
+		ret = obus_peer_sync(peer);
+
+	if (ret < 0)
+		obus_peer_destroy(peer);
+}
+
+static void obus_peer_worker_write_done(enum obus_io_status status,
+					struct obus_buffer *buf,
+					void *user_data)
+{
+	struct obus_peer *peer = user_data;
+
 	/* destroy peer on error */
-	if (status != OBUS_IO_OK)
+	if (status != OBUS_IO_OK) {
 		obus_peer_destroy(peer);
+		return;
+	}
+
+	if (buf == peer->sync_buf)
+		peer->sync_buf = NULL;
+
+	/* writer thread is not blocked, send pending packets */
+	if (!obus_worker_io_is_blocked(peer->wio))
+		obus_peer_io_drained(peer);
 }
 
-static int obus_peer_send_connection_response(struct obus_peer *peer,
-					      enum obus_conresp_status status)
+/* get a reference on accepted connection response, encoded only once
+ * until next bus objects change */
+static struct obus_buffer *obus_server_snapshot(struct obus_server *srv)
 {
 	struct obus_buffer *buf;
-	struct obus_node *objects;
+	uint64_t start;
 	int ret;
 
+	if (srv->bus.snapshot)
+		return obus_buffer_ref(srv->bus.snapshot);
+
 	/* peek buffer */
-	buf = obus_buffer_pool_peek(&peer->srv->pool);
+	buf = obus_buffer_pool_peek(&srv->pool);
 	if (!buf)
-		return -ENOMEM;
-
-	/* only add objects if connection accepted */
-	objects = (status == OBUS_CONRESP_ACCEPTED) ?
-		   &peer->srv->bus.objects : NULL;
+		return NULL;
 
-	ret = obus_packet_conresp_encode(buf, status, objects);
+	start = obus_stats_start(&srv->stats);
+	ret = obus_packet_conresp_encode(buf, OBUS_CONRESP_ACCEPTED,
+					 &srv->bus.objects, NULL, 0);
+	obus_time_hist_add(&srv->stats.encode, start);
 	if (ret < 0) {
 		obus_error("can't encode connection response packet");
 		obus_buffer_unref(buf);
-		return ret;
+		return NULL;
 	}
 
-	/* write packet */
-	ret = obus_io_write(peer->io, buf);
-	if (ret == 0) {
-		/* buffer written, unref it */
-		obus_buffer_unref(buf);
-	} else if (ret == -EAGAIN) {
-		/* buffer put in write queue don't unref it */
-		ret = 0;
+	srv->bus.snapshot = obus_buffer_ref(buf);
+	return buf;
+}
+
+static int obus_peer_send_connection_response(struct obus_peer *peer,
+					      enum obus_conresp_status status)
+{
+	struct obus_bus_event_filter pfilter, *filter;
+	struct obus_node *objects;
+	struct obus_buffer *buf;
+	int ret;
+
+	/* objects are streamed after response to peers supporting it, shm log
+	 * peers still get them in response to match log start position */
+	if (status == OBUS_CONRESP_ACCEPTED && !peer->log &&
+	    (peer->caps & OBUS_CONREQ_CAP_SYNC))
+		obus_peer_sync_start(peer);
+
+	/* objects snapshot is shared between peers wanting all objects */
+	objects = NULL;
+	filter = NULL;
+	if (status == OBUS_CONRESP_ACCEPTED && !peer->syncing) {
+		objects = &peer->srv->bus.objects;
+		if (peer->filtered ||
+		    !obus_peer_wants_type(peer, OBUS_STATS_UID))
+			filter = &pfilter;
+	}
+
+	if (objects && !filter) {
+		buf = obus_server_snapshot(peer->srv);
+		if (!buf)
+			return -ENOMEM;
 	} else {
-		/* buffer write failure */
-		obus_buffer_unref(buf);
+		/* peek buffer */
+		buf = obus_buffer_pool_peek(&peer->srv->pool);
+		if (!buf)
+			return -ENOMEM;
+
+		pfilter.object = &obus_peer_wants_object;
+		pfilter.event = &obus_peer_wants_event;
+		pfilter.mask = &obus_peer_mask;
+		pfilter.data = peer;
+		ret = obus_packet_conresp_encode(buf, status, objects, filter,
+						 peer->syncing);
+		if (ret < 0) {
+			obus_error("can't encode connection response packet");
+			obus_buffer_unref(buf);
+			return ret;
+		}
 	}
 
+	/* shm peer reads broadcast log from objects snapshot position */
+	if (peer->log)
+		obus_shm_set_log_start(obus_socket_peer_shm(peer->sk),
+				       obus_shm_log_head(peer->srv->shm_log));
+
+	/* write packet */
+	ret = obus_peer_write(peer, buf);
+	obus_buffer_unref(buf);
 	return ret;
 }
 
@@ -286,6 +1840,7 @@ static int obus_peer_connection_request(struct obus_peer *peer,
 	peer->name = strdup(pkt->client);
 
 	/* check client protocol version against server's one */
+	peer->caps = pkt->caps;
 	if (pkt->version != OBUS_PROTOCOL_VERSION) {
 		obus_warn("protocol version mismatch");
 		obus_warn("peer  :%d", pkt->version);
@@ -328,6 +1883,13 @@ static int obus_peer_connection_request(struct obus_peer *peer,
 			status = OBUS_CONRESP_REFUSED;
 	}
 
+	/* only send subscribed objects */
+	if (status == OBUS_CONRESP_ACCEPTED && pkt->sub.filtered) {
+		ret = obus_peer_subscribe(peer, &pkt->sub);
+		if (ret < 0)
+			goto destroy_peer;
+	}
+
 	/* send connection response */
 	ret = obus_peer_send_connection_response(peer, status);
 	if (ret < 0)
@@ -338,6 +1900,7 @@ static int obus_peer_connection_request(struct obus_peer *peer,
 		/* accept connection */
 		peer->state = PEER_STATE_CONNECTED;
 		peer->srv->n_peers_connected++;
+		peer->srv->n_connections++;
 
 		if (peer->srv->log_flags & OBUS_LOG_CONNECTION)
 			obus_info("peer {addr='%s', name='%s'} connected to "
@@ -345,6 +1908,11 @@ static int obus_peer_connection_request(struct obus_peer *peer,
 				  peer->name,  pkt->bus);
 
 		obus_peer_notify_user(peer, OBUS_PEER_EVENT_CONNECTED);
+
+		/* start streaming registered objects */
+		ret = obus_peer_sync(peer);
+		if (ret < 0)
+			goto destroy_peer;
 	} else {
 		/* refused connection */
 		peer->state = PEER_STATE_REFUSED;
@@ -364,19 +1932,115 @@ destroy_peer:
 }
 
 
+static int obus_server_write_ack(struct obus_server *srv,
+				 struct obus_call *call,
+				 enum obus_call_status status)
+{
+	struct obus_peer *peer = call->peer;
+	struct obus_buffer *buf;
+	struct obus_ack ack;
+	uint64_t start;
+	int ret;
+
+	/* peek buffer */
+	buf = obus_buffer_pool_peek(&srv->pool);
+	if (!buf)
+		return -ENOMEM;
+
+	/* encode ack packet with peer call handle */
+	ack.handle = call->peer_handle;
+	ack.status = status;
+	start = obus_stats_start(&srv->stats);
+	ret = obus_packet_ack_encode(buf, &ack);
+	obus_time_hist_add(&srv->stats.encode, start);
+	if (ret < 0) {
+		obus_error("can't encode ack packet");
+		obus_buffer_unref(buf);
+		return ret;
+	}
+
+	/* write packet, merged object events are sent before */
+	ret = obus_peer_send(peer, buf, NULL);
+	obus_buffer_unref(buf);
+	if (ret < 0)
+		return ret;
+
+	/* update call ack status */
+	call->status = status;
+
+	/* log ack if requested */
+	if (srv->log_flags & OBUS_LOG_BUS) {
+		obus_info("call ack sent:");
+		obus_ack_log(&ack, call, OBUS_LOG_INFO);
+	}
+
+	return 0;
+}
+
+/* send ack and remove call, peer is destroyed if ack can't be written */
+static int obus_server_complete_call(struct obus_server *srv,
+				     struct obus_call *call,
+				     enum obus_call_status status)
+{
+	struct obus_peer *peer = call->peer;
+	int ret;
+
+	/* send ack and remove call from pending calls */
+	ret = obus_server_write_ack(srv, call, status);
+	obus_bus_unregister_call(&srv->bus, call);
+	obus_call_destroy(call);
+
+	/* peer write error => disconnect peer */
+	if (ret < 0)
+		obus_peer_destroy(peer);
+
+	return ret;
+}
+
+static void obus_server_abort_calls(struct obus_server *srv,
+				    struct obus_object *obj)
+{
+	struct obus_call *call, *tmp;
+
+restart:
+	obus_list_walk_entry_forward_safe(&srv->bus.calls, call, tmp, node) {
+		/* a destroyed peer drops its other calls, walk again */
+		if (call->obj == obj &&
+		    obus_server_complete_call(srv, call,
+					      OBUS_CALL_ABORTED) < 0)
+			goto restart;
+	}
+}
+
 static int obus_peer_call_request(struct obus_peer *peer,
 				   struct obus_call *call)
 {
+	struct obus_server *srv = peer->srv;
 	obus_method_handler_cb_t handler;
 	enum obus_method_state state;
 	enum obus_call_status status;
+	obus_handle_t handle;
+	int ret;
 
 	/* log object event if requested */
-	if (peer->srv->log_flags & OBUS_LOG_BUS)
+	if (srv->log_flags & OBUS_LOG_BUS)
 		obus_call_log(call, OBUS_LOG_INFO);
 
-	/* set current call */
-	peer->srv->call = call;
+	/* add call in pending calls with a server handle, so calls of
+	 * different peers can't collide */
+	call->peer = peer;
+	call->peer_handle = call->handle;
+	call->handle = OBUS_INVALID_HANDLE;
+	ret = obus_bus_register_call(&srv->bus, call);
+	if (ret < 0) {
+		ret = obus_server_write_ack(srv, call, OBUS_CALL_REFUSED);
+		obus_call_destroy(call);
+		if (ret < 0)
+			obus_peer_destroy(peer);
+		return ret;
+	}
+
+	handle = call->handle;
 
 	/* if object exist but is not registered, abort call */
 	if (!obus_object_is_registered(call->obj)) {
@@ -411,9 +2075,11 @@ static int obus_peer_call_request(struct obus_peer *peer,
 	}
 
 send_ack:
-	/* acknowledge call if not already done done */
-	if (call->status == OBUS_CALL_INVALID)
-		obus_server_send_ack(peer->srv, call->handle, status);
+	/* acknowledge call if not already done nor deferred by handler,
+	 * call may have been destroyed by handler */
+	call = obus_bus_call(&srv->bus, handle);
+	if (call && !call->is_deferred)
+		return obus_server_complete_call(srv, call, status);
 
 	return 0;
 }
@@ -421,6 +2087,7 @@ send_ack:
 static void obus_peer_io_read_event(int events, void *user_data)
 {
 	struct obus_peer *peer = user_data;
+	struct obus_server *srv = peer->srv;
 	struct obus_packet_info info;
 	int ret;
 
@@ -435,6 +2102,7 @@ static void obus_peer_io_read_event(int events, void *user_data)
 		return;
 
 	/* read packet */
+	srv->reading = peer;
 	do {
 		/* read packet */
 		ret = obus_packet_decoder_read(&peer->decoder, &info);
@@ -456,16 +2124,29 @@ static void obus_peer_io_read_event(int events, void *user_data)
 			/* free info */
 			free(info.conreq.bus);
 			free(info.conreq.client);
+			obus_packet_subscribe_release(&info.conreq.sub);
 		break;
 
-		case OBUS_PKT_CALL:
-			/* set call peer */
-			info.call->peer = peer;
-			ret = obus_peer_call_request(peer, info.call);
+		case OBUS_PKT_SUBSCRIBE:
+			if (obus_peer_subscribe(peer, &info.sub) < 0) {
+				obus_packet_subscribe_release(&info.sub);
+				obus_peer_destroy(peer);
+				return;
+			}
+			obus_packet_subscribe_release(&info.sub);
+			ret = 0;
+		break;
 
-			/* destroy call */
-			obus_call_destroy(info.call);
+		case OBUS_PKT_CALL:
+			/* call is owned by server until acked */
+			(void)obus_peer_call_request(peer, info.call);
 			info.call = NULL;
+
+			/* peer is destroyed if ack write failed, handler
+			 * may also have acked or sent events */
+			if (srv->reading != peer)
+				return;
+			ret = 0;
 		break;
 
 		/* other packet should not be received by servers */
@@ -475,6 +2156,7 @@ static void obus_peer_io_read_event(int events, void *user_data)
 		case OBUS_PKT_ADD:
 		case OBUS_PKT_REMOVE:
 		case OBUS_PKT_ACK:
+		case OBUS_PKT_SYNC:
 		case OBUS_PKT_COUNT:
 		default:
 		break;
@@ -483,11 +2165,27 @@ static void obus_peer_io_read_event(int events, void *user_data)
 	} while (ret == 0);
 }
 
+/* get writer thread serving fewest peers, NULL if none */
+static struct obus_worker *obus_server_pick_worker(struct obus_server *srv)
+{
+	struct obus_worker *worker = NULL;
+	size_t i;
+
+	for (i = 0; i < srv->n_workers; i++) {
+		if (!worker || obus_worker_get_io_count(srv->workers[i]) <
+			       obus_worker_get_io_count(worker))
+			worker = srv->workers[i];
+	}
+
+	return worker;
+}
+
 static void obus_server_accept(struct obus_socket_server *sk_srv,
 			       struct obus_socket_peer *sk_peer,
 			       void *user_data)
 {
 	struct obus_server *srv = user_data;
+	struct obus_worker *worker;
 	struct obus_buffer *buf;
 	struct obus_peer *peer;
 	int log_io = 0;
@@ -506,6 +2204,9 @@ static void obus_server_accept(struct obus_socket_server *sk_srv,
 	/* get server ref */
 	peer->srv = srv;
 
+	/* shm peer has received server broadcast log */
+	peer->log = (srv->shm_log && obus_socket_peer_shm(sk_peer)) ? 1 : 0;
+
 	/* create new io from socket fd */
 	peer->io = obus_io_new(srv->loop, obus_socket_peer_name(peer->sk),
 			       obus_socket_peer_fd(peer->sk),
@@ -516,22 +2217,50 @@ static void obus_server_accept(struct obus_socket_server *sk_srv,
 		goto destroy_peer;
 	}
 
+	/* switch io to shared memory channel if any */
+	if (obus_socket_peer_shm(peer->sk) &&
+	    obus_io_set_shm(peer->io, obus_socket_peer_shm(peer->sk)) < 0)
+		goto destroy_io;
+
 	/* enable io log traffic on demand */
 	if (peer->srv->log_flags & OBUS_LOG_IO)
 		log_io = 1;
 
 	obus_io_log_traffic(peer->io, log_io);
+	obus_io_set_drained_cb(peer->io, obus_peer_io_drained);
+
+	/* socket peer packets are written by least loaded writer thread */
+	worker = obus_server_pick_worker(srv);
+	if (worker && !obus_socket_peer_shm(peer->sk)) {
+		peer->wio = obus_worker_io_new(worker,
+					       obus_socket_peer_name(peer->sk),
+					       obus_socket_peer_fd(peer->sk),
+					       log_io,
+					       &obus_peer_worker_write_done,
+					       &obus_peer_worker_closed, peer);
+		if (!peer->wio) {
+			obus_error("can't create peer worker io");
+			goto destroy_io;
+		}
+	}
 
 	/* get buffer */
 	buf = obus_buffer_pool_peek(&srv->pool);
 	if (!buf)
-		goto destroy_io;
+		goto destroy_wio;
 
 	/* init decoder */
 	obus_packet_decoder_init(&peer->decoder, buf, &peer->srv->bus,
 				 peer->io, log_io);
+	obus_packet_decoder_set_stats(&peer->decoder, &srv->stats,
+				      &peer->traffic);
 	obus_buffer_unref(buf);
 
+	/* init merged object events hash */
+	obus_hash_init(&peer->coalesced, OBUS_PEER_HASH_SIZE);
+	obus_hash_init(&peer->synced, OBUS_PEER_HASH_SIZE);
+	obus_hash_init(&peer->subs, OBUS_PEER_HASH_SIZE);
+
 	/* add peer in list */
 	obus_list_add_before(&srv->peers, &peer->node);
 
@@ -540,6 +2269,13 @@ static void obus_server_accept(struct obus_socket_server *sk_srv,
 			  obus_socket_peer_name(peer->sk));
 	return;
 
+destroy_wio:
+	if (peer->wio) {
+		/* socket is disconnected once writer thread released it */
+		obus_io_destroy(peer->io);
+		obus_worker_io_destroy(peer->wio);
+		return;
+	}
 destroy_io:
 	obus_io_destroy(peer->io);
 destroy_peer:
@@ -549,10 +2285,74 @@ disconnect:
 	obus_socket_peer_disconnect(sk_peer);
 }
 
+static void obus_server_release_bus_event(struct obus_bus_event *event)
+{
+	struct obus_object *obj, *tmp;
+
+	/* nobody is left to destroy objects which were to be registered */
+	obus_list_walk_entry_forward_safe(&event->add_objs, obj, tmp,
+					  event_node) {
+		if (!obus_object_is_registered(obj))
+			obus_object_destroy(obj);
+	}
+
+	obus_bus_event_destroy(event);
+}
+
+static void obus_server_release_submissions(struct obus_submit_node *node)
+{
+	struct obus_server_submission *sub;
+
+	while (node) {
+		sub = obus_container_of(node, struct obus_server_submission,
+					node);
+		node = node->next;
+
+		if (sub->event)
+			obus_event_destroy(sub->event);
+		if (sub->bus_event)
+			obus_server_release_bus_event(sub->bus_event);
+		free(sub);
+	}
+}
+
+static void obus_server_drain(struct obus_submit_node *node, void *data)
+{
+	struct obus_server *srv = data;
+	struct obus_server_submission *sub;
+	int ret;
+
+	/* send submitted events in submission order */
+	while (node) {
+		sub = obus_container_of(node, struct obus_server_submission,
+					node);
+		node = node->next;
+
+		if (sub->event) {
+			ret = obus_server_send_event(srv, sub->event);
+			if (ret < 0)
+				obus_warn("submitted event '%s' dropped",
+					  sub->event->desc->name);
+			obus_event_destroy(sub->event);
+		}
+
+		if (sub->bus_event) {
+			ret = obus_server_send_bus_event(srv, sub->bus_event);
+			if (ret < 0)
+				obus_warn("submitted bus event '%s' dropped",
+					  sub->bus_event->desc->name);
+			obus_server_release_bus_event(sub->bus_event);
+		}
+
+		free(sub);
+	}
+}
+
 OBUS_API
 struct obus_server *obus_server_new(const struct obus_bus_desc *desc)
 {
 	int ret;
+	uint16_t i;
 	struct obus_server *srv;
 
 	if (!desc)
@@ -577,15 +2377,39 @@ struct obus_server *obus_server_new(const struct obus_bus_desc *desc)
 	if (ret < 0)
 		goto free_srv;
 
+	/* init object types subscribers lists */
+	obus_list_init(&srv->projections);
+	desc = srv->bus.api.desc;
+	srv->sub_lists = calloc(desc->n_objects, sizeof(*srv->sub_lists));
+	if (desc->n_objects && !srv->sub_lists)
+		goto destroy_bus;
+
+	obus_hash_init(&srv->subscribers, OBUS_SUBSCRIBERS_HASH_SIZE);
+	for (i = 0; i < desc->n_objects; i++) {
+		obus_list_init(&srv->sub_lists[i]);
+		obus_hash_insert(&srv->subscribers, desc->objects[i]->uid,
+				 &srv->sub_lists[i]);
+	}
+
 	/* create poll fd set */
 	srv->loop = obus_loop_new();
 	if (!srv->loop)
-		goto destroy_bus;
+		goto destroy_subscribers;
+
+	/* create submission queue of other threads */
+	srv->submit = obus_submit_new(srv->loop, &obus_server_drain, srv);
+	if (!srv->submit)
+		goto unref_loop;
 
 	srv->state = SERVER_STATE_IDLE;
 	srv->n_peers_connected = 0;
 	return srv;
 
+unref_loop:
+	obus_loop_unref(srv->loop);
+destroy_subscribers:
+	obus_hash_destroy(&srv->subscribers);
+	free(srv->sub_lists);
 destroy_bus:
 	obus_bus_destroy(&srv->bus);
 free_srv:
@@ -608,10 +2432,24 @@ OBUS_API int obus_server_start(struct obus_server *srv,
 
 	log = (srv->log_flags & OBUS_LOG_SOCKET) ? 1 : 0;
 
+	/* create broadcast log of shm peers on demand */
+	if (srv->shm_log_size && !srv->shm_log) {
+		ret = obus_shm_log_new(srv->shm_log_size, &srv->shm_log);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* start socket peers writer threads */
+	ret = obus_server_create_workers(srv);
+	if (ret < 0)
+		return ret;
+
 	/* allocate servers array */
 	sks = calloc(n_addrs, sizeof(struct obus_socket_server *));
-	if (!sks)
+	if (!sks) {
+		obus_server_destroy_workers(srv);
 		return -ENOMEM;
+	}
 
 	/* create socket server */
 	for (i = 0; i < n_addrs; i++) {
@@ -620,6 +2458,8 @@ OBUS_API int obus_server_start(struct obus_server *srv,
 					     &sks[i]);
 		if (ret < 0)
 			goto destroy_server;
+
+		obus_socket_server_set_shm_log(sks[i], srv->shm_log);
 	}
 
 	srv->state = SERVER_STATE_STARTED;
@@ -632,6 +2472,7 @@ destroy_server:
 		obus_socket_server_destroy(sks[i]);
 
 	free(sks);
+	obus_server_destroy_workers(srv);
 	return ret;
 }
 
@@ -648,12 +2489,33 @@ OBUS_API int obus_server_destroy(struct obus_server *srv)
 		obus_peer_destroy(current);
 	}
 
+	/* stop publishing stats, object is destroyed with bus */
+	obus_timer_destroy(srv->stats_timer);
+
+	/* join writer threads, peers sockets are closed meanwhile */
+	obus_server_destroy_workers(srv);
+
 	/* destroy socket server's */
 	for (i = 0; i < srv->n_sks; i++)
 		obus_socket_server_destroy(srv->sks[i]);
 
 	free(srv->sks);
 
+	/* destroy broadcast log */
+	obus_shm_log_destroy(srv->shm_log);
+
+	/* destroy state mirror */
+	obus_mirror_destroy(srv->bus.mirror);
+	srv->bus.mirror = NULL;
+
+	/* destroy subscribers lists */
+	obus_hash_destroy(&srv->subscribers);
+	free(srv->sub_lists);
+
+	/* drop pending submissions */
+	obus_server_release_submissions(obus_submit_take(srv->submit));
+	obus_submit_destroy(srv->submit);
+
 	/* destroy bus  */
 	obus_bus_destroy(&srv->bus);
 
@@ -713,10 +2575,16 @@ obus_server_new_object(struct obus_server *srv,
 		return NULL;
 
 	/* allocate object */
-	obj = obus_object_new(desc, cbs, info);
+	obj = obus_object_new(desc, cbs, info,
+			      obus_bus_object_slab(&srv->bus, desc));
 	if (!obj)
 		return NULL;
 
+	/* object created by another thread is added in bus by loop thread
+	 * when its registration is submitted */
+	if (!obus_bus_is_owner(&srv->bus))
+		return obj;
+
 	/* add object in bus without registering it */
 	ret = obus_bus_add_object(&srv->bus, obj);
 	if (ret < 0) {
@@ -730,7 +2598,9 @@ obus_server_new_object(struct obus_server *srv,
 OBUS_API int
 obus_server_register_object(struct obus_server *srv, struct obus_object *obj)
 {
+	struct obus_packet_info info;
 	struct obus_buffer *buf;
+	uint64_t start;
 	int ret;
 
 	if (!srv || !obj)
@@ -755,7 +2625,9 @@ obus_server_register_object(struct obus_server *srv, struct obus_object *obj)
 		return -ENOMEM;
 
 	/* encode add packet */
-	ret = obus_packet_add_encode(buf, obj);
+	start = obus_stats_start(&srv->stats);
+	ret = obus_packet_add_encode(buf, obj, NULL);
+	obus_time_hist_add(&srv->stats.encode, start);
 	if (ret < 0) {
 		obus_error("can't encode objec add packet");
 		obus_buffer_unref(buf);
@@ -763,7 +2635,9 @@ obus_server_register_object(struct obus_server *srv, struct obus_object *obj)
 	}
 
 	/* send packet to connected peers */
-	obus_server_send_peers(srv, buf);
+	info.type = OBUS_PKT_ADD;
+	info.object = obj;
+	obus_server_send_peers(srv, buf, &info);
 
 	/* unref packet */
 	obus_buffer_unref(buf);
@@ -781,7 +2655,9 @@ out:
 OBUS_API int
 obus_server_unregister_object(struct obus_server *srv, struct obus_object *obj)
 {
+	struct obus_packet_info info;
 	struct obus_buffer *buf;
+	uint64_t start;
 	int ret;
 
 	if (!srv || !obj)
@@ -792,10 +2668,13 @@ obus_server_unregister_object(struct obus_server *srv, struct obus_object *obj)
 		return -EPERM;
 
 	/* unregister object */
-	ret = obus_bus_unregister_object(&srv->bus, obj);
+	ret = obus_server_unregister_bus_object(srv, obj);
 	if (ret < 0)
 		return ret;
 
+	/* abort object pending calls */
+	obus_server_abort_calls(srv, obj);
+
 	/* skip packet encoding if no connected peers */
 	if (srv->n_peers_connected == 0)
 		goto out;
@@ -806,7 +2685,9 @@ obus_server_unregister_object(struct obus_server *srv, struct obus_object *obj)
 		return -ENOMEM;
 
 	/* encode remove packet */
+	start = obus_stats_start(&srv->stats);
 	ret = obus_packet_remove_encode(buf, obj);
+	obus_time_hist_add(&srv->stats.encode, start);
 	if (ret < 0) {
 		obus_error("can't encode object add packet");
 		obus_buffer_unref(buf);
@@ -814,7 +2695,9 @@ obus_server_unregister_object(struct obus_server *srv, struct obus_object *obj)
 	}
 
 	/* send packet to connected peers */
-	obus_server_send_peers(srv, buf);
+	info.type = OBUS_PKT_REMOVE;
+	info.object = obj;
+	obus_server_send_peers(srv, buf, &info);
 
 	/* unref packet */
 	obus_buffer_unref(buf);
@@ -845,7 +2728,9 @@ OBUS_API struct obus_object *obus_server_get_object(struct obus_server *srv,
 OBUS_API int obus_server_send_event(struct obus_server *srv,
 				    struct obus_event *event)
 {
+	struct obus_packet_info info;
 	struct obus_buffer *buf;
+	uint64_t start;
 	int ret;
 
 	if (!srv || !event)
@@ -870,7 +2755,9 @@ OBUS_API int obus_server_send_event(struct obus_server *srv,
 		return -ENOMEM;
 
 	/* encode object event packet */
-	ret = obus_packet_event_encode(buf, event);
+	start = obus_stats_start(&srv->stats);
+	ret = obus_packet_event_encode(buf, event, NULL);
+	obus_time_hist_add(&srv->stats.encode, start);
 	if (ret < 0) {
 		obus_error("can't encode object event packet");
 		obus_buffer_unref(buf);
@@ -878,7 +2765,9 @@ OBUS_API int obus_server_send_event(struct obus_server *srv,
 	}
 
 	/* send packet to connected peers */
-	obus_server_send_peers(srv, buf);
+	info.type = OBUS_PKT_EVENT;
+	info.event = event;
+	obus_server_send_peers(srv, buf, &info);
 
 	/* unref packet */
 	obus_buffer_unref(buf);
@@ -941,7 +2830,7 @@ static void obus_server_undo_register_objects(struct obus_server *srv,
 	struct obus_object *obj;
 
 	obus_list_walk_entry_forward(&event->add_objs, obj, event_node) {
-		obus_bus_unregister_object(&srv->bus, obj);
+		obus_server_unregister_bus_object(srv, obj);
 	}
 }
 
@@ -953,6 +2842,13 @@ static int obus_server_register_objects(struct obus_server *srv,
 
 	/* register new object */
 	obus_list_walk_entry_forward(&event->add_objs, obj, event_node) {
+		/* add object created by another thread in bus */
+		if (!obj->bus) {
+			ret = obus_bus_add_object(&srv->bus, obj);
+			if (ret < 0)
+				break;
+		}
+
 		/* register object */
 		ret = obus_bus_register_object(&srv->bus, obj);
 		if (ret < 0)
@@ -984,7 +2880,7 @@ static int obus_server_commit_bus_event(struct obus_server *srv,
 	/* unregister object */
 	obus_list_walk_entry_forward(&event->remove_objs, obj, event_node) {
 		/* remove object from bus */
-		ret |= obus_bus_unregister_object(&srv->bus, obj);
+		ret |= obus_server_unregister_bus_object(srv, obj);
 	}
 
 	if (ret < 0)
@@ -997,7 +2893,10 @@ OBUS_API
 int obus_server_send_bus_event(struct obus_server *srv,
 			       struct obus_bus_event *event)
 {
+	struct obus_object *obj;
+	struct obus_packet_info info;
 	struct obus_buffer *buf;
+	uint64_t start;
 	int ret;
 
 	if (!srv || !event)
@@ -1013,6 +2912,12 @@ int obus_server_send_bus_event(struct obus_server *srv,
 	if (ret < 0)
 		goto undo_register_objects;
 
+	/* abort pending calls of removed objects, acks are sent before
+	 * objects removal */
+	obus_list_walk_entry_forward(&event->remove_objs, obj, event_node) {
+		obus_server_abort_calls(srv, obj);
+	}
+
 	/* skip packet encoding if no connected peers */
 	if (srv->n_peers_connected == 0)
 		goto out;
@@ -1025,7 +2930,9 @@ int obus_server_send_bus_event(struct obus_server *srv,
 	}
 
 	/* encode object event packet */
-	ret = obus_packet_bus_event_encode(buf, event);
+	start = obus_stats_start(&srv->stats);
+	ret = obus_packet_bus_event_encode(buf, event, NULL);
+	obus_time_hist_add(&srv->stats.encode, start);
 	if (ret < 0) {
 		obus_error("can't encode bus event packet");
 		obus_buffer_unref(buf);
@@ -1033,7 +2940,9 @@ int obus_server_send_bus_event(struct obus_server *srv,
 	}
 
 	/* send packet to connected peers */
-	obus_server_send_peers(srv, buf);
+	info.type = OBUS_PKT_BUS_EVENT;
+	info.bus_event = event;
+	obus_server_send_peers(srv, buf, &info);
 
 	/* unref packet */
 	obus_buffer_unref(buf);
@@ -1054,63 +2963,77 @@ undo_register_objects:
 	return ret;
 }
 
+static int obus_server_submit(struct obus_server *srv,
+			      struct obus_event *event,
+			      struct obus_bus_event *bus_event)
+{
+	struct obus_server_submission *sub;
+	int ret;
+
+	sub = calloc(1, sizeof(*sub));
+	if (!sub)
+		return -ENOMEM;
+
+	sub->event = event;
+	sub->bus_event = bus_event;
+	ret = obus_submit_push(srv->submit, &sub->node);
+	if (ret < 0)
+		free(sub);
+
+	return ret;
+}
+
+OBUS_API
+int obus_server_submit_event(struct obus_server *srv,
+			     struct obus_event *event)
+{
+	/* event is destroyed by loop thread once sent */
+	if (!srv || !event || !event->is_allocated)
+		return -EINVAL;
+
+	return obus_server_submit(srv, event, NULL);
+}
+
+OBUS_API
+int obus_server_submit_bus_event(struct obus_server *srv,
+				 struct obus_bus_event *event)
+{
+	/* bus event is destroyed by loop thread once sent */
+	if (!srv || !event || !event->is_allocated)
+		return -EINVAL;
+
+	return obus_server_submit(srv, NULL, event);
+}
+
 OBUS_API int obus_server_send_ack(struct obus_server *srv,
 				  obus_handle_t handle,
 				  enum obus_call_status status)
 {
-	struct obus_buffer *buf;
-	struct obus_peer *peer;
 	struct obus_call *call;
-	struct obus_ack ack;
-	int ret;
 
 	if (!srv)
 		return -EINVAL;
 
-	call = srv->call;
-	if (!call || call->handle != handle)
+	call = obus_bus_call(&srv->bus, handle);
+	if (!call)
 		return -ENOENT;
 
-	peer = call->peer;
-
-	/* peek buffer */
-	buf = obus_buffer_pool_peek(&srv->pool);
-	if (!buf)
-		return -ENOMEM;
-
-	/* encode object event packet */
-	ack.handle = call->handle;
-	ack.status = status;
-	ret = obus_packet_ack_encode(buf, &ack);
-	if (ret < 0) {
-		obus_error("can't encode ack packet");
-		obus_buffer_unref(buf);
-		return ret;
-	}
+	return obus_server_complete_call(srv, call, status);
+}
 
-	/* write packet */
-	ret = obus_io_write(peer->io, buf);
-	if (ret == 0) {
-		/* buffer written, unref it */
-		obus_buffer_unref(buf);
-	} else if (ret == -EAGAIN) {
-		/* buffer put in write queue don't unref it */
-		ret = 0;
-	} else {
-		/* buffer write failure */
-		obus_buffer_unref(buf);
-	}
+OBUS_API int obus_server_defer_ack(struct obus_server *srv,
+				   obus_handle_t handle)
+{
+	struct obus_call *call;
 
-	/* update call ack status */
-	call->status = status;
+	if (!srv)
+		return -EINVAL;
 
-	/* log ack if requested */
-	if (srv->log_flags & OBUS_LOG_BUS) {
-		obus_info("call ack sent:");
-		obus_ack_log(&ack, call, OBUS_LOG_INFO);
-	}
+	call = obus_bus_call(&srv->bus, handle);
+	if (!call)
+		return -ENOENT;
 
-	srv->call = NULL;
+	call->is_deferred = 1;
 	return 0;
 }
 
@@ -1122,9 +3045,6 @@ OBUS_API struct obus_peer *obus_server_get_call_peer(struct obus_server *srv,
 	if (!srv)
 		return NULL;
 
-	call = srv->call;
-	if (!call || call->handle != handle)
-		return NULL;
-
-	return srv->call->peer;
+	call = obus_bus_call(&srv->bus, handle);
+	return call ? call->peer : NULL;
 }
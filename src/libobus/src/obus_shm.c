@@ -0,0 +1,969 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_shm.c
+ *
+ * @brief obus shared memory transport
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "obus_header.h"
+
+/* handshake message magic */
+#define OBUS_SHM_MAGIC 0x4853424f
+
+/* max accepted ring size */
+#define OBUS_SHM_RING_MAX_SIZE (16 * 1024 * 1024)
+
+/* number of fds sent in handshake: memfd + 2 doorbells per ring */
+#define OBUS_SHM_N_FDS 5
+
+/* seals preventing the other side to resize rings memory */
+#define OBUS_SHM_SEALS (F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)
+
+/* max accepted broadcast log size */
+#define OBUS_SHM_LOG_MAX_SIZE (64 * 1024 * 1024)
+
+/* seals making broadcast log read only for clients */
+#define OBUS_SHM_LOG_SEALS (F_SEAL_SHRINK | F_SEAL_GROW | \
+			    F_SEAL_FUTURE_WRITE | F_SEAL_SEAL)
+
+/* broadcast log record magic */
+#define OBUS_SHM_LOG_MAGIC 0x474f4c4f
+
+/* broadcast log records are 8 bytes aligned */
+#define OBUS_SHM_LOG_ALIGN(len) (((len) + 7) & ~((uint64_t)7))
+
+/* ring header shared by both sides (padded to a cache line) */
+struct obus_shm_hdr {
+	/* write index (free running, updated by writer) */
+	uint32_t head;
+	/* read index (free running, updated by reader) */
+	uint32_t tail;
+	/* writer is waiting for space */
+	uint32_t writer_waiting;
+	/* ring data size */
+	uint32_t size;
+	/* client waits for broadcast log data (server to client ring) */
+	uint32_t log_waiting;
+	uint32_t reserved;
+	/* log position of connection response (server to client ring) */
+	uint64_t log_start;
+	uint8_t pad[32];
+};
+
+/* one direction of a channel */
+struct obus_shm_ring {
+	/* shared header */
+	struct obus_shm_hdr *hdr;
+	/* ring data */
+	uint8_t *data;
+	/* ring size (local copy, never read from shared memory) */
+	uint32_t size;
+	/* doorbell rung by writer when data is available */
+	int data_fd;
+	/* doorbell rung by reader when space is available */
+	int space_fd;
+};
+
+struct obus_shm {
+	/* memfd holding both rings */
+	int memfd;
+	/* mapping of memfd */
+	void *map;
+	size_t map_size;
+	/* ring written by this side */
+	struct obus_shm_ring tx;
+	/* ring read by this side */
+	struct obus_shm_ring rx;
+};
+
+/* broadcast log header */
+struct obus_shm_log_hdr {
+	/* end of last published record (free running) */
+	uint64_t head;
+	/* end of record being written, data before reserve - size is
+	 * being overwritten */
+	uint64_t reserve;
+	/* log data size */
+	uint32_t size;
+	uint8_t pad[44];
+};
+
+/* broadcast log record header */
+struct obus_shm_log_rec {
+	uint32_t len;
+	uint32_t magic;
+};
+
+struct obus_shm_log {
+	/* memfd holding log */
+	int memfd;
+	/* mapping of memfd */
+	void *map;
+	size_t map_size;
+	/* shared header */
+	struct obus_shm_log_hdr *hdr;
+	/* log data */
+	uint8_t *data;
+	/* log size (local copy, never read from shared memory) */
+	uint32_t size;
+};
+
+/* handshake message */
+struct obus_shm_hello {
+	uint32_t magic;
+	uint32_t size;
+};
+
+static inline uint32_t obus_shm_load(const uint32_t *ptr)
+{
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void obus_shm_store(uint32_t *ptr, uint32_t val)
+{
+	__atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+	/* order store with next load of other side index */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline uint64_t obus_shm_load64(const uint64_t *ptr)
+{
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void obus_shm_store64(uint64_t *ptr, uint64_t val)
+{
+	__atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static void obus_shm_ring_bell(int fd)
+{
+	uint64_t val = 1;
+	ssize_t ret;
+
+	do {
+		ret = write(fd, &val, sizeof(val));
+	} while (ret < 0 && errno == EINTR);
+}
+
+void obus_shm_clear_event(int fd)
+{
+	uint64_t val;
+	ssize_t ret;
+
+	do {
+		ret = read(fd, &val, sizeof(val));
+	} while (ret < 0 && errno == EINTR);
+}
+
+static void obus_shm_ring_init(struct obus_shm_ring *ring, void *base,
+			       uint32_t size)
+{
+	ring->hdr = base;
+	ring->data = (uint8_t *)base + sizeof(struct obus_shm_hdr);
+	ring->size = size;
+}
+
+/* check memfd received from other side carries all given seals */
+static int obus_shm_check_seals(int fd, int seals)
+{
+	int ret;
+
+	ret = fcntl(fd, F_GET_SEALS);
+	if (ret < 0) {
+		obus_log_fd_errno("fcntl", fd);
+		return -errno;
+	}
+
+	return ((ret & seals) == seals) ? 0 : -EPERM;
+}
+
+static size_t obus_shm_map_size(uint32_t size)
+{
+	return 2 * (sizeof(struct obus_shm_hdr) + (size_t)size);
+}
+
+static struct obus_shm *obus_shm_alloc(void)
+{
+	struct obus_shm *shm;
+
+	shm = calloc(1, sizeof(*shm));
+	if (!shm)
+		return NULL;
+
+	shm->memfd = -1;
+	shm->map = MAP_FAILED;
+	shm->tx.data_fd = -1;
+	shm->tx.space_fd = -1;
+	shm->rx.data_fd = -1;
+	shm->rx.space_fd = -1;
+	return shm;
+}
+
+static int obus_shm_map(struct obus_shm *shm, uint32_t size, int is_client)
+{
+	uint8_t *first, *second;
+
+	shm->map_size = obus_shm_map_size(size);
+	shm->map = mmap(NULL, shm->map_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED, shm->memfd, 0);
+	if (shm->map == MAP_FAILED) {
+		obus_log_errno("mmap");
+		return -errno;
+	}
+
+	/* first ring is client to server, second is server to client */
+	first = shm->map;
+	second = first + sizeof(struct obus_shm_hdr) + size;
+	obus_shm_ring_init(is_client ? &shm->tx : &shm->rx, first, size);
+	obus_shm_ring_init(is_client ? &shm->rx : &shm->tx, second, size);
+	return 0;
+}
+
+void obus_shm_destroy(struct obus_shm *shm)
+{
+	if (!shm)
+		return;
+
+	if (shm->map != MAP_FAILED)
+		munmap(shm->map, shm->map_size);
+	if (shm->memfd >= 0)
+		close(shm->memfd);
+	if (shm->tx.data_fd >= 0)
+		close(shm->tx.data_fd);
+	if (shm->tx.space_fd >= 0)
+		close(shm->tx.space_fd);
+	if (shm->rx.data_fd >= 0)
+		close(shm->rx.data_fd);
+	if (shm->rx.space_fd >= 0)
+		close(shm->rx.space_fd);
+	free(shm);
+}
+
+int obus_shm_new(size_t size, struct obus_shm **shm)
+{
+	struct obus_shm *s;
+	int ret;
+
+	if (!shm || size == 0 || size > OBUS_SHM_RING_MAX_SIZE ||
+	    (size & (size - 1)) != 0)
+		return -EINVAL;
+
+	s = obus_shm_alloc();
+	if (!s)
+		return -ENOMEM;
+
+	/* create shared memory */
+	s->memfd = obus_memfd_create("obus-shm",
+				     MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (s->memfd < 0) {
+		ret = -errno;
+		obus_log_errno("memfd_create");
+		goto error;
+	}
+
+	if (ftruncate(s->memfd, (off_t)obus_shm_map_size((uint32_t)size)) < 0) {
+		ret = -errno;
+		obus_log_fd_errno("ftruncate", s->memfd);
+		goto error;
+	}
+
+	/* server maps this memory, it must not be resized under it */
+	if (fcntl(s->memfd, F_ADD_SEALS, OBUS_SHM_SEALS) < 0) {
+		ret = -errno;
+		obus_log_fd_errno("fcntl", s->memfd);
+		goto error;
+	}
+
+	ret = obus_shm_map(s, (uint32_t)size, 1);
+	if (ret < 0)
+		goto error;
+
+	s->tx.hdr->size = (uint32_t)size;
+	s->rx.hdr->size = (uint32_t)size;
+
+	/* create doorbells */
+	s->tx.data_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	s->tx.space_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	s->rx.data_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	s->rx.space_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (s->tx.data_fd < 0 || s->tx.space_fd < 0 ||
+	    s->rx.data_fd < 0 || s->rx.space_fd < 0) {
+		ret = -errno;
+		obus_log_errno("eventfd");
+		goto error;
+	}
+
+	*shm = s;
+	return 0;
+
+error:
+	obus_shm_destroy(s);
+	return ret;
+}
+
+int obus_shm_send(struct obus_shm *shm, int fd)
+{
+	struct obus_shm_hello hello;
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	int fds[OBUS_SHM_N_FDS];
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(sizeof(fds))];
+	} ctrl;
+	ssize_t ret;
+
+	if (!shm || fd < 0)
+		return -EINVAL;
+
+	/* client to server ring doorbells first */
+	fds[0] = shm->memfd;
+	fds[1] = shm->tx.data_fd;
+	fds[2] = shm->tx.space_fd;
+	fds[3] = shm->rx.data_fd;
+	fds[4] = shm->rx.space_fd;
+
+	hello.magic = OBUS_SHM_MAGIC;
+	hello.size = shm->tx.size;
+	iov.iov_base = &hello;
+	iov.iov_len = sizeof(hello);
+
+	memset(&msg, 0, sizeof(msg));
+	memset(&ctrl, 0, sizeof(ctrl));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl.buf;
+	msg.msg_controllen = sizeof(ctrl.buf);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+	memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+	do {
+		ret = sendmsg(fd, &msg, MSG_NOSIGNAL);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0) {
+		obus_log_fd_errno("sendmsg", fd);
+		return -errno;
+	}
+
+	/* socket was just connected, short write is not expected */
+	return (ret == (ssize_t)sizeof(hello)) ? 0 : -EIO;
+}
+
+int obus_shm_recv(int fd, struct obus_shm **shm)
+{
+	struct obus_shm_hello hello;
+	struct obus_shm *s;
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	struct stat st;
+	int fds[OBUS_SHM_N_FDS];
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(sizeof(fds))];
+	} ctrl;
+	size_t i, n_fds = 0;
+	ssize_t nbytes;
+	int ret;
+
+	if (fd < 0 || !shm)
+		return -EINVAL;
+
+	iov.iov_base = &hello;
+	iov.iov_len = sizeof(hello);
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl.buf;
+	msg.msg_controllen = sizeof(ctrl.buf);
+
+	do {
+		nbytes = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+	} while (nbytes < 0 && errno == EINTR);
+
+	if (nbytes < 0) {
+		if (errno != EAGAIN)
+			obus_log_fd_errno("recvmsg", fd);
+		return -errno;
+	} else if (nbytes == 0) {
+		return -EPIPE;
+	}
+
+	/* get received fds */
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level != SOL_SOCKET ||
+		    cmsg->cmsg_type != SCM_RIGHTS)
+			continue;
+
+		n_fds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+		if (n_fds > OBUS_SHM_N_FDS)
+			n_fds = OBUS_SHM_N_FDS;
+		memcpy(fds, CMSG_DATA(cmsg), n_fds * sizeof(int));
+		break;
+	}
+
+	s = obus_shm_alloc();
+	if (!s) {
+		ret = -ENOMEM;
+		goto close_fds;
+	}
+
+	/* check handshake */
+	if (nbytes != (ssize_t)sizeof(hello) || n_fds != OBUS_SHM_N_FDS ||
+	    hello.magic != OBUS_SHM_MAGIC || hello.size == 0 ||
+	    hello.size > OBUS_SHM_RING_MAX_SIZE ||
+	    (hello.size & (hello.size - 1)) != 0 ||
+	    (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+		obus_error("invalid shm handshake on fd=%d", fd);
+		ret = -EPROTO;
+		goto destroy_shm;
+	}
+
+	/* fds are now owned by channel */
+	s->memfd = fds[0];
+	s->rx.data_fd = fds[1];
+	s->rx.space_fd = fds[2];
+	s->tx.data_fd = fds[3];
+	s->tx.space_fd = fds[4];
+	n_fds = 0;
+
+	/* check shared memory is large enough and can not be resized */
+	if (obus_shm_check_seals(s->memfd, OBUS_SHM_SEALS) < 0 ||
+	    fstat(s->memfd, &st) < 0 ||
+	    (size_t)st.st_size < obus_shm_map_size(hello.size)) {
+		obus_error("invalid shm memory on fd=%d", fd);
+		ret = -EPROTO;
+		goto destroy_shm;
+	}
+
+	ret = obus_shm_map(s, hello.size, 0);
+	if (ret < 0)
+		goto destroy_shm;
+
+	*shm = s;
+	return 0;
+
+destroy_shm:
+	obus_shm_destroy(s);
+close_fds:
+	for (i = 0; i < n_fds; i++)
+		close(fds[i]);
+	return ret;
+}
+
+/* get free space of tx ring, -1 if peer corrupted indexes */
+static int64_t obus_shm_tx_space(struct obus_shm_ring *ring, uint32_t head)
+{
+	uint32_t used = head - obus_shm_load(&ring->hdr->tail);
+	return used > ring->size ? -1 : (int64_t)(ring->size - used);
+}
+
+ssize_t obus_shm_writev(struct obus_shm *shm, const struct iovec *iov,
+			int iovcnt)
+{
+	struct obus_shm_ring *ring = &shm->tx;
+	uint32_t head, off, len, chunk, written = 0;
+	const uint8_t *src;
+	size_t total = 0;
+	int64_t avail;
+	int i;
+
+	for (i = 0; i < iovcnt; i++)
+		total += iov[i].iov_len;
+
+	head = ring->hdr->head;
+	avail = obus_shm_tx_space(ring, head);
+
+	/* ring full: ask reader to ring space doorbell, then check again in
+	 * case reader consumed data in between */
+	if (avail == 0) {
+		obus_shm_store(&ring->hdr->writer_waiting, 1);
+		avail = obus_shm_tx_space(ring, head);
+	}
+
+	if (avail < 0) {
+		errno = EPROTO;
+		return -1;
+	} else if (avail == 0) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	/* copy vectors in ring */
+	for (i = 0; i < iovcnt && written < avail; i++) {
+		src = iov[i].iov_base;
+		len = (uint32_t)iov[i].iov_len;
+		if (len > avail - written)
+			len = (uint32_t)(avail - written);
+
+		while (len > 0) {
+			off = (head + written) & (ring->size - 1);
+			chunk = ring->size - off;
+			if (chunk > len)
+				chunk = len;
+			memcpy(ring->data + off, src, chunk);
+			src += chunk;
+			len -= chunk;
+			written += chunk;
+		}
+	}
+
+	/* a short write waits for space doorbell */
+	if (written < total)
+		obus_shm_store(&ring->hdr->writer_waiting, 1);
+
+	/* publish data and wake up reader if it may sleep */
+	obus_shm_store(&ring->hdr->head, head + written);
+	if (obus_shm_load(&ring->hdr->tail) == head)
+		obus_shm_ring_bell(ring->data_fd);
+
+	return (ssize_t)written;
+}
+
+ssize_t obus_shm_read(struct obus_shm *shm, void *ptr, size_t size)
+{
+	struct obus_shm_ring *ring = &shm->rx;
+	uint32_t head, tail, used, off, len, chunk;
+	uint8_t *dst = ptr;
+
+	tail = ring->hdr->tail;
+	head = obus_shm_load(&ring->hdr->head);
+	used = head - tail;
+
+	/* never trust peer indexes beyond ring size */
+	if (used > ring->size) {
+		errno = EPROTO;
+		return -1;
+	}
+
+	if (used == 0) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	len = size < used ? (uint32_t)size : used;
+	used = len;
+	while (len > 0) {
+		off = tail & (ring->size - 1);
+		chunk = ring->size - off;
+		if (chunk > len)
+			chunk = len;
+		memcpy(dst, ring->data + off, chunk);
+		dst += chunk;
+		tail += chunk;
+		len -= chunk;
+	}
+
+	/* release space and wake up writer if waiting for it */
+	obus_shm_store(&ring->hdr->tail, tail);
+	if (obus_shm_load(&ring->hdr->writer_waiting)) {
+		obus_shm_store(&ring->hdr->writer_waiting, 0);
+		obus_shm_ring_bell(ring->space_fd);
+	}
+
+	return (ssize_t)used;
+}
+
+int obus_shm_read_fd(struct obus_shm *shm)
+{
+	return shm ? shm->rx.data_fd : -EINVAL;
+}
+
+int obus_shm_write_fd(struct obus_shm *shm)
+{
+	return shm ? shm->tx.space_fd : -EINVAL;
+}
+
+void obus_shm_set_log_start(struct obus_shm *shm, uint64_t pos)
+{
+	obus_shm_store64(&shm->tx.hdr->log_start, pos);
+}
+
+uint64_t obus_shm_get_log_start(struct obus_shm *shm)
+{
+	return obus_shm_load64(&shm->rx.hdr->log_start);
+}
+
+void obus_shm_log_wait(struct obus_shm *shm)
+{
+	obus_shm_store(&shm->rx.hdr->log_waiting, 1);
+}
+
+void obus_shm_log_wake(struct obus_shm *shm)
+{
+	/* only the first append after client went idle rings */
+	if (obus_shm_load(&shm->tx.hdr->log_waiting) &&
+	    __atomic_exchange_n(&shm->tx.hdr->log_waiting, 0,
+				__ATOMIC_ACQ_REL))
+		obus_shm_ring_bell(shm->tx.data_fd);
+}
+
+static size_t obus_shm_log_map_size(uint32_t size)
+{
+	return sizeof(struct obus_shm_log_hdr) + (size_t)size;
+}
+
+static int obus_shm_log_map(struct obus_shm_log *log, uint32_t size, int prot)
+{
+	log->map_size = obus_shm_log_map_size(size);
+	log->map = mmap(NULL, log->map_size, prot, MAP_SHARED, log->memfd, 0);
+	if (log->map == MAP_FAILED) {
+		obus_log_errno("mmap");
+		return -errno;
+	}
+
+	log->hdr = log->map;
+	log->data = (uint8_t *)log->map + sizeof(struct obus_shm_log_hdr);
+	log->size = size;
+	return 0;
+}
+
+static struct obus_shm_log *obus_shm_log_alloc(void)
+{
+	struct obus_shm_log *log;
+
+	log = calloc(1, sizeof(*log));
+	if (!log)
+		return NULL;
+
+	log->memfd = -1;
+	log->map = MAP_FAILED;
+	return log;
+}
+
+void obus_shm_log_destroy(struct obus_shm_log *log)
+{
+	if (!log)
+		return;
+
+	if (log->map != MAP_FAILED)
+		munmap(log->map, log->map_size);
+	if (log->memfd >= 0)
+		close(log->memfd);
+	free(log);
+}
+
+int obus_shm_log_new(size_t size, struct obus_shm_log **log)
+{
+	struct obus_shm_log *l;
+	int ret;
+
+	if (!log || size < 64 || size > OBUS_SHM_LOG_MAX_SIZE ||
+	    (size & (size - 1)) != 0)
+		return -EINVAL;
+
+	l = obus_shm_log_alloc();
+	if (!l)
+		return -ENOMEM;
+
+	l->memfd = obus_memfd_create("obus-log",
+				     MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (l->memfd < 0) {
+		ret = -errno;
+		obus_log_errno("memfd_create");
+		goto error;
+	}
+
+	if (ftruncate(l->memfd,
+		      (off_t)obus_shm_log_map_size((uint32_t)size)) < 0) {
+		ret = -errno;
+		obus_log_fd_errno("ftruncate", l->memfd);
+		goto error;
+	}
+
+	ret = obus_shm_log_map(l, (uint32_t)size, PROT_READ | PROT_WRITE);
+	if (ret < 0)
+		goto error;
+
+	/* log is shared with all clients, only server mapping may write it */
+	if (fcntl(l->memfd, F_ADD_SEALS, OBUS_SHM_LOG_SEALS) < 0) {
+		ret = -errno;
+		obus_log_fd_errno("fcntl", l->memfd);
+		goto error;
+	}
+
+	l->hdr->size = (uint32_t)size;
+	*log = l;
+	return 0;
+
+error:
+	obus_shm_log_destroy(l);
+	return ret;
+}
+
+/* open log received from server, clients only map it read only */
+static int obus_shm_log_open(int fd, uint32_t size, struct obus_shm_log **log)
+{
+	struct obus_shm_log *l;
+	struct stat st;
+	int ret;
+
+	if (size < 64 || size > OBUS_SHM_LOG_MAX_SIZE ||
+	    (size & (size - 1)) != 0 ||
+	    obus_shm_check_seals(fd, OBUS_SHM_LOG_SEALS) < 0 ||
+	    fstat(fd, &st) < 0 ||
+	    (size_t)st.st_size < obus_shm_log_map_size(size)) {
+		obus_error("invalid shm log on fd=%d", fd);
+		close(fd);
+		return -EPROTO;
+	}
+
+	l = obus_shm_log_alloc();
+	if (!l) {
+		close(fd);
+		return -ENOMEM;
+	}
+
+	l->memfd = fd;
+	ret = obus_shm_log_map(l, size, PROT_READ);
+	if (ret < 0) {
+		obus_shm_log_destroy(l);
+		return ret;
+	}
+
+	*log = l;
+	return 0;
+}
+
+/* copy data in log at given position, handling wrap around */
+static void obus_shm_log_copy_in(struct obus_shm_log *log, uint64_t pos,
+				 const void *ptr, size_t len)
+{
+	size_t off = (size_t)(pos & (log->size - 1));
+	size_t chunk = log->size - off;
+
+	if (chunk > len)
+		chunk = len;
+	memcpy(log->data + off, ptr, chunk);
+	memcpy(log->data, (const uint8_t *)ptr + chunk, len - chunk);
+}
+
+static void obus_shm_log_copy_out(struct obus_shm_log *log, uint64_t pos,
+				  void *ptr, size_t len)
+{
+	size_t off = (size_t)(pos & (log->size - 1));
+	size_t chunk = log->size - off;
+
+	if (chunk > len)
+		chunk = len;
+	memcpy(ptr, log->data + off, chunk);
+	memcpy((uint8_t *)ptr + chunk, log->data, len - chunk);
+}
+
+int obus_shm_log_append(struct obus_shm_log *log, const void *ptr,
+			size_t len)
+{
+	struct obus_shm_log_rec rec;
+	uint64_t head, end;
+
+	/* keep room for several records so readers are not always lagging */
+	if (!log || len == 0 || len > log->size / 4)
+		return -EMSGSIZE;
+
+	head = log->hdr->head;
+	end = head + sizeof(rec) + OBUS_SHM_LOG_ALIGN(len);
+
+	/* invalidate overwritten records before touching them */
+	obus_shm_store64(&log->hdr->reserve, end);
+
+	rec.len = (uint32_t)len;
+	rec.magic = OBUS_SHM_LOG_MAGIC;
+	obus_shm_log_copy_in(log, head, &rec, sizeof(rec));
+	obus_shm_log_copy_in(log, head + sizeof(rec), ptr, len);
+
+	/* publish record */
+	obus_shm_store64(&log->hdr->head, end);
+	return 0;
+}
+
+uint64_t obus_shm_log_head(struct obus_shm_log *log)
+{
+	return obus_shm_load64(&log->hdr->head);
+}
+
+/* check data read at position was not overwritten meanwhile */
+static int obus_shm_log_check(struct obus_shm_log *log, uint64_t pos)
+{
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return (obus_shm_load64(&log->hdr->reserve) - pos > log->size) ?
+		-ESTALE : 0;
+}
+
+int obus_shm_log_peek(struct obus_shm_log *log, uint64_t pos, size_t *len)
+{
+	struct obus_shm_log_rec rec;
+	uint64_t head;
+
+	head = obus_shm_log_head(log);
+	if (pos == head)
+		return -EAGAIN;
+
+	/* reader position overwritten or corrupted */
+	if (head - pos > log->size || (pos & 7) != 0)
+		return -ESTALE;
+
+	obus_shm_log_copy_out(log, pos, &rec, sizeof(rec));
+	if (obus_shm_log_check(log, pos) < 0)
+		return -ESTALE;
+
+	if (rec.magic != OBUS_SHM_LOG_MAGIC || rec.len == 0 ||
+	    sizeof(rec) + OBUS_SHM_LOG_ALIGN(rec.len) > head - pos)
+		return -ESTALE;
+
+	*len = rec.len;
+	return 0;
+}
+
+int obus_shm_log_read(struct obus_shm_log *log, uint64_t *pos, void *ptr,
+		      size_t len)
+{
+	struct obus_shm_log_rec rec;
+
+	obus_shm_log_copy_out(log, *pos + sizeof(rec), ptr, len);
+	if (obus_shm_log_check(log, *pos) < 0)
+		return -ESTALE;
+
+	*pos += sizeof(rec) + OBUS_SHM_LOG_ALIGN(len);
+	return 0;
+}
+
+int obus_shm_send_reply(int fd, struct obus_shm_log *log)
+{
+	struct obus_shm_hello hello;
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(sizeof(int))];
+	} ctrl;
+	ssize_t ret;
+
+	/* log size is 0 if server has no broadcast log */
+	hello.magic = OBUS_SHM_MAGIC;
+	hello.size = log ? log->size : 0;
+	iov.iov_base = &hello;
+	iov.iov_len = sizeof(hello);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	if (log) {
+		memset(&ctrl, 0, sizeof(ctrl));
+		msg.msg_control = ctrl.buf;
+		msg.msg_controllen = sizeof(ctrl.buf);
+		cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+		memcpy(CMSG_DATA(cmsg), &log->memfd, sizeof(int));
+	}
+
+	do {
+		ret = sendmsg(fd, &msg, MSG_NOSIGNAL);
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0) {
+		obus_log_fd_errno("sendmsg", fd);
+		return -errno;
+	}
+
+	return (ret == (ssize_t)sizeof(hello)) ? 0 : -EIO;
+}
+
+int obus_shm_recv_reply(int fd, struct obus_shm_log **log)
+{
+	struct obus_shm_hello hello;
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr *cmsg;
+	union {
+		struct cmsghdr align;
+		char buf[CMSG_SPACE(sizeof(int))];
+	} ctrl;
+	ssize_t nbytes;
+	int logfd = -1;
+
+	if (fd < 0 || !log)
+		return -EINVAL;
+
+	iov.iov_base = &hello;
+	iov.iov_len = sizeof(hello);
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl.buf;
+	msg.msg_controllen = sizeof(ctrl.buf);
+
+	do {
+		nbytes = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+	} while (nbytes < 0 && errno == EINTR);
+
+	if (nbytes < 0) {
+		if (errno != EAGAIN)
+			obus_log_fd_errno("recvmsg", fd);
+		return -errno;
+	} else if (nbytes == 0) {
+		return -EPIPE;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET &&
+		    cmsg->cmsg_type == SCM_RIGHTS &&
+		    cmsg->cmsg_len == CMSG_LEN(sizeof(int))) {
+			memcpy(&logfd, CMSG_DATA(cmsg), sizeof(int));
+			break;
+		}
+	}
+
+	if (nbytes != (ssize_t)sizeof(hello) || hello.magic != OBUS_SHM_MAGIC ||
+	    (hello.size != 0) != (logfd >= 0) ||
+	    (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+		obus_error("invalid shm handshake reply on fd=%d", fd);
+		if (logfd >= 0)
+			close(logfd);
+		return -EPROTO;
+	}
+
+	*log = NULL;
+	if (logfd < 0)
+		return 0;
+
+	return obus_shm_log_open(logfd, hello.size, log);
+}
@@ -0,0 +1,231 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_shm.h
+ *
+ * @brief obus shared memory transport
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _OBUS_SHM_H_
+#define _OBUS_SHM_H_
+
+/**
+ * shared memory channel between a client and a server peer.
+ *
+ * A channel is made of two byte rings (one per direction) stored in a
+ * single memfd and of eventfd doorbells used to wake up the reader when
+ * data is available and the writer when space is available. Doorbells
+ * are only rung when the other side may be sleeping, so a busy channel
+ * exchanges packets without any syscall.
+ *
+ * The channel is created by the client and handed to the server over the
+ * connected unix socket (SCM_RIGHTS), the socket is then only used to
+ * detect peer hang up.
+ */
+struct obus_shm;
+struct obus_shm_log;
+
+/**
+ * create a new client shared memory channel
+ * @param size ring size of each direction (power of 2)
+ * @param shm created channel
+ * @return 0 on success
+ */
+int obus_shm_new(size_t size, struct obus_shm **shm);
+
+/**
+ * destroy shared memory channel
+ * @param shm channel
+ */
+void obus_shm_destroy(struct obus_shm *shm);
+
+/**
+ * send client channel to server
+ * @param shm channel
+ * @param fd connected unix socket
+ * @return 0 on success
+ */
+int obus_shm_send(struct obus_shm *shm, int fd);
+
+/**
+ * receive channel sent by client
+ * @param fd connected unix socket
+ * @param shm received channel
+ * @return 0 on success, -EAGAIN if not yet received
+ */
+int obus_shm_recv(int fd, struct obus_shm **shm);
+
+/**
+ * write data in tx ring, same semantic as writev(2)
+ * @param shm channel
+ * @param iov data vectors
+ * @param iovcnt number of vectors
+ * @return number of bytes written or -1 with errno set (EAGAIN if full)
+ */
+ssize_t obus_shm_writev(struct obus_shm *shm, const struct iovec *iov,
+			int iovcnt);
+
+/**
+ * read data from rx ring, same semantic as read(2) except 0 is never
+ * returned (peer hang up is reported by socket)
+ * @param shm channel
+ * @param ptr destination
+ * @param size max size to be read
+ * @return number of bytes read or -1 with errno set (EAGAIN if empty)
+ */
+ssize_t obus_shm_read(struct obus_shm *shm, void *ptr, size_t size);
+
+/**
+ * get fd readable when rx ring has data
+ * @param shm channel
+ * @return fd
+ */
+int obus_shm_read_fd(struct obus_shm *shm);
+
+/**
+ * get fd readable when tx ring has space
+ * @param shm channel
+ * @return fd
+ */
+int obus_shm_write_fd(struct obus_shm *shm);
+
+/**
+ * acknowledge a doorbell fd event
+ * @param fd read or write doorbell fd
+ */
+void obus_shm_clear_event(int fd);
+
+/**
+ * send server handshake reply to client
+ * @param fd connected unix socket
+ * @param log server broadcast log (NULL if none)
+ * @return 0 on success
+ */
+int obus_shm_send_reply(int fd, struct obus_shm_log *log);
+
+/**
+ * receive server handshake reply
+ * @param fd connected unix socket
+ * @param log server broadcast log (set to NULL if server has none)
+ * @return 0 on success, -EAGAIN if not yet received
+ */
+int obus_shm_recv_reply(int fd, struct obus_shm_log **log);
+
+/**
+ * publish position of broadcast log matching next connection response
+ * (server side)
+ * @param shm channel
+ * @param pos log position
+ */
+void obus_shm_set_log_start(struct obus_shm *shm, uint64_t pos);
+
+/**
+ * get position of broadcast log matching received connection response
+ * (client side)
+ * @param shm channel
+ * @return log position
+ */
+uint64_t obus_shm_get_log_start(struct obus_shm *shm);
+
+/**
+ * ask server to ring read doorbell on next log append (client side),
+ * log head must be checked again after this call
+ * @param shm channel
+ */
+void obus_shm_log_wait(struct obus_shm *shm);
+
+/**
+ * ring client read doorbell if it waits for log data (server side)
+ * @param shm channel
+ */
+void obus_shm_log_wake(struct obus_shm *shm);
+
+/**
+ * shared memory broadcast log.
+ *
+ * The log is a single writer / many readers ring of packets written once
+ * by server and read by each shm client at its own position. Positions are
+ * free running byte offsets, a reader whose position has been overwritten
+ * by writer is lagging and must resync from a new connection response.
+ */
+
+/**
+ * create a new broadcast log (server side)
+ * @param size log size (power of 2)
+ * @param log created log
+ * @return 0 on success
+ */
+int obus_shm_log_new(size_t size, struct obus_shm_log **log);
+
+/**
+ * destroy broadcast log
+ * @param log log
+ */
+void obus_shm_log_destroy(struct obus_shm_log *log);
+
+/**
+ * append a packet in log (server side)
+ * @param log log
+ * @param ptr packet data
+ * @param len packet length
+ * @return 0 on success, -EMSGSIZE if packet is too large for log
+ */
+int obus_shm_log_append(struct obus_shm_log *log, const void *ptr,
+			size_t len);
+
+/**
+ * get log write position
+ * @param log log
+ * @return position of next appended packet
+ */
+uint64_t obus_shm_log_head(struct obus_shm_log *log);
+
+/**
+ * get length of packet at given position (client side)
+ * @param log log
+ * @param pos read position
+ * @param len packet length
+ * @return 0 on success, -EAGAIN if no packet, -ESTALE if lagging
+ */
+int obus_shm_log_peek(struct obus_shm_log *log, uint64_t pos, size_t *len);
+
+/**
+ * read packet at given position and advance it (client side)
+ * @param log log
+ * @param pos read position
+ * @param ptr destination (size given by obus_shm_log_peek)
+ * @param len packet length given by obus_shm_log_peek
+ * @return 0 on success, -ESTALE if packet was overwritten while read
+ */
+int obus_shm_log_read(struct obus_shm_log *log, uint64_t *pos, void *ptr,
+		      size_t len);
+
+#endif /* _OBUS_SHM_H_ */
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_slab.c
+ *
+ * @brief obus fixed size objects allocator
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "obus_header.h"
+
+static void obus_slab_check_destroy(struct obus_slab *slab)
+{
+	struct obus_node *node;
+
+	/* slab still used */
+	if (!slab->is_released || slab->n_used > 0)
+		return;
+
+	/* free cached objects */
+	while (!obus_list_is_empty(&slab->free_objs)) {
+		node = slab->free_objs.next;
+		obus_list_del(node);
+		free(node);
+	}
+
+	free(slab);
+}
+
+struct obus_slab *obus_slab_new(size_t size, uint32_t max_free)
+{
+	struct obus_slab *slab;
+
+	slab = calloc(1, sizeof(*slab));
+	if (!slab)
+		return NULL;
+
+	/* free objects are linked using their first bytes */
+	if (size < sizeof(struct obus_node))
+		size = sizeof(struct obus_node);
+
+	obus_list_init(&slab->free_objs);
+	slab->size = size;
+	slab->max_free = max_free;
+	return slab;
+}
+
+void obus_slab_release(struct obus_slab *slab)
+{
+	if (!slab)
+		return;
+
+	slab->is_released = 1;
+	obus_slab_check_destroy(slab);
+}
+
+void *obus_slab_alloc(struct obus_slab *slab)
+{
+	struct obus_node *node;
+	void *ptr;
+
+	/* reuse a cached object if any */
+	if (slab->n_free > 0) {
+		node = slab->free_objs.next;
+		obus_list_del(node);
+		slab->n_free--;
+		ptr = node;
+		memset(ptr, 0, slab->size);
+	} else {
+		ptr = calloc(1, slab->size);
+		if (!ptr)
+			return NULL;
+
+		slab->stats.n_heap_allocs++;
+	}
+
+	slab->stats.n_allocs++;
+	slab->n_used++;
+	return ptr;
+}
+
+void obus_slab_free(struct obus_slab *slab, void *ptr)
+{
+	struct obus_node *node = ptr;
+
+	if (!ptr)
+		return;
+
+	slab->stats.n_frees++;
+	slab->n_used--;
+
+	/* keep object for next allocation if possible */
+	if (!slab->is_released && slab->n_free < slab->max_free) {
+		obus_list_add_before(&slab->free_objs, node);
+		slab->n_free++;
+	} else {
+		free(ptr);
+		slab->stats.n_heap_frees++;
+	}
+
+	obus_slab_check_destroy(slab);
+}
+
+void obus_slab_add_stats(const struct obus_slab *slab,
+			 struct obus_alloc_stats *stats)
+{
+	if (!slab || !stats)
+		return;
+
+	stats->n_allocs += slab->stats.n_allocs;
+	stats->n_heap_allocs += slab->stats.n_heap_allocs;
+	stats->n_frees += slab->stats.n_frees;
+	stats->n_heap_frees += slab->stats.n_heap_frees;
+	stats->n_used += slab->n_used;
+	stats->n_cached += slab->n_free;
+}
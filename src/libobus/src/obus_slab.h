@@ -0,0 +1,94 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_slab.h
+ *
+ * @brief obus fixed size objects allocator
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _OBUS_SLAB_H_
+#define _OBUS_SLAB_H_
+
+/**
+ * fixed size objects allocator.
+ *
+ * released objects are kept in a free list (up to max_free) and reused
+ * by next allocations. A slab is refcounted by its owner and by each
+ * allocated object, so objects may be released after owner has
+ * released the slab.
+ */
+struct obus_slab {
+	struct obus_node free_objs;	/* cached free objects */
+	size_t size;			/* objects size */
+	uint32_t max_free;		/* max number of cached objects */
+	uint32_t n_free;		/* number of cached objects */
+	uint32_t n_used;		/* number of allocated objects */
+	int is_released;		/* slab released by its owner */
+	struct obus_alloc_stats stats;	/* allocation counters */
+};
+
+/**
+ * create a slab
+ * @param size objects size
+ * @param max_free max number of cached free objects
+ * @return slab or NULL on error
+ */
+struct obus_slab *obus_slab_new(size_t size, uint32_t max_free);
+
+/**
+ * release slab, slab memory is freed once all objects are released
+ * @param slab slab
+ */
+void obus_slab_release(struct obus_slab *slab);
+
+/**
+ * allocate a zeroed object
+ * @param slab slab
+ * @return object or NULL on error
+ */
+void *obus_slab_alloc(struct obus_slab *slab);
+
+/**
+ * release an object previously allocated with obus_slab_alloc
+ * @param slab slab
+ * @param ptr object
+ */
+void obus_slab_free(struct obus_slab *slab, void *ptr);
+
+/**
+ * add slab counters to given stats
+ * @param slab slab
+ * @param stats stats to be updated
+ */
+void obus_slab_add_stats(const struct obus_slab *slab,
+			 struct obus_alloc_stats *stats);
+
+#endif /* _OBUS_SLAB_H_ */
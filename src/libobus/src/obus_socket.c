@@ -39,6 +39,9 @@
 /* connection attempt interval in ms used by socket clients */
 #define OBUS_SOCKET_CONN_INTVL 500
 
+/* shared memory ring size of each direction */
+#define OBUS_SOCKET_SHM_SIZE (256 * 1024)
+
 /* socket role */
 enum obus_socket_role {
 	OBUS_SOCKET_CLIENT,
@@ -74,6 +77,10 @@ struct obus_socket_client {
 	obus_socket_client_connected_cb_t cb;
 	/* socket connected user data */
 	void *user_data;
+	/* shared memory channel ('shm:' address) */
+	struct obus_shm *shm;
+	/* server broadcast log (NULL if server has none) */
+	struct obus_shm_log *shm_log;
 	/* client log flag */
 	int log;
 };
@@ -92,6 +99,8 @@ struct obus_socket_peer {
 	struct obus_node node;
 	/* peer server socket */
 	struct obus_socket_server *srv;
+	/* shared memory channel ('shm:' address) */
+	struct obus_shm *shm;
 };
 
 /* socket server object */
@@ -108,6 +117,8 @@ struct obus_socket_server {
 	obus_socket_server_accept_cb_t cb;
 	/* server socket user data*/
 	void *user_data;
+	/* broadcast log given to shm peers */
+	struct obus_shm_log *shm_log;
 	/* server log flag */
 	int log;
 };
@@ -175,6 +186,7 @@ static int obus_socket_addr_init_from_string(struct obus_socket_addr *addr,
 		{"inet:", 5, AF_INET},
 		{"inet6:", 6 , AF_INET6},
 		{"unix:", 5, AF_UNIX},
+		{"shm:", 4, AF_UNIX},
 	};
 
 
@@ -192,6 +204,7 @@ static int obus_socket_addr_init_from_string(struct obus_socket_addr *addr,
 
 		/* handle address */
 		remain = name + families[i].len;
+		addr->shm = (families[i].prefix[0] == 's');
 		break;
 	}
 
@@ -477,6 +490,36 @@ error:
 }
 
 
+static void obus_socket_peer_shm_events(struct obus_fd *ofd, int events,
+					void *data)
+{
+	struct obus_socket_peer *peer = data;
+	struct obus_socket_server *srv = peer->srv;
+	int ret;
+
+	/* receive client shared memory channel */
+	ret = obus_fd_event_error(events) ? -EPIPE :
+	      obus_shm_recv(peer->sock.fd, &peer->shm);
+	if (ret == -EAGAIN)
+		return;
+
+	/* reply with server broadcast log if any */
+	if (ret == 0)
+		ret = obus_shm_send_reply(peer->sock.fd, srv->shm_log);
+
+	if (ret < 0) {
+		obus_socket_peer_disconnect(peer);
+		return;
+	}
+
+	/* socket is now monitored by peer io */
+	obus_loop_remove(peer->sock.loop, &peer->sock.ofd);
+	obus_fd_reset(&peer->sock.ofd);
+
+	/* notify server callback, of peer connected */
+	(*srv->cb) (srv, peer, srv->user_data);
+}
+
 static void obus_socket_server_events(struct obus_fd *ofd, int events,
 				      void *data)
 {
@@ -579,6 +622,16 @@ static void obus_socket_server_events(struct obus_fd *ofd, int events,
 		obus_debug("socket server '%s' has new peer '%s'",
 			   srv->addr.name, peer->peer_addr.name);
 
+	/* wait shared memory channel before notifying peer */
+	if (srv->addr.shm) {
+		obus_fd_init(&peer->sock.ofd, sockfd, OBUS_FD_IN,
+			     &obus_socket_peer_shm_events, peer);
+		ret = obus_loop_add(peer->sock.loop, &peer->sock.ofd);
+		if (ret < 0)
+			obus_socket_peer_disconnect(peer);
+		return;
+	}
+
 	/* notify server callback, of peer connected */
 	(*srv->cb) (srv, peer, srv->user_data);
 	return;
@@ -811,6 +864,7 @@ int obus_socket_peer_disconnect(struct obus_socket_peer *peer)
 
 	/* close and destroy socket base */
 	obus_socket_base_destroy(&peer->sock);
+	obus_shm_destroy(peer->shm);
 
 	if (peer->srv->log)
 		obus_debug("socket peer '%s' disconnected",
@@ -838,6 +892,56 @@ pid_t obus_socket_peer_pid(struct obus_socket_peer *peer)
 	return peer ? peer->peer_pid : 0;
 }
 
+struct obus_shm *obus_socket_peer_shm(struct obus_socket_peer *peer)
+{
+	return peer ? peer->shm : NULL;
+}
+
+void obus_socket_server_set_shm_log(struct obus_socket_server *srv,
+				    struct obus_shm_log *log)
+{
+	if (srv)
+		srv->shm_log = log;
+}
+
+/* close socket and set connect retry timer */
+static void obus_socket_client_retry(struct obus_socket_client *client)
+{
+	obus_socket_base_close(&client->sock);
+	obus_shm_destroy(client->shm);
+	client->shm = NULL;
+	obus_shm_log_destroy(client->shm_log);
+	client->shm_log = NULL;
+	free(client->local_addr.name);
+	client->local_addr.name = NULL;
+	obus_timer_set(client->timer, OBUS_SOCKET_CONN_INTVL);
+}
+
+static void obus_socket_client_shm_events(struct obus_fd *ofd, int events,
+					  void *data)
+{
+	struct obus_socket_client *client = data;
+	int ret;
+
+	/* receive server reply and its broadcast log */
+	ret = obus_fd_event_error(events) ? -EPIPE :
+	      obus_shm_recv_reply(client->sock.fd, &client->shm_log);
+	if (ret == -EAGAIN)
+		return;
+
+	if (ret < 0) {
+		obus_socket_client_retry(client);
+		return;
+	}
+
+	/* socket is now monitored by client io */
+	obus_loop_remove(client->sock.loop, &client->sock.ofd);
+	obus_fd_reset(&client->sock.ofd);
+
+	/* notify sock user */
+	(*client->cb) (client, client->user_data);
+}
+
 static void obus_socket_client_connected(struct obus_socket_client *client)
 {
 	socklen_t len;
@@ -872,6 +976,26 @@ static void obus_socket_client_connected(struct obus_socket_client *client)
 	    client->local_addr.base->sa_family == AF_INET6)
 		obus_socket_activate_keepalive(client->sock.fd, 5, 1, 2);
 
+	/* create shared memory channel, give it to server and wait for
+	 * server reply before notifying sock user */
+	if (client->peer_addr.shm) {
+		ret = obus_shm_new(OBUS_SOCKET_SHM_SIZE, &client->shm);
+		if (ret == 0)
+			ret = obus_shm_send(client->shm, client->sock.fd);
+
+		if (ret == 0) {
+			obus_fd_init(&client->sock.ofd, client->sock.fd,
+				     OBUS_FD_IN, &obus_socket_client_shm_events,
+				     client);
+			ret = obus_loop_add(client->sock.loop,
+					    &client->sock.ofd);
+		}
+
+		if (ret < 0)
+			obus_socket_client_retry(client);
+		return;
+	}
+
 	/* notify sock user */
 	(*client->cb) (client, client->user_data);
 }
@@ -1036,6 +1160,8 @@ int obus_socket_client_destroy(struct obus_socket_client *client)
 
 	obus_timer_destroy(client->timer);
 	obus_socket_base_destroy(&client->sock);
+	obus_shm_destroy(client->shm);
+	obus_shm_log_destroy(client->shm_log);
 	free(client->peer_addr.name);
 	free(client->local_addr.name);
 	free(client);
@@ -1053,6 +1179,12 @@ int obus_socket_client_reconnect(struct obus_socket_client *client)
 
 	/* close socket */
 	obus_socket_base_close(&client->sock);
+	obus_shm_destroy(client->shm);
+	client->shm = NULL;
+	obus_shm_log_destroy(client->shm_log);
+	client->shm_log = NULL;
+	free(client->local_addr.name);
+	client->local_addr.name = NULL;
 
 	/* open socket */
 	ret = obus_socket_base_open(&client->sock);
@@ -1077,3 +1209,14 @@ const char *obus_socket_client_name(struct obus_socket_client *client)
 {
 	return client ? client->peer_addr.name : NULL;
 }
+
+struct obus_shm *obus_socket_client_shm(struct obus_socket_client *client)
+{
+	return client ? client->shm : NULL;
+}
+
+struct obus_shm_log *
+obus_socket_client_shm_log(struct obus_socket_client *client)
+{
+	return client ? client->shm_log : NULL;
+}
@@ -40,6 +40,8 @@
 /* socket address */
 struct obus_socket_addr {
 	char *name;
+	/* unix socket only used to setup a shared memory channel */
+	int shm;
 	struct sockaddr_storage st;
 	struct sockaddr *base;
 	union {
@@ -123,6 +125,23 @@ int obus_socket_peer_fd(struct obus_socket_peer *peer);
  */
 pid_t obus_socket_peer_pid(struct obus_socket_peer *peer);
 
+/**
+ * get peer shared memory channel
+ *
+ * @param peer socket peer object
+ * @return channel or NULL if peer is not connected with 'shm:' address
+ */
+struct obus_shm *obus_socket_peer_shm(struct obus_socket_peer *peer);
+
+/**
+ * set broadcast log given to peers connected with 'shm:' address
+ *
+ * @param srv socket server object
+ * @param log broadcast log (not owned, NULL to disable)
+ */
+void obus_socket_server_set_shm_log(struct obus_socket_server *srv,
+				    struct obus_shm_log *log);
+
 /**
  * create a new socket client make a server connection attempt
  * once socket is connected, obus_socket_client_connected_cb_t is called
@@ -171,4 +190,21 @@ const char *obus_socket_client_name(struct obus_socket_client *client);
  */
 int obus_socket_client_fd(struct obus_socket_client *client);
 
+/**
+ * get client shared memory channel
+ *
+ * @param client socket client object
+ * @return channel or NULL if client is not connected with 'shm:' address
+ */
+struct obus_shm *obus_socket_client_shm(struct obus_socket_client *client);
+
+/**
+ * get server broadcast log received by client
+ *
+ * @param client socket client object
+ * @return log or NULL if server has none
+ */
+struct obus_shm_log *
+obus_socket_client_shm_log(struct obus_socket_client *client);
+
 #endif /* _OBUS_SOCKET_H_ */
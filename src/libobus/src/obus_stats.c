@@ -0,0 +1,298 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_stats.c
+ *
+ * @brief obus runtime counters
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "obus_header.h"
+
+/* stats object field uids are field index + 1 */
+#define OBUS_STATS_FIELD(_idx, _name, _type)				\
+	[_idx] = {							\
+		.uid = (_idx) + 1,					\
+		.name = #_name,						\
+		.offset = obus_offsetof(struct obus_stats_info, _name),	\
+		.role = OBUS_PROPERTY,					\
+		.type = _type,						\
+	}
+
+#define OBUS_STATS_HIST_FIELD(_idx, _name)				\
+	[_idx] = {							\
+		.uid = (_idx) + 1,					\
+		.name = #_name,						\
+		.offset = obus_offsetof(struct obus_stats_info, _name),	\
+		.role = OBUS_PROPERTY,					\
+		.type = OBUS_FIELD_U32 | OBUS_FIELD_ARRAY,		\
+		.nb_offset = obus_offsetof(struct obus_stats_info,	\
+					   n_ ## _name),		\
+	}
+
+static const struct obus_field_desc obus_stats_info_fields[] = {
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_N_PEERS, n_peers,
+			 OBUS_FIELD_U32),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_N_CONNECTIONS, n_connections,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_N_DISCONNECTIONS, n_disconnections,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_N_PENDING_CALLS, n_pending_calls,
+			 OBUS_FIELD_U32),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_TX_BYTES, tx_bytes,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_TX_PACKETS, tx_packets,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_RX_BYTES, rx_bytes,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_RX_PACKETS, rx_packets,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_ENCODE_SAMPLES, encode_samples,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_ENCODE_TIME, encode_time,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_ENCODE_MAX, encode_max,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_HIST_FIELD(OBUS_STATS_FIELD_ENCODE_HIST, encode_hist),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_DECODE_SAMPLES, decode_samples,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_DECODE_TIME, decode_time,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_FIELD(OBUS_STATS_FIELD_DECODE_MAX, decode_max,
+			 OBUS_FIELD_U64),
+	OBUS_STATS_HIST_FIELD(OBUS_STATS_FIELD_DECODE_HIST, decode_hist),
+};
+
+/* field index + 1 indexed by field uid */
+static const uint16_t obus_stats_info_uids[] = {
+	[OBUS_STATS_FIELD_N_PEERS + 1] = OBUS_STATS_FIELD_N_PEERS + 1,
+	[OBUS_STATS_FIELD_N_CONNECTIONS + 1] = OBUS_STATS_FIELD_N_CONNECTIONS + 1,
+	[OBUS_STATS_FIELD_N_DISCONNECTIONS + 1] = OBUS_STATS_FIELD_N_DISCONNECTIONS + 1,
+	[OBUS_STATS_FIELD_N_PENDING_CALLS + 1] = OBUS_STATS_FIELD_N_PENDING_CALLS + 1,
+	[OBUS_STATS_FIELD_TX_BYTES + 1] = OBUS_STATS_FIELD_TX_BYTES + 1,
+	[OBUS_STATS_FIELD_TX_PACKETS + 1] = OBUS_STATS_FIELD_TX_PACKETS + 1,
+	[OBUS_STATS_FIELD_RX_BYTES + 1] = OBUS_STATS_FIELD_RX_BYTES + 1,
+	[OBUS_STATS_FIELD_RX_PACKETS + 1] = OBUS_STATS_FIELD_RX_PACKETS + 1,
+	[OBUS_STATS_FIELD_ENCODE_SAMPLES + 1] = OBUS_STATS_FIELD_ENCODE_SAMPLES + 1,
+	[OBUS_STATS_FIELD_ENCODE_TIME + 1] = OBUS_STATS_FIELD_ENCODE_TIME + 1,
+	[OBUS_STATS_FIELD_ENCODE_MAX + 1] = OBUS_STATS_FIELD_ENCODE_MAX + 1,
+	[OBUS_STATS_FIELD_ENCODE_HIST + 1] = OBUS_STATS_FIELD_ENCODE_HIST + 1,
+	[OBUS_STATS_FIELD_DECODE_SAMPLES + 1] = OBUS_STATS_FIELD_DECODE_SAMPLES + 1,
+	[OBUS_STATS_FIELD_DECODE_TIME + 1] = OBUS_STATS_FIELD_DECODE_TIME + 1,
+	[OBUS_STATS_FIELD_DECODE_MAX + 1] = OBUS_STATS_FIELD_DECODE_MAX + 1,
+	[OBUS_STATS_FIELD_DECODE_HIST + 1] = OBUS_STATS_FIELD_DECODE_HIST + 1,
+};
+
+static const struct obus_struct_desc obus_stats_info_desc = {
+	.size = sizeof(struct obus_stats_info),
+	.fields_offset = obus_offsetof(struct obus_stats_info, fields),
+	.n_fields = OBUS_SIZEOF_ARRAY(obus_stats_info_fields),
+	.fields = obus_stats_info_fields,
+	.uids = obus_stats_info_uids,
+	.n_uids = OBUS_SIZEOF_ARRAY(obus_stats_info_uids),
+};
+
+#define OBUS_STATS_UPDATE(_idx) { .field = &obus_stats_info_fields[_idx] }
+
+/* 'updated' event updates all fields */
+static const struct obus_event_update_desc obus_stats_updates[] = {
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_N_PEERS),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_N_CONNECTIONS),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_N_DISCONNECTIONS),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_N_PENDING_CALLS),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_TX_BYTES),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_TX_PACKETS),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_RX_BYTES),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_RX_PACKETS),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_ENCODE_SAMPLES),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_ENCODE_TIME),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_ENCODE_MAX),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_ENCODE_HIST),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_DECODE_SAMPLES),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_DECODE_TIME),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_DECODE_MAX),
+	OBUS_STATS_UPDATE(OBUS_STATS_FIELD_DECODE_HIST),
+};
+
+const struct obus_event_desc obus_stats_updated_desc = {
+	.uid = 1,
+	.name = "updated",
+	.updates = obus_stats_updates,
+	.n_updates = OBUS_SIZEOF_ARRAY(obus_stats_updates),
+};
+
+const struct obus_object_desc obus_stats_desc = {
+	.uid = OBUS_STATS_UID,
+	.name = "obus_stats",
+	.info_desc = &obus_stats_info_desc,
+	.n_events = 1,
+	.events = &obus_stats_updated_desc,
+};
+
+void obus_time_hist_add(struct obus_time_hist *hist, uint64_t start)
+{
+	uint64_t ns, us;
+	uint32_t i;
+
+	if (start == 0)
+		return;
+
+	ns = obus_get_monotonic_ns() - start;
+	hist->n_samples++;
+	hist->total_ns += ns;
+	if (ns > hist->max_ns)
+		hist->max_ns = ns;
+
+	/* bucket i holds samples from 2^(i-1) us to 2^i us */
+	us = ns / 1000;
+	i = us ? (uint32_t)(64 - __builtin_clzll(us)) : 0;
+	if (i >= OBUS_TIME_HIST_SIZE)
+		i = OBUS_TIME_HIST_SIZE - 1;
+	hist->buckets[i]++;
+}
+
+void obus_traffic_add(struct obus_traffic_stats *to,
+		      const struct obus_traffic_stats *from)
+{
+	to->tx_bytes += from->tx_bytes;
+	to->tx_packets += from->tx_packets;
+	to->rx_bytes += from->rx_bytes;
+	to->rx_packets += from->rx_packets;
+}
+
+int obus_stats_bus_desc_init(struct obus_bus_desc *desc,
+			     const struct obus_bus_desc *from)
+{
+	const struct obus_object_desc **objects;
+	uint16_t i;
+
+	*desc = *from;
+	desc->objects = NULL;
+
+	/* generated bus already using stats uid is kept as is */
+	for (i = 0; i < from->n_objects; i++) {
+		if (from->objects[i]->uid == OBUS_STATS_UID) {
+			obus_warn("'%s' bus object '%s' uses stats uid, "
+				  "server stats can't be published",
+				  from->name, from->objects[i]->name);
+			desc->objects = from->objects;
+			return 0;
+		}
+	}
+
+	objects = calloc((size_t)from->n_objects + 1, sizeof(*objects));
+	if (!objects)
+		return -ENOMEM;
+
+	for (i = 0; i < from->n_objects; i++)
+		objects[i] = from->objects[i];
+
+	objects[i] = &obus_stats_desc;
+	desc->objects = objects;
+	desc->n_objects = (uint16_t)(from->n_objects + 1);
+	return 0;
+}
+
+void obus_stats_bus_desc_release(struct obus_bus_desc *desc)
+{
+	/* objects array is only allocated when stats type is appended */
+	if (desc->n_objects && desc->objects[desc->n_objects - 1] ==
+			       &obus_stats_desc)
+		free((void *)desc->objects);
+
+	desc->objects = NULL;
+	desc->n_objects = 0;
+}
+
+static void obus_stats_hist_set(const struct obus_time_hist *hist,
+				uint64_t *samples, uint64_t *time,
+				uint64_t *max, const uint32_t **buckets,
+				uint32_t *n_buckets)
+{
+	*samples = hist->n_samples;
+	*time = hist->total_ns;
+	*max = hist->max_ns;
+	*buckets = hist->buckets;
+	*n_buckets = OBUS_TIME_HIST_SIZE;
+}
+
+void obus_stats_info_set(struct obus_stats_info *info,
+			 const struct obus_server_stats *stats)
+{
+	memset(info, 0, sizeof(*info));
+	info->fields = (1U << OBUS_STATS_FIELD_COUNT) - 1;
+	info->n_peers = stats->n_peers;
+	info->n_connections = stats->n_connections;
+	info->n_disconnections = stats->n_disconnections;
+	info->n_pending_calls = stats->n_pending_calls;
+	info->tx_bytes = stats->traffic.tx_bytes;
+	info->tx_packets = stats->traffic.tx_packets;
+	info->rx_bytes = stats->traffic.rx_bytes;
+	info->rx_packets = stats->traffic.rx_packets;
+	obus_stats_hist_set(&stats->encode, &info->encode_samples,
+			    &info->encode_time, &info->encode_max,
+			    &info->encode_hist, &info->n_encode_hist);
+	obus_stats_hist_set(&stats->decode, &info->decode_samples,
+			    &info->decode_time, &info->decode_max,
+			    &info->decode_hist, &info->n_decode_hist);
+}
+
+static void obus_stats_hist_get(struct obus_time_hist *hist,
+				uint64_t samples, uint64_t time, uint64_t max,
+				const uint32_t *buckets, uint32_t n_buckets)
+{
+	hist->n_samples = samples;
+	hist->total_ns = time;
+	hist->max_ns = max;
+	if (n_buckets > OBUS_TIME_HIST_SIZE)
+		n_buckets = OBUS_TIME_HIST_SIZE;
+	if (buckets && n_buckets)
+		memcpy(hist->buckets, buckets, n_buckets * sizeof(*buckets));
+}
+
+void obus_stats_info_get(const struct obus_stats_info *info,
+			 struct obus_server_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats->n_peers = info->n_peers;
+	stats->n_connections = info->n_connections;
+	stats->n_disconnections = info->n_disconnections;
+	stats->n_pending_calls = info->n_pending_calls;
+	stats->traffic.tx_bytes = info->tx_bytes;
+	stats->traffic.tx_packets = info->tx_packets;
+	stats->traffic.rx_bytes = info->rx_bytes;
+	stats->traffic.rx_packets = info->rx_packets;
+	obus_stats_hist_get(&stats->encode, info->encode_samples,
+			    info->encode_time, info->encode_max,
+			    info->encode_hist, info->n_encode_hist);
+	obus_stats_hist_get(&stats->decode, info->decode_samples,
+			    info->decode_time, info->decode_max,
+			    info->decode_hist, info->n_decode_hist);
+}
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_stats.h
+ *
+ * @brief obus runtime counters
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _OBUS_STATS_H_
+#define _OBUS_STATS_H_
+
+/**
+ * runtime counters of a server or client.
+ *
+ * Traffic counters are plain integers updated by loop thread while
+ * packets are written and decoded, they are summed only when polled.
+ * Encoding and decoding times are measured only when timing is enabled,
+ * otherwise a measure costs a branch.
+ */
+struct obus_stats {
+	/* packets encoding and decoding times are measured */
+	int timing;
+	/* packets encoding time */
+	struct obus_time_hist encode;
+	/* received packets decoding time */
+	struct obus_time_hist decode;
+};
+
+/* builtin stats object fields, in fields presence bits order */
+enum obus_stats_field_type {
+	OBUS_STATS_FIELD_N_PEERS = 0,
+	OBUS_STATS_FIELD_N_CONNECTIONS,
+	OBUS_STATS_FIELD_N_DISCONNECTIONS,
+	OBUS_STATS_FIELD_N_PENDING_CALLS,
+	OBUS_STATS_FIELD_TX_BYTES,
+	OBUS_STATS_FIELD_TX_PACKETS,
+	OBUS_STATS_FIELD_RX_BYTES,
+	OBUS_STATS_FIELD_RX_PACKETS,
+	OBUS_STATS_FIELD_ENCODE_SAMPLES,
+	OBUS_STATS_FIELD_ENCODE_TIME,
+	OBUS_STATS_FIELD_ENCODE_MAX,
+	OBUS_STATS_FIELD_ENCODE_HIST,
+	OBUS_STATS_FIELD_DECODE_SAMPLES,
+	OBUS_STATS_FIELD_DECODE_TIME,
+	OBUS_STATS_FIELD_DECODE_MAX,
+	OBUS_STATS_FIELD_DECODE_HIST,
+	OBUS_STATS_FIELD_COUNT,
+};
+
+/* builtin stats object info, published server counters */
+struct obus_stats_info {
+	uint32_t fields;
+	uint32_t n_peers;
+	uint64_t n_connections;
+	uint64_t n_disconnections;
+	uint32_t n_pending_calls;
+	uint64_t tx_bytes;
+	uint64_t tx_packets;
+	uint64_t rx_bytes;
+	uint64_t rx_packets;
+	uint64_t encode_samples;
+	uint64_t encode_time;
+	uint64_t encode_max;
+	const uint32_t *encode_hist;
+	uint32_t n_encode_hist;
+	uint64_t decode_samples;
+	uint64_t decode_time;
+	uint64_t decode_max;
+	const uint32_t *decode_hist;
+	uint32_t n_decode_hist;
+};
+
+/* builtin stats object description, part of every bus */
+extern const struct obus_object_desc obus_stats_desc;
+
+/* builtin stats object 'updated' event description */
+extern const struct obus_event_desc obus_stats_updated_desc;
+
+/**
+ * get start time of a measure
+ * @param stats counters
+ * @return start time or 0 if timing is disabled
+ */
+static inline uint64_t obus_stats_start(const struct obus_stats *stats)
+{
+	return stats->timing ? obus_get_monotonic_ns() : 0;
+}
+
+/**
+ * add measure started at given time in histogram
+ * @param hist time histogram
+ * @param start measure start time (0 if not measured)
+ */
+void obus_time_hist_add(struct obus_time_hist *hist, uint64_t start);
+
+/**
+ * account a sent packet
+ * @param traffic traffic counters
+ * @param length packet length
+ */
+static inline void obus_traffic_tx(struct obus_traffic_stats *traffic,
+				   size_t length)
+{
+	traffic->tx_packets++;
+	traffic->tx_bytes += length;
+}
+
+/**
+ * add traffic counters to others
+ * @param to counters incremented
+ * @param from counters added
+ */
+void obus_traffic_add(struct obus_traffic_stats *to,
+		      const struct obus_traffic_stats *from);
+
+/**
+ * build bus description with builtin stats object type appended
+ * @param desc bus description filled
+ * @param from generated bus description
+ * @return 0 on success, description objects must be freed with
+ * obus_stats_bus_desc_release
+ */
+int obus_stats_bus_desc_init(struct obus_bus_desc *desc,
+			     const struct obus_bus_desc *from);
+
+/**
+ * release bus description built by obus_stats_bus_desc_init
+ * @param desc bus description
+ */
+void obus_stats_bus_desc_release(struct obus_bus_desc *desc);
+
+/**
+ * set stats object info from server counters
+ * @param info stats object info, arrays point into stats
+ * @param stats server counters
+ */
+void obus_stats_info_set(struct obus_stats_info *info,
+			 const struct obus_server_stats *stats);
+
+/**
+ * get server counters from stats object info
+ * @param info stats object info
+ * @param stats server counters filled
+ */
+void obus_stats_info_get(const struct obus_stats_info *info,
+			 struct obus_server_stats *stats);
+
+#endif /* _OBUS_STATS_H_ */
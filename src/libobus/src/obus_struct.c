@@ -122,7 +122,7 @@ int obus_struct_has_field(const struct obus_struct *st,
 		return 0;
 
 	/* check field bit in array */
-	return ((fields[idx / 32] & (uint32_t)(1 << (idx % 32))) != 0);
+	return ((fields[idx / 32] & (1u << (idx % 32))) != 0);
 }
 
 
@@ -140,7 +140,7 @@ int obus_struct_set_has_field(const struct obus_struct *st,
 		return -EINVAL;
 
 	/* set field bit in array */
-	fields[idx / 32] |= (uint32_t)(1 << (idx % 32));
+	fields[idx / 32] |= 1u << (idx % 32);
 	return 0;
 }
 
@@ -158,7 +158,7 @@ int obus_struct_clear_has_field(const struct obus_struct *st,
 		return -EINVAL;
 
 	/* clear field bit in array */
-	fields[idx / 32] &= ~(uint32_t)(1 << (idx % 32));
+	fields[idx / 32] &= ~(1u << (idx % 32));
 	return 0;
 }
 
@@ -185,7 +185,38 @@ int obus_struct_clear_has_fields(const struct obus_struct *st)
 	return ret;
 }
 
-int obus_struct_encode(const struct obus_struct *st, struct obus_buffer *buf)
+static int obus_struct_encode_generated(const struct obus_struct *st,
+					struct obus_buffer *buf)
+{
+	size_t size, length;
+	int ret;
+
+	/* compute encoded size and ensure buffer space once */
+	size = (*st->desc->encoded_size) (st);
+	ret = obus_buffer_ensure_write_space(buf, size);
+	if (ret < 0)
+		return ret;
+
+	/* encode struct in place */
+	length = (*st->desc->encode) (st, obus_buffer_write_ptr(buf));
+	if (length != size) {
+		obus_error("generated encoder size mismatch: %zu != %zu",
+			   length, size);
+		return -EINVAL;
+	}
+
+	obus_buffer_inc_write_ptr(buf, length);
+	return 0;
+}
+
+static inline int obus_struct_mask_has(const uint32_t *mask, uint32_t idx)
+{
+	return !mask || (mask[idx / 32] & (1u << (idx % 32))) != 0;
+}
+
+static int obus_struct_encode_fields(const struct obus_struct *st,
+				     struct obus_buffer *buf,
+				     const uint32_t *mask)
 {
 	int ret;
 	uint16_t i, n_fields;
@@ -193,32 +224,55 @@ int obus_struct_encode(const struct obus_struct *st, struct obus_buffer *buf)
 	/* count number of field set */
 	n_fields = 0;
 	for (i = 0; i < st->desc->n_fields; i++) {
-		if (obus_struct_has_field(st, &st->desc->fields[i]))
+		if (obus_struct_mask_has(mask, i) &&
+		    obus_struct_has_field(st, &st->desc->fields[i]))
 			n_fields++;
 	}
 
 	/* encode field numbers */
 	ret = obus_buffer_append_u16(buf, n_fields);
 	if (ret < 0)
-		goto error;
+		return ret;
 
 	/* encode fields */
 	for (i = 0; i < st->desc->n_fields; i++) {
-		if (obus_struct_has_field(st, &st->desc->fields[i])) {
+		if (obus_struct_mask_has(mask, i) &&
+		    obus_struct_has_field(st, &st->desc->fields[i])) {
 			ret = obus_field_encode(st, &st->desc->fields[i], buf);
 			if (ret < 0)
-				goto error;
+				return ret;
 		}
 	}
 
 	return 0;
+}
+
+int obus_struct_encode(const struct obus_struct *st, struct obus_buffer *buf)
+{
+	return obus_struct_encode_masked(st, buf, NULL);
+}
+
+/* encode only struct fields set in mask, a bitset indexed like struct
+ * fields (NULL for all fields) */
+int obus_struct_encode_masked(const struct obus_struct *st,
+			      struct obus_buffer *buf, const uint32_t *mask)
+{
+	int ret;
+
+	/* use generated encoder if any, it encodes all fields set */
+	if (st->desc->encoded_size && st->desc->encode && !mask)
+		ret = obus_struct_encode_generated(st, buf);
+	else
+		ret = obus_struct_encode_fields(st, buf, mask);
+
+	if (ret < 0)
+		obus_error("can't encode struct: error=%d", ret);
 
-error:
-	obus_error("can't encode struct: error=%d", ret);
 	return ret;
 }
 
-int obus_struct_decode(const struct obus_struct *st, struct obus_buffer *buf)
+static int obus_struct_decode_fields(const struct obus_struct *st,
+				     struct obus_buffer *buf, int borrow)
 {
 	const struct obus_field_desc *desc;
 	uint16_t i, n_fields;
@@ -237,7 +291,7 @@ int obus_struct_decode(const struct obus_struct *st, struct obus_buffer *buf)
 	/* decode fields */
 	for (i = 0; i < n_fields; i++) {
 		/* decode field */
-		desc = obus_field_decode(st, buf);
+		desc = obus_field_decode(st, buf, borrow);
 		/* mark field has decoded */
 		if (desc)
 			obus_struct_set_has_field(st, desc);
@@ -249,6 +303,31 @@ error:
 	return ret;
 }
 
+int obus_struct_decode(const struct obus_struct *st, struct obus_buffer *buf)
+{
+	return obus_struct_decode_fields(st, buf, 0);
+}
+
+int obus_struct_decode_view(const struct obus_struct *st,
+			    struct obus_buffer *buf)
+{
+	/* strings & arrays are borrowed from buffer when possible */
+	return obus_struct_decode_fields(st, buf, 1);
+}
+
+void obus_struct_release_view(const struct obus_struct *st,
+			      const void *start, const void *end)
+{
+	uint32_t i;
+
+	if (!st || !st->desc || !st->u.addr)
+		return;
+
+	/* forget fields values borrowed from [start, end) */
+	for (i = 0; i < st->desc->n_fields; i++)
+		obus_field_release_view(st, &st->desc->fields[i], start, end);
+}
+
 int obus_struct_copy(const struct obus_struct *dst,
 		     const struct obus_struct *src)
 {
@@ -306,10 +385,36 @@ int obus_struct_is_empty(const struct obus_struct *st)
 	return 1;
 }
 
+int obus_struct_is_masked_empty(const struct obus_struct *st,
+				const uint32_t *mask)
+{
+	uint32_t i;
+
+	for (i = 0; i < st->desc->n_fields; i++) {
+		if (obus_struct_mask_has(mask, i) &&
+		    obus_struct_has_field(st, &st->desc->fields[i]))
+			return 0;
+	}
+
+	return 1;
+}
+
 const struct obus_field_desc *
 obus_struct_get_field_desc(const struct obus_struct *st, uint16_t uid)
 {
+	const struct obus_struct_desc *desc = st->desc;
 	uint16_t i;
+
+	/* use generated uid lookup table if any */
+	if (desc->uids) {
+		if (uid >= desc->n_uids || desc->uids[uid] == 0 ||
+		    desc->uids[uid] > desc->n_fields)
+			return NULL;
+
+		return &desc->fields[desc->uids[uid] - 1];
+	}
+
+	/* old generated code, scan fields */
 	for (i = 0; i < st->desc->n_fields; i++) {
 		if (st->desc->fields[i].uid == uid)
 			return &st->desc->fields[i];
@@ -42,10 +42,22 @@ int obus_struct_init(const struct obus_struct *st);
 
 void obus_struct_destroy(const struct obus_struct *st);
 
+/* number of uint32 words of a struct fields bitset */
+#define OBUS_STRUCT_MASK_WORDS(n_fields) (((n_fields) + 31) / 32)
+
 int obus_struct_encode(const struct obus_struct *st, struct obus_buffer *buf);
 
+int obus_struct_encode_masked(const struct obus_struct *st,
+			      struct obus_buffer *buf, const uint32_t *mask);
+
 int obus_struct_decode(const struct obus_struct *st, struct obus_buffer *buf);
 
+int obus_struct_decode_view(const struct obus_struct *st,
+			    struct obus_buffer *buf);
+
+void obus_struct_release_view(const struct obus_struct *st,
+			      const void *start, const void *end);
+
 void obus_struct_log(const struct obus_struct *st, enum obus_log_level level);
 
 int obus_struct_has_field(const struct obus_struct *st,
@@ -68,6 +80,9 @@ int obus_struct_merge(const struct obus_struct *dst,
 
 int obus_struct_is_empty(const struct obus_struct *st);
 
+int obus_struct_is_masked_empty(const struct obus_struct *st,
+				const uint32_t *mask);
+
 const struct obus_field_desc *
 obus_struct_get_field_desc(const struct obus_struct *st, uint16_t uid);
 
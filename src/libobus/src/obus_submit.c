@@ -0,0 +1,222 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_submit.c
+ *
+ * @brief obus loop thread submission queue
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "obus_header.h"
+
+/* maximum number of nodes drained per loop iteration */
+#define OBUS_SUBMIT_BATCH 256
+
+/* obus submission queue */
+struct obus_submit {
+	struct obus_fd ofd;
+	struct obus_loop *loop;
+	struct obus_submit_node *head;	/* pushed nodes, last pushed first */
+	struct obus_submit_node *pending;	/* taken nodes not drained yet */
+	obus_submit_cb_t cb;
+	void *data;
+};
+
+static void obus_submit_signal(struct obus_submit *submit)
+{
+	uint64_t u = 1;
+	ssize_t ret;
+
+	do {
+		ret = write(submit->ofd.fd, &u, sizeof(u));
+	} while (ret < 0 && errno == EINTR);
+
+	/* EAGAIN means counter is already non zero, loop will wake up */
+	if (ret < 0 && errno != EAGAIN)
+		obus_log_fd_errno("eventfd_write", submit->ofd.fd);
+}
+
+static struct obus_submit_node *obus_submit_collect(struct obus_submit *submit)
+{
+	struct obus_submit_node *node, *next, *first = NULL;
+
+	/* detach whole stack, pushes done from now wake loop up again */
+	node = __atomic_exchange_n(&submit->head, NULL, __ATOMIC_ACQUIRE);
+
+	/* reverse it to get nodes in push order */
+	while (node) {
+		next = node->next;
+		node->next = first;
+		first = node;
+		node = next;
+	}
+
+	return first;
+}
+
+struct obus_submit_node *obus_submit_take(struct obus_submit *submit)
+{
+	struct obus_submit_node *first, *last;
+
+	first = submit->pending;
+	submit->pending = NULL;
+	if (!first)
+		return obus_submit_collect(submit);
+
+	/* append newly pushed nodes to not yet drained ones */
+	for (last = first; last->next; last = last->next)
+		;
+	last->next = obus_submit_collect(submit);
+	return first;
+}
+
+static void obus_submit_events(struct obus_fd *ofd, int events, void *data)
+{
+	struct obus_submit *submit = data;
+	struct obus_submit_node *first, *last;
+	uint64_t u;
+	ssize_t ret;
+	int n;
+
+	if (obus_fd_event_error(events)) {
+		obus_loop_remove(submit->loop, &submit->ofd);
+		return;
+	}
+
+	if (!obus_fd_event_read(events))
+		return;
+
+	/* clear eventfd counter before taking nodes so that no wake up is
+	 * lost for nodes pushed meanwhile */
+	do {
+		ret = read(submit->ofd.fd, &u, sizeof(u));
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0 && errno != EAGAIN) {
+		obus_log_fd_errno("eventfd_read", submit->ofd.fd);
+		return;
+	}
+
+	/* take new nodes once previous ones are all drained */
+	if (!submit->pending)
+		submit->pending = obus_submit_collect(submit);
+
+	first = submit->pending;
+	if (!first)
+		return;
+
+	/* cut batch, wake up again to drain remaining nodes after other
+	 * loop sources have been processed. nodes pushed since eventfd has
+	 * been read did not signal it as queue was not empty */
+	for (last = first, n = 1; n < OBUS_SUBMIT_BATCH && last->next; n++)
+		last = last->next;
+
+	submit->pending = last->next;
+	last->next = NULL;
+	if (submit->pending ||
+	    __atomic_load_n(&submit->head, __ATOMIC_RELAXED))
+		obus_submit_signal(submit);
+
+	(*submit->cb) (first, submit->data);
+}
+
+struct obus_submit *obus_submit_new(struct obus_loop *loop,
+				    obus_submit_cb_t cb, void *data)
+{
+	struct obus_submit *submit;
+	int efd, ret;
+
+	if (!loop || !cb)
+		return NULL;
+
+	submit = calloc(1, sizeof(*submit));
+	if (!submit)
+		return NULL;
+
+	submit->cb = cb;
+	submit->data = data;
+	submit->loop = obus_loop_ref(loop);
+
+	efd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (efd < 0) {
+		obus_log_errno("eventfd");
+		goto unref_loop;
+	}
+
+	/* add eventfd in loop */
+	obus_fd_init(&submit->ofd, efd, OBUS_FD_IN, &obus_submit_events,
+		     submit);
+	ret = obus_loop_add(loop, &submit->ofd);
+	if (ret < 0)
+		goto close_efd;
+
+	return submit;
+
+close_efd:
+	close(efd);
+unref_loop:
+	obus_loop_unref(loop);
+	free(submit);
+	return NULL;
+}
+
+void obus_submit_destroy(struct obus_submit *submit)
+{
+	if (!submit)
+		return;
+
+	obus_loop_remove(submit->loop, &submit->ofd);
+	if (close(submit->ofd.fd) < 0)
+		obus_log_fd_errno("eventfd_close", submit->ofd.fd);
+
+	obus_loop_unref(submit->loop);
+	free(submit);
+}
+
+int obus_submit_push(struct obus_submit *submit, struct obus_submit_node *node)
+{
+	struct obus_submit_node *head;
+
+	if (!submit || !node)
+		return -EINVAL;
+
+	head = __atomic_load_n(&submit->head, __ATOMIC_RELAXED);
+	do {
+		node->next = head;
+	} while (!__atomic_compare_exchange_n(&submit->head, &head, node, 1,
+					      __ATOMIC_RELEASE,
+					      __ATOMIC_RELAXED));
+
+	/* only first node pushed on an empty queue has to wake loop up */
+	if (!head)
+		obus_submit_signal(submit);
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_submit.h
+ *
+ * @brief obus loop thread submission queue
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _OBUS_SUBMIT_H_
+#define _OBUS_SUBMIT_H_
+
+/**
+ * multiple producers single consumer submission queue.
+ *
+ * Any thread may push nodes without lock, the loop thread is woken up
+ * through an eventfd when the queue becomes non empty and drains pending
+ * nodes in push order, by batches to let other loop sources be processed.
+ */
+struct obus_submit;
+
+/* submission node, embedded in submitted item */
+struct obus_submit_node {
+	struct obus_submit_node *next;
+};
+
+/**
+ * submission queue drain callback, invoked in loop thread
+ * @param node first node of drained batch, next ones are linked in push
+ * order up to a NULL next
+ * @param data user data pointer given back
+ */
+typedef void (*obus_submit_cb_t) (struct obus_submit_node *node, void *data);
+
+/**
+ * create a new submission queue
+ * @param loop file descriptor events loop
+ * @param cb drain callback
+ * @param data user data
+ * @return submission queue or NULL on error
+ */
+struct obus_submit *obus_submit_new(struct obus_loop *loop,
+				    obus_submit_cb_t cb, void *data);
+
+/**
+ * destroy submission queue, pending nodes must have been taken before
+ * @param submit submission queue
+ */
+void obus_submit_destroy(struct obus_submit *submit);
+
+/**
+ * push node in submission queue, may be called from any thread
+ * @param submit submission queue
+ * @param node node to be pushed
+ * @return 0 on success
+ */
+int obus_submit_push(struct obus_submit *submit, struct obus_submit_node *node);
+
+/**
+ * take all not yet drained nodes without invoking drain callback
+ * @param submit submission queue
+ * @return first pending node in push order or NULL if empty
+ */
+struct obus_submit_node *obus_submit_take(struct obus_submit *submit);
+
+#endif /* _OBUS_SUBMIT_H_ */
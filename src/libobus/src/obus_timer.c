@@ -36,70 +36,268 @@
 
 #include "obus_header.h"
 
-#ifdef HAVE_SYS_TIMERFD_H
-
 #define MSEC_PER_SEC	1000L
-#define USEC_PER_MSEC	1000L
-#define NSEC_PER_USEC	1000L
 #define NSEC_PER_MSEC	1000000L
-#define USEC_PER_SEC	1000000L
-#define NSEC_PER_SEC	1000000000L
 
 #ifndef CLOCK_MONOTONIC
 #define CLOCK_MONOTONIC 1
 #endif
 
+/* timing wheel: levels of 64 slots, level n slots cover 64^n ticks */
+#define OBUS_TIMER_WHEEL_BITS 6
+#define OBUS_TIMER_WHEEL_SIZE (1 << OBUS_TIMER_WHEEL_BITS)
+#define OBUS_TIMER_WHEEL_MASK (OBUS_TIMER_WHEEL_SIZE - 1)
+#define OBUS_TIMER_WHEEL_LEVELS 5
+
+/* shift of level slots index in ticks */
+#define OBUS_TIMER_WHEEL_SHIFT(level) ((level) * OBUS_TIMER_WHEEL_BITS)
+
+/* max delay covered by wheel, longer timers are cascaded again */
+#define OBUS_TIMER_WHEEL_MAX_DELAY \
+	((1ULL << OBUS_TIMER_WHEEL_SHIFT(OBUS_TIMER_WHEEL_LEVELS)) - 1)
+
+/* loop timers */
+struct obus_timer_wheel {
+	struct obus_node slots[OBUS_TIMER_WHEEL_LEVELS][OBUS_TIMER_WHEEL_SIZE];
+	uint32_t n_armed[OBUS_TIMER_WHEEL_LEVELS];	/* timers per level */
+	uint64_t cur;			/* next tick to process */
+	uint64_t next;			/* tick clock is armed for (0 none) */
+	struct obus_timer_clock *clock;
+	struct obus_loop *loop;
+	size_t ref;			/* number of timers */
+};
+
 /* obus timer */
 struct obus_timer {
-	struct obus_fd ofd;
+	struct obus_node node;		/* node in wheel slot */
+	struct obus_timer_wheel *wheel;
 	struct obus_loop *loop;
+	uint64_t expires;		/* expiration tick */
+	int level;			/* wheel level, -1 if not armed */
 	int timeout;
 	obus_timer_cb_t cb;
 	void *data;
 };
 
-static int obus_timer_read(struct obus_timer *timer, uint64_t *val)
+static void obus_timer_wheel_add(struct obus_timer_wheel *wheel,
+				 struct obus_timer *timer)
 {
-	uint64_t u;
-	ssize_t ret;
+	uint64_t delay, expires;
+	int level, idx;
 
-	do {
-		ret = read(timer->ofd.fd, &u, sizeof(u));
-	} while (ret < 0 && errno == EINTR);
+	/* expired timers are run on next processed tick */
+	expires = timer->expires < wheel->cur ? wheel->cur : timer->expires;
+	delay = expires - wheel->cur;
+	if (delay > OBUS_TIMER_WHEEL_MAX_DELAY) {
+		delay = OBUS_TIMER_WHEEL_MAX_DELAY;
+		expires = wheel->cur + delay;
+	}
 
-	if (ret < 0) {
-		obus_log_fd_errno("timerfd_read", timer->ofd.fd);
-		ret = -errno;
-	} else if (val) {
-		*val = u;
-		ret = 0;
+	for (level = 0; level < OBUS_TIMER_WHEEL_LEVELS - 1; level++) {
+		if (delay < (1ULL << OBUS_TIMER_WHEEL_SHIFT(level + 1)))
+			break;
 	}
 
-	return (int)ret;
+	idx = (int)((expires >> OBUS_TIMER_WHEEL_SHIFT(level)) &
+		    OBUS_TIMER_WHEEL_MASK);
+	obus_list_add_before(&wheel->slots[level][idx], &timer->node);
+	wheel->n_armed[level]++;
+	timer->level = level;
 }
 
-static void obus_timer_events(struct obus_fd *ofd, int events, void *data)
+static void obus_timer_wheel_del(struct obus_timer_wheel *wheel,
+				 struct obus_timer *timer)
 {
-	struct obus_timer *timer = (struct obus_timer *)data;
-	int ret;
-	uint64_t nbexpired = 0;
+	if (timer->level < 0)
+		return;
 
-	/* is it possible for a timer fd ? */
-	if (obus_fd_event_error(events)) {
-		/* remove source from loop */
-		obus_loop_remove(timer->loop, &timer->ofd);
+	obus_list_del(&timer->node);
+	wheel->n_armed[timer->level]--;
+	timer->level = -1;
+}
+
+static int obus_timer_wheel_is_empty(const struct obus_timer_wheel *wheel)
+{
+	int level;
+
+	for (level = 0; level < OBUS_TIMER_WHEEL_LEVELS; level++) {
+		if (wheel->n_armed[level])
+			return 0;
 	}
 
-	if (!obus_fd_event_read(events))
+	return 1;
+}
+
+/* get tick of next timer expiration or cascade, 0 if no timer armed */
+static uint64_t obus_timer_wheel_next(const struct obus_timer_wheel *wheel)
+{
+	uint64_t base, tick, next = 0;
+	int level, shift, first, k, idx;
+
+	for (level = 0; level < OBUS_TIMER_WHEEL_LEVELS; level++) {
+		if (!wheel->n_armed[level])
+			continue;
+
+		/* current slot has already been cascaded unless current
+		 * tick starts it, timers found there then expire one
+		 * rotation later */
+		shift = OBUS_TIMER_WHEEL_SHIFT(level);
+		base = wheel->cur >> shift;
+		first = (wheel->cur & ((1ULL << shift) - 1)) ? 1 : 0;
+		for (k = first; k < first + OBUS_TIMER_WHEEL_SIZE; k++) {
+			idx = (int)((base + k) & OBUS_TIMER_WHEEL_MASK);
+			if (obus_list_is_empty(&wheel->slots[level][idx]))
+				continue;
+
+			tick = (base + k) << shift;
+			if (!next || tick < next)
+				next = tick;
+			break;
+		}
+	}
+
+	return next;
+}
+
+/* arm clock for next expiration if earlier than current one */
+static void obus_timer_wheel_arm(struct obus_timer_wheel *wheel,
+				 uint64_t tick)
+{
+	if (!tick || (wheel->next && wheel->next <= tick))
 		return;
 
-	/* read timer value */
-	ret = obus_timer_read(timer, &nbexpired);
-	if (ret < 0)
+	if (obus_timer_clock_set(wheel->clock, tick) == 0)
+		wheel->next = tick;
+}
+
+/* move timers of upper level slot to lower levels */
+static int obus_timer_wheel_cascade(struct obus_timer_wheel *wheel,
+				    int level)
+{
+	struct obus_timer *timer, *tmp;
+	struct obus_node list;
+	int idx;
+
+	idx = (int)((wheel->cur >> OBUS_TIMER_WHEEL_SHIFT(level)) &
+		    OBUS_TIMER_WHEEL_MASK);
+
+	obus_list_init(&list);
+	obus_list_walk_entry_forward_safe(&wheel->slots[level][idx], timer,
+					  tmp, node) {
+		obus_timer_wheel_del(wheel, timer);
+		obus_list_add_before(&list, &timer->node);
+	}
+
+	obus_list_walk_entry_forward_safe(&list, timer, tmp, node) {
+		obus_list_del(&timer->node);
+		obus_timer_wheel_add(wheel, timer);
+	}
+
+	return idx;
+}
+
+/* run timers expired up to given tick */
+static void obus_timer_wheel_run(struct obus_timer_wheel *wheel,
+				 uint64_t now)
+{
+	struct obus_timer *timer;
+	struct obus_node *slot;
+	uint64_t nbexpired, end;
+	int level;
+
+	while (wheel->cur <= now) {
+		if (obus_timer_wheel_is_empty(wheel)) {
+			wheel->cur = now + 1;
+			break;
+		}
+
+		/* cascade upper levels each time lower level wraps */
+		for (level = 1; level < OBUS_TIMER_WHEEL_LEVELS; level++) {
+			if (wheel->cur & ((1ULL <<
+			     OBUS_TIMER_WHEEL_SHIFT(level)) - 1))
+				break;
+			if (obus_timer_wheel_cascade(wheel, level) != 0)
+				break;
+		}
+
+		/* run timers of current tick, they may be cleared, set or
+		 * destroyed from any callback. Timers set meanwhile expire
+		 * after current tick so they are never added to its slot */
+		slot = &wheel->slots[0][wheel->cur & OBUS_TIMER_WHEEL_MASK];
+		while (!obus_list_is_empty(slot)) {
+			timer = obus_list_entry(obus_list_first(slot),
+						struct obus_timer, node);
+			obus_timer_wheel_del(wheel, timer);
+			timer->timeout = 0;
+			nbexpired = 1;
+			(*timer->cb) (timer, &nbexpired, timer->data);
+		}
+
+		wheel->cur++;
+
+		/* skip ticks up to next cascade if lower level is empty */
+		if (!wheel->n_armed[0] && (wheel->cur & OBUS_TIMER_WHEEL_MASK)) {
+			end = (wheel->cur | OBUS_TIMER_WHEEL_MASK) + 1;
+			wheel->cur = end < now + 1 ? end : now + 1;
+		}
+	}
+}
+
+static void obus_timer_wheel_unref(struct obus_timer_wheel *wheel)
+{
+	if (--wheel->ref > 0)
 		return;
 
-	/* invoke timer callback */
-	(*timer->cb) (timer, &nbexpired, timer->data);
+	obus_loop_set_timers(wheel->loop, NULL);
+	obus_timer_clock_destroy(wheel->clock);
+	free(wheel);
+}
+
+static void obus_timer_wheel_expired(void *data)
+{
+	struct obus_timer_wheel *wheel = data;
+
+	/* keep wheel while timers callbacks destroy their timer */
+	wheel->ref++;
+	wheel->next = 0;
+	obus_timer_wheel_run(wheel, obus_get_monotonic_ms());
+	obus_timer_wheel_arm(wheel, obus_timer_wheel_next(wheel));
+	obus_timer_wheel_unref(wheel);
+}
+
+/* get loop timers wheel, created with first timer of loop */
+static struct obus_timer_wheel *obus_timer_wheel_get(struct obus_loop *loop)
+{
+	struct obus_timer_wheel *wheel;
+	int level, idx;
+
+	wheel = obus_loop_get_timers(loop);
+	if (wheel) {
+		wheel->ref++;
+		return wheel;
+	}
+
+	wheel = calloc(1, sizeof(*wheel));
+	if (!wheel)
+		return NULL;
+
+	for (level = 0; level < OBUS_TIMER_WHEEL_LEVELS; level++) {
+		for (idx = 0; idx < OBUS_TIMER_WHEEL_SIZE; idx++)
+			obus_list_init(&wheel->slots[level][idx]);
+	}
+
+	wheel->clock = obus_timer_clock_new(loop, &obus_timer_wheel_expired,
+					    wheel);
+	if (!wheel->clock) {
+		free(wheel);
+		return NULL;
+	}
+
+	wheel->cur = obus_get_monotonic_ms();
+	wheel->loop = loop;
+	wheel->ref = 1;
+	obus_loop_set_timers(loop, wheel);
+	return wheel;
 }
 
 /* create timer */
@@ -107,7 +305,6 @@ struct obus_timer *obus_timer_new(struct obus_loop *loop, obus_timer_cb_t cb,
 				  void *data)
 {
 	struct obus_timer *timer;
-	int tfd, ret;
 
 	if (!loop || !cb)
 		return NULL;
@@ -116,77 +313,179 @@ struct obus_timer *obus_timer_new(struct obus_loop *loop, obus_timer_cb_t cb,
 	if (!timer)
 		return NULL;
 
+	timer->wheel = obus_timer_wheel_get(loop);
+	if (!timer->wheel) {
+		free(timer);
+		return NULL;
+	}
+
 	timer->cb = cb;
 	timer->data = data;
 	timer->timeout = 0;
+	timer->level = -1;
 	timer->loop = obus_loop_ref(loop);
+	return timer;
+}
+
+int obus_timer_destroy(struct obus_timer *timer)
+{
+	if (!timer)
+		return -EINVAL;
+
+	obus_timer_wheel_del(timer->wheel, timer);
+	obus_timer_wheel_unref(timer->wheel);
+	obus_loop_unref(timer->loop);
+	free(timer);
+	return 0;
+}
+
+int obus_timer_set(struct obus_timer *timer, int timeout)
+{
+	struct obus_timer_wheel *wheel;
+
+	if (!timer)
+		return -EINVAL;
+
+	/* rearming is O(1), clock is only set for an earlier expiration,
+	 * a cleared timer may only wake loop up uselessly once */
+	wheel = timer->wheel;
+	obus_timer_wheel_del(wheel, timer);
+	timer->timeout = timeout > 0 ? timeout : 0;
+	if (timeout <= 0)
+		return 0;
+
+	/* do not run ticks before timer arming */
+	if (obus_timer_wheel_is_empty(wheel))
+		wheel->cur = obus_get_monotonic_ms();
+
+	timer->expires = obus_get_monotonic_ms() + (uint64_t)timeout;
+	obus_timer_wheel_add(wheel, timer);
+	obus_timer_wheel_arm(wheel, timer->expires);
+	return 0;
+}
+
+int obus_timer_clear(struct obus_timer *timer)
+{
+	return obus_timer_set(timer, 0);
+}
+
+#ifdef HAVE_SYS_TIMERFD_H
+
+/* timerfd based loop timers clock */
+struct obus_timer_clock {
+	struct obus_fd ofd;
+	struct obus_loop *loop;
+	obus_timer_clock_cb_t cb;
+	void *data;
+};
+
+static int obus_timer_clock_read(struct obus_timer_clock *clock)
+{
+	uint64_t u;
+	ssize_t ret;
+
+	do {
+		ret = read(clock->ofd.fd, &u, sizeof(u));
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0) {
+		/* clock rearmed before being read */
+		if (errno == EAGAIN)
+			return -EAGAIN;
+
+		obus_log_fd_errno("timerfd_read", clock->ofd.fd);
+		return -errno;
+	}
+
+	return 0;
+}
+
+static void obus_timer_clock_events(struct obus_fd *ofd, int events,
+				    void *data)
+{
+	struct obus_timer_clock *clock = data;
+
+	/* is it possible for a timer fd ? */
+	if (obus_fd_event_error(events)) {
+		/* remove source from loop */
+		obus_loop_remove(clock->loop, &clock->ofd);
+	}
+
+	if (!obus_fd_event_read(events))
+		return;
+
+	if (obus_timer_clock_read(clock) < 0)
+		return;
+
+	(*clock->cb) (clock->data);
+}
+
+struct obus_timer_clock *obus_timer_clock_new(struct obus_loop *loop,
+					      obus_timer_clock_cb_t cb,
+					      void *data)
+{
+	struct obus_timer_clock *clock;
+	int tfd, ret;
+
+	clock = calloc(1, sizeof(*clock));
+	if (!clock)
+		return NULL;
+
+	clock->cb = cb;
+	clock->data = data;
+	clock->loop = loop;
 
 	/* create timerfd with CLOCK_MONOTONIC clock*/
 	tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
 	if (tfd == -1) {
 		obus_log_errno("timerfd_create");
-		goto unref_loop;
+		goto free_clock;
 	}
 
 	/* add fd timer object in loop */
-	obus_fd_init(&timer->ofd, tfd, OBUS_FD_IN, &obus_timer_events, timer);
-	ret = obus_loop_add(loop, &timer->ofd);
+	obus_fd_init(&clock->ofd, tfd, OBUS_FD_IN, &obus_timer_clock_events,
+		     clock);
+	ret = obus_loop_add(loop, &clock->ofd);
 	if (ret < 0)
 		goto close_tfd;
 
-	return timer;
+	return clock;
 
 close_tfd:
 	close(tfd);
-unref_loop:
-	obus_loop_unref(loop);
-	free(timer);
+free_clock:
+	free(clock);
 	return NULL;
 }
 
-int obus_timer_destroy(struct obus_timer *timer)
+void obus_timer_clock_destroy(struct obus_timer_clock *clock)
 {
-	int ret;
-	obus_loop_remove(timer->loop, &timer->ofd);
-	ret = close(timer->ofd.fd);
-	if (ret < 0)
-		obus_log_fd_errno("timerfd_close", timer->ofd.fd);
+	if (!clock)
+		return;
 
-	obus_loop_unref(timer->loop);
-	free(timer);
-	return 0;
+	obus_loop_remove(clock->loop, &clock->ofd);
+	if (close(clock->ofd.fd) < 0)
+		obus_log_fd_errno("timerfd_close", clock->ofd.fd);
+
+	free(clock);
 }
 
-int obus_timer_set(struct obus_timer *timer, int timeout)
+int obus_timer_clock_set(struct obus_timer_clock *clock, uint64_t expires)
 {
-	int ret = 0;
-	struct itimerspec nval, oval;
-
-	/* configure one shot */
-	nval.it_interval.tv_sec = 0;
-	nval.it_interval.tv_nsec = 0;
+	struct itimerspec nval;
+	int ret;
 
-	if (timeout > 0) {
-		nval.it_value.tv_sec = timeout / MSEC_PER_SEC;
-		nval.it_value.tv_nsec = (timeout % MSEC_PER_SEC)*NSEC_PER_MSEC;
-	} else {
-		/* clear timer */
-		nval.it_value.tv_sec = 0;
-		nval.it_value.tv_nsec = 0;
-	}
-	ret = timerfd_settime(timer->ofd.fd, 0, &nval, &oval);
+	/* configure absolute one shot */
+	memset(&nval, 0, sizeof(nval));
+	nval.it_value.tv_sec = (time_t)(expires / MSEC_PER_SEC);
+	nval.it_value.tv_nsec = (long)(expires % MSEC_PER_SEC) * NSEC_PER_MSEC;
+	ret = timerfd_settime(clock->ofd.fd, TFD_TIMER_ABSTIME, &nval, NULL);
 	if (ret == -1) {
 		ret = -errno;
-		obus_log_fd_errno("timerfd_settime", timer->ofd.fd);
-	} else {
-		timer->timeout = timeout;
+		obus_log_fd_errno("timerfd_settime", clock->ofd.fd);
 	}
-	return ret;
-}
 
-int obus_timer_clear(struct obus_timer *timer)
-{
-	return obus_timer_set(timer, 0);
+	return ret;
 }
 
 #endif /* HAVE_SYS_TIMERFD_H */
@@ -38,7 +38,11 @@
 #define _OBUS_TIMER_H_
 
 /**
- * obus timer object
+ * obus timer object.
+ *
+ * timers of a loop are kept in a hierarchical timing wheel with one
+ * millisecond tick, woken up by a single kernel clock per loop, so arming
+ * and clearing a timer are O(1) and do not use any file descriptor.
  */
 struct obus_timer;
 
@@ -85,4 +89,41 @@ int obus_timer_set(struct obus_timer *timer, int timeout);
  */
 int obus_timer_clear(struct obus_timer *timer);
 
+/**
+ * loop timers kernel clock, timerfd based in obus_timer.c or posix timer
+ * based in obus_timer_posix.c
+ */
+struct obus_timer_clock;
+
+/**
+ * clock callback
+ * @param data user data pointer given back
+ */
+typedef void (*obus_timer_clock_cb_t) (void *data);
+
+/**
+ * create loop timers clock
+ * @param loop file descriptor events loop
+ * @param cb clock expiration callback
+ * @param data user data
+ * @return clock or NULL on error
+ */
+struct obus_timer_clock *obus_timer_clock_new(struct obus_loop *loop,
+					      obus_timer_clock_cb_t cb,
+					      void *data);
+
+/**
+ * destroy loop timers clock
+ * @param clock clock
+ */
+void obus_timer_clock_destroy(struct obus_timer_clock *clock);
+
+/**
+ * arm clock
+ * @param clock clock
+ * @param expires absolute monotonic time in milliseconds, 0 to disarm
+ * @return 0 on success
+ */
+int obus_timer_clock_set(struct obus_timer_clock *clock, uint64_t expires);
+
 #endif /*_OBUS_TIMER_H_*/
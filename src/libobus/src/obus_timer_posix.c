@@ -39,20 +39,15 @@
 #ifndef HAVE_SYS_TIMERFD_H
 
 #define MSEC_PER_SEC	1000L
-#define USEC_PER_MSEC	1000L
-#define NSEC_PER_USEC	1000L
 #define NSEC_PER_MSEC	1000000L
-#define USEC_PER_SEC	1000000L
-#define NSEC_PER_SEC	1000000000L
 
 #define OBUS_SIGALARM SIGRTMIN
 
-/* obus timer */
-struct obus_timer {
+/* posix timer based loop timers clock */
+struct obus_timer_clock {
 	struct obus_fd ofd;
 	struct obus_loop *loop;
-	int timeout;
-	obus_timer_cb_t cb;
+	obus_timer_clock_cb_t cb;
 	void *data;
 	int pipefd[2];
 	timer_t timerid;
@@ -61,31 +56,31 @@ struct obus_timer {
 static void obus_timer_sighandler(int signum, siginfo_t *si, void *unused)
 {
 	ssize_t ret;
-	struct obus_timer *timer;
+	struct obus_timer_clock *clock;
 	uint8_t dummy = 0;
 
-	/* extract timer from siginfo */
-	timer = si->si_value.sival_ptr;
-	if (timer) {
+	/* extract clock from siginfo */
+	clock = si->si_value.sival_ptr;
+	if (clock) {
 		/* write in pipe to notify loop */
 		do {
-			ret = write(timer->pipefd[1], &dummy, sizeof(dummy));
+			ret = write(clock->pipefd[1], &dummy, sizeof(dummy));
 		} while (ret < 0 && errno == EINTR);
 	}
 }
 
-static int obus_timer_read(struct obus_timer *timer)
+static int obus_timer_clock_read(struct obus_timer_clock *clock)
 {
 	uint8_t u;
 	ssize_t ret;
 
 	/* Read the pipe */
 	do {
-		ret = read(timer->pipefd[0], &u, sizeof(u));
+		ret = read(clock->pipefd[0], &u, sizeof(u));
 	} while (ret < 0 && errno == EINTR);
 
 	if (ret < 0) {
-		obus_log_fd_errno("timer_read", timer->pipefd[0]);
+		obus_log_fd_errno("timer_read", clock->pipefd[0]);
 		ret = -errno;
 	} else {
 		ret = 0;
@@ -94,59 +89,51 @@ static int obus_timer_read(struct obus_timer *timer)
 	return (int)ret;
 }
 
-static void obus_timer_events(struct obus_fd *ofd, int events, void *data)
+static void obus_timer_clock_events(struct obus_fd *ofd, int events,
+				    void *data)
 {
-	struct obus_timer *timer = (struct obus_timer *)data;
-	int ret;
-	uint64_t nbexpired = 0;
+	struct obus_timer_clock *clock = data;
 
 	if (obus_fd_event_error(events)) {
 		/* remove source from loop */
-		obus_loop_remove(timer->loop, &timer->ofd);
+		obus_loop_remove(clock->loop, &clock->ofd);
 	}
 
 	if (!obus_fd_event_read(events))
 		return;
 
-	/* read timer value (force nbexpired to 1) */
-	nbexpired = 1;
-	ret = obus_timer_read(timer);
-	if (ret < 0)
+	if (obus_timer_clock_read(clock) < 0)
 		return;
 
-	/* invoke timer callback */
-	(*timer->cb) (timer, &nbexpired, timer->data);
+	(*clock->cb) (clock->data);
 }
 
-struct obus_timer *obus_timer_new(struct obus_loop *loop, obus_timer_cb_t cb,
-				  void *data)
+struct obus_timer_clock *obus_timer_clock_new(struct obus_loop *loop,
+					      obus_timer_clock_cb_t cb,
+					      void *data)
 {
-	struct obus_timer *timer;
+	struct obus_timer_clock *clock;
 	struct sigevent sev;
 	struct sigaction sa;
 	int ret;
 
-	if (!loop || !cb)
-		return NULL;
-
-	timer = calloc(1, sizeof(*timer));
-	if (!timer)
+	clock = calloc(1, sizeof(*clock));
+	if (!clock)
 		return NULL;
 
-	timer->cb = cb;
-	timer->data = data;
-	timer->timeout = 0;
-	timer->loop = obus_loop_ref(loop);
+	clock->cb = cb;
+	clock->data = data;
+	clock->loop = loop;
 
 	/* create timer with CLOCK_MONOTONIC clock*/
 	memset(&sev, 0, sizeof(sev));
 	sev.sigev_notify = SIGEV_SIGNAL;
 	sev.sigev_signo = OBUS_SIGALARM;
-	sev.sigev_value.sival_ptr = timer;
-	ret = timer_create(CLOCK_MONOTONIC, &sev, &timer->timerid);
+	sev.sigev_value.sival_ptr = clock;
+	ret = timer_create(CLOCK_MONOTONIC, &sev, &clock->timerid);
 	if (ret < 0) {
 		obus_log_errno("timer_create");
-		goto unref_loop;
+		goto free_clock;
 	}
 
 	/* setup signal handler */
@@ -160,92 +147,75 @@ struct obus_timer *obus_timer_new(struct obus_loop *loop, obus_timer_cb_t cb,
 	}
 
 	/* create pipe for notification */
-	ret = pipe(timer->pipefd);
+	ret = pipe(clock->pipefd);
 	if (ret < 0) {
 		obus_log_errno("pipe");
 		goto close_timer;
 	}
 
 	/* setup pipe fds flags */
-	ret = obus_fd_set_close_on_exec(timer->pipefd[0]);
+	ret = obus_fd_set_close_on_exec(clock->pipefd[0]);
 	if (ret < 0)
 		goto close_pipe;
-	ret = obus_fd_set_close_on_exec(timer->pipefd[1]);
+	ret = obus_fd_set_close_on_exec(clock->pipefd[1]);
 	if (ret < 0)
 		goto close_pipe;
-	ret = obus_fd_add_flags(timer->pipefd[0], O_NONBLOCK);
+	ret = obus_fd_add_flags(clock->pipefd[0], O_NONBLOCK);
 	if (ret < 0)
 		goto close_pipe;
-	ret = obus_fd_add_flags(timer->pipefd[1], O_NONBLOCK);
+	ret = obus_fd_add_flags(clock->pipefd[1], O_NONBLOCK);
 	if (ret < 0)
 		goto close_pipe;
 
 	/* add pipe input fd object in loop */
-	obus_fd_init(&timer->ofd, timer->pipefd[0], OBUS_FD_IN,
-		     &obus_timer_events, timer);
-	ret = obus_loop_add(loop, &timer->ofd);
+	obus_fd_init(&clock->ofd, clock->pipefd[0], OBUS_FD_IN,
+		     &obus_timer_clock_events, clock);
+	ret = obus_loop_add(loop, &clock->ofd);
 	if (ret < 0)
 		goto close_pipe;
 
-	return timer;
+	return clock;
 
 close_pipe:
-	close(timer->pipefd[0]);
-	close(timer->pipefd[1]);
+	close(clock->pipefd[0]);
+	close(clock->pipefd[1]);
 close_timer:
-	timer_delete(timer->timerid);
-unref_loop:
-	obus_loop_unref(loop);
-	free(timer);
+	timer_delete(clock->timerid);
+free_clock:
+	free(clock);
 	return NULL;
 }
 
-int obus_timer_destroy(struct obus_timer *timer)
+void obus_timer_clock_destroy(struct obus_timer_clock *clock)
 {
-	if (!timer)
-		return -EINVAL;
+	if (!clock)
+		return;
 
-	obus_loop_remove(timer->loop, &timer->ofd);
-	close(timer->pipefd[0]);
-	close(timer->pipefd[1]);
+	obus_loop_remove(clock->loop, &clock->ofd);
+	close(clock->pipefd[0]);
+	close(clock->pipefd[1]);
 	/* FIXME: The treatment  of  any  pending signal generated by the
 	 * deleted timer is unspecified */
-	timer_delete(timer->timerid);
-	obus_loop_unref(timer->loop);
-	free(timer);
-	return 0;
+	timer_delete(clock->timerid);
+	free(clock);
 }
 
-int obus_timer_set(struct obus_timer *timer, int timeout)
+int obus_timer_clock_set(struct obus_timer_clock *clock, uint64_t expires)
 {
-	int ret = 0;
-	struct itimerspec nval, oval;
-
-	/* configure one shot */
-	nval.it_interval.tv_sec = 0;
-	nval.it_interval.tv_nsec = 0;
+	struct itimerspec nval;
+	int ret;
 
-	if (timeout > 0) {
-		nval.it_value.tv_sec = timeout / MSEC_PER_SEC;
-		nval.it_value.tv_nsec = (timeout % MSEC_PER_SEC)*NSEC_PER_MSEC;
-	} else {
-		/* clear timer */
-		nval.it_value.tv_sec = 0;
-		nval.it_value.tv_nsec = 0;
-	}
-	ret = timer_settime(timer->timerid, 0, &nval, &oval);
+	/* configure absolute one shot */
+	memset(&nval, 0, sizeof(nval));
+	nval.it_value.tv_sec = (time_t)(expires / MSEC_PER_SEC);
+	nval.it_value.tv_nsec = (long)(expires % MSEC_PER_SEC) * NSEC_PER_MSEC;
+	ret = timer_settime(clock->timerid, TIMER_ABSTIME, &nval, NULL);
 	if (ret == -1) {
 		ret = -errno;
-		obus_log_fd_errno("timerfd_settime", timer->ofd.fd);
-	} else {
-		timer->timeout = timeout;
+		obus_log_errno("timer_settime");
 	}
-	return ret;
-}
 
-int obus_timer_clear(struct obus_timer *timer)
-{
-	return obus_timer_set(timer, 0);
+	return ret;
 }
 
 #endif /* !HAVE_SYS_TIMERFD_H */
@@ -0,0 +1,498 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_uring.c
+ *
+ * @brief obus io_uring write batching
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "obus_header.h"
+
+#ifdef HAVE_IO_URING
+
+/* number of submission queue entries */
+#define OBUS_URING_ENTRIES 256
+
+/* loop io_uring */
+struct obus_uring {
+	struct obus_fd ofd;		/* completions eventfd */
+	struct obus_loop *loop;
+	int fd;				/* ring fd */
+	/* submission queue */
+	unsigned int *sq_head;
+	unsigned int *sq_tail;
+	unsigned int *sq_array;
+	unsigned int sq_mask;
+	unsigned int sq_entries;
+	struct io_uring_sqe *sqes;
+	/* completion queue */
+	unsigned int *cq_head;
+	unsigned int *cq_tail;
+	unsigned int cq_mask;
+	unsigned int cq_entries;
+	struct io_uring_cqe *cqes;
+	/* rings mappings */
+	void *sq_ptr;
+	size_t sq_size;
+	void *cq_ptr;
+	size_t cq_size;
+	size_t sqes_size;
+	struct obus_node queued;	/* operations waiting submission */
+	struct obus_node done;		/* reaped operations */
+	unsigned int n_inflight;	/* sqes not completed yet */
+	size_t ref;
+};
+
+/* set once io_uring has been found not usable */
+static int obus_uring_disabled;
+
+static int obus_uring_setup(unsigned int entries, struct io_uring_params *p)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int obus_uring_enter(struct obus_uring *ring, unsigned int to_submit,
+			    unsigned int min_complete, unsigned int flags)
+{
+	int ret;
+
+	ret = (int)syscall(__NR_io_uring_enter, ring->fd, to_submit,
+			   min_complete, flags, NULL, 0);
+	return ret < 0 ? -errno : ret;
+}
+
+static void obus_uring_unmap(struct obus_uring *ring)
+{
+	if (ring->sqes)
+		munmap(ring->sqes, ring->sqes_size);
+
+	if (ring->cq_ptr && ring->cq_ptr != ring->sq_ptr)
+		munmap(ring->cq_ptr, ring->cq_size);
+
+	if (ring->sq_ptr)
+		munmap(ring->sq_ptr, ring->sq_size);
+}
+
+static void *obus_uring_mmap(struct obus_uring *ring, size_t size,
+			     off_t offset)
+{
+	void *ptr;
+
+	ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_POPULATE, ring->fd, offset);
+	if (ptr == MAP_FAILED) {
+		obus_log_fd_errno("mmap", ring->fd);
+		return NULL;
+	}
+
+	return ptr;
+}
+
+static int obus_uring_map(struct obus_uring *ring,
+			  const struct io_uring_params *p)
+{
+	uint8_t *sq, *cq;
+
+	ring->sq_size = p->sq_off.array + p->sq_entries * sizeof(unsigned int);
+	ring->cq_size = p->cq_off.cqes +
+			p->cq_entries * sizeof(struct io_uring_cqe);
+
+	/* both rings may share a single mapping */
+	if ((p->features & IORING_FEAT_SINGLE_MMAP) &&
+	    ring->cq_size > ring->sq_size)
+		ring->sq_size = ring->cq_size;
+
+	ring->sq_ptr = obus_uring_mmap(ring, ring->sq_size, IORING_OFF_SQ_RING);
+	if (!ring->sq_ptr)
+		return -ENOMEM;
+
+	if (p->features & IORING_FEAT_SINGLE_MMAP)
+		ring->cq_ptr = ring->sq_ptr;
+	else
+		ring->cq_ptr = obus_uring_mmap(ring, ring->cq_size,
+					       IORING_OFF_CQ_RING);
+	if (!ring->cq_ptr)
+		return -ENOMEM;
+
+	ring->sqes_size = p->sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = obus_uring_mmap(ring, ring->sqes_size, IORING_OFF_SQES);
+	if (!ring->sqes)
+		return -ENOMEM;
+
+	sq = ring->sq_ptr;
+	ring->sq_head = (unsigned int *)(sq + p->sq_off.head);
+	ring->sq_tail = (unsigned int *)(sq + p->sq_off.tail);
+	ring->sq_array = (unsigned int *)(sq + p->sq_off.array);
+	ring->sq_mask = *(unsigned int *)(sq + p->sq_off.ring_mask);
+	ring->sq_entries = p->sq_entries;
+
+	cq = ring->cq_ptr;
+	ring->cq_head = (unsigned int *)(cq + p->cq_off.head);
+	ring->cq_tail = (unsigned int *)(cq + p->cq_off.tail);
+	ring->cq_mask = *(unsigned int *)(cq + p->cq_off.ring_mask);
+	ring->cq_entries = p->cq_entries;
+	ring->cqes = (struct io_uring_cqe *)(cq + p->cq_off.cqes);
+	return 0;
+}
+
+/* get a free submission entry, NULL if submission queue is full */
+static struct io_uring_sqe *obus_uring_get_sqe(struct obus_uring *ring)
+{
+	struct io_uring_sqe *sqe;
+	unsigned int head, tail;
+
+	head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+	tail = *ring->sq_tail;
+	if (tail - head >= ring->sq_entries)
+		return NULL;
+
+	sqe = &ring->sqes[tail & ring->sq_mask];
+	memset(sqe, 0, sizeof(*sqe));
+	ring->sq_array[tail & ring->sq_mask] = tail & ring->sq_mask;
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	ring->n_inflight++;
+	return sqe;
+}
+
+/* number of submission entries not consumed by kernel yet */
+static unsigned int obus_uring_sq_pending(struct obus_uring *ring)
+{
+	return *ring->sq_tail - __atomic_load_n(ring->sq_head,
+						__ATOMIC_ACQUIRE);
+}
+
+/* move completed operations in done list, callbacks are not invoked */
+static void obus_uring_reap(struct obus_uring *ring)
+{
+	struct io_uring_cqe *cqe;
+	struct obus_uring_op *op;
+	unsigned int head, tail;
+
+	head = *ring->cq_head;
+	tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+	while (head != tail) {
+		cqe = &ring->cqes[head & ring->cq_mask];
+		op = (struct obus_uring_op *)(uintptr_t)cqe->user_data;
+
+		/* cancel requests have no operation */
+		if (op) {
+			op->res = cqe->res;
+			op->state = OBUS_URING_OP_DONE;
+			obus_list_add_before(&ring->done, &op->node);
+		}
+
+		ring->n_inflight--;
+		head++;
+	}
+
+	__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+void obus_uring_submit(struct obus_uring *ring)
+{
+	struct io_uring_sqe *sqe;
+	struct obus_uring_op *op;
+	int ret;
+
+	if (!ring)
+		return;
+
+	do {
+		/* completion queue can not overflow, it is sized to hold all
+		 * submitted entries */
+		while (!obus_list_is_empty(&ring->queued) &&
+		       ring->n_inflight < ring->cq_entries) {
+			op = obus_list_entry(obus_list_first(&ring->queued),
+					     struct obus_uring_op, node);
+
+			/* buffers queued so far are written by operation */
+			op->iovcnt = (*op->prep) (op, op->data);
+			if (op->iovcnt <= 0) {
+				obus_list_del(&op->node);
+				op->state = OBUS_URING_OP_IDLE;
+				continue;
+			}
+
+			sqe = obus_uring_get_sqe(ring);
+			if (!sqe)
+				break;
+
+			obus_list_del(&op->node);
+			sqe->opcode = IORING_OP_WRITEV;
+			sqe->fd = op->fd;
+			sqe->addr = (uint64_t)(uintptr_t)op->iov;
+			sqe->len = (uint32_t)op->iovcnt;
+			sqe->user_data = (uint64_t)(uintptr_t)op;
+			op->state = OBUS_URING_OP_SUBMITTED;
+		}
+
+		if (obus_uring_sq_pending(ring) == 0)
+			return;
+
+		/* one syscall for whole batch */
+		do {
+			ret = obus_uring_enter(ring,
+					       obus_uring_sq_pending(ring),
+					       0, 0);
+		} while (ret == -EINTR);
+
+		if (ret < 0) {
+			/* entries are kept and submitted next time */
+			if (ret != -EAGAIN && ret != -EBUSY)
+				obus_error("io_uring_enter(fd=%d) error=%d(%s)",
+					   ring->fd, -ret, strerror(-ret));
+			return;
+		}
+	} while (!obus_list_is_empty(&ring->queued) &&
+		 ring->n_inflight < ring->cq_entries);
+}
+
+void obus_uring_queue(struct obus_uring *ring, struct obus_uring_op *op)
+{
+	if (!ring || !op || op->state != OBUS_URING_OP_IDLE)
+		return;
+
+	op->state = OBUS_URING_OP_QUEUED;
+	obus_list_add_before(&ring->queued, &op->node);
+
+	/* loop submits operations queued by its callbacks at once */
+	if (!obus_loop_is_dispatching(ring->loop))
+		obus_uring_submit(ring);
+}
+
+int obus_uring_cancel(struct obus_uring *ring, struct obus_uring_op *op)
+{
+	struct io_uring_sqe *sqe;
+	int ret;
+
+	if (!ring || !op)
+		return -EINVAL;
+
+	switch (op->state) {
+	case OBUS_URING_OP_QUEUED:
+		obus_list_del(&op->node);
+		op->state = OBUS_URING_OP_IDLE;
+		return -ECANCELED;
+	case OBUS_URING_OP_SUBMITTED:
+	break;
+	case OBUS_URING_OP_DONE:
+		obus_list_del(&op->node);
+		op->state = OBUS_URING_OP_IDLE;
+		return op->res;
+	case OBUS_URING_OP_IDLE:
+	default:
+		return -ECANCELED;
+	}
+
+	/* ask kernel to cancel operation, it may complete meanwhile.
+	 * submission queue is emptied by each submit so an entry is left */
+	sqe = obus_uring_get_sqe(ring);
+	if (sqe) {
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->addr = (uint64_t)(uintptr_t)op;
+	}
+
+	/* wait operation completion, other completions are kept in done
+	 * list until ring eventfd is processed */
+	while (op->state == OBUS_URING_OP_SUBMITTED) {
+		ret = obus_uring_enter(ring, obus_uring_sq_pending(ring), 1,
+				       IORING_ENTER_GETEVENTS);
+		if (ret < 0 && ret != -EINTR && ret != -EAGAIN &&
+		    ret != -EBUSY) {
+			obus_critical("io_uring_enter(fd=%d) error=%d(%s)",
+				      ring->fd, -ret, strerror(-ret));
+			break;
+		}
+
+		obus_uring_reap(ring);
+	}
+
+	if (op->state == OBUS_URING_OP_DONE)
+		obus_list_del(&op->node);
+
+	op->state = OBUS_URING_OP_IDLE;
+	return op->res;
+}
+
+static void obus_uring_events(struct obus_fd *ofd, int events, void *data)
+{
+	struct obus_uring *ring = data;
+	struct obus_uring_op *op;
+	uint64_t u;
+	ssize_t ret;
+
+	if (obus_fd_event_error(events)) {
+		obus_loop_remove(ring->loop, &ring->ofd);
+		return;
+	}
+
+	/* clear eventfd counter before reaping so that no completion is
+	 * missed */
+	do {
+		ret = read(ring->ofd.fd, &u, sizeof(u));
+	} while (ret < 0 && errno == EINTR);
+
+	if (ret < 0 && errno != EAGAIN)
+		obus_log_fd_errno("eventfd_read", ring->ofd.fd);
+
+	/* ring may be released in operation callbacks */
+	ring->ref++;
+	obus_uring_reap(ring);
+	while (!obus_list_is_empty(&ring->done)) {
+		op = obus_list_entry(obus_list_first(&ring->done),
+				     struct obus_uring_op, node);
+		obus_list_del(&op->node);
+		op->state = OBUS_URING_OP_IDLE;
+		(*op->done) (op, op->res, op->data);
+	}
+
+	obus_uring_put(ring);
+}
+
+static void obus_uring_destroy(struct obus_uring *ring)
+{
+	obus_loop_set_uring(ring->loop, NULL);
+	if (obus_fd_is_used(&ring->ofd))
+		obus_loop_remove(ring->loop, &ring->ofd);
+
+	if (ring->ofd.fd >= 0)
+		close(ring->ofd.fd);
+
+	obus_uring_unmap(ring);
+	close(ring->fd);
+	obus_loop_unref(ring->loop);
+	free(ring);
+}
+
+static struct obus_uring *obus_uring_new(struct obus_loop *loop)
+{
+	struct io_uring_params p;
+	struct obus_uring *ring;
+	int ret, efd;
+
+	ring = calloc(1, sizeof(*ring));
+	if (!ring)
+		return NULL;
+
+	memset(&p, 0, sizeof(p));
+	ring->fd = obus_uring_setup(OBUS_URING_ENTRIES, &p);
+	if (ring->fd < 0) {
+		/* kernel without io_uring or forbidden by seccomp */
+		obus_info("io_uring not available error=%d(%s), using writev",
+			  errno, strerror(errno));
+		goto disable;
+	}
+
+	/* writes to a full socket must wait in kernel without io thread */
+	if (!(p.features & IORING_FEAT_FAST_POLL) ||
+	    !(p.features & IORING_FEAT_NODROP)) {
+		obus_info("io_uring features 0x%x not supported, using writev",
+			  p.features);
+		close(ring->fd);
+		goto disable;
+	}
+
+	ring->loop = obus_loop_ref(loop);
+	ring->ref = 1;
+	obus_list_init(&ring->queued);
+	obus_list_init(&ring->done);
+	obus_fd_init(&ring->ofd, -1, OBUS_FD_IN, &obus_uring_events, ring);
+	ret = obus_uring_map(ring, &p);
+	if (ret < 0)
+		goto error;
+
+	/* completions wake loop up through an eventfd */
+	efd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (efd < 0) {
+		obus_log_errno("eventfd");
+		goto error;
+	}
+
+	ring->ofd.fd = efd;
+	ret = (int)syscall(__NR_io_uring_register, ring->fd,
+			   IORING_REGISTER_EVENTFD, &efd, 1);
+	if (ret < 0) {
+		obus_log_fd_errno("io_uring_register", ring->fd);
+		goto error;
+	}
+
+	ret = obus_loop_add(loop, &ring->ofd);
+	if (ret < 0)
+		goto error;
+
+	obus_loop_set_uring(loop, ring);
+	return ring;
+
+error:
+	obus_uring_destroy(ring);
+	return NULL;
+
+disable:
+	__atomic_store_n(&obus_uring_disabled, 1, __ATOMIC_RELAXED);
+	free(ring);
+	return NULL;
+}
+
+struct obus_uring *obus_uring_get(struct obus_loop *loop)
+{
+	struct obus_uring *ring;
+
+	if (!loop)
+		return NULL;
+
+	ring = obus_loop_get_uring(loop);
+	if (ring) {
+		ring->ref++;
+		return ring;
+	}
+
+	if (__atomic_load_n(&obus_uring_disabled, __ATOMIC_RELAXED))
+		return NULL;
+
+	if (obus_check_env("OBUS_IO_URING", "0")) {
+		__atomic_store_n(&obus_uring_disabled, 1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+
+	return obus_uring_new(loop);
+}
+
+void obus_uring_put(struct obus_uring *ring)
+{
+	if (!ring)
+		return;
+
+	ring->ref--;
+	if (ring->ref == 0)
+		obus_uring_destroy(ring);
+}
+
+#endif /* HAVE_IO_URING */
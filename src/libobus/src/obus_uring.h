@@ -0,0 +1,183 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_uring.h
+ *
+ * @brief obus io_uring write batching
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _OBUS_URING_H_
+#define _OBUS_URING_H_
+
+/**
+ * io_uring writes batching.
+ *
+ * A ring is shared by all ios of a loop. Writes queued while loop
+ * dispatches events are submitted with a single io_uring_enter once
+ * dispatch is done, their completions are reaped when ring eventfd
+ * registered in loop becomes readable. Writes queued outside of loop
+ * dispatch are submitted immediately.
+ */
+struct obus_uring;
+
+/* ring operation */
+struct obus_uring_op;
+
+/**
+ * operation prepare callback, invoked just before operation is given
+ * to kernel to set its iovecs (buffers queued until then are written)
+ * @param op ring operation
+ * @param data user data
+ * @return number of iovecs set, 0 to drop operation
+ */
+typedef int (*obus_uring_prep_cb_t) (struct obus_uring_op *op, void *data);
+
+/**
+ * operation completion callback, invoked from loop
+ * @param op ring operation, idle again
+ * @param res number of bytes written or negative errno
+ * @param data user data
+ */
+typedef void (*obus_uring_done_cb_t) (struct obus_uring_op *op, int res,
+				      void *data);
+
+/* ring operation state */
+enum obus_uring_op_state {
+	OBUS_URING_OP_IDLE,
+	OBUS_URING_OP_QUEUED,		/* waiting to be submitted */
+	OBUS_URING_OP_SUBMITTED,	/* owned by kernel */
+	OBUS_URING_OP_DONE,		/* reaped, callback not invoked yet */
+};
+
+/* ring writev operation, embedded in owner */
+struct obus_uring_op {
+	struct obus_node node;
+	enum obus_uring_op_state state;
+	int fd;
+	const struct iovec *iov;
+	int iovcnt;
+	int res;
+	obus_uring_prep_cb_t prep;
+	obus_uring_done_cb_t done;
+	void *data;
+};
+
+/* init writev operation on fd */
+static inline
+void obus_uring_op_init(struct obus_uring_op *op, int fd,
+			obus_uring_prep_cb_t prep, obus_uring_done_cb_t done,
+			void *data)
+{
+	memset(op, 0, sizeof(*op));
+	op->state = OBUS_URING_OP_IDLE;
+	op->fd = fd;
+	op->prep = prep;
+	op->done = done;
+	op->data = data;
+}
+
+/* check if operation is given to ring */
+static inline
+int obus_uring_op_is_busy(const struct obus_uring_op *op)
+{
+	return op->state != OBUS_URING_OP_IDLE;
+}
+
+#ifdef HAVE_IO_URING
+
+/**
+ * get a reference on loop ring, ring is created with first reference
+ * @param loop file descriptor events loop
+ * @return ring or NULL if io_uring is not available or disabled with
+ * OBUS_IO_URING=0 environment variable
+ */
+struct obus_uring *obus_uring_get(struct obus_loop *loop);
+
+/**
+ * release ring reference, ring is destroyed with last one
+ * @param ring ring
+ */
+void obus_uring_put(struct obus_uring *ring);
+
+/**
+ * queue idle operation for next submission
+ * @param ring ring
+ * @param op operation
+ */
+void obus_uring_queue(struct obus_uring *ring, struct obus_uring_op *op);
+
+/**
+ * cancel operation and wait for it, completion callback is not invoked
+ * @param ring ring
+ * @param op operation, idle on return
+ * @return number of bytes written before cancel or negative errno
+ */
+int obus_uring_cancel(struct obus_uring *ring, struct obus_uring_op *op);
+
+/**
+ * submit queued operations, invoked by loop once events are dispatched
+ * @param ring ring or NULL
+ */
+void obus_uring_submit(struct obus_uring *ring);
+
+#else /* !HAVE_IO_URING */
+
+static inline
+struct obus_uring *obus_uring_get(struct obus_loop *loop)
+{
+	return NULL;
+}
+
+static inline
+void obus_uring_put(struct obus_uring *ring)
+{
+}
+
+static inline
+void obus_uring_queue(struct obus_uring *ring, struct obus_uring_op *op)
+{
+}
+
+static inline
+int obus_uring_cancel(struct obus_uring *ring, struct obus_uring_op *op)
+{
+	op->state = OBUS_URING_OP_IDLE;
+	return -ECANCELED;
+}
+
+static inline
+void obus_uring_submit(struct obus_uring *ring)
+{
+}
+
+#endif /* !HAVE_IO_URING */
+
+#endif /* _OBUS_URING_H_ */
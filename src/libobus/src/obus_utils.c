@@ -194,6 +194,28 @@ obus_handle_t obus_rand_handle(void)
 	return r.handle;
 }
 
+/* get monotonic time in milliseconds */
+uint64_t obus_get_monotonic_ms(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+		return 0;
+
+	return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/* get monotonic time in nanoseconds */
+uint64_t obus_get_monotonic_ns(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+		return 0;
+
+	return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
 /* get log flags from env */
 static int obus_bus_has_flag(const char *flag, const char *bus_name)
 {
@@ -61,6 +61,12 @@ int obus_check_env(const char *key, const char *value);
 /* get random handle */
 obus_handle_t obus_rand_handle(void);
 
+/* get monotonic time in milliseconds */
+uint64_t obus_get_monotonic_ms(void);
+
+/* get monotonic time in nanoseconds */
+uint64_t obus_get_monotonic_ns(void);
+
 enum obus_log_flags {
 	OBUS_LOG_BUS = (1 << 0),
 	OBUS_LOG_IO = (1 << 1),
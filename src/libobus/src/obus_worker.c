@@ -0,0 +1,493 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_worker.c
+ *
+ * @brief obus peers writer threads
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#include "obus_header.h"
+
+/* max number of cached free messages */
+#define OBUS_WORKER_MSG_CACHE 1024
+
+/* worker message operation */
+enum obus_worker_op {
+	OBUS_WORKER_ATTACH = 0,
+	OBUS_WORKER_WRITE,
+	OBUS_WORKER_DETACH,
+	OBUS_WORKER_STOP,
+};
+
+/* message sent to worker thread, given back once processed */
+struct obus_worker_msg {
+	struct obus_submit_node node;	/* node in inbox or done queue */
+	struct obus_node io_node;	/* node in io queued writes */
+	enum obus_worker_op op;
+	struct obus_worker_io *wio;
+	struct obus_buffer *buf;
+	enum obus_io_status status;
+	int blocked;			/* io has queued buffers */
+};
+
+struct obus_worker_io {
+	struct obus_worker *worker;
+	char *name;
+	int fd;
+	int log_io;
+	/* worker thread side */
+	struct obus_io *io;		/* NULL if not attached or failed */
+	struct obus_node queued;	/* messages of queued writes */
+	struct obus_node cork_node;	/* node in worker corked ios */
+	int corked;
+	/* server loop thread side */
+	struct obus_worker_msg *detach;	/* preallocated detach message */
+	size_t n_pending;
+	size_t pending_bytes;
+	int closing;			/* io destroyed by server */
+	int failed;			/* write error notified */
+	int blocked;			/* io blocked at last completion */
+	obus_io_write_cb_t write_cb;
+	obus_worker_io_closed_cb_t closed_cb;
+	void *user_data;
+};
+
+struct obus_worker {
+	pthread_t thread;
+	struct obus_loop *loop;		/* worker thread loop */
+	struct obus_submit *inbox;	/* messages to worker thread */
+	struct obus_submit *done;	/* messages back to server loop */
+	struct obus_slab *msgs;		/* messages allocator */
+	struct obus_node corked;	/* ios corked during inbox batch */
+	size_t n_ios;
+	int stopped;
+};
+
+static void obus_worker_reply(struct obus_worker *worker,
+			      struct obus_worker_msg *msg,
+			      enum obus_io_status status)
+{
+	msg->status = status;
+	msg->blocked = msg->wio && msg->wio->io &&
+		       obus_io_get_pending_count(msg->wio->io) > 0;
+	obus_submit_push(worker->done, &msg->node);
+}
+
+/* release io in worker thread, queued writes are aborted */
+static void obus_worker_io_release(struct obus_worker_io *wio)
+{
+	struct obus_worker_msg *msg, *tmp;
+
+	if (wio->corked) {
+		obus_list_del(&wio->cork_node);
+		wio->corked = 0;
+	}
+
+	obus_io_destroy(wio->io);
+	wio->io = NULL;
+
+	obus_list_walk_entry_forward_safe(&wio->queued, msg, tmp, io_node) {
+		obus_list_del(&msg->io_node);
+		obus_worker_reply(wio->worker, msg, OBUS_IO_ABORT);
+	}
+}
+
+static void obus_worker_io_write_done(enum obus_io_status status,
+				      struct obus_buffer *buf,
+				      void *user_data)
+{
+	struct obus_worker_io *wio = user_data;
+	struct obus_worker_msg *msg;
+
+	/* queued messages are aborted once io is released */
+	if (status == OBUS_IO_ABORT || obus_list_is_empty(&wio->queued))
+		return;
+
+	/* buffers are completed in write order */
+	msg = obus_list_entry(obus_list_first(&wio->queued),
+			      struct obus_worker_msg, io_node);
+	obus_list_del(&msg->io_node);
+	obus_worker_reply(wio->worker, msg, status);
+
+	/* fd is not used anymore on error, server destroys io */
+	if (status != OBUS_IO_OK)
+		obus_worker_io_release(wio);
+}
+
+static void obus_worker_attach(struct obus_worker *worker,
+			       struct obus_worker_msg *msg)
+{
+	struct obus_worker_io *wio = msg->wio;
+
+	wio->io = obus_io_new(worker->loop, wio->name, wio->fd,
+			      &obus_worker_io_write_done, NULL, wio);
+	if (!wio->io) {
+		obus_error("can't create worker io");
+		obus_worker_reply(worker, msg, OBUS_IO_ERROR);
+		return;
+	}
+
+	obus_io_log_traffic(wio->io, wio->log_io);
+	obus_worker_reply(worker, msg, OBUS_IO_OK);
+}
+
+static void obus_worker_write(struct obus_worker *worker,
+			      struct obus_worker_msg *msg)
+{
+	struct obus_worker_io *wio = msg->wio;
+	int ret;
+
+	if (!wio->io) {
+		obus_worker_reply(worker, msg, OBUS_IO_ABORT);
+		return;
+	}
+
+	/* buffers of same batch are written with as few writev as
+	 * possible once batch is processed */
+	if (!wio->corked) {
+		obus_io_set_cork(wio->io, 1);
+		obus_list_add_before(&worker->corked, &wio->cork_node);
+		wio->corked = 1;
+	}
+
+	ret = obus_io_write(wio->io, msg->buf);
+	if (ret == -EAGAIN) {
+		obus_list_add_before(&wio->queued, &msg->io_node);
+	} else if (ret == 0) {
+		obus_worker_reply(worker, msg, OBUS_IO_OK);
+	} else {
+		obus_worker_reply(worker, msg, OBUS_IO_ERROR);
+		obus_worker_io_release(wio);
+	}
+}
+
+/* worker thread inbox, messages are processed in push order */
+static void obus_worker_inbox(struct obus_submit_node *node, void *data)
+{
+	struct obus_worker *worker = data;
+	struct obus_worker_io *wio, *tmp;
+	struct obus_worker_msg *msg;
+
+	while (node) {
+		msg = obus_container_of(node, struct obus_worker_msg, node);
+		node = node->next;
+
+		switch (msg->op) {
+		case OBUS_WORKER_ATTACH:
+			obus_worker_attach(worker, msg);
+		break;
+		case OBUS_WORKER_WRITE:
+			obus_worker_write(worker, msg);
+		break;
+		case OBUS_WORKER_DETACH:
+			obus_worker_io_release(msg->wio);
+			obus_worker_reply(worker, msg, OBUS_IO_OK);
+		break;
+		case OBUS_WORKER_STOP:
+		default:
+			worker->stopped = 1;
+			obus_worker_reply(worker, msg, OBUS_IO_OK);
+		break;
+		}
+	}
+
+	/* write batch, io may be released on error */
+	obus_list_walk_entry_forward_safe(&worker->corked, wio, tmp,
+					  cork_node) {
+		obus_list_del(&wio->cork_node);
+		wio->corked = 0;
+		obus_io_set_cork(wio->io, 0);
+	}
+}
+
+static void *obus_worker_run(void *data)
+{
+	struct obus_worker *worker = data;
+
+	while (!worker->stopped)
+		obus_loop_wait(worker->loop);
+
+	return NULL;
+}
+
+/* notify server of io write status */
+static void obus_worker_io_complete(struct obus_worker_io *wio,
+				    enum obus_io_status status,
+				    struct obus_buffer *buf)
+{
+	/* nothing is notified once io is destroyed or failed */
+	if (wio->closing || wio->failed)
+		return;
+
+	if (status != OBUS_IO_OK)
+		wio->failed = 1;
+
+	(*wio->write_cb) (status, buf, wio->user_data);
+}
+
+/* server loop, messages given back by worker thread */
+static void obus_worker_done(struct obus_submit_node *node, void *data)
+{
+	struct obus_worker *worker = data;
+	struct obus_worker_msg *msg;
+	struct obus_worker_io *wio;
+
+	while (node) {
+		msg = obus_container_of(node, struct obus_worker_msg, node);
+		node = node->next;
+		wio = msg->wio;
+
+		switch (msg->op) {
+		case OBUS_WORKER_ATTACH:
+			if (msg->status != OBUS_IO_OK)
+				obus_worker_io_complete(wio, msg->status,
+							NULL);
+		break;
+		case OBUS_WORKER_WRITE:
+			wio->n_pending--;
+			wio->pending_bytes -= obus_buffer_length(msg->buf);
+			wio->blocked = msg->blocked;
+			obus_worker_io_complete(wio, msg->status, msg->buf);
+			obus_buffer_unref(msg->buf);
+		break;
+		case OBUS_WORKER_DETACH:
+			/* worker does not use io anymore */
+			worker->n_ios--;
+			(*wio->closed_cb) (wio->user_data);
+			free(wio->name);
+			free(wio);
+		break;
+		case OBUS_WORKER_STOP:
+		default:
+			/* stop message is not allocated */
+			continue;
+		}
+
+		obus_slab_free(worker->msgs, msg);
+	}
+}
+
+static struct obus_worker_msg *obus_worker_msg_new(struct obus_worker *worker,
+						   enum obus_worker_op op,
+						   struct obus_worker_io *wio)
+{
+	struct obus_worker_msg *msg;
+
+	msg = obus_slab_alloc(worker->msgs);
+	if (msg) {
+		msg->op = op;
+		msg->wio = wio;
+	}
+
+	return msg;
+}
+
+struct obus_worker *obus_worker_new(struct obus_loop *loop)
+{
+	struct obus_worker *worker;
+	sigset_t set, oldset;
+	int ret;
+
+	if (!loop)
+		return NULL;
+
+	worker = calloc(1, sizeof(*worker));
+	if (!worker)
+		return NULL;
+
+	obus_list_init(&worker->corked);
+	worker->msgs = obus_slab_new(sizeof(struct obus_worker_msg),
+				     OBUS_WORKER_MSG_CACHE);
+	if (!worker->msgs)
+		goto free_worker;
+
+	worker->loop = obus_loop_new();
+	if (!worker->loop)
+		goto release_msgs;
+
+	worker->inbox = obus_submit_new(worker->loop, &obus_worker_inbox,
+					worker);
+	if (!worker->inbox)
+		goto unref_loop;
+
+	worker->done = obus_submit_new(loop, &obus_worker_done, worker);
+	if (!worker->done)
+		goto destroy_inbox;
+
+	/* signals are left to application threads */
+	sigfillset(&set);
+	pthread_sigmask(SIG_SETMASK, &set, &oldset);
+	ret = pthread_create(&worker->thread, NULL, &obus_worker_run, worker);
+	pthread_sigmask(SIG_SETMASK, &oldset, NULL);
+	if (ret != 0) {
+		obus_error("pthread_create error=%d(%s)", ret, strerror(ret));
+		goto destroy_done;
+	}
+
+	return worker;
+
+destroy_done:
+	obus_submit_destroy(worker->done);
+destroy_inbox:
+	obus_submit_destroy(worker->inbox);
+unref_loop:
+	obus_loop_unref(worker->loop);
+release_msgs:
+	obus_slab_release(worker->msgs);
+free_worker:
+	free(worker);
+	return NULL;
+}
+
+void obus_worker_destroy(struct obus_worker *worker)
+{
+	struct obus_worker_msg msg;
+
+	if (!worker)
+		return;
+
+	/* stop message is given back in done queue, not freed */
+	memset(&msg, 0, sizeof(msg));
+	msg.op = OBUS_WORKER_STOP;
+	obus_submit_push(worker->inbox, &msg.node);
+	pthread_join(worker->thread, NULL);
+
+	/* give back messages not yet received, closing released ios */
+	obus_worker_done(obus_submit_take(worker->done), worker);
+	if (worker->n_ios > 0)
+		obus_warn("worker destroyed with %zu ios", worker->n_ios);
+
+	obus_submit_destroy(worker->done);
+	obus_submit_destroy(worker->inbox);
+	obus_loop_unref(worker->loop);
+	obus_slab_release(worker->msgs);
+	free(worker);
+}
+
+size_t obus_worker_get_io_count(const struct obus_worker *worker)
+{
+	return worker ? worker->n_ios : 0;
+}
+
+struct obus_worker_io *obus_worker_io_new(struct obus_worker *worker,
+					  const char *name, int fd, int log_io,
+					  obus_io_write_cb_t write_cb,
+					  obus_worker_io_closed_cb_t closed_cb,
+					  void *user_data)
+{
+	struct obus_worker_msg *msg;
+	struct obus_worker_io *wio;
+
+	if (!worker || fd < 0 || !write_cb || !closed_cb)
+		return NULL;
+
+	wio = calloc(1, sizeof(*wio));
+	if (!wio)
+		return NULL;
+
+	wio->name = strdup(name ? name : "???");
+	if (!wio->name)
+		goto free_wio;
+
+	wio->worker = worker;
+	wio->fd = fd;
+	wio->log_io = log_io;
+	obus_list_init(&wio->queued);
+	wio->write_cb = write_cb;
+	wio->closed_cb = closed_cb;
+	wio->user_data = user_data;
+
+	/* detach message is allocated now so that destroy can not fail */
+	msg = obus_worker_msg_new(worker, OBUS_WORKER_ATTACH, wio);
+	if (!msg)
+		goto free_name;
+
+	wio->detach = obus_worker_msg_new(worker, OBUS_WORKER_DETACH, wio);
+	if (!wio->detach)
+		goto free_msg;
+
+	obus_submit_push(worker->inbox, &msg->node);
+	worker->n_ios++;
+	return wio;
+
+free_msg:
+	obus_slab_free(worker->msgs, msg);
+free_name:
+	free(wio->name);
+free_wio:
+	free(wio);
+	return NULL;
+}
+
+void obus_worker_io_destroy(struct obus_worker_io *wio)
+{
+	if (!wio || wio->closing)
+		return;
+
+	/* detach is only given back once worker released io */
+	wio->closing = 1;
+	obus_submit_push(wio->worker->inbox, &wio->detach->node);
+}
+
+int obus_worker_io_write(struct obus_worker_io *wio, struct obus_buffer *buf)
+{
+	struct obus_worker_msg *msg;
+
+	if (!wio || !buf || wio->closing)
+		return -EINVAL;
+
+	msg = obus_worker_msg_new(wio->worker, OBUS_WORKER_WRITE, wio);
+	if (!msg)
+		return -ENOMEM;
+
+	/* buffer reference is released once written */
+	msg->buf = obus_buffer_ref(buf);
+	obus_submit_push(wio->worker->inbox, &msg->node);
+	wio->n_pending++;
+	wio->pending_bytes += obus_buffer_length(buf);
+	return 0;
+}
+
+size_t obus_worker_io_get_pending_count(const struct obus_worker_io *wio)
+{
+	return wio ? wio->n_pending : 0;
+}
+
+size_t obus_worker_io_get_pending_bytes(const struct obus_worker_io *wio)
+{
+	return wio ? wio->pending_bytes : 0;
+}
+
+int obus_worker_io_is_blocked(const struct obus_worker_io *wio)
+{
+	return wio ? wio->blocked : 0;
+}
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * libobus - linux interprocess objects synchronization protocol.
+ *
+ * @file obus_worker.h
+ *
+ * @brief obus peers writer threads header
+ *
+ * @author jean-baptiste.dubois@parrot.com
+ *
+ * Copyright (c) 2013 Parrot S.A.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef _OBUS_WORKER_H_
+#define _OBUS_WORKER_H_
+
+/**
+ * peers writer thread.
+ *
+ * A worker runs its own loop in a dedicated thread and writes packets of
+ * the peers attached to it. Packets are encoded once by the server loop
+ * thread and handed to workers as referenced buffers which must not be
+ * modified anymore. Write completions are given back to the server loop
+ * thread, where buffers are released, so that buffer pools and all
+ * peers state are only accessed by the server loop thread.
+ */
+struct obus_worker;
+
+/* write only io of a peer attached to a worker */
+struct obus_worker_io;
+
+/**
+ * worker io callback invoked in server loop thread once io has been
+ * released by worker
+ * @param user_data callback user data
+ */
+typedef void (*obus_worker_io_closed_cb_t) (void *user_data);
+
+/**
+ * create worker and start its thread
+ * @param loop server loop receiving write completions
+ * @return worker or NULL on error
+ */
+struct obus_worker *obus_worker_new(struct obus_loop *loop);
+
+/**
+ * stop and join worker thread, all worker ios must have been destroyed
+ * before, their closed callbacks are invoked here if not done yet
+ * @param worker worker
+ */
+void obus_worker_destroy(struct obus_worker *worker);
+
+/**
+ * get number of ios attached to worker
+ * @param worker worker
+ * @return number of ios
+ */
+size_t obus_worker_get_io_count(const struct obus_worker *worker);
+
+/**
+ * attach a write only io of given fd to worker
+ * @param worker worker
+ * @param name io name (label)
+ * @param fd io file descriptor, must stay opened until closed callback
+ * @param log_io log io traffic
+ * @param write_cb write completion callback, invoked in server loop thread
+ * in write order until first failed write, io must then be destroyed
+ * @param closed_cb io released callback
+ * @param user_data callbacks user data
+ * @return worker io or NULL on error
+ */
+struct obus_worker_io *obus_worker_io_new(struct obus_worker *worker,
+					  const char *name, int fd, int log_io,
+					  obus_io_write_cb_t write_cb,
+					  obus_worker_io_closed_cb_t closed_cb,
+					  void *user_data);
+
+/**
+ * detach io from its worker, pending writes are aborted. closed callback
+ * is invoked once worker does not use io fd anymore
+ * @param wio worker io
+ */
+void obus_worker_io_destroy(struct obus_worker_io *wio);
+
+/**
+ * hand buffer to worker io, a buffer reference is kept until write
+ * callback has returned
+ * @param wio worker io
+ * @param buf encoded packet buffer
+ * @return 0 on success
+ */
+int obus_worker_io_write(struct obus_worker_io *wio, struct obus_buffer *buf);
+
+/**
+ * get number of buffers handed to worker and not yet written
+ * @param wio worker io
+ * @return number of buffers
+ */
+size_t obus_worker_io_get_pending_count(const struct obus_worker_io *wio);
+
+/**
+ * get bytes handed to worker and not yet written
+ * @param wio worker io
+ * @return number of bytes
+ */
+size_t obus_worker_io_get_pending_bytes(const struct obus_worker_io *wio);
+
+/**
+ * check if worker was waiting for io fd to be writable when last write
+ * completion has been given back
+ * @param wio worker io
+ * @return 1 if blocked, 0 otherwise
+ */
+int obus_worker_io_is_blocked(const struct obus_worker_io *wio);
+
+#endif /* _OBUS_WORKER_H_ */
@@ -50,6 +50,7 @@ obusgen-macro-path := $(LOCAL_PATH)
 # $4: output directory (Relative to build directory unless an absolute path is
 #     given (ex LOCAL_PATH).
 # $5: input xml file
+# $6: extra obusgen option without leading '--' (optional, ex: codecs)
 define obusgen-macro
 
 # Setup some internal variables
@@ -59,10 +60,10 @@ obusgen_out_dir := $(if $(call is-path-absolute,$4),$4,$$(obusgen_module_build_d
 obusgen_done_file := $$(obusgen_module_build_dir)/$$(notdir $$(obusgen_xml_file)).done
 $(if $(wildcard $(HOST_OUT_STAGING)/usr/lib/obusgen/obusgen.py), \
 	obusgen_gen_files := $$(shell $(HOST_OUT_STAGING)/usr/lib/obusgen/obusgen.py \
-		--files --$1 --lang $2 --package $3 -o $$(obusgen_out_dir) $5) \
+		--files --$1 --lang $2 --package $3 $(if $6,--$6) -o $$(obusgen_out_dir) $5) \
 	, \
 	obusgen_gen_files := $$(shell $(obusgen-macro-path)/obusgen.py \
-		--files --$1 --lang $2 --package $3 -o $$(obusgen_out_dir) $5) \
+		--files --$1 --lang $2 --package $3 $(if $6,--$6) -o $$(obusgen_out_dir) $5) \
 )
 obusgen_c_files := $$(filter %.c,$$(obusgen_gen_files))
 obusgen_h_files := $$(filter %.h,$$(obusgen_gen_files))
@@ -87,7 +88,7 @@ $$(obusgen_done_file): PRIVATE_OUT_DIR := $$(obusgen_out_dir)
 $$(obusgen_done_file): $$(obusgen_xml_file)
 	@echo "$$(PRIVATE_MODULE): Generating obus files from $$(call path-from-top,$5)"
 	$(Q) $(HOST_OUT_STAGING)/usr/lib/obusgen/obusgen.py \
-		--$1 --lang $2 --package $3 -o $$(PRIVATE_OUT_DIR) $5
+		--$1 --lang $2 --package $3 $(if $6,--$6) -o $$(PRIVATE_OUT_DIR) $5
 	@mkdir -p $(TARGET_OUT_STAGING)/usr/share/obus
 	$(Q) cp -af $5 $(TARGET_OUT_STAGING)/usr/share/obus/$(notdir $5).$$(PRIVATE_MODULE)
 	$(Q) mv -f $(TARGET_OUT_STAGING)/usr/share/obus/$(notdir $5).$$(PRIVATE_MODULE) \
@@ -46,7 +46,8 @@ from obus_c_bus_event import ObusBusEventsWriter
 from obus_c_type import getType
 from obus_c_type import getLibobusType
 from obus_c_enum import ObusEnumWriter
-from obus_c_utils import getObjectName, indentFile
+from obus_c_codec import ObusCodecWriter, ObusCodecField
+from obus_c_utils import getObjectName, indentFile, writeUidTable
 from obusgen import Writer, writeHeader
 
 def genHeader(out, obj, client, header):
@@ -85,7 +86,7 @@ def genFooter(out, header):
 		out.write("\n/* *INDENT-OFF* */\nOBUS_END_DECLS\n/* *INDENT-ON* */\n")
 		out.write("\n#endif /*_%s_H_*/\n", guard)
 
-def genObjectStruct(out, obj):
+def genObjectStruct(out, obj, options):
 	# declare enum object fields
 
 	first = True
@@ -144,6 +145,28 @@ def genObjectStruct(out, obj):
 		# out.write("/* *INDENT-ON* */\n")
 	out.write("\n};\n")
 
+	# field uid lookup table
+	uids = []
+	for prop in obj.properties.values():
+		uids.append((prop.uid, "%s_FIELD_%s" % (getObjectName(obj).upper(),
+				prop.name.upper())))
+	for mtd in obj.methods.values():
+		uids.append((mtd.uid, "%s_FIELD_METHOD_%s" % (
+				getObjectName(obj).upper(), mtd.name.upper())))
+	hasUids = writeUidTable(out, "%s_info_uids" % getObjectName(obj), uids)
+
+	# schema specialized encoder/decoder
+	codec = None
+	if options.codecs:
+		fields = []
+		for prop in obj.properties.values():
+			fields.append(ObusCodecField(prop.uid, prop.name, prop.type))
+		for mtd in obj.methods.values():
+			fields.append(ObusCodecField(mtd.uid, "method_" + mtd.name,
+					None, "enum obus_method_state", "OBUS_FIELD_ENUM"))
+		codec = ObusCodecWriter("%s_info" % getObjectName(obj), fields)
+		codec.writeCodec(out)
+
 	out.write("\nstatic const struct obus_struct_desc %s_info_desc = {\n",
 			getObjectName(obj))
 	out.write("\t.size = sizeof(struct %s_info),\n", getObjectName(obj))
@@ -152,6 +175,12 @@ def genObjectStruct(out, obj):
 	out.write("\t.n_fields = OBUS_SIZEOF_ARRAY(%s_info_fields),\n",
 			getObjectName(obj))
 	out.write("\t.fields = %s_info_fields,\n", getObjectName(obj))
+	if hasUids:
+		out.write("\t.uids = %s_info_uids,\n", getObjectName(obj))
+		out.write("\t.n_uids = OBUS_SIZEOF_ARRAY(%s_info_uids),\n",
+				getObjectName(obj))
+	if codec:
+		codec.writeDescCallbacks(out)
 	out.write("};\n")
 
 def genObjectDesc(out, obj):
@@ -929,6 +958,59 @@ def genObjectApi(out, obj, options, header):
 			out.write("\treturn obus_server_send_event(server, &event);\n")
 			out.write("}\n\n")
 
+		if header:
+			out.write("\n/**\n")
+			out.write(" * @brief submit a %s object event from any thread.\n", getObjectName(obj))
+			out.write(" *\n")
+			out.write(" * This function queue an event on a %s object, it may be\n", getObjectName(obj))
+			out.write(" * called from another thread than the server loop one.\n")
+			out.write(" * Event is sent and object content updated by server loop,\n")
+			out.write(" * submitted events of a thread are sent in submission order.\n")
+			out.write(" * Object must not be destroyed before its event is sent.\n")
+			out.write(" *\n")
+			out.write(" * @param[in]  server    %s bus server.\n", obj.bus.name)
+			out.write(" * @param[in]  object    %s object.\n", getObjectName(obj))
+			out.write(" * @param[in]  type      %s event type.\n", getObjectName(obj))
+			out.write(" * @param[in]  info      associated %s content to be updated.\n", getObjectName(obj))
+			out.write(" *\n")
+			out.write(" * @retval  0          event queued.\n")
+			out.write(" * @retval  -EINVAL    invalid parameters.\n")
+			out.write(" * @retval  -ENOMEM    memory error.\n")
+			out.write(" *\n")
+			out.write(" * @note: Partial info members copy is done inside function.\n")
+			out.write(" * No reference to info members is kept.\n")
+			out.write(" **/")
+
+		out.write("\nint %s_submit_event(struct obus_server *server, struct %s"\
+				" *object, enum %s_event_type type, const struct %s_info "\
+				"*info)%s\n", getObjectName(obj), getObjectName(obj),
+				getObjectName(obj), getObjectName(obj),
+				(';' if header else ''))
+
+		if not header:
+			out.write("{\n")
+			out.write("\tint ret;\n")
+			out.write("\tstruct obus_event *event;\n")
+			out.write("\tstruct obus_struct st = {\n\t\t.u.const_addr = info,\n\t\t"\
+					".desc = %s_desc.info_desc\n\t};\n", getObjectName(obj))
+			out.write("\n")
+			out.write("\tif (!object || !server || type >= %s_EVENT_COUNT)\n",
+					getObjectName(obj).upper())
+			out.write("\t\treturn -EINVAL;\n")
+			out.write("\n")
+			out.write("\tevent = obus_event_new(%s_object(object), "\
+					"&%s_events_desc[type], &st);\n", getObjectName(obj),
+					getObjectName(obj))
+			out.write("\tif (!event)\n")
+			out.write("\t\treturn -ENOMEM;\n")
+			out.write("\n")
+			out.write("\tret = obus_server_submit_event(server, event);\n")
+			out.write("\tif (ret < 0)\n")
+			out.write("\t\tobus_event_destroy(event);\n")
+			out.write("\n")
+			out.write("\treturn ret;\n")
+			out.write("}\n\n")
+
 	if not options.client:
 		if obj.events:
 			if header:
@@ -1114,7 +1196,7 @@ def genObject(obj, options, header):
 		ObusEventsWriter(obj).declareEvents(out)
 	else:
 		# generate object struct
-		genObjectStruct(out, obj)
+		genObjectStruct(out, obj, options)
 		# generate events
 		ObusEventsWriter(obj).writeEventsDesc(out)
 
@@ -1122,7 +1204,7 @@ def genObject(obj, options, header):
 
 	if not header:
 		# generate object methods struct
-		ObusMethodsWriter(obj).writeMethodsDesc(out)
+		ObusMethodsWriter(obj).writeMethodsDesc(out, options.codecs)
 		# generate object desc
 		genObjectDesc(out, obj)
 
@@ -1254,5 +1336,6 @@ if __name__ == "__main__":
 		def __init__(self):
 			self.outdir = "."
 			self.client = True
+			self.codecs = False
 			self.lang = "c"
 	main(_Options(), sys.argv[1])
@@ -264,3 +264,30 @@ class ObusBusEventsWriter(object):
 				out.write("\tstruct obus_bus_event *evt = (struct obus_bus_event *)event;\n")
 				out.write("\treturn obus_server_send_bus_event(server, evt);\n")
 				out.write("}\n")
+
+			if header:
+				out.write("\n/**\n")
+				out.write(" * @brief submit a %s bus event from any thread.\n", self.bus.name)
+				out.write(" *\n")
+				out.write(" * This function queue a %s bus event, it may be called\n", self.bus.name)
+				out.write(" * from another thread than the server loop one.\n")
+				out.write(" * Bus event is sent then destroyed by server loop, submitted\n")
+				out.write(" * bus events of a thread are sent in submission order.\n")
+				out.write(" * Bus event must not be used anymore once submitted.\n")
+				out.write(" *\n")
+				out.write(" * @param[in]  server  %s bus server.\n", self.bus.name)
+				out.write(" * @param[in]  event   %s bus event.\n", self.bus.name)
+				out.write(" *\n")
+				out.write(" * @retval     0      bus event is queued\n")
+				out.write(" * @retval  -EINVAL   invalid parameters.\n")
+				out.write(" * @retval  -ENOMEM   memory error.\n")
+				out.write(" **/")
+
+			out.write("\nint %s_bus_event_submit(struct obus_server *server, "\
+					"struct %s_bus_event *event)%s\n", self.bus.name, self.bus.name,
+					(';' if header else ''))
+			if not header:
+				out.write("{\n")
+				out.write("\tstruct obus_bus_event *evt = (struct obus_bus_event *)event;\n")
+				out.write("\treturn obus_server_submit_bus_event(server, evt);\n")
+				out.write("}\n")
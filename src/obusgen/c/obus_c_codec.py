@@ -0,0 +1,218 @@
+#!/usr/bin/env python
+#===============================================================================
+# obusgen - obus source code generator.
+#
+# @file obus_c_codec.py
+#
+# @brief obus c struct encoder/decoder code generator
+#
+# @author jean-baptiste.dubois@parrot.com
+#
+# Copyright (c) 2013 Parrot S.A.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#   * Neither the name of the Parrot Company nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL PARROT COMPANY BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+# THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#===============================================================================
+
+from obusparser import ObusType
+from obus_c_type import getType
+from obus_c_type import getLibobusType
+
+# wire size and store/load helper suffix for each obus type
+CODEC_TYPES = {
+	ObusType.Type.INT8 : (1, 'u8', 'uint8_t'),
+	ObusType.Type.UINT8 : (1, 'u8', 'uint8_t'),
+	ObusType.Type.INT16 : (2, 'u16', 'uint16_t'),
+	ObusType.Type.UINT16 : (2, 'u16', 'uint16_t'),
+	ObusType.Type.INT32 : (4, 'u32', 'uint32_t'),
+	ObusType.Type.UINT32 : (4, 'u32', 'uint32_t'),
+	ObusType.Type.INT64 : (8, 'u64', 'uint64_t'),
+	ObusType.Type.UINT64 : (8, 'u64', 'uint64_t'),
+	ObusType.Type.HANDLE : (2, 'u16', 'uint16_t'),
+	ObusType.Type.ENUM : (4, 'u32', 'uint32_t'),
+	ObusType.Type.BOOL : (1, 'u8', 'uint8_t'),
+	ObusType.Type.FLOAT : (4, 'f32', None),
+	ObusType.Type.DOUBLE : (8, 'f64', None),
+	ObusType.Type.STRING : (None, 'string', None)}
+
+class ObusCodecField(object):
+	""" struct field as seen by codec writer """
+	def __init__(self, uid, member, t, ctype=None, libtype=None):
+		self.uid = uid
+		self.member = member
+		self.base = t.base if t else ObusType.Type.ENUM
+		self.array = t.isArray() if t else False
+		self.ctype = ctype if ctype else getType(t).strip()
+		self.libtype = libtype if libtype else getLibobusType(t)
+
+	def isScalar(self):
+		return not self.array and self.base != ObusType.Type.STRING
+
+	def getWireSize(self):
+		return CODEC_TYPES[self.base][0]
+
+	def getStore(self, value):
+		(size, suffix, cast) = CODEC_TYPES[self.base]
+		if self.base == ObusType.Type.BOOL:
+			value = "%s ? 1 : 0" % value
+		elif cast:
+			value = "(%s)%s" % (cast, value)
+		return "obus_put_%s(p, %s)" % (suffix, value)
+
+	def getLoad(self):
+		(size, suffix, cast) = CODEC_TYPES[self.base]
+		value = "obus_get_%s(ptr)" % suffix
+		if self.base == ObusType.Type.BOOL:
+			return "%s ? 1 : 0" % value
+		elif self.base == ObusType.Type.ENUM:
+			return "(%s)(int32_t)%s" % (self.ctype, value)
+		elif cast and cast != self.ctype:
+			return "(%s)%s" % (self.ctype, value)
+		return value
+
+class ObusCodecWriter(object):
+	""" schema specialized struct encoder/decoder writer """
+	def __init__(self, name, fields):
+		# struct name (ex: bus_object_info)
+		self.name = name
+		# list of ObusCodecField, in struct description order
+		self.fields = fields
+
+	def hasScalar(self):
+		for field in self.fields:
+			if field.isScalar():
+				return True
+		return False
+
+	def hasArray(self):
+		for field in self.fields:
+			if field.array:
+				return True
+		return False
+
+	def hasStringArray(self):
+		for field in self.fields:
+			if field.array and not field.getWireSize():
+				return True
+		return False
+
+	def writeEncodedSize(self, out):
+		out.write("\nstatic size_t %s_encoded_size(const struct obus_struct *st)\n",
+				self.name)
+		out.write("{\n")
+		out.write("\tconst struct %s *info = st->u.const_addr;\n", self.name)
+		out.write("\tsize_t size = 2;\n")
+		if self.hasStringArray():
+			out.write("\tuint32_t i;\n")
+		out.write("\n")
+		for field in self.fields:
+			value = "info->%s" % field.member
+			if not field.array:
+				out.write("\tif (info->fields.%s)\n", field.member)
+				if field.getWireSize():
+					out.write("\t\tsize += 3 + %d;\n", field.getWireSize())
+				else:
+					out.write("\t\tsize += 3 + obus_string_encoded_size(%s);\n",
+						value)
+			elif field.getWireSize():
+				out.write("\tif (info->fields.%s)\n", field.member)
+				out.write("\t\tsize += 3 + 4 + info->n_%s * %d;\n",
+					field.member, field.getWireSize())
+			else:
+				out.write("\tif (info->fields.%s) {\n", field.member)
+				out.write("\t\tsize += 3 + 4;\n")
+				out.write("\t\tfor (i = 0; i < info->n_%s; i++)\n", field.member)
+				out.write("\t\t\tsize += obus_string_encoded_size(%s[i]);\n",
+					value)
+				out.write("\t}\n")
+		out.write("\n\treturn size;\n")
+		out.write("}\n")
+
+	def writeEncode(self, out):
+		out.write("\nstatic size_t %s_encode(const struct obus_struct *st, uint8_t *ptr)\n",
+				self.name)
+		out.write("{\n")
+		out.write("\tconst struct %s *info = st->u.const_addr;\n", self.name)
+		out.write("\tuint8_t *p = ptr + 2;\n")
+		out.write("\tuint16_t n_fields = 0;\n")
+		if self.hasArray():
+			out.write("\tuint32_t i;\n")
+		out.write("\n")
+		for field in self.fields:
+			value = "info->%s" % field.member
+			out.write("\tif (info->fields.%s) {\n", field.member)
+			out.write("\t\tp = obus_put_u16(p, %d);\n", field.uid)
+			out.write("\t\tp = obus_put_u8(p, %s);\n", field.libtype)
+			if field.array:
+				out.write("\t\tp = obus_put_u32(p, info->n_%s);\n", field.member)
+				out.write("\t\tfor (i = 0; i < info->n_%s; i++)\n", field.member)
+				out.write("\t\t\tp = %s;\n", field.getStore(value + "[i]"))
+			else:
+				out.write("\t\tp = %s;\n", field.getStore(value))
+			out.write("\t\tn_fields++;\n")
+			out.write("\t}\n")
+		out.write("\n\tobus_put_u16(ptr, n_fields);\n")
+		out.write("\treturn (size_t)(p - ptr);\n")
+		out.write("}\n")
+
+	def writeDecodeField(self, out):
+		out.write("\nstatic size_t %s_decode_field(const struct obus_struct *st,\n",
+				self.name)
+		out.write("\t\tuint16_t uid, uint8_t type, const uint8_t *ptr, size_t len)\n")
+		out.write("{\n")
+		out.write("\tstruct %s *info = st->u.addr;\n", self.name)
+		out.write("\n")
+		out.write("\tswitch (uid) {\n")
+		for field in self.fields:
+			if not field.isScalar():
+				continue
+			out.write("\tcase %d:\n", field.uid)
+			out.write("\t\tif (type != %s || len < %d)\n", field.libtype,
+					field.getWireSize())
+			out.write("\t\t\treturn 0;\n")
+			out.write("\t\tinfo->%s = %s;\n", field.member, field.getLoad())
+			out.write("\t\treturn %d;\n", field.getWireSize())
+		out.write("\tdefault:\n")
+		out.write("\t\t/* strings, arrays & unknown fields use generic decoder */\n")
+		out.write("\t\treturn 0;\n")
+		out.write("\t}\n")
+		out.write("}\n")
+
+	def writeCodec(self, out):
+		""" write struct encoder & decoder functions """
+		if not self.fields:
+			return
+		self.writeEncodedSize(out)
+		self.writeEncode(out)
+		if self.hasScalar():
+			self.writeDecodeField(out)
+
+	def writeDescCallbacks(self, out):
+		""" write struct description codec callbacks """
+		if not self.fields:
+			return
+		out.write("\t.encoded_size = %s_encoded_size,\n", self.name)
+		out.write("\t.encode = %s_encode,\n", self.name)
+		if self.hasScalar():
+			out.write("\t.decode_field = %s_decode_field,\n", self.name)
@@ -38,7 +38,8 @@
 from obus_c_type import getType
 from obus_c_type import getLibobusType
 from obus_c_enum import ObusEnumWriter
-from obus_c_utils import getObjectName
+from obus_c_codec import ObusCodecWriter, ObusCodecField
+from obus_c_utils import getObjectName, writeUidTable
 
 class ObusMethodsWriter(object):
 	""" ObusMethods C class writer """
@@ -76,7 +77,7 @@ class ObusMethodsWriter(object):
 
 			ObusMethodWriter(mtd).writeMethodCallApi(header, out)
 
-	def writeMethodsDesc(self, out):
+	def writeMethodsDesc(self, out, codecs=False):
 		""" generate object methods args struct """
 		if not self.obj.methods:
 			return
@@ -95,7 +96,7 @@ class ObusMethodsWriter(object):
 		out.write("};\n")
 
 		for mtd in self.obj.methods.values():
-			ObusMethodWriter(mtd).writeMethodArgsDesc(out)
+			ObusMethodWriter(mtd).writeMethodArgsDesc(out, codecs)
 
 		out.write("\nstatic const struct obus_method_desc %s[] = {\n",
 				self.getMethodsDescSymbol())
@@ -171,7 +172,7 @@ class ObusMethodWriter(object):
 
 		out.write("};\n")
 
-	def writeMethodArgsDesc(self, out):
+	def writeMethodArgsDesc(self, out, codecs=False):
 		""" write method arguments srtruct in a .c file """
 
 		if self.mtd.args:
@@ -201,6 +202,20 @@ class ObusMethodWriter(object):
 				out.write("\t}\n")
 			out.write("};\n")
 
+			# argument uid lookup table
+			uids = []
+			for (idx, arg) in enumerate(self.mtd.args.values()):
+				uids.append((arg.uid, idx))
+			hasUids = writeUidTable(out, "%s_uids" % self.getMethodArgsName(),
+					uids)
+
+			# schema specialized encoder/decoder
+			if codecs:
+				fields = [ObusCodecField(arg.uid, arg.name, arg.type)
+						for arg in self.mtd.args.values()]
+				codec = ObusCodecWriter(self.getMethodArgsName(), fields)
+				codec.writeCodec(out)
+
 		out.write("\nstatic const struct obus_struct_desc %s = {\n",
 				self.getMethodArgsNameDescSymbol())
 		if self.mtd.args:
@@ -210,6 +225,12 @@ class ObusMethodWriter(object):
 			out.write("\t.n_fields = OBUS_SIZEOF_ARRAY(%s_fields),\n",
 				self.getMethodArgsName())
 			out.write("\t.fields = %s_fields,\n", self.getMethodArgsName())
+			if hasUids:
+				out.write("\t.uids = %s_uids,\n", self.getMethodArgsName())
+				out.write("\t.n_uids = OBUS_SIZEOF_ARRAY(%s_uids),\n",
+						self.getMethodArgsName())
+			if codecs:
+				codec.writeDescCallbacks(out)
 		else:
 			out.write("\t.size = 0,\n")
 			out.write("\t.fields_offset = 0,\n")
@@ -70,6 +70,26 @@ def writeFooterIncludeGuard(out):
 def getObjectName(obj):
 	return obj.bus.name + "_" + obj.name
 
+#===============================================================================
+# write struct field uid lookup table.
+# fields is a list of (uid, field index) tuples, table gives field index + 1
+# for each uid. Nothing is written if uids are too sparse.
+#===============================================================================
+UID_TABLE_MAX = 1024
+
+def writeUidTable(out, symbol, fields):
+	if not fields or max([uid for (uid, idx) in fields]) > UID_TABLE_MAX:
+		return False
+
+	out.write("\nstatic const uint16_t %s[] = {\n", symbol)
+	for (uid, idx) in sorted(fields):
+		if isinstance(idx, int):
+			out.write("\t[%d] = %d,\n", uid, idx + 1)
+		else:
+			out.write("\t[%d] = %s + 1,\n", uid, idx)
+	out.write("};\n")
+	return True
+
 #===============================================================================
 # indent c or h file.
 #===============================================================================
@@ -150,6 +150,11 @@ def parseArgs():
 		action = "store_false",
 		default = False,
 		help = "Generate code for server")
+	parser.add_option("--codecs",
+		dest = "codecs",
+		action = "store_true",
+		default = False,
+		help = "Generate schema specialized struct encoders/decoders (c only)")
 	parser.add_option("-f", "--files",
 		dest = "listFiles",
 		action = "store_true",